@@ -0,0 +1,200 @@
+# Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+# Runs every benchmark kernel through the converter, the translator and DaCe at
+# several problem sizes. Times each pipeline stage as well as the execution of
+# the compiled SDFG and stores the results as JSON. If a baseline is provided,
+# reports every measurement that got slower than the threshold allows.
+
+import argparse
+import glob
+import json
+import os
+import re
+import statistics
+import string
+import subprocess
+import sys
+import time
+
+import dace
+import numpy as np
+from dace import SDFG
+from dace.config import Config
+
+Config.set("cache", value='unique')
+
+SIZE_RE = re.compile(r"^//\s*SIZE\s+(\w+):(.*)$")
+
+
+def parse_sizes(source):
+    """Extracts the problem sizes listed in the header of a kernel."""
+    sizes = {}
+    for line in source.splitlines():
+        match = SIZE_RE.match(line)
+        if match:
+            params = dict(p.split("=") for p in match.group(2).split())
+            sizes[match.group(1)] = params
+    return sizes
+
+
+def run_stage(cmd, stdin, timeout):
+    """Runs a command of the pipeline and returns its output and duration."""
+    start = time.perf_counter()
+    res = subprocess.run(cmd,
+                         input=stdin,
+                         capture_output=True,
+                         text=True,
+                         timeout=timeout)
+    duration = time.perf_counter() - start
+
+    if res.returncode != 0:
+        raise RuntimeError("%s failed:\n%s" % (" ".join(cmd), res.stderr))
+
+    return res.stdout, duration
+
+
+def create_args(sdfg):
+    """Creates randomly initialized arguments for the SDFG."""
+    rng = np.random.default_rng(0)
+    args = {}
+
+    for arg_name, arg_type in sdfg.arglist().items():
+        array = dace.ndarray(shape=arg_type.shape, dtype=arg_type.dtype)
+        array[:] = rng.random(array.shape)
+        args[arg_name] = array
+
+    return args
+
+
+def bench_kernel(path, size, params, options):
+    """Benchmarks a kernel at a single problem size."""
+    with open(path) as f:
+        source = string.Template(f.read()).substitute(params)
+
+    stages = {}
+    converted, stages["convert"] = run_stage(
+        [options.sdfg_opt, "--convert-to-sdfg"], source, options.timeout)
+    translated, stages["translate"] = run_stage(
+        [options.sdfg_translate, "--mlir-to-sdfg"], converted,
+        options.timeout)
+
+    start = time.perf_counter()
+    sdfg = SDFG.from_json(json.loads(translated))
+    stages["import"] = time.perf_counter() - start
+
+    start = time.perf_counter()
+    obj = sdfg.compile()
+    stages["compile"] = time.perf_counter() - start
+
+    args = create_args(sdfg)
+    runtimes = []
+    for _ in range(options.repetitions):
+        start = time.perf_counter()
+        obj(**args)
+        runtimes.append(time.perf_counter() - start)
+
+    return {
+        "kernel": os.path.splitext(os.path.basename(path))[0],
+        "size": size,
+        "params": params,
+        "stages": stages,
+        "runtimes": runtimes,
+        "median": statistics.median(runtimes),
+    }
+
+
+def find_regressions(results, baseline, threshold):
+    """Returns a description of every measurement slower than the baseline."""
+    reference = {(r["kernel"], r["size"]): r for r in baseline}
+    regressions = []
+
+    for result in results:
+        ref = reference.get((result["kernel"], result["size"]))
+        if ref is None or "error" in result or "error" in ref:
+            continue
+
+        timings = dict(result["stages"], execute=result["median"])
+        ref_timings = dict(ref["stages"], execute=ref["median"])
+
+        for name, value in timings.items():
+            ref_value = ref_timings.get(name)
+            if ref_value and value > ref_value * threshold:
+                regressions.append(
+                    "%s (%s) %s: %.4fs -> %.4fs" %
+                    (result["kernel"], result["size"], name, ref_value, value))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmarks the SDFG pipeline on the kernels")
+    parser.add_argument("--sdfg-opt", default="sdfg-opt")
+    parser.add_argument("--sdfg-translate", default="sdfg-translate")
+    parser.add_argument("--kernels",
+                        default=os.path.join(os.path.dirname(__file__),
+                                             "polybench"),
+                        help="directory containing the kernel templates")
+    parser.add_argument("--sizes",
+                        default="mini,small",
+                        help="comma-separated list of problem sizes")
+    parser.add_argument("--repetitions", type=int, default=5)
+    parser.add_argument("--timeout",
+                        type=float,
+                        default=600.0,
+                        help="seconds after which a pipeline stage fails")
+    parser.add_argument("--output", default="bench_results.json")
+    parser.add_argument("--baseline", help="results of a previous run")
+    parser.add_argument("--threshold",
+                        type=float,
+                        default=1.1,
+                        help="slowdown reported as a regression")
+    options = parser.parse_args()
+
+    results = []
+    failed = False
+
+    for path in sorted(glob.glob(os.path.join(options.kernels, "*.mlir"))):
+        with open(path) as f:
+            sizes = parse_sizes(f.read())
+
+        for size in options.sizes.split(","):
+            if size not in sizes:
+                continue
+
+            try:
+                result = bench_kernel(path, size, sizes[size], options)
+            except (RuntimeError, subprocess.TimeoutExpired,
+                    json.JSONDecodeError) as e:
+                # Keeps the results collected so far and records the failure.
+                print("error: %s" % e, file=sys.stderr)
+                results.append({
+                    "kernel": os.path.splitext(os.path.basename(path))[0],
+                    "size": size,
+                    "params": sizes[size],
+                    "error": str(e),
+                })
+                failed = True
+                continue
+
+            results.append(result)
+            print("%-12s %-8s execute: %.4fs  compile: %.2fs" %
+                  (result["kernel"], size, result["median"],
+                   result["stages"]["compile"]))
+
+    with open(options.output, "w") as f:
+        json.dump(results, f, indent=2)
+
+    if options.baseline:
+        with open(options.baseline) as f:
+            regressions = find_regressions(results, json.load(f),
+                                           options.threshold)
+        for regression in regressions:
+            print("regression: %s" % regression, file=sys.stderr)
+        failed |= bool(regressions)
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
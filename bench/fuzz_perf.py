@@ -0,0 +1,525 @@
+# Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+# Differential performance fuzzing of the SDFG lowerings. Generates programs
+# with sdfg-smith and runs each of them through DaCe (translation to a SDFG)
+# and natively (lowering to generic MLIR and LLVM). Records the runtime and
+# the peak memory added by the execution of both paths and compares their
+# outputs. Programs with diverging outputs or where one path is slower than
+# the threshold allows are stored as findings together with their
+# measurements. With --minimize, the symbol value and the integer sdfg-smith
+# options of every finding are bisected down to the smallest values that still
+# reproduce it. With --compare, a given program is run through both paths
+# instead, which serves as an execution test of the lowerings.
+
+import argparse
+import copy
+import ctypes
+import json
+import os
+import resource
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+import numpy as np
+
+NATIVE_PIPELINE = [
+    "--llvm-request-c-wrappers", "--convert-scf-to-cf",
+    "--convert-math-to-libm", "--convert-math-to-llvm",
+    "--expand-strided-metadata", "--lower-affine", "--convert-arith-to-llvm",
+    "--finalize-memref-to-llvm", "--convert-func-to-llvm",
+    "--convert-cf-to-llvm", "--reconcile-unrealized-casts"
+]
+
+
+def run_stage(cmd, stdin, timeout):
+    """Runs a command of the pipeline and returns its output."""
+    res = subprocess.run(cmd,
+                         input=stdin,
+                         capture_output=True,
+                         text=True,
+                         timeout=timeout)
+
+    if res.returncode != 0:
+        raise RuntimeError("%s failed:\n%s" % (" ".join(cmd), res.stderr))
+
+    return res.stdout
+
+
+def get_peak_memory():
+    """Returns the peak resident set size of the current process in KiB."""
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+
+
+def run_child(cmd, timeout):
+    """Runs an execution child process. Returns the measurements it prints."""
+    with tempfile.TemporaryFile(mode="w+") as out:
+        proc = subprocess.Popen(cmd, stdout=out, stderr=subprocess.PIPE)
+
+        try:
+            _, stderr = proc.communicate(timeout=timeout)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+            proc.communicate()
+            raise RuntimeError("%s timed out" % " ".join(cmd))
+
+        stderr = stderr.decode()
+
+        if proc.returncode != 0:
+            raise RuntimeError("%s failed:\n%s" % (" ".join(cmd), stderr))
+
+        out.seek(0)
+        return json.loads(out.read())
+
+
+def get_signature(sdfg_json, symbol_value):
+    """Returns the shapes and types of the SDFG arguments in the order of the
+    SDFG dialect arguments as well as the values of the symbols in the order
+    the lowered function expects them."""
+    from dace import SDFG, data
+
+    sdfg = SDFG.from_json(sdfg_json)
+    arguments = []
+    symbols = {}
+
+    for name in sdfg.arg_names:
+        desc = sdfg.arrays[name]
+        dims = () if isinstance(desc, data.Scalar) else desc.shape
+        shape = []
+        for dim in dims:
+            if not isinstance(dim, int) and not str(dim).isdigit():
+                symbols.setdefault(str(dim), symbol_value)
+                dim = symbol_value
+            shape.append(int(dim))
+        arguments.append((name, tuple(shape), desc.dtype.as_numpy_dtype()))
+
+    return arguments, symbols
+
+
+def create_inputs(arguments, seed):
+    """Creates reproducible, randomly initialized arguments."""
+    rng = np.random.default_rng(seed)
+    inputs = {}
+
+    for name, shape, dtype in arguments:
+        if np.issubdtype(dtype, np.integer):
+            inputs[name] = rng.integers(0, 10, size=shape).astype(dtype)
+        else:
+            inputs[name] = rng.random(size=shape).astype(dtype)
+
+    return inputs
+
+
+def compare_outputs(dace_outputs, native_outputs):
+    """Returns the names of the arguments whose final values differ."""
+    diverging = []
+
+    for name in dace_outputs.files:
+        dace_value = dace_outputs[name]
+        native_value = native_outputs[name]
+
+        if np.issubdtype(dace_value.dtype, np.floating):
+            equal = np.allclose(dace_value,
+                                native_value,
+                                rtol=1e-5,
+                                equal_nan=True)
+        else:
+            equal = np.array_equal(dace_value, native_value)
+
+        if not equal:
+            diverging.append(name)
+
+    return diverging
+
+
+def execute_dace(options):
+    """Child process executing a translated SDFG through DaCe."""
+    from dace import SDFG
+    from dace.config import Config
+
+    Config.set("cache", value='unique')
+
+    with open(options.run_dace) as f:
+        sdfg = SDFG.from_json(json.load(f))
+
+    obj = sdfg.compile()
+    inputs = dict(np.load(options.inputs))
+    symbols = json.loads(options.symbols)
+
+    # The interpreter, numpy, DaCe and the compiled program are already
+    # loaded, so only the memory of the execution itself is measured.
+    baseline = get_peak_memory()
+    runtimes = []
+    for _ in range(options.repetitions):
+        args = {name: value.copy() for name, value in inputs.items()}
+        start = time.perf_counter()
+        obj(**args, **symbols)
+        runtimes.append(time.perf_counter() - start)
+
+    print(
+        json.dumps({
+            "runtime": min(runtimes),
+            "peak_memory": get_peak_memory() - baseline
+        }))
+    np.savez(options.outputs, **args)
+
+
+def memref_descriptor(array):
+    """Returns the MLIR memref descriptor of the provided array."""
+    rank = array.ndim
+    fields = [("allocated", ctypes.c_void_p), ("aligned", ctypes.c_void_p),
+              ("offset", ctypes.c_int64)]
+    if rank > 0:
+        fields += [("sizes", ctypes.c_int64 * rank),
+                   ("strides", ctypes.c_int64 * rank)]
+
+    descriptor_type = type("MemRef%dD" % rank, (ctypes.Structure, ),
+                           {"_fields_": fields})
+    descriptor = descriptor_type()
+    descriptor.allocated = array.ctypes.data
+    descriptor.aligned = array.ctypes.data
+    descriptor.offset = 0
+
+    for i in range(rank):
+        descriptor.sizes[i] = array.shape[i]
+        descriptor.strides[i] = array.strides[i] // array.itemsize
+
+    return descriptor
+
+
+def execute_native(options):
+    """Child process executing a lowered program through its C interface."""
+    lib = ctypes.CDLL(options.run_native)
+    func = lib._mlir_ciface_sdfg
+    func.restype = None
+
+    inputs = dict(np.load(options.inputs))
+    names = json.loads(options.arg_names)
+    symbols = json.loads(options.symbols)
+
+    # Measured like in execute_dace, after the library is loaded.
+    baseline = get_peak_memory()
+    runtimes = []
+    for _ in range(options.repetitions):
+        args = {name: np.array(inputs[name], order="C") for name in names}
+        # The descriptors have to outlive the call.
+        descriptors = [memref_descriptor(args[name]) for name in names]
+        call_args = [ctypes.byref(d) for d in descriptors]
+        call_args += [ctypes.c_int64(v) for v in symbols.values()]
+
+        start = time.perf_counter()
+        func(*call_args)
+        runtimes.append(time.perf_counter() - start)
+
+    print(
+        json.dumps({
+            "runtime": min(runtimes),
+            "peak_memory": get_peak_memory() - baseline
+        }))
+    np.savez(options.outputs, **args)
+
+
+def compile_native(source, workdir, options):
+    """Lowers a SDFG dialect program to a shared library."""
+    generic = run_stage([options.sdfg_opt, "--lower-sdfg"], source,
+                        options.timeout)
+    llvm_dialect = run_stage([options.mlir_opt] + NATIVE_PIPELINE, generic,
+                             options.timeout)
+    llvm_ir = run_stage([options.mlir_translate, "--mlir-to-llvmir"],
+                        llvm_dialect, options.timeout)
+
+    ll_file = os.path.join(workdir, "program.ll")
+    lib_file = os.path.join(workdir, "program.so")
+    with open(ll_file, "w") as f:
+        f.write(llvm_ir)
+
+    run_stage([
+        options.clang, "-O3", "-shared", "-fPIC", "-o", lib_file, ll_file,
+        "-lm"
+    ], None, options.timeout)
+    return lib_file
+
+
+def fuzz_program(seed, workdir, options):
+    """Generates a program and runs it through both paths."""
+    source = run_stage([options.sdfg_smith, "--seed=%d" % seed] +
+                       options.smith_arg, None, options.timeout)
+    if "sdfg.sdfg" not in source:
+        return None
+
+    return run_program(source, seed, workdir, options)
+
+
+def run_program(source, seed, workdir, options):
+    """Runs a program through both paths with inputs derived from the seed."""
+    translated = run_stage([options.sdfg_translate, "--mlir-to-sdfg"],
+                           source, options.timeout)
+    sdfg_json = json.loads(translated)
+    sdfg_file = os.path.join(workdir, "program.sdfg")
+    with open(sdfg_file, "w") as f:
+        json.dump(sdfg_json, f)
+
+    arguments, symbols = get_signature(sdfg_json, options.symbol_value)
+    inputs_file = os.path.join(workdir, "inputs.npz")
+    np.savez(inputs_file, **create_inputs(arguments, seed))
+
+    lib_file = compile_native(source, workdir, options)
+    script = os.path.abspath(__file__)
+    child_args = [
+        "--inputs", inputs_file, "--symbols",
+        json.dumps(symbols), "--repetitions",
+        str(options.repetitions)
+    ]
+
+    dace_outputs = os.path.join(workdir, "dace.npz")
+    dace = run_child([
+        sys.executable, script, "--run-dace", sdfg_file, "--outputs",
+        dace_outputs
+    ] + child_args, options.timeout)
+
+    native_outputs = os.path.join(workdir, "native.npz")
+    native = run_child([
+        sys.executable, script, "--run-native", lib_file, "--outputs",
+        native_outputs, "--arg-names",
+        json.dumps([name for name, _, _ in arguments])
+    ] + child_args, options.timeout)
+
+    diverging = compare_outputs(np.load(dace_outputs), np.load(native_outputs))
+    slower = max(dace["runtime"], native["runtime"])
+    faster = max(min(dace["runtime"], native["runtime"]), 1e-9)
+
+    return {
+        "seed": seed,
+        "dace": dace,
+        "native": native,
+        "slowdown": slower / faster,
+        "slower_path": "dace" if dace["runtime"] > native["runtime"] else
+        "native",
+        "diverging": diverging,
+        "source": source,
+    }
+
+
+def try_program(seed, options, verbose=False):
+    """Runs fuzz_program in a temporary directory. Returns None if the program
+    is not a SDFG or one of the paths cannot handle it."""
+    workdir = tempfile.mkdtemp(prefix="sdfg-fuzz-")
+    try:
+        return fuzz_program(seed, workdir, options)
+    except (RuntimeError, subprocess.TimeoutExpired) as e:
+        # Programs one of the paths cannot handle are not performance
+        # findings.
+        if verbose:
+            print("seed %d skipped: %s" % (seed, e), file=sys.stderr)
+        return None
+    finally:
+        shutil.rmtree(workdir)
+
+
+def get_reasons(result, options):
+    """Returns why a result is a finding. Empty if it is none."""
+    reasons = []
+    if result["diverging"]:
+        reasons.append("outputs diverge: %s" % ", ".join(result["diverging"]))
+    if result["slowdown"] > options.slowdown:
+        reasons.append("%s path %.1fx slower" %
+                       (result["slower_path"], result["slowdown"]))
+    return reasons
+
+
+def get_kinds(result, options):
+    """Returns the kinds of finding a result shows, which have to be preserved
+    while minimizing it."""
+    kinds = set()
+    if result["diverging"]:
+        kinds.add("diverge")
+    if result["slowdown"] > options.slowdown:
+        kinds.add("slowdown:" + result["slower_path"])
+    return kinds
+
+
+def get_int_smith_args(options):
+    """Returns the indices, names and values of the sdfg-smith options of the
+    form `--name=<integer>`, e.g. the generator scale configuration."""
+    int_args = []
+    for i, arg in enumerate(options.smith_arg):
+        name, sep, value = arg.partition("=")
+        if sep and value.isdigit():
+            int_args.append((i, name, int(value)))
+    return int_args
+
+
+def bisect(value, lowest, reproduces):
+    """Returns the smallest value in [lowest, value] for which reproduces
+    holds, assuming it holds for value and is monotonic in between."""
+    while lowest < value:
+        mid = (lowest + value) // 2
+        if reproduces(mid):
+            value = mid
+        else:
+            lowest = mid + 1
+    return value
+
+
+def minimize(seed, result, source, options):
+    """Bisects the symbol value and the integer sdfg-smith options of a finding
+    one after the other. Returns the minimized parameters and the program of
+    the smallest configuration that still shows the same kinds of finding."""
+    kinds = get_kinds(result, options)
+    current = copy.copy(options)
+    current.smith_arg = list(options.smith_arg)
+    # Only successful runs move a bisection, so the last reproducing result
+    # always belongs to the current configuration.
+    best = dict(result, source=source)
+
+    def reproduces(candidate):
+        nonlocal best
+        reproduced = try_program(seed, candidate)
+        if reproduced is None or not kinds <= get_kinds(reproduced, options):
+            return False
+        best = reproduced
+        return True
+
+    def with_symbol_value(value):
+        candidate = copy.copy(current)
+        candidate.symbol_value = value
+        return reproduces(candidate)
+
+    current.symbol_value = bisect(options.symbol_value, 1, with_symbol_value)
+
+    for index, name, value in get_int_smith_args(options):
+
+        def with_smith_arg(value):
+            candidate = copy.copy(current)
+            candidate.smith_arg = list(current.smith_arg)
+            candidate.smith_arg[index] = "%s=%d" % (name, value)
+            return reproduces(candidate)
+
+        minimized = bisect(value, 0, with_smith_arg)
+        current.smith_arg[index] = "%s=%d" % (name, minimized)
+
+    params = {
+        "symbol_value": current.symbol_value,
+        "smith_args": current.smith_arg,
+        "slowdown": best["slowdown"],
+        "diverging": best["diverging"],
+    }
+    return params, best["source"]
+
+
+def compare_program(options):
+    """Runs the program of --compare through both paths and reports whether
+    their outputs diverge."""
+    with open(options.compare) as f:
+        source = f.read()
+
+    workdir = tempfile.mkdtemp(prefix="sdfg-compare-")
+    try:
+        result = run_program(source, options.seed, workdir, options)
+    finally:
+        shutil.rmtree(workdir)
+
+    if result["diverging"]:
+        print("outputs diverge: %s" % ", ".join(result["diverging"]))
+        return 1
+
+    print("outputs match")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Differential performance fuzzing of the SDFG lowerings")
+    parser.add_argument("--sdfg-smith", default="sdfg-smith")
+    parser.add_argument("--sdfg-opt", default="sdfg-opt")
+    parser.add_argument("--sdfg-translate", default="sdfg-translate")
+    parser.add_argument("--mlir-opt", default="mlir-opt")
+    parser.add_argument("--mlir-translate", default="mlir-translate")
+    parser.add_argument("--clang", default="clang")
+    parser.add_argument("--smith-arg",
+                        action="append",
+                        default=[],
+                        help="option passed to sdfg-smith")
+    parser.add_argument("--count", type=int, default=100)
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--repetitions", type=int, default=3)
+    parser.add_argument("--slowdown",
+                        type=float,
+                        default=10.0,
+                        help="slowdown of one path reported as a finding")
+    parser.add_argument("--symbol-value",
+                        type=int,
+                        default=16,
+                        help="value of every symbol in the array sizes")
+    parser.add_argument("--minimize",
+                        action="store_true",
+                        help="bisect the symbol value and the integer "
+                        "sdfg-smith options of every finding")
+    parser.add_argument("--timeout", type=float, default=600.0)
+    parser.add_argument("--output", default="fuzz_results.json")
+    parser.add_argument("--findings", default="fuzz_findings")
+    parser.add_argument("--compare",
+                        help="run the given program through both paths and "
+                        "compare their outputs instead of fuzzing")
+
+    # Options of the execution child processes.
+    parser.add_argument("--run-dace", help=argparse.SUPPRESS)
+    parser.add_argument("--run-native", help=argparse.SUPPRESS)
+    parser.add_argument("--inputs", help=argparse.SUPPRESS)
+    parser.add_argument("--outputs", help=argparse.SUPPRESS)
+    parser.add_argument("--symbols", help=argparse.SUPPRESS)
+    parser.add_argument("--arg-names", help=argparse.SUPPRESS)
+    options = parser.parse_args()
+
+    if options.run_dace:
+        return execute_dace(options)
+    if options.run_native:
+        return execute_native(options)
+    if options.compare:
+        return compare_program(options)
+
+    os.makedirs(options.findings, exist_ok=True)
+    results = []
+    findings = 0
+
+    for seed in range(options.seed, options.seed + options.count):
+        result = try_program(seed, options, verbose=True)
+        if result is None:
+            continue
+
+        source = result.pop("source")
+        results.append(result)
+        reasons = get_reasons(result, options)
+
+        print("seed %-6d dace: %.4fs  native: %.4fs%s" %
+              (seed, result["dace"]["runtime"], result["native"]["runtime"],
+               "  FINDING: " + "; ".join(reasons) if reasons else ""))
+
+        if reasons:
+            findings += 1
+            result["reasons"] = reasons
+            base = os.path.join(options.findings, str(seed))
+            with open(base + ".mlir", "w") as f:
+                f.write(source)
+
+            if options.minimize:
+                params, minimized = minimize(seed, result, source, options)
+                result["minimized"] = params
+                print("seed %-6d minimized: %s" % (seed, params))
+                with open(base + ".min.mlir", "w") as f:
+                    f.write(minimized)
+
+            with open(base + ".json", "w") as f:
+                json.dump(result, f, indent=2)
+
+    with open(options.output, "w") as f:
+        json.dump(results, f, indent=2)
+
+    print("%d programs, %d findings" % (len(results), findings))
+    return 1 if findings else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,54 @@
+// D = alpha * A * B * C + beta * D
+// SIZE mini: NI=16 NJ=18 NK=22 NL=24
+// SIZE small: NI=40 NJ=50 NK=70 NL=80
+// SIZE medium: NI=180 NJ=190 NK=210 NL=220
+
+func.func private @kernel_2mm(%alpha: f64, %beta: f64,
+                              %tmp: memref<${NI}x${NJ}xf64>,
+                              %A: memref<${NI}x${NK}xf64>,
+                              %B: memref<${NK}x${NJ}xf64>,
+                              %C: memref<${NJ}x${NL}xf64>,
+                              %D: memref<${NI}x${NL}xf64>) {
+  %cst = arith.constant 0.000000e+00 : f64
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %ni = arith.constant ${NI} : index
+  %nj = arith.constant ${NJ} : index
+  %nk = arith.constant ${NK} : index
+  %nl = arith.constant ${NL} : index
+
+  scf.for %i = %c0 to %ni step %c1 {
+    scf.for %j = %c0 to %nj step %c1 {
+      memref.store %cst, %tmp[%i, %j] : memref<${NI}x${NJ}xf64>
+
+      scf.for %k = %c0 to %nk step %c1 {
+        %0 = memref.load %A[%i, %k] : memref<${NI}x${NK}xf64>
+        %1 = arith.mulf %alpha, %0 : f64
+        %2 = memref.load %B[%k, %j] : memref<${NK}x${NJ}xf64>
+        %3 = arith.mulf %1, %2 : f64
+        %4 = memref.load %tmp[%i, %j] : memref<${NI}x${NJ}xf64>
+        %5 = arith.addf %4, %3 : f64
+        memref.store %5, %tmp[%i, %j] : memref<${NI}x${NJ}xf64>
+      }
+    }
+  }
+
+  scf.for %i = %c0 to %ni step %c1 {
+    scf.for %j = %c0 to %nl step %c1 {
+      %0 = memref.load %D[%i, %j] : memref<${NI}x${NL}xf64>
+      %1 = arith.mulf %0, %beta : f64
+      memref.store %1, %D[%i, %j] : memref<${NI}x${NL}xf64>
+
+      scf.for %k = %c0 to %nj step %c1 {
+        %2 = memref.load %tmp[%i, %k] : memref<${NI}x${NJ}xf64>
+        %3 = memref.load %C[%k, %j] : memref<${NJ}x${NL}xf64>
+        %4 = arith.mulf %2, %3 : f64
+        %5 = memref.load %D[%i, %j] : memref<${NI}x${NL}xf64>
+        %6 = arith.addf %5, %4 : f64
+        memref.store %6, %D[%i, %j] : memref<${NI}x${NL}xf64>
+      }
+    }
+  }
+
+  return
+}
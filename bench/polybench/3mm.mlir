@@ -0,0 +1,68 @@
+// G = (A * B) * (C * D)
+// SIZE mini: NI=16 NJ=18 NK=20 NL=22 NM=24
+// SIZE small: NI=40 NJ=50 NK=60 NL=70 NM=80
+// SIZE medium: NI=180 NJ=190 NK=200 NL=210 NM=220
+
+func.func private @kernel_3mm(%E: memref<${NI}x${NJ}xf64>,
+                              %A: memref<${NI}x${NK}xf64>,
+                              %B: memref<${NK}x${NJ}xf64>,
+                              %F: memref<${NJ}x${NL}xf64>,
+                              %C: memref<${NJ}x${NM}xf64>,
+                              %D: memref<${NM}x${NL}xf64>,
+                              %G: memref<${NI}x${NL}xf64>) {
+  %cst = arith.constant 0.000000e+00 : f64
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %ni = arith.constant ${NI} : index
+  %nj = arith.constant ${NJ} : index
+  %nk = arith.constant ${NK} : index
+  %nl = arith.constant ${NL} : index
+  %nm = arith.constant ${NM} : index
+
+  scf.for %i = %c0 to %ni step %c1 {
+    scf.for %j = %c0 to %nj step %c1 {
+      memref.store %cst, %E[%i, %j] : memref<${NI}x${NJ}xf64>
+
+      scf.for %k = %c0 to %nk step %c1 {
+        %0 = memref.load %A[%i, %k] : memref<${NI}x${NK}xf64>
+        %1 = memref.load %B[%k, %j] : memref<${NK}x${NJ}xf64>
+        %2 = arith.mulf %0, %1 : f64
+        %3 = memref.load %E[%i, %j] : memref<${NI}x${NJ}xf64>
+        %4 = arith.addf %3, %2 : f64
+        memref.store %4, %E[%i, %j] : memref<${NI}x${NJ}xf64>
+      }
+    }
+  }
+
+  scf.for %i = %c0 to %nj step %c1 {
+    scf.for %j = %c0 to %nl step %c1 {
+      memref.store %cst, %F[%i, %j] : memref<${NJ}x${NL}xf64>
+
+      scf.for %k = %c0 to %nm step %c1 {
+        %0 = memref.load %C[%i, %k] : memref<${NJ}x${NM}xf64>
+        %1 = memref.load %D[%k, %j] : memref<${NM}x${NL}xf64>
+        %2 = arith.mulf %0, %1 : f64
+        %3 = memref.load %F[%i, %j] : memref<${NJ}x${NL}xf64>
+        %4 = arith.addf %3, %2 : f64
+        memref.store %4, %F[%i, %j] : memref<${NJ}x${NL}xf64>
+      }
+    }
+  }
+
+  scf.for %i = %c0 to %ni step %c1 {
+    scf.for %j = %c0 to %nl step %c1 {
+      memref.store %cst, %G[%i, %j] : memref<${NI}x${NL}xf64>
+
+      scf.for %k = %c0 to %nj step %c1 {
+        %0 = memref.load %E[%i, %k] : memref<${NI}x${NJ}xf64>
+        %1 = memref.load %F[%k, %j] : memref<${NJ}x${NL}xf64>
+        %2 = arith.mulf %0, %1 : f64
+        %3 = memref.load %G[%i, %j] : memref<${NI}x${NL}xf64>
+        %4 = arith.addf %3, %2 : f64
+        memref.store %4, %G[%i, %j] : memref<${NI}x${NL}xf64>
+      }
+    }
+  }
+
+  return
+}
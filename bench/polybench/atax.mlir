@@ -0,0 +1,42 @@
+// y = A^T * (A * x)
+// SIZE mini: M=38 N=42
+// SIZE small: M=116 N=124
+// SIZE medium: M=390 N=410
+
+func.func private @kernel_atax(%A: memref<${M}x${N}xf64>,
+                               %x: memref<${N}xf64>, %y: memref<${N}xf64>,
+                               %tmp: memref<${M}xf64>) {
+  %cst = arith.constant 0.000000e+00 : f64
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %m = arith.constant ${M} : index
+  %n = arith.constant ${N} : index
+
+  scf.for %i = %c0 to %n step %c1 {
+    memref.store %cst, %y[%i] : memref<${N}xf64>
+  }
+
+  scf.for %i = %c0 to %m step %c1 {
+    memref.store %cst, %tmp[%i] : memref<${M}xf64>
+
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %A[%i, %j] : memref<${M}x${N}xf64>
+      %1 = memref.load %x[%j] : memref<${N}xf64>
+      %2 = arith.mulf %0, %1 : f64
+      %3 = memref.load %tmp[%i] : memref<${M}xf64>
+      %4 = arith.addf %3, %2 : f64
+      memref.store %4, %tmp[%i] : memref<${M}xf64>
+    }
+
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %A[%i, %j] : memref<${M}x${N}xf64>
+      %1 = memref.load %tmp[%i] : memref<${M}xf64>
+      %2 = arith.mulf %0, %1 : f64
+      %3 = memref.load %y[%j] : memref<${N}xf64>
+      %4 = arith.addf %3, %2 : f64
+      memref.store %4, %y[%j] : memref<${N}xf64>
+    }
+  }
+
+  return
+}
@@ -0,0 +1,39 @@
+// s = A^T * r, q = A * p
+// SIZE mini: M=38 N=42
+// SIZE small: M=116 N=124
+// SIZE medium: M=390 N=410
+
+func.func private @kernel_bicg(%A: memref<${N}x${M}xf64>,
+                               %s: memref<${M}xf64>, %q: memref<${N}xf64>,
+                               %p: memref<${M}xf64>, %r: memref<${N}xf64>) {
+  %cst = arith.constant 0.000000e+00 : f64
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %m = arith.constant ${M} : index
+  %n = arith.constant ${N} : index
+
+  scf.for %i = %c0 to %m step %c1 {
+    memref.store %cst, %s[%i] : memref<${M}xf64>
+  }
+
+  scf.for %i = %c0 to %n step %c1 {
+    memref.store %cst, %q[%i] : memref<${N}xf64>
+
+    scf.for %j = %c0 to %m step %c1 {
+      %0 = memref.load %r[%i] : memref<${N}xf64>
+      %1 = memref.load %A[%i, %j] : memref<${N}x${M}xf64>
+      %2 = arith.mulf %0, %1 : f64
+      %3 = memref.load %s[%j] : memref<${M}xf64>
+      %4 = arith.addf %3, %2 : f64
+      memref.store %4, %s[%j] : memref<${M}xf64>
+
+      %5 = memref.load %p[%j] : memref<${M}xf64>
+      %6 = arith.mulf %1, %5 : f64
+      %7 = memref.load %q[%i] : memref<${N}xf64>
+      %8 = arith.addf %7, %6 : f64
+      memref.store %8, %q[%i] : memref<${N}xf64>
+    }
+  }
+
+  return
+}
@@ -0,0 +1,37 @@
+// C = alpha * A * B + beta * C
+// SIZE mini: NI=20 NJ=25 NK=30
+// SIZE small: NI=60 NJ=70 NK=80
+// SIZE medium: NI=200 NJ=220 NK=240
+
+func.func private @kernel_gemm(%alpha: f64, %beta: f64,
+                               %C: memref<${NI}x${NJ}xf64>,
+                               %A: memref<${NI}x${NK}xf64>,
+                               %B: memref<${NK}x${NJ}xf64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %ni = arith.constant ${NI} : index
+  %nj = arith.constant ${NJ} : index
+  %nk = arith.constant ${NK} : index
+
+  scf.for %i = %c0 to %ni step %c1 {
+    scf.for %j = %c0 to %nj step %c1 {
+      %0 = memref.load %C[%i, %j] : memref<${NI}x${NJ}xf64>
+      %1 = arith.mulf %0, %beta : f64
+      memref.store %1, %C[%i, %j] : memref<${NI}x${NJ}xf64>
+    }
+
+    scf.for %k = %c0 to %nk step %c1 {
+      scf.for %j = %c0 to %nj step %c1 {
+        %2 = memref.load %A[%i, %k] : memref<${NI}x${NK}xf64>
+        %3 = arith.mulf %alpha, %2 : f64
+        %4 = memref.load %B[%k, %j] : memref<${NK}x${NJ}xf64>
+        %5 = arith.mulf %3, %4 : f64
+        %6 = memref.load %C[%i, %j] : memref<${NI}x${NJ}xf64>
+        %7 = arith.addf %6, %5 : f64
+        memref.store %7, %C[%i, %j] : memref<${NI}x${NJ}xf64>
+      }
+    }
+  }
+
+  return
+}
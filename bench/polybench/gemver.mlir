@@ -0,0 +1,64 @@
+// A = A + u1 * v1^T + u2 * v2^T, x = x + beta * A^T * y + z,
+// w = w + alpha * A * x
+// SIZE mini: N=40
+// SIZE small: N=120
+// SIZE medium: N=400
+
+func.func private @kernel_gemver(%alpha: f64, %beta: f64,
+                                 %A: memref<${N}x${N}xf64>,
+                                 %u1: memref<${N}xf64>, %v1: memref<${N}xf64>,
+                                 %u2: memref<${N}xf64>, %v2: memref<${N}xf64>,
+                                 %w: memref<${N}xf64>, %x: memref<${N}xf64>,
+                                 %y: memref<${N}xf64>, %z: memref<${N}xf64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %n = arith.constant ${N} : index
+
+  scf.for %i = %c0 to %n step %c1 {
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %u1[%i] : memref<${N}xf64>
+      %1 = memref.load %v1[%j] : memref<${N}xf64>
+      %2 = arith.mulf %0, %1 : f64
+      %3 = memref.load %u2[%i] : memref<${N}xf64>
+      %4 = memref.load %v2[%j] : memref<${N}xf64>
+      %5 = arith.mulf %3, %4 : f64
+      %6 = memref.load %A[%i, %j] : memref<${N}x${N}xf64>
+      %7 = arith.addf %6, %2 : f64
+      %8 = arith.addf %7, %5 : f64
+      memref.store %8, %A[%i, %j] : memref<${N}x${N}xf64>
+    }
+  }
+
+  scf.for %i = %c0 to %n step %c1 {
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %A[%j, %i] : memref<${N}x${N}xf64>
+      %1 = arith.mulf %beta, %0 : f64
+      %2 = memref.load %y[%j] : memref<${N}xf64>
+      %3 = arith.mulf %1, %2 : f64
+      %4 = memref.load %x[%i] : memref<${N}xf64>
+      %5 = arith.addf %4, %3 : f64
+      memref.store %5, %x[%i] : memref<${N}xf64>
+    }
+  }
+
+  scf.for %i = %c0 to %n step %c1 {
+    %0 = memref.load %x[%i] : memref<${N}xf64>
+    %1 = memref.load %z[%i] : memref<${N}xf64>
+    %2 = arith.addf %0, %1 : f64
+    memref.store %2, %x[%i] : memref<${N}xf64>
+  }
+
+  scf.for %i = %c0 to %n step %c1 {
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %A[%i, %j] : memref<${N}x${N}xf64>
+      %1 = arith.mulf %alpha, %0 : f64
+      %2 = memref.load %x[%j] : memref<${N}xf64>
+      %3 = arith.mulf %1, %2 : f64
+      %4 = memref.load %w[%i] : memref<${N}xf64>
+      %5 = arith.addf %4, %3 : f64
+      memref.store %5, %w[%i] : memref<${N}xf64>
+    }
+  }
+
+  return
+}
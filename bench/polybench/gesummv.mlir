@@ -0,0 +1,45 @@
+// y = alpha * A * x + beta * B * x
+// SIZE mini: N=30
+// SIZE small: N=90
+// SIZE medium: N=250
+
+func.func private @kernel_gesummv(%alpha: f64, %beta: f64,
+                                  %A: memref<${N}x${N}xf64>,
+                                  %B: memref<${N}x${N}xf64>,
+                                  %tmp: memref<${N}xf64>,
+                                  %x: memref<${N}xf64>,
+                                  %y: memref<${N}xf64>) {
+  %cst = arith.constant 0.000000e+00 : f64
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %n = arith.constant ${N} : index
+
+  scf.for %i = %c0 to %n step %c1 {
+    memref.store %cst, %tmp[%i] : memref<${N}xf64>
+    memref.store %cst, %y[%i] : memref<${N}xf64>
+
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %x[%j] : memref<${N}xf64>
+      %1 = memref.load %A[%i, %j] : memref<${N}x${N}xf64>
+      %2 = arith.mulf %1, %0 : f64
+      %3 = memref.load %tmp[%i] : memref<${N}xf64>
+      %4 = arith.addf %2, %3 : f64
+      memref.store %4, %tmp[%i] : memref<${N}xf64>
+
+      %5 = memref.load %B[%i, %j] : memref<${N}x${N}xf64>
+      %6 = arith.mulf %5, %0 : f64
+      %7 = memref.load %y[%i] : memref<${N}xf64>
+      %8 = arith.addf %6, %7 : f64
+      memref.store %8, %y[%i] : memref<${N}xf64>
+    }
+
+    %9 = memref.load %tmp[%i] : memref<${N}xf64>
+    %10 = arith.mulf %alpha, %9 : f64
+    %11 = memref.load %y[%i] : memref<${N}xf64>
+    %12 = arith.mulf %beta, %11 : f64
+    %13 = arith.addf %10, %12 : f64
+    memref.store %13, %y[%i] : memref<${N}xf64>
+  }
+
+  return
+}
@@ -0,0 +1,36 @@
+// x1 = x1 + A * y1, x2 = x2 + A^T * y2
+// SIZE mini: N=40
+// SIZE small: N=120
+// SIZE medium: N=400
+
+func.func private @kernel_mvt(%x1: memref<${N}xf64>, %x2: memref<${N}xf64>,
+                              %y1: memref<${N}xf64>, %y2: memref<${N}xf64>,
+                              %A: memref<${N}x${N}xf64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %n = arith.constant ${N} : index
+
+  scf.for %i = %c0 to %n step %c1 {
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %A[%i, %j] : memref<${N}x${N}xf64>
+      %1 = memref.load %y1[%j] : memref<${N}xf64>
+      %2 = arith.mulf %0, %1 : f64
+      %3 = memref.load %x1[%i] : memref<${N}xf64>
+      %4 = arith.addf %3, %2 : f64
+      memref.store %4, %x1[%i] : memref<${N}xf64>
+    }
+  }
+
+  scf.for %i = %c0 to %n step %c1 {
+    scf.for %j = %c0 to %n step %c1 {
+      %0 = memref.load %A[%j, %i] : memref<${N}x${N}xf64>
+      %1 = memref.load %y2[%j] : memref<${N}xf64>
+      %2 = arith.mulf %0, %1 : f64
+      %3 = memref.load %x2[%i] : memref<${N}xf64>
+      %4 = arith.addf %3, %2 : f64
+      memref.store %4, %x2[%i] : memref<${N}xf64>
+    }
+  }
+
+  return
+}
@@ -0,0 +1,90 @@
+# Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+# Translates a SDFG whose states each contain a large nested SDFG with and
+# without --sdfg-stream-states and compares the peak memory of both runs.
+# Streaming only keeps the nested SDFGs of the current state, so its peak
+# memory is expected to stay well below the one of the regular translation.
+# The peak memory depends on the machine and the allocator, so this is a
+# benchmark rather than a test.
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def generate(num_states, num_tasklets):
+    """Returns a SDFG with a nested SDFG in every state."""
+    lines = [
+        "sdfg.sdfg{entry=@state_0} () -> (%r: !sdfg.array<i32>) {",
+    ]
+
+    for i in range(num_states):
+        lines.append("  sdfg.state @state_%d {" % i)
+        lines.append("    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {")
+        lines.append("      sdfg.state @inner_%d {" % i)
+        for j in range(num_tasklets):
+            lines.append("        %%t%d = sdfg.tasklet() -> (i32) {" % j)
+            lines.append("          %%c = arith.constant %d : i32" % j)
+            lines.append("          sdfg.return %c : i32")
+            lines.append("        }")
+            lines.append("        sdfg.store %%t%d, %%r[] : i32 -> "
+                         "!sdfg.array<i32>" % j)
+        lines.append("      }")
+        lines.append("    }")
+        lines.append("  }")
+
+    for i in range(num_states - 1):
+        lines.append("  sdfg.edge{assign=[], condition=\"1\"} "
+                     "@state_%d -> @state_%d" % (i, i + 1))
+
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def get_peak_memory(cmd):
+    """Runs the command and returns its peak memory in KiB."""
+    with open(os.devnull, "w") as devnull:
+        proc = subprocess.Popen(cmd, stdout=devnull)
+        _, status, usage = os.wait4(proc.pid, 0)
+
+    if os.waitstatus_to_exitcode(status) != 0:
+        raise RuntimeError("%s failed" % " ".join(cmd))
+
+    return usage.ru_maxrss
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compares the peak memory of the streamed translation")
+    parser.add_argument("--sdfg-translate", default="sdfg-translate")
+    parser.add_argument("--states", type=int, default=256)
+    parser.add_argument("--tasklets",
+                        type=int,
+                        default=64,
+                        help="tasklets in the nested SDFG of every state")
+    options = parser.parse_args()
+
+    with tempfile.NamedTemporaryFile(mode="w", suffix=".mlir") as f:
+        f.write(generate(options.states, options.tasklets))
+        f.flush()
+
+        try:
+            regular = get_peak_memory(
+                [options.sdfg_translate, "--mlir-to-sdfg", f.name])
+            streamed = get_peak_memory([
+                options.sdfg_translate, "--mlir-to-sdfg",
+                "--sdfg-stream-states", f.name
+            ])
+        except RuntimeError as e:
+            print("error: %s" % e, file=sys.stderr)
+            return 1
+
+    print("regular: %d KiB  streamed: %d KiB  ratio: %.2f" %
+          (regular, streamed, streamed / regular))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
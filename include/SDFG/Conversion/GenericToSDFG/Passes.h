@@ -12,6 +12,10 @@ namespace mlir::sdfg::conversion {
 /// Creates a generic to sdfg converting pass
 std::unique_ptr<Pass> createGenericToSDFGPass(StringRef getMainFuncName = "");
 
+/// Returns true if the provided linalg operation is converted to a library
+/// call.
+bool isLibraryOp(Operation *op);
+
 //===----------------------------------------------------------------------===//
 // Registration
 //===----------------------------------------------------------------------===//
@@ -39,10 +39,18 @@ cf::CondBranchOp createCondBranch(PatternRewriter &rewriter, Location loc,
                                   Value condition, Block *trueDest,
                                   Block *falseDest);
 
+/// Builds, creates and inserts a cf::AssertOp.
+cf::AssertOp createAssert(PatternRewriter &rewriter, Location loc,
+                          Value condition, StringRef message);
+
 /// Builds, creates and inserts a memref::AllocOp.
 memref::AllocOp createAlloc(PatternRewriter &rewriter, Location loc,
                             MemRefType memrefType, ValueRange dynamicSizes);
 
+/// Builds, creates and inserts a memref::AllocaOp.
+memref::AllocaOp createAlloca(PatternRewriter &rewriter, Location loc,
+                              MemRefType memrefType);
+
 /// Builds, creates and inserts a memref::LoadOp.
 memref::LoadOp createLoad(PatternRewriter &rewriter, Location loc, Value memref,
                           ValueRange indices);
@@ -55,6 +63,15 @@ memref::StoreOp createStore(PatternRewriter &rewriter, Location loc,
 memref::CopyOp createCopy(PatternRewriter &rewriter, Location loc, Value source,
                           Value target);
 
+/// Builds, creates and inserts a memref::AtomicRMWOp.
+memref::AtomicRMWOp createAtomicRMW(PatternRewriter &rewriter, Location loc,
+                                    arith::AtomicRMWKind kind, Value value,
+                                    Value memref, ValueRange indices);
+
+/// Builds, creates and inserts a memref::DimOp.
+memref::DimOp createDim(PatternRewriter &rewriter, Location loc, Value memref,
+                        int64_t index);
+
 /// Allocates a symbol as a memref<i64> if it's not already allocated and
 /// populates the symbol map.
 void allocSymbol(PatternRewriter &rewriter, Location loc, StringRef symName,
@@ -64,6 +81,10 @@ void allocSymbol(PatternRewriter &rewriter, Location loc, StringRef symName,
 arith::ConstantIntOp createConstantInt(PatternRewriter &rewriter, Location loc,
                                        int val, int width);
 
+/// Builds, creates and inserts an arith::ConstantIndexOp.
+arith::ConstantIndexOp createConstantIndex(PatternRewriter &rewriter,
+                                           Location loc, int64_t val);
+
 /// Builds, creates and inserts an arith::AddIOp.
 arith::AddIOp createAddI(PatternRewriter &rewriter, Location loc, Value a,
                          Value b);
@@ -88,6 +109,10 @@ arith::FloorDivSIOp createFloorDivSI(PatternRewriter &rewriter, Location loc,
 arith::RemSIOp createRemSI(PatternRewriter &rewriter, Location loc, Value a,
                            Value b);
 
+/// Builds, creates and inserts an arith::RemUIOp.
+arith::RemUIOp createRemUI(PatternRewriter &rewriter, Location loc, Value a,
+                           Value b);
+
 /// Builds, creates and inserts an arith::OrIOp.
 arith::OrIOp createOrI(PatternRewriter &rewriter, Location loc, Value a,
                        Value b);
@@ -96,6 +121,10 @@ arith::OrIOp createOrI(PatternRewriter &rewriter, Location loc, Value a,
 arith::AndIOp createAndI(PatternRewriter &rewriter, Location loc, Value a,
                          Value b);
 
+/// Builds, creates and inserts an arith::MinSIOp.
+arith::MinSIOp createMinSI(PatternRewriter &rewriter, Location loc, Value a,
+                           Value b);
+
 /// Builds, creates and inserts an arith::XOrIOp.
 arith::XOrIOp createXOrI(PatternRewriter &rewriter, Location loc, Value a,
                          Value b);
@@ -129,6 +158,18 @@ scf::ParallelOp createParallel(PatternRewriter &rewriter, Location loc,
                                ValueRange lowerBounds, ValueRange upperBounds,
                                ValueRange steps);
 
+/// Builds, creates and inserts a scf::ForOp with an empty body.
+scf::ForOp createFor(PatternRewriter &rewriter, Location loc, Value lowerBound,
+                     Value upperBound, Value step);
+
+/// Builds, creates and inserts a scf::WhileOp without results and with empty
+/// regions.
+scf::WhileOp createWhile(PatternRewriter &rewriter, Location loc);
+
+/// Builds, creates and inserts a scf::ConditionOp.
+scf::ConditionOp createCondition(PatternRewriter &rewriter, Location loc,
+                                 Value condition);
+
 /// Builds, creates and inserts a scf::YieldOp.
 scf::YieldOp createYield(PatternRewriter &rewriter, Location loc);
 
@@ -6,6 +6,7 @@
 #define SDFG_Conversion_SDFGToGeneric_PassDetail_H
 
 #include "SDFG/Dialect/Dialect.h"
+#include "mlir/Dialect/GPU/IR/GPUDialect.h"
 #include "mlir/Pass/Pass.h"
 
 namespace mlir {
@@ -20,6 +20,11 @@ public:
   virtual Value codegen(PatternRewriter &rewriter, Location loc,
                         llvm::StringMap<Value> &symbolMap,
                         llvm::StringMap<Value> &refMap) = 0;
+
+  /// Simplifies the node by constant folding, algebraic identities and
+  /// strength reduction. Returns the node replacing this node or null if this
+  /// node remains.
+  virtual std::unique_ptr<ASTNode> simplify();
 };
 
 /// Integer AST node representing an integer constant.
@@ -83,6 +88,10 @@ public:
   Value codegen(PatternRewriter &rewriter, Location loc,
                 llvm::StringMap<Value> &symbolMap,
                 llvm::StringMap<Value> &refMap) override;
+
+  /// Simplifies the assigned expression. Returns null as the assignment
+  /// remains.
+  std::unique_ptr<ASTNode> simplify() override;
 };
 
 /// Unary Operation AST node representing an unary operation performed on an
@@ -104,6 +113,10 @@ public:
   Value codegen(PatternRewriter &rewriter, Location loc,
                 llvm::StringMap<Value> &symbolMap,
                 llvm::StringMap<Value> &refMap) override;
+
+  /// Simplifies the unary operation node. Returns the node replacing this
+  /// node or null if this node remains.
+  std::unique_ptr<ASTNode> simplify() override;
 };
 
 /// Binary Operation AST node representing a binary operation performed on an
@@ -148,6 +161,10 @@ public:
   Value codegen(PatternRewriter &rewriter, Location loc,
                 llvm::StringMap<Value> &symbolMap,
                 llvm::StringMap<Value> &refMap) override;
+
+  /// Simplifies the binary operation node. Returns the node replacing this
+  /// node or null if this node remains.
+  std::unique_ptr<ASTNode> simplify() override;
 };
 
 /// Enum representing all accepted token types.
@@ -11,6 +11,7 @@
 #include "mlir/Interfaces/CallInterfaces.h"
 #include "mlir/Interfaces/GeneratableInterfaces.h"
 #include "mlir/Interfaces/LoopLikeInterface.h"
+#include <atomic>
 
 #include "SDFG/Dialect/OpsDialect.h.inc"
 
@@ -22,4 +23,11 @@
 #define GET_OP_CLASSES
 #include "SDFG/Dialect/Ops.h.inc"
 
+namespace mlir::sdfg {
+
+/// Returns true if the provided name is a DaCe instrumentation type.
+bool isInstrumentationType(StringRef instrument);
+
+} // namespace mlir::sdfg
+
 #endif // SDFG_DIALECT_DIALECT_H
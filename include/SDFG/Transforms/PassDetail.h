@@ -0,0 +1,23 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for SDFG transformation pass details.
+
+#ifndef SDFG_Transforms_PassDetail_H
+#define SDFG_Transforms_PassDetail_H
+
+#include "SDFG/Dialect/Dialect.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace sdfg {
+namespace transforms {
+
+/// Generate the code for base classes.
+#define GEN_PASS_CLASSES
+#include "SDFG/Transforms/Passes.h.inc"
+
+} // namespace transforms
+} // namespace sdfg
+} // end namespace mlir
+
+#endif // SDFG_Transforms_PassDetail_H
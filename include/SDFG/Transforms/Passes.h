@@ -0,0 +1,37 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for SDFG transformation passes.
+
+#ifndef SDFG_Transforms_H
+#define SDFG_Transforms_H
+
+#include "mlir/Pass/Pass.h"
+
+namespace mlir::sdfg::transforms {
+
+/// Creates a pass eliminating redundant transients, memlets and states.
+std::unique_ptr<Pass> createEliminateTransientsPass();
+/// Creates a pass collapsing linear chains of states.
+std::unique_ptr<Pass> createCollapseStatesPass();
+/// Creates a pass inlining nested SDFGs consisting of a single state.
+std::unique_ptr<Pass> createInlineNestedSDFGsPass();
+/// Creates a pass collapsing perfectly nested maps.
+std::unique_ptr<Pass> createMapCollapsePass();
+/// Creates a pass fusing sibling maps over identical ranges.
+std::unique_ptr<Pass> createMapFusionPass();
+/// Creates a pass tiling maps.
+std::unique_ptr<Pass> createTileMapsPass();
+/// Creates a pass specializing symbols to constant values.
+std::unique_ptr<Pass> createSpecializeSymbolsPass();
+
+//===----------------------------------------------------------------------===//
+// Registration
+//===----------------------------------------------------------------------===//
+
+/// Generate the code for registering passes.
+#define GEN_PASS_REGISTRATION
+#include "SDFG/Transforms/Passes.h.inc"
+
+} // namespace mlir::sdfg::transforms
+
+#endif // SDFG_Transforms_H
@@ -0,0 +1,64 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for the abstract emitter interface in SDFG translation.
+
+#ifndef SDFG_Emitter_H
+#define SDFG_Emitter_H
+
+#include "mlir/IR/Attributes.h"
+#include "mlir/IR/Operation.h"
+#include "llvm/ADT/ArrayRef.h"
+
+namespace mlir::sdfg::emitter {
+
+/// Interface for all serialization backends of the translator. The internal
+/// IR describes the SDFG as nested objects, lists and key-value pairs through
+/// this interface, while the backend decides on the output format.
+class Emitter {
+public:
+  virtual ~Emitter() {}
+
+  /// Checks for errors (open objects/lists) and finalizes the output. Returns
+  /// a LogicalResult indicating success or failure.
+  virtual LogicalResult finish() = 0;
+
+  /// Prints a string to the output stream, surrounding it with quotation marks.
+  virtual void printString(StringRef str) = 0;
+  /// Prints a literal value (null, true, false or a number) to the output
+  /// stream, without quotation marks.
+  virtual void printLiteral(StringRef str) = 0;
+
+  /// Starts a new JSON object.
+  virtual void startObject() = 0;
+  /// Starts a new named (keyed) JSON object.
+  virtual void startNamedObject(StringRef name) = 0;
+  /// Ends the current JSON object.
+  virtual void endObject() = 0;
+
+  /// Starts a new named JSON list.
+  virtual void startNamedList(StringRef name) = 0;
+  /// Ends the current JSON list.
+  virtual void endList() = 0;
+
+  /// Starts a new entry in the current JSON object or list.
+  virtual void startEntry() = 0;
+  /// Prints a key-value pair to the output stream. If desired, turns the value
+  /// into string.
+  virtual void printKVPair(StringRef key, StringRef val,
+                           bool stringify = true) = 0;
+  /// Prints a key-value pair to the output stream. If desired, turns the value
+  /// into string.
+  virtual void printKVPair(StringRef key, int val, bool stringify = true) = 0;
+  /// Prints a key-value pair to the output stream. If desired, turns the value
+  /// into string.
+  virtual void printKVPair(StringRef key, Attribute val,
+                           bool stringify = true) = 0;
+
+  /// Prints a list of NamedAttributes as key-value pairs.
+  void printAttributes(ArrayRef<NamedAttribute> arr,
+                       ArrayRef<StringRef> elidedAttrs = {});
+};
+
+} // namespace mlir::sdfg::emitter
+
+#endif // SDFG_Emitter_H
@@ -5,24 +5,26 @@
 #ifndef SDFG_JsonEmitter_H
 #define SDFG_JsonEmitter_H
 
-#include "mlir/IR/Attributes.h"
-#include "mlir/IR/Operation.h"
-#include "llvm/ADT/ArrayRef.h"
+#include "SDFG/Translate/Emitter.h"
 #include "llvm/Support/raw_ostream.h"
 
 namespace mlir::sdfg::emitter {
 
-struct JsonEmitter {
-  explicit JsonEmitter(raw_ostream &os);
+struct JsonEmitter : public Emitter {
+  /// Creates a new JSON emitter. In compact mode indentation and newlines are
+  /// omitted and the output is written through a large buffer.
+  explicit JsonEmitter(raw_ostream &os, bool compact = false);
 
   /// Returns a reference to the output stream. Avoid writing directly to the
   /// output stream if possible.
   raw_ostream &ostream() { return os; };
   /// Returns the current indentation level.
   unsigned getIndentation() { return indentation; };
+  /// Returns true if the emitter omits indentation and newlines.
+  bool isCompact() { return compact; };
   /// Checks for errors (open objects/lists) and adds trailing newline. Returns
   /// a LogicalResult indicating success or failure.
-  LogicalResult finish();
+  LogicalResult finish() override;
 
   /// Increases the indentation level.
   void indent();
@@ -31,46 +33,49 @@ struct JsonEmitter {
   /// Starts a new line in the output stream.
   void newLine();
   /// Prints a literal string to the output stream.
-  void printLiteral(StringRef str);
+  void printLiteral(StringRef str) override;
   /// Prints a string to the output stream, surrounding it with quotation marks.
-  void printString(StringRef str);
+  void printString(StringRef str) override;
   /// Prints an integer to the output stream, surrounding it with quotation
   /// marks.
   void printInt(int i);
 
   /// Starts a new JSON object.
-  void startObject();
+  void startObject() override;
   /// Starts a new named (keyed) JSON object.
-  void startNamedObject(StringRef name);
+  void startNamedObject(StringRef name) override;
   /// Ends the current JSON object.
-  void endObject();
+  void endObject() override;
 
+  /// Starts a new JSON list. Only used for root lists, e.g. to emit several
+  /// SDFGs as a single document.
+  void startList();
   /// Starts a new named JSON list.
-  void startNamedList(StringRef name);
+  void startNamedList(StringRef name) override;
   /// Ends the current JSON list.
-  void endList();
+  void endList() override;
 
   /// Starts a new entry in the current JSON object or list.
-  void startEntry();
+  void startEntry() override;
   /// Prints a key-value pair to the output stream. If desired, turns the value
   /// into string.
-  void printKVPair(StringRef key, StringRef val, bool stringify = true);
+  void printKVPair(StringRef key, StringRef val,
+                   bool stringify = true) override;
   /// Prints a key-value pair to the output stream. If desired, turns the value
   /// into string.
-  void printKVPair(StringRef key, int val, bool stringify = true);
+  void printKVPair(StringRef key, int val, bool stringify = true) override;
   /// Prints a key-value pair to the output stream. If desired, turns the value
   /// into string.
-  void printKVPair(StringRef key, Attribute val, bool stringify = true);
-
-  /// Prints a list of NamedAttributes as key-value pairs.
-  void printAttributes(ArrayRef<NamedAttribute> arr,
-                       ArrayRef<StringRef> elidedAttrs = {});
+  void printKVPair(StringRef key, Attribute val,
+                   bool stringify = true) override;
 
 private:
   /// The output stream.
   raw_ostream &os;
   /// The current indentation level.
   unsigned indentation;
+  /// Flag indicating whether indentation and newlines are omitted.
+  bool compact;
   /// Flag indicating whether the current entry is the first in its parent
   /// object or list.
   bool firstEntry;
@@ -88,6 +93,8 @@ private:
   SmallVector<SYM> symStack;
   /// Tries to pop a symbol from the symStack, checking for matching symbols.
   void tryPop(SYM sym);
+  /// Prints a quoted key followed by a colon.
+  void printKey(StringRef key);
 
   /// Flag indicating whether there was an error during printing.
   bool error;
@@ -0,0 +1,101 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for the MessagePack emitter in SDFG translation.
+
+#ifndef SDFG_MsgPackEmitter_H
+#define SDFG_MsgPackEmitter_H
+
+#include "SDFG/Translate/Emitter.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace mlir::sdfg::emitter {
+
+/// Emits the SDFG in MessagePack format. The produced document is equivalent to
+/// the JSON generated by the JsonEmitter, but binary encoded. The output is
+/// buffered and written to the output stream when finishing.
+struct MsgPackEmitter : public Emitter {
+  explicit MsgPackEmitter(raw_ostream &os);
+
+  /// Checks for errors (open objects/lists) and writes the buffered document
+  /// to the output stream. Returns a LogicalResult indicating success or
+  /// failure.
+  LogicalResult finish() override;
+
+  /// Prints a string to the output stream.
+  void printString(StringRef str) override;
+  /// Prints a literal value (null, true, false or a number) to the output
+  /// stream.
+  void printLiteral(StringRef str) override;
+
+  /// Starts a new map.
+  void startObject() override;
+  /// Starts a new named (keyed) map.
+  void startNamedObject(StringRef name) override;
+  /// Ends the current map.
+  void endObject() override;
+
+  /// Starts a new named array.
+  void startNamedList(StringRef name) override;
+  /// Ends the current array.
+  void endList() override;
+
+  /// Starts a new entry in the current map or array. Entries are counted when
+  /// they are printed, so this is a no-op.
+  void startEntry() override;
+  /// Prints a key-value pair to the output stream. If desired, turns the value
+  /// into string.
+  void printKVPair(StringRef key, StringRef val,
+                   bool stringify = true) override;
+  /// Prints a key-value pair to the output stream. If desired, turns the value
+  /// into string.
+  void printKVPair(StringRef key, int val, bool stringify = true) override;
+  /// Prints a key-value pair to the output stream. If desired, turns the value
+  /// into string.
+  void printKVPair(StringRef key, Attribute val,
+                   bool stringify = true) override;
+
+private:
+  /// The output stream.
+  raw_ostream &os;
+  /// The buffered document.
+  SmallVector<char> buffer;
+
+  /// Represents an open map or array.
+  struct Container {
+    /// Flag indicating whether the container is a map.
+    bool isMap;
+    /// Offset of the container header in the buffer.
+    size_t offset;
+    /// Number of entries in the container.
+    uint32_t size;
+  };
+
+  /// Stack to keep track of the opened containers.
+  SmallVector<Container> containerStack;
+
+  /// Counts a new entry in the current container, checking that it is of the
+  /// expected kind.
+  void countEntry(bool keyed);
+  /// Starts a new container with a size header patched on closing.
+  void startContainer(bool isMap);
+  /// Ends the current container, checking for matching kinds.
+  void endContainer(bool isMap);
+
+  /// Writes a big-endian unsigned integer of the given byte width.
+  void writeBE(uint64_t val, unsigned bytes);
+  /// Writes a string.
+  void writeString(StringRef str);
+  /// Writes a signed integer.
+  void writeInt(int64_t val);
+  /// Writes a value given as a JSON literal (null, true, false or numbers).
+  /// Other literals are written as strings.
+  void writeLiteral(StringRef str);
+
+  /// Flag indicating whether there was an error during printing.
+  bool error;
+};
+
+} // namespace mlir::sdfg::emitter
+
+#endif // SDFG_MsgPackEmitter_H
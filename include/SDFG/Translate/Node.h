@@ -6,9 +6,12 @@
 #define SDFG_Translation_Node_H
 
 #include "SDFG/Dialect/Dialect.h"
-#include "SDFG/Translate/JsonEmitter.h"
+#include "SDFG/Translate/Emitter.h"
+#include "SDFG/Translate/RecordingEmitter.h"
 #include "SDFG/Utils/Utils.h"
 #include "mlir/IR/Location.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Allocator.h"
 
 namespace mlir::sdfg::translation {
 // Forward declarations.
@@ -69,7 +72,55 @@ class ConsumeExitImpl;
 class Emittable {
 public:
   virtual ~Emittable() {}
-  virtual void emit(emitter::JsonEmitter &jemit) = 0;
+  virtual void emit(emitter::Emitter &jemit) = 0;
+};
+
+//===----------------------------------------------------------------------===//
+// NodeArena
+//===----------------------------------------------------------------------===//
+
+/// Owns the implementations of the nodes and interstate edges. They are
+/// bump-allocated in the arena that is current on the creating thread and
+/// destroyed together with the arena, so the handles referring to them are
+/// plain pointers that are free to copy.
+class NodeArena {
+private:
+  /// Allocator for the implementations.
+  llvm::BumpPtrAllocator allocator;
+  /// Array of the allocated implementations, destroyed with the arena.
+  std::vector<Emittable *> objects;
+  /// The current arena of this thread.
+  static thread_local NodeArena *current;
+
+public:
+  NodeArena() = default;
+  NodeArena(const NodeArena &) = delete;
+  NodeArena &operator=(const NodeArena &) = delete;
+  ~NodeArena();
+
+  /// Allocates an implementation in the current arena of this thread.
+  template <typename T, typename... Args>
+  static T *create(Args &&...args) {
+    assert(current && "No node arena is active on this thread");
+    T *object = new (current->allocator.Allocate<T>())
+        T(std::forward<Args>(args)...);
+    current->objects.push_back(object);
+    return object;
+  }
+
+  /// Makes an arena the current arena of this thread for the lifetime of the
+  /// scope.
+  class Scope {
+  private:
+    /// The arena that was current before.
+    NodeArena *previous;
+
+  public:
+    Scope(NodeArena &arena) : previous(current) { current = &arena; }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    ~Scope() { current = previous; }
+  };
 };
 
 //===----------------------------------------------------------------------===//
@@ -155,6 +206,19 @@ public:
   bool stream;
   bool init;
   SizedType shape;
+  /// The DaCe storage type. Empty for the default storage.
+  std::string storage;
+  /// The DaCe allocation lifetime. Empty for the default lifetime.
+  std::string lifetime;
+  /// The number of elements a stream holds at once. Empty for the default
+  /// buffer size.
+  std::string bufferSize;
+  /// Whether this data container is a view of another one.
+  bool view = false;
+  /// Whether this data container is an argument of its SDFG.
+  bool argument = false;
+  /// The strides of the array. Empty for contiguously stored elements.
+  std::vector<std::string> strides;
 
   Array(StringRef name, bool transient, bool stream, bool init, Type t)
       : name(name), transient(transient), stream(stream), init(init),
@@ -164,10 +228,12 @@ public:
       : name(name), transient(transient), stream(stream), init(init),
         shape(shape) {}
 
-  bool operator==(const Array other) const { return other.name == name; }
+  bool operator==(const Array &other) const { return other.name == name; }
 
+  /// Returns the strides of the array if its elements are stored contiguously.
+  std::vector<std::string> getContiguousStrides();
   /// Emits this array to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Represents a range for memlets.
@@ -181,13 +247,13 @@ public:
   Range(StringRef start, StringRef end, StringRef step, StringRef tile)
       : start(start), end(end), step(step), tile(tile) {}
 
-  bool operator==(const Range other) const {
+  bool operator==(const Range &other) const {
     return other.start == start && other.end == end && other.step == step &&
            other.tile == tile;
   }
 
   /// Emits this range to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -197,16 +263,19 @@ public:
 /// Base class for all SDFG nodes.
 class Node : public Emittable {
 protected:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<NodeImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  NodeImpl *ptr;
   /// Stores the type of this node.
   NType type;
 
 public:
-  Node(std::shared_ptr<NodeImpl> ptr) : ptr(ptr), type(NType::Other) {}
+  Node(NodeImpl *ptr) : ptr(ptr), type(NType::Other) {}
   virtual ~Node() {}
 
-  bool operator==(const Node other) const { return other.ptr == ptr; }
+  bool operator==(const Node &other) const { return other.ptr == ptr; }
+
+  /// Returns the implementation pointer, which uniquely identifies the node.
+  NodeImpl *getImpl() const { return ptr; }
 
   /// Sets the ID of the node.
   void setID(unsigned id);
@@ -223,6 +292,9 @@ public:
   /// Returns the name of the node.
   StringRef getName();
 
+  /// Sets the DaCe instrumentation type of the node.
+  void setInstrument(StringRef instrument);
+
   /// Sets the parent of the node.
   void setParent(Node parent);
   /// Returns the parent of the node.
@@ -239,12 +311,11 @@ public:
   /// name.
   void addAttribute(Attribute attribute);
   /// Emits this node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the base node class.
-class NodeImpl : public Emittable,
-                 public std::enable_shared_from_this<NodeImpl> {
+class NodeImpl : public Emittable {
 protected:
   /// Unique node ID.
   unsigned id;
@@ -254,9 +325,14 @@ protected:
   std::string name;
   /// An array of associated attributes.
   std::vector<Attribute> attributes;
+  /// The DaCe instrumentation type. Empty if not instrumented.
+  std::string instrument;
   /// Pointer to the parent node.
   Node parent;
 
+  /// Emits the instrumentation type, if any, to the output stream.
+  void emitInstrument(emitter::Emitter &jemit);
+
 public:
   NodeImpl(Location location) : id(0), location(location), parent(nullptr) {}
   virtual ~NodeImpl() {}
@@ -274,6 +350,9 @@ public:
   /// Name getter.
   StringRef getName();
 
+  /// Instrumentation type setter.
+  void setInstrument(StringRef instrument);
+
   /// Parent node setter.
   void setParent(Node parent);
   /// Parent node getter.
@@ -283,7 +362,7 @@ public:
   /// name.
   void addAttribute(Attribute attribute);
   /// Emits this node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -293,15 +372,12 @@ public:
 /// Special type of node capable of connecting to other nodes (memlets).
 class ConnectorNode : public Node {
 protected:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<ConnectorNodeImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  ConnectorNodeImpl *ptr;
 
 public:
-  ConnectorNode(std::shared_ptr<ConnectorNodeImpl> ptr)
-      : Node(std::static_pointer_cast<NodeImpl>(ptr)), ptr(ptr) {}
-
-  ConnectorNode(Node n)
-      : Node(n), ptr(std::static_pointer_cast<ConnectorNodeImpl>(Node::ptr)) {}
+  ConnectorNode(ConnectorNodeImpl *ptr);
+  ConnectorNode(Node n);
 
   virtual ~ConnectorNode() {}
 
@@ -315,7 +391,7 @@ public:
   unsigned getOutConnectorCount();
 
   /// Emits the connectors to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the connector node class.
@@ -340,7 +416,7 @@ public:
   unsigned getOutConnectorCount();
 
   /// Emits the connectors to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Represents a single connector.
@@ -356,6 +432,8 @@ public:
   std::vector<Range> ranges;
   /// The name of the data being moved.
   std::string data;
+  /// The write-conflict resolution of the moved data.
+  std::string wcr;
   // IDEA: Add DType?
 
   Connector(ConnectorNode parent)
@@ -363,11 +441,11 @@ public:
   Connector(ConnectorNode parent, StringRef name)
       : parent(parent), name(name), isNull(false), ranges({}) {}
 
-  bool operator==(const Connector other) const {
+  bool operator==(const Connector &other) const {
     return other.parent == parent && other.name == name &&
            ((other.isNull && isNull) ||
             (!other.isNull && !isNull && other.ranges == ranges &&
-             other.data == data));
+             other.data == data && other.wcr == wcr));
   }
 
   /// Adds a data range to the connector.
@@ -376,6 +454,8 @@ public:
   void setRanges(std::vector<Range> ranges) { this->ranges = ranges; }
   /// Sets the name of the data being moved.
   void setData(StringRef data) { this->data = data.str(); }
+  /// Sets the write-conflict resolution of the moved data.
+  void setWCR(StringRef wcr) { this->wcr = wcr.str(); }
 };
 
 //===----------------------------------------------------------------------===//
@@ -394,21 +474,39 @@ private:
   Connector destination;
   /// Ignore connectors. Just a dependency edge.
   bool depEdge;
+  /// The number of moved elements. Empty if unknown.
+  std::string volume;
+  /// Flag indicating whether the volume is only an upper bound.
+  bool dynamic;
 
 public:
   MultiEdge(Location location, Connector source, Connector destination)
       : location(location), source(source), destination(destination),
-        depEdge(false) {}
+        depEdge(false), dynamic(false) {}
 
   /// Returns the source connector of this edge.
-  Connector getSource();
+  const Connector &getSource();
   /// Returns the destination connector of this edge.
-  Connector getDestination();
+  const Connector &getDestination();
   /// Makes this edge a dependency edge.
   void makeDependence();
+  /// Returns true if this edge is a dependency edge.
+  bool isDependence();
+
+  /// Returns the moved subset, which is the subset of the source connector or
+  /// the subset of the destination connector if the source has none.
+  std::vector<Range> getSubset();
+  /// Sets the moved subset.
+  void setSubset(std::vector<Range> subset);
+  /// Returns the number of moved elements. Empty if unknown.
+  StringRef getVolume();
+  /// Returns true if the volume is only an upper bound.
+  bool isDynamic();
+  /// Sets the number of moved elements and whether it is only an upper bound.
+  void setVolume(StringRef volume, bool dynamic);
 
   /// Emits this edge to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -418,17 +516,12 @@ public:
 /// Special type of connector node containing a scope.
 class ScopeNode : public ConnectorNode {
 protected:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<ScopeNodeImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  ScopeNodeImpl *ptr;
 
 public:
-  ScopeNode(std::shared_ptr<ScopeNodeImpl> ptr)
-      : ConnectorNode(std::static_pointer_cast<ConnectorNodeImpl>(ptr)),
-        ptr(ptr) {}
-
-  ScopeNode(Node n)
-      : ConnectorNode(n),
-        ptr(std::static_pointer_cast<ScopeNodeImpl>(Node::ptr)) {}
+  ScopeNode(ScopeNodeImpl *ptr);
+  ScopeNode(Node n);
 
   virtual ~ScopeNode() {}
 
@@ -446,18 +539,29 @@ public:
   virtual void addDependency(Value value, Connector connector);
 
   /// Emits all nodes and edges to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the scoped node class.
 class ScopeNodeImpl : public ConnectorNodeImpl {
 protected:
   /// Lookup table for Value-Connector mapping.
-  std::map<std::string, Connector> lut;
+  llvm::DenseMap<Value, Connector> lut;
   /// Array of all nodes in the scope.
   std::vector<ConnectorNode> nodes;
   /// Array of all edges in the scope.
   std::vector<MultiEdge> edges;
+  /// Maps nodes to the indices of their incoming edges in the scope.
+  llvm::DenseMap<NodeImpl *, llvm::SmallVector<unsigned>> inEdges;
+  /// Maps nodes to the indices of their outgoing edges in the scope.
+  llvm::DenseMap<NodeImpl *, llvm::SmallVector<unsigned>> outEdges;
+
+  /// Appends an edge to the scope and updates the edge adjacency.
+  void insertEdge(MultiEdge edge);
+  /// Returns true if the node has an incoming edge in the scope.
+  bool hasInEdge(ConnectorNode node);
+  /// Returns true if the node has an outgoing edge in the scope.
+  bool hasOutEdge(ConnectorNode node);
 
 public:
   ScopeNodeImpl(Location location) : ConnectorNodeImpl(location) {}
@@ -477,7 +581,7 @@ public:
   virtual void addDependency(Value value, Connector connector);
 
   /// Emits all nodes and edges to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -487,41 +591,60 @@ public:
 /// Represents a SDFG state.
 class State final : public ScopeNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<StateImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  StateImpl *ptr;
 
 public:
-  State(std::shared_ptr<StateImpl> ptr)
-      : ScopeNode(std::static_pointer_cast<ScopeNodeImpl>(ptr)), ptr(ptr) {
-    type = NType::State;
-  }
-
-  State(Location location)
-      : ScopeNode(std::static_pointer_cast<ScopeNodeImpl>(
-            std::make_shared<StateImpl>(location))),
-        ptr(std::static_pointer_cast<StateImpl>(Node::ptr)) {
-    type = NType::State;
-  }
+  State(StateImpl *ptr);
+  State(Location location);
 
   /// Modified lookup function creates access nodes if the value could not be
   /// found.
   Connector lookup(Value value) override;
+  /// Computes the exact subsets and volumes of the memlets entering and
+  /// leaving maps.
+  void propagateMemlets();
+  /// Releases the nodes and edges of the state once it has been emitted.
+  void release();
 
   /// Emits the state node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the state node class.
 class StateImpl final : public ScopeNodeImpl {
+private:
+  /// Computes the memlet moved by an edge in a single iteration of the
+  /// surrounding scope. Returns false if it is not known exactly.
+  bool getMemlet(MultiEdge &edge, std::vector<Range> &subset,
+                 std::string &volume, bool &dynamic);
+  /// Computes the union of the memlets moved by the provided edges in a single
+  /// iteration of the surrounding scope. Returns false if it is not known
+  /// exactly.
+  bool uniteMemlets(ArrayRef<unsigned> edgeIndices, std::vector<Range> &subset,
+                    std::string &volume, bool &dynamic);
+  /// Propagates the memlets of the map body to the edges entering the map.
+  void propagateMapEntry(MapEntry entry);
+  /// Propagates the memlets of the map body to the edges leaving the map.
+  void propagateMapExit(MapEntry entry);
+
 public:
   StateImpl(Location location) : ScopeNodeImpl(location) {}
 
   /// Modified lookup function creates access nodes if the value could not be
   /// found.
   Connector lookup(Value value) override;
+  /// Adds a multiedge from the source to the destination connector. Writes to
+  /// views are written back to the array they view.
+  void routeWrite(Connector from, Connector to, Value mapValue) override;
+  /// Computes the exact subsets and volumes of the memlets entering and
+  /// leaving maps.
+  void propagateMemlets();
+  /// Releases the nodes and edges of the state once it has been emitted.
+  void release();
 
   /// Emits the state node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -531,25 +654,13 @@ public:
 /// Represents the top-level SDFG.
 class SDFG final : public Node {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<SDFGImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  SDFGImpl *ptr;
 
 public:
-  SDFG(std::shared_ptr<SDFGImpl> ptr)
-      : Node(std::static_pointer_cast<NodeImpl>(ptr)), ptr(ptr) {
-    type = NType::SDFG;
-  }
-
-  SDFG(Location location)
-      : Node(std::static_pointer_cast<NodeImpl>(
-            std::make_shared<SDFGImpl>(location))),
-        ptr(std::static_pointer_cast<SDFGImpl>(Node::ptr)) {
-    type = NType::SDFG;
-  }
-
-  SDFG(Node n) : Node(n), ptr(std::static_pointer_cast<SDFGImpl>(Node::ptr)) {
-    type = NType::SDFG;
-  }
+  SDFG(SDFGImpl *ptr);
+  SDFG(Location location);
+  SDFG(Node n);
 
   /// Returns the state associated with the provided name.
   State lookup(StringRef name);
@@ -566,15 +677,23 @@ public:
   /// Adds a symbol to the SDFG.
   void addSymbol(Symbol symbol);
   /// Returns an array of all symbols in the SDFG.
-  std::vector<Symbol> getSymbols();
+  const std::vector<Symbol> &getSymbols();
 
   /// Sets all non-argument arrays to transient.
   void setNestedTransient();
 
   /// Emits the SDFG to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
   /// Emits the SDFG as a nested SDFG to the output stream.
-  void emitNested(emitter::JsonEmitter &jemit);
+  void emitNested(emitter::Emitter &jemit);
+
+  /// Starts emitting the SDFG to the output stream, such that its states can
+  /// be emitted as soon as they are collected.
+  void beginStream(emitter::Emitter &jemit);
+  /// Emits the provided state of a streamed SDFG and releases its contents.
+  void streamState(State state, emitter::Emitter &jemit);
+  /// Finishes emitting a streamed SDFG once all states are collected.
+  void endStream(emitter::Emitter &jemit);
 };
 
 /// Implementation of the SDFG node class.
@@ -594,16 +713,19 @@ private:
   std::vector<Symbol> symbols;
   /// The entry state of the SDFG
   State startState;
-  /// Global counter for the ID of SDFGs.
-  static unsigned list_id;
+  /// Global counter for the ID of SDFGs, assigned in emission order. Separate
+  /// per thread, as nested SDFGs may be recorded concurrently.
+  static thread_local unsigned list_id;
 
   /// Emits the body of the SDFG to the output stream.
-  void emitBody(emitter::JsonEmitter &jemit);
+  void emitBody(emitter::Emitter &jemit);
+  /// Emits the attributes of the SDFG to the output stream.
+  void emitAttributes(emitter::Emitter &jemit);
+  /// Emits the interstate edges of the SDFG to the output stream.
+  void emitEdges(emitter::Emitter &jemit);
 
 public:
-  SDFGImpl(Location location) : NodeImpl(location), startState(location) {
-    id = SDFGImpl::list_id++;
-  }
+  SDFGImpl(Location location) : NodeImpl(location), startState(location) {}
 
   /// Returns the state associated with the provided name.
   State lookup(StringRef name);
@@ -620,15 +742,32 @@ public:
   /// Adds a symbol to the SDFG.
   void addSymbol(Symbol symbol);
   /// Returns an array of all symbols in the SDFG.
-  std::vector<Symbol> getSymbols();
+  const std::vector<Symbol> &getSymbols();
 
   /// Sets all non-argument arrays to transient.
   void setNestedTransient();
 
   /// Emits the SDFG to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
   /// Emits the SDFG as a nested SDFG to the output stream.
-  void emitNested(emitter::JsonEmitter &jemit);
+  void emitNested(emitter::Emitter &jemit);
+
+  /// Starts emitting the SDFG to the output stream, such that its states can
+  /// be emitted as soon as they are collected.
+  void beginStream(emitter::Emitter &jemit);
+  /// Emits the provided state of a streamed SDFG and releases its contents.
+  void streamState(State state, emitter::Emitter &jemit);
+  /// Finishes emitting a streamed SDFG once all states are collected.
+  void endStream(emitter::Emitter &jemit);
+
+  /// Replays a nested SDFG recorded by emitNested to the output stream. The
+  /// IDs of the contained SDFGs are assigned in emission order and the
+  /// inherited symbols are added to all of them, as if the SDFG was emitted
+  /// in place.
+  static void
+  emitRecording(emitter::Emitter &jemit,
+                ArrayRef<emitter::RecordingEmitter::Event> recording,
+                ArrayRef<Symbol> inherited);
 };
 
 //===----------------------------------------------------------------------===//
@@ -638,17 +777,16 @@ public:
 /// Represents a nested SDFG.
 class NestedSDFG final : public ConnectorNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<NestedSDFGImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  NestedSDFGImpl *ptr;
 
 public:
-  NestedSDFG(Location location, SDFG sdfg)
-      : ConnectorNode(std::static_pointer_cast<ConnectorNodeImpl>(
-            std::make_shared<NestedSDFGImpl>(location, sdfg))),
-        ptr(std::static_pointer_cast<NestedSDFGImpl>(ConnectorNode::ptr)) {}
+  NestedSDFG(Location location, SDFG sdfg);
+  NestedSDFG(Location location,
+             std::vector<emitter::RecordingEmitter::Event> recording);
 
   /// Emits the nested SDFG to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the nested SDFG node class.
@@ -656,13 +794,20 @@ class NestedSDFGImpl final : public ConnectorNodeImpl {
 private:
   /// The contained SDFG.
   SDFG sdfg;
+  /// The recorded emission of the contained SDFG. If not empty, it is replayed
+  /// instead of emitting the contained SDFG.
+  std::vector<emitter::RecordingEmitter::Event> recording;
 
 public:
   NestedSDFGImpl(Location location, SDFG sdfg)
       : ConnectorNodeImpl(location), sdfg(sdfg) {}
 
+  NestedSDFGImpl(Location location,
+                 std::vector<emitter::RecordingEmitter::Event> recording)
+      : ConnectorNodeImpl(location), sdfg(location), recording(recording) {}
+
   /// Emits the nested SDFG to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -672,13 +817,11 @@ public:
 /// Represents an edge connecting muliple states.
 class InterstateEdge final : public Emittable {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<InterstateEdgeImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  InterstateEdgeImpl *ptr;
 
 public:
-  InterstateEdge(Location location, State source, State destination)
-      : ptr(std::make_shared<InterstateEdgeImpl>(location, source,
-                                                 destination)) {}
+  InterstateEdge(Location location, State source, State destination);
 
   /// Sets the condition of the interstate edge.
   void setCondition(Condition condition);
@@ -686,7 +829,7 @@ public:
   void addAssignment(Assignment assignment);
 
   /// Emits the interstate edge to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the interstate edge class.
@@ -715,7 +858,7 @@ public:
   void addAssignment(Assignment assignment);
 
   /// Emits the interstate edge to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -725,14 +868,11 @@ public:
 /// Represents a SDFG tasklet.
 class Tasklet final : public ConnectorNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<TaskletImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  TaskletImpl *ptr;
 
 public:
-  Tasklet(Location location)
-      : ConnectorNode(std::static_pointer_cast<ConnectorNodeImpl>(
-            std::make_shared<TaskletImpl>(location))),
-        ptr(std::static_pointer_cast<TaskletImpl>(ConnectorNode::ptr)) {}
+  Tasklet(Location location);
 
   /// Sets the code of the tasklet.
   void setCode(Code code);
@@ -742,7 +882,7 @@ public:
   void setHasSideEffect(bool hasSideEffect);
 
   /// Emits the tasklet to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the tasklet node class.
@@ -767,7 +907,7 @@ public:
   void setHasSideEffect(bool hasSideEffect);
 
   /// Emits the tasklet to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -777,19 +917,23 @@ public:
 /// Represents a SDFG libary node.
 class Library final : public ConnectorNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<LibraryImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  LibraryImpl *ptr;
 
 public:
-  Library(Location location)
-      : ConnectorNode(std::static_pointer_cast<ConnectorNodeImpl>(
-            std::make_shared<LibraryImpl>(location))),
-        ptr(std::static_pointer_cast<LibraryImpl>(ConnectorNode::ptr)) {}
+  Library(Location location);
 
   /// Sets the library code path.
   void setClasspath(StringRef classpath);
+  /// Adds a property of the library node. If desired, turns the value into a
+  /// string.
+  void addProperty(StringRef key, StringRef value, bool stringify = true);
+  /// Adds a list-valued property of the library node. If desired, turns the
+  /// values into strings.
+  void addProperty(StringRef key, ArrayRef<std::string> values,
+                   bool stringify = true);
   /// Emits the library node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the library node class.
@@ -797,14 +941,26 @@ class LibraryImpl final : public ConnectorNodeImpl {
 private:
   /// The path to the library code.
   std::string classpath;
+  /// The properties of the library node as key, value and stringify flag.
+  std::vector<std::tuple<std::string, std::string, bool>> properties;
+  /// The list-valued properties of the library node as key, values and
+  /// stringify flag.
+  std::vector<std::tuple<std::string, std::vector<std::string>, bool>>
+      listProperties;
 
 public:
   LibraryImpl(Location location) : ConnectorNodeImpl(location) {}
 
   /// Sets the library code path.
   void setClasspath(StringRef classpath);
+  /// Adds a property of the library node. If desired, turns the value into a
+  /// string.
+  void addProperty(StringRef key, StringRef value, bool stringify);
+  /// Adds a list-valued property of the library node. If desired, turns the
+  /// values into strings.
+  void addProperty(StringRef key, ArrayRef<std::string> values, bool stringify);
   /// Emits the library node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -814,28 +970,18 @@ public:
 /// Represents an access node in the SDFG.
 class Access final : public ConnectorNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<AccessImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  AccessImpl *ptr;
 
 public:
-  Access(Location location, bool init)
-      : ConnectorNode(std::static_pointer_cast<ConnectorNodeImpl>(
-            std::make_shared<AccessImpl>(location, init))),
-        ptr(std::static_pointer_cast<AccessImpl>(ConnectorNode::ptr)) {
-    type = NType::Access;
-  }
-
-  Access(ConnectorNode n)
-      : ConnectorNode(n),
-        ptr(std::static_pointer_cast<AccessImpl>(ConnectorNode::ptr)) {
-    type = NType::Access;
-  }
+  Access(Location location, bool init);
+  Access(ConnectorNode n);
 
   /// Returns true if this access node should initialize.
   bool getInit();
 
   /// Emits the access node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the access node class.
@@ -851,7 +997,7 @@ public:
   bool getInit();
 
   /// Emits the access node to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -861,23 +1007,14 @@ public:
 /// Represents a map entry node in the SDFG.
 class MapEntry final : public ScopeNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<MapEntryImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  MapEntryImpl *ptr;
 
 public:
-  MapEntry(Location location)
-      : ScopeNode(std::static_pointer_cast<ScopeNodeImpl>(
-            std::make_shared<MapEntryImpl>(location))),
-        ptr(std::static_pointer_cast<MapEntryImpl>(Node::ptr)) {
-    type = NType::MapEntry;
-  }
-
-  MapEntry(Node n)
-      : ScopeNode(n), ptr(std::static_pointer_cast<MapEntryImpl>(Node::ptr)) {
-    type = NType::MapEntry;
-  }
+  MapEntry(Location location);
 
-  MapEntry() : ScopeNode(nullptr) {}
+  MapEntry(Node n);
+  MapEntry() : ScopeNode(nullptr), ptr(nullptr) {}
 
   /// Adds a parameter to the map entry.
   void addParam(StringRef param);
@@ -903,25 +1040,32 @@ public:
   /// Adds a dependency edge between the MLIR and the connector.
   void addDependency(Value value, Connector connector) override;
 
+  /// Sets the DaCe schedule type of the map.
+  void setSchedule(StringRef schedule);
+  /// Sets the number of collapsed dimensions.
+  void setCollapse(int collapse);
+  /// Sets the OpenMP chunk size.
+  void setOmpChunkSize(int chunkSize);
+  /// Sets the tile sizes of the map dimensions.
+  void setTileSizes(ArrayRef<int> tileSizes);
+
+  /// Propagates the memlet moved in a single iteration to the memlet moved by
+  /// the whole map. Returns false if the result would not be exact.
+  bool propagate(std::vector<Range> &subset, std::string &volume);
+
   /// Emits the map entry to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Represents a map exit node in the SDFG.
 class MapExit final : public ConnectorNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<MapExitImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  MapExitImpl *ptr;
 
 public:
-  MapExit(Location location)
-      : ConnectorNode(std::static_pointer_cast<ConnectorNodeImpl>(
-            std::make_shared<MapExitImpl>(location))),
-        ptr(std::static_pointer_cast<MapExitImpl>(ConnectorNode::ptr)) {
-    type = NType::MapExit;
-  }
-
-  MapExit() : ConnectorNode(nullptr) {}
+  MapExit(Location location);
+  MapExit() : ConnectorNode(nullptr), ptr(nullptr) {}
 
   /// Sets the map entry this map exit belongs to.
   void setEntry(MapEntry entry);
@@ -929,7 +1073,7 @@ public:
   MapEntry getEntry();
 
   /// Emits the map exit to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the map entry node class.
@@ -943,6 +1087,14 @@ private:
   std::vector<Range> ranges;
   /// Array of pending write routes.
   std::vector<std::tuple<Connector, Connector, Value>> writeQueue;
+  /// The DaCe schedule type. Empty for the default schedule.
+  std::string schedule;
+  /// The number of collapsed dimensions.
+  int collapse = 1;
+  /// The OpenMP chunk size. Zero for the default chunk size.
+  int ompChunkSize = 0;
+  /// Array of tile sizes for the parameters.
+  std::vector<int> tileSizes;
 
   /// Routes the write to the outer scope.
   void routeOut(Connector from, Connector to, Value mapValue);
@@ -974,8 +1126,21 @@ public:
   /// Adds a dependency edge between the MLIR and the connector.
   void addDependency(Value value, Connector connector) override;
 
+  /// Sets the DaCe schedule type of the map.
+  void setSchedule(StringRef schedule);
+  /// Sets the number of collapsed dimensions.
+  void setCollapse(int collapse);
+  /// Sets the OpenMP chunk size.
+  void setOmpChunkSize(int chunkSize);
+  /// Sets the tile sizes of the map dimensions.
+  void setTileSizes(ArrayRef<int> tileSizes);
+
+  /// Propagates the memlet moved in a single iteration to the memlet moved by
+  /// the whole map. Returns false if the result would not be exact.
+  bool propagate(std::vector<Range> &subset, std::string &volume);
+
   /// Emits the map entry to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the map exit node class.
@@ -993,7 +1158,7 @@ public:
   MapEntry getEntry();
 
   /// Emits the map exit to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 //===----------------------------------------------------------------------===//
@@ -1003,24 +1168,14 @@ public:
 /// Represents a consume entry node in the SDFG.
 class ConsumeEntry final : public ScopeNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<ConsumeEntryImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  ConsumeEntryImpl *ptr;
 
 public:
-  ConsumeEntry(Location location)
-      : ScopeNode(std::static_pointer_cast<ScopeNodeImpl>(
-            std::make_shared<ConsumeEntryImpl>(location))),
-        ptr(std::static_pointer_cast<ConsumeEntryImpl>(Node::ptr)) {
-    type = NType::ConsumeEntry;
-  }
-
-  ConsumeEntry(Node n)
-      : ScopeNode(n),
-        ptr(std::static_pointer_cast<ConsumeEntryImpl>(Node::ptr)) {
-    type = NType::ConsumeEntry;
-  }
+  ConsumeEntry(Location location);
 
-  ConsumeEntry() : ScopeNode(nullptr) {}
+  ConsumeEntry(Node n);
+  ConsumeEntry() : ScopeNode(nullptr), ptr(nullptr) {}
 
   /// Sets the consume exit this consume entry belongs to.
   void setExit(ConsumeExit exit);
@@ -1049,30 +1204,24 @@ public:
   void setCondition(Code condition);
 
   /// Emits the consume entry to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Represents a consume exit node in the SDFG.
 class ConsumeExit final : public ConnectorNode {
 private:
-  /// Pointer to the implementation (Pimpl idiom).
-  std::shared_ptr<ConsumeExitImpl> ptr;
+  /// Pointer to the implementation (Pimpl idiom), owned by a NodeArena.
+  ConsumeExitImpl *ptr;
 
 public:
-  ConsumeExit(Location location)
-      : ConnectorNode(std::static_pointer_cast<ConnectorNodeImpl>(
-            std::make_shared<ConsumeExitImpl>(location))),
-        ptr(std::static_pointer_cast<ConsumeExitImpl>(ConnectorNode::ptr)) {
-    type = NType::ConsumeExit;
-  }
-
-  ConsumeExit() : ConnectorNode(nullptr) {}
+  ConsumeExit(Location location);
+  ConsumeExit() : ConnectorNode(nullptr), ptr(nullptr) {}
 
   /// Sets the consume entry this consume exit belongs to.
   void setEntry(ConsumeEntry entry);
 
   /// Emits the consume exit to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the consume entry node class.
@@ -1117,7 +1266,7 @@ public:
   void setCondition(Code condition);
 
   /// Emits the consume entry to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 /// Implementation of the consume exit node class.
@@ -1133,7 +1282,7 @@ public:
   void setEntry(ConsumeEntry entry);
 
   /// Emits the consume exit to the output stream.
-  void emit(emitter::JsonEmitter &jemit) override;
+  void emit(emitter::Emitter &jemit) override;
 };
 
 } // namespace mlir::sdfg::translation
@@ -0,0 +1,100 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for the recording emitter in SDFG translation.
+
+#ifndef SDFG_RecordingEmitter_H
+#define SDFG_RecordingEmitter_H
+
+#include "SDFG/Translate/Emitter.h"
+#include "llvm/ADT/SmallVector.h"
+#include <string>
+#include <vector>
+
+namespace mlir::sdfg::emitter {
+
+/// Records the emitted document as a sequence of emitter calls instead of
+/// printing it. The recording does not depend on the output format, can be
+/// serialized to a string and replayed on any emitter later on.
+struct RecordingEmitter : public Emitter {
+  /// The kind of a recorded emitter call.
+  enum class Kind : char {
+    String = 's',
+    Literal = 'v',
+    Object = 'o',
+    NamedObject = 'O',
+    EndObject = 'e',
+    NamedList = 'L',
+    EndList = 'l',
+    Entry = 'n',
+    KVString = 'k',
+    KVInt = 'i'
+  };
+
+  /// A recorded emitter call.
+  struct Event {
+    Kind kind;
+    /// The key of named objects, lists and key-value pairs.
+    std::string key;
+    /// The value of strings, literals and key-value pairs.
+    std::string value;
+    /// The stringify flag of key-value pairs.
+    bool stringify = true;
+  };
+
+  /// Checks for errors (open objects/lists). Returns a LogicalResult
+  /// indicating success or failure.
+  LogicalResult finish() override;
+
+  /// Records a string.
+  void printString(StringRef str) override;
+  /// Records a literal value.
+  void printLiteral(StringRef str) override;
+
+  /// Records the start of a new object.
+  void startObject() override;
+  /// Records the start of a new named (keyed) object.
+  void startNamedObject(StringRef name) override;
+  /// Records the end of the current object.
+  void endObject() override;
+
+  /// Records the start of a new named list.
+  void startNamedList(StringRef name) override;
+  /// Records the end of the current list.
+  void endList() override;
+
+  /// Records the start of a new entry.
+  void startEntry() override;
+  /// Records a key-value pair.
+  void printKVPair(StringRef key, StringRef val,
+                   bool stringify = true) override;
+  /// Records a key-value pair.
+  void printKVPair(StringRef key, int val, bool stringify = true) override;
+  /// Records a key-value pair. Attributes are recorded by their printed value.
+  void printKVPair(StringRef key, Attribute val,
+                   bool stringify = true) override;
+
+  /// Returns the recorded emitter calls.
+  const std::vector<Event> &getEvents() { return events; }
+  /// Serializes the recorded emitter calls to a string.
+  std::string str();
+
+  /// Parses a serialized recording. Returns failure if it is malformed.
+  static LogicalResult parse(StringRef str, std::vector<Event> &events);
+  /// Replays a single recorded emitter call on the provided emitter.
+  static void replay(const Event &event, Emitter &em);
+
+private:
+  /// The recorded emitter calls.
+  std::vector<Event> events;
+  /// Stack to keep track of the opened objects (true) and lists (false).
+  SmallVector<bool> openStack;
+  /// Flag indicating whether there was an error during recording.
+  bool error = false;
+
+  /// Tries to pop a symbol from the openStack, checking for matching kinds.
+  void tryPop(bool isObject);
+};
+
+} // namespace mlir::sdfg::emitter
+
+#endif // SDFG_RecordingEmitter_H
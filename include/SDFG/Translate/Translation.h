@@ -8,39 +8,110 @@
 #include "SDFG/Dialect/Dialect.h"
 #include "SDFG/Translate/JsonEmitter.h"
 #include "SDFG/Translate/Node.h"
+#include "SDFG/Translate/RecordingEmitter.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 
 using namespace mlir::sdfg::emitter;
 
 namespace mlir::sdfg::translation {
 /// Registers SDFG to SDFG IR translation.
 void registerToSDFGTranslation();
+/// Registers the dialects needed for the SDFG translation.
+void registerTranslationDialects(DialectRegistry &registry);
+
+/// Options controlling the SDFG IR translation.
+struct TranslationOptions {
+  /// The language tasklets are lifted to if possible. Python otherwise.
+  CodeLanguage taskletLanguage = CodeLanguage::Python;
+  /// The DaCe instrumentation type applied to every top-level map without an
+  /// instrument attribute. Empty to leave such maps uninstrumented.
+  std::string mapInstrumentation;
+  /// The directory caching the translation of nested SDFGs across runs. Empty
+  /// to disable the cache.
+  std::string cacheDirectory;
+  /// Whether the states of the top-level SDFG are emitted as soon as they are
+  /// collected. Bounds the memory to the largest state including its nested
+  /// SDFGs, but emits the attributes of the SDFG after its states.
+  bool streamStates = false;
+};
+
+/// The state of a running translation. Passed along the collection instead of
+/// being kept in globals, so that concurrent translations do not interfere.
+struct TranslationContext {
+  TranslationContext(const TranslationOptions &options) : options(options) {}
+
+  /// The options of the translation.
+  const TranslationOptions &options;
+  /// Nested SDFGs collected ahead of time, mapped to their operation.
+  llvm::DenseMap<Operation *, SDFG> precollectedSDFGs;
+  /// Recordings of cached nested SDFGs collected ahead of time, mapped to their
+  /// operation.
+  llvm::DenseMap<Operation *, std::vector<RecordingEmitter::Event>>
+      precollectedRecordings;
+  /// The arenas holding the nested SDFGs collected ahead of time, one per
+  /// nested SDFG, as they are collected concurrently. Streamed states free
+  /// them once they are emitted.
+  std::vector<std::unique_ptr<NodeArena>> precollectedArenas;
+  /// The arena the contents of the next collected state are allocated in. Set
+  /// for streamed states, whose contents are freed once they are emitted.
+  NodeArena *stateArena = nullptr;
+
+  /// Frees the nested SDFGs collected ahead of time.
+  void releasePrecollected() {
+    precollectedSDFGs.clear();
+    precollectedRecordings.clear();
+    precollectedArenas.clear();
+  }
+};
 
 /// Translates a module containing SDFG dialect to SDFG IR, outputs the result
 /// to the provided output stream.
-LogicalResult translateToSDFG(ModuleOp &op, JsonEmitter &jemit);
+LogicalResult translateToSDFG(ModuleOp &op, Emitter &jemit,
+                              const TranslationOptions &options = {});
+/// Translates every top-level SDFG of a module containing SDFG dialect to SDFG
+/// IR, outputs the i-th SDFG to the i-th emitter. The SDFGs are translated in
+/// parallel. If provided, the callback is invoked with the index of every SDFG
+/// as soon as it is translated, possibly from several threads at once.
+LogicalResult
+translateToSDFGs(ModuleOp &op, ArrayRef<Emitter *> emitters,
+                 const TranslationOptions &options = {},
+                 llvm::function_ref<void(size_t)> onTranslated = {});
 
 /// Collects state node information in a top-level SDFG.
-LogicalResult collect(StateNode &op, SDFG &sdfg);
+LogicalResult collect(StateNode &op, SDFG &sdfg, TranslationContext &ctx);
 /// Collects edge information in a top-level SDFG.
 LogicalResult collect(EdgeOp &op, SDFG &sdfg);
 /// Collects array/stream allocation information in a top-level SDFG.
 LogicalResult collect(AllocOp &op, SDFG &sdfg);
+/// Collects view cast information in a top-level SDFG.
+LogicalResult collect(ViewCastOp &op, SDFG &sdfg);
+/// Collects subview information in a top-level SDFG.
+LogicalResult collect(SubviewOp &op, SDFG &sdfg);
 /// Collects symbol allocation information in a top-level SDFG.
 LogicalResult collect(AllocSymbolOp &op, SDFG &sdfg);
 
 /// Collects array/stream allocation information in a scope.
 LogicalResult collect(AllocOp &op, ScopeNode &scope);
+/// Collects view cast information in a scope.
+LogicalResult collect(ViewCastOp &op, ScopeNode &scope);
+/// Collects subview information in a scope.
+LogicalResult collect(SubviewOp &op, ScopeNode &scope);
 /// Collects tasklet information in a scope.
-LogicalResult collect(TaskletNode &op, ScopeNode &scope);
+LogicalResult collect(TaskletNode &op, ScopeNode &scope,
+                      TranslationContext &ctx);
 /// Collects library call information in a scope.
 LogicalResult collect(LibCallOp &op, ScopeNode &scope);
 /// Collects nested SDFG node information in a scope.
-LogicalResult collect(NestedSDFGNode &op, ScopeNode &scope);
+LogicalResult collect(NestedSDFGNode &op, ScopeNode &scope,
+                      TranslationContext &ctx);
 
 /// Collects map node information in a scope.
-LogicalResult collect(MapNode &op, ScopeNode &scope);
+LogicalResult collect(MapNode &op, ScopeNode &scope,
+                      TranslationContext &ctx);
 /// Collects consume node information in a scope.
-LogicalResult collect(ConsumeNode &op, ScopeNode &scope);
+LogicalResult collect(ConsumeNode &op, ScopeNode &scope,
+                      TranslationContext &ctx);
 /// Collects copy operation information in a scope.
 LogicalResult collect(CopyOp &op, ScopeNode &scope);
 /// Collects store operation information in a scope.
@@ -0,0 +1,18 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for lifting operations to C++.
+
+#ifndef SDFG_Translation_LiftToCpp_H
+#define SDFG_Translation_LiftToCpp_H
+
+#include "SDFG/Dialect/Dialect.h"
+
+namespace mlir::sdfg::translation {
+
+/// Converts the operations in the first region of op to typed C++ code. If
+/// successful, returns C++ code as a string.
+Optional<std::string> liftToCpp(Operation &op);
+
+} // namespace mlir::sdfg::translation
+
+#endif // SDFG_Translation_LiftToCpp_H
@@ -0,0 +1,34 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for the access collection utility functions.
+
+#ifndef SDFG_Utils_CollectAccesses_H
+#define SDFG_Utils_CollectAccesses_H
+
+#include "SDFG/Dialect/Dialect.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/MapVector.h"
+
+namespace mlir::sdfg::utils {
+
+/// The data containers a group of operations reads and writes.
+struct Accesses {
+  llvm::DenseSet<Value> reads;
+  llvm::DenseSet<Value> writes;
+  /// The operations accessing each data container in program order.
+  llvm::MapVector<Value, SmallVector<Operation *>> ops;
+};
+
+/// Returns true if the provided array is a view of another array.
+bool isView(Value array);
+/// Collects the data containers the provided operation and the operations
+/// nested in it access. Nested SDFGs read their arguments and write their
+/// results, except for the provided one, whose arguments are replaced by the
+/// corresponding operands. Fails if the operations contain accesses through
+/// views or side effects that cannot be attributed to data containers.
+LogicalResult collectAccesses(Operation *root, Accesses &accesses,
+                              NestedSDFGNode inlined = nullptr);
+
+} // namespace mlir::sdfg::utils
+
+#endif // SDFG_Utils_CollectAccesses_H
@@ -12,6 +12,8 @@ namespace mlir::sdfg::utils {
 /// Returns the parent SDFG node, NestedSDFG node or nullptr if a parent does
 /// not exist.
 Operation *getParentSDFG(Operation &op);
+/// Returns the name of the entry state of the provided (nested) SDFG node.
+StringRef getEntryStateName(Operation *sdfg);
 /// Returns the parent State node or nullptr if a parent does not exist.
 StateNode getParentState(Operation &op, bool ignoreSDFGs = false);
 /// Returns top-level module operation or nullptr if a parent does not exist.
@@ -5,12 +5,20 @@
 #ifndef SDFG_Utils_IDGenerator_H
 #define SDFG_Utils_IDGenerator_H
 
+namespace mlir {
+class MLIRContext;
+class Operation;
+} // namespace mlir
+
 namespace mlir::sdfg::utils {
 
-/// Returns a globally unique ID.
-unsigned generateID();
-/// Resets the ID generator.
-void resetIDGenerator();
+/// Returns an ID unique within the provided context. The counter is attached
+/// to the SDFG dialect and may be used concurrently by multiple threads.
+unsigned generateID(MLIRContext *ctx);
+/// Renumbers the IDs of all nodes nested in the provided operation in the order
+/// of the operations, so that they do not depend on the order the nodes were
+/// created in.
+void renumberIDs(Operation *root);
 
 } // namespace mlir::sdfg::utils
 
@@ -9,9 +9,35 @@
 
 namespace mlir::sdfg::utils {
 
-/// Converts the provided string to a globally unique one.
+/// Converts the provided string to a unique one. Uses the innermost active
+/// NameGeneratorScope of the current thread or a global counter otherwise.
 std::string generateName(std::string base);
 
+/// Redirects generateName on the current thread to a local counter for its
+/// lifetime. Passes open an unprefixed scope per module, so names restart for
+/// every module and do not depend on other threads. Prefixed scopes keep the
+/// names unique and deterministic when independent tasks of the same module
+/// generate names concurrently. Scopes may be nested.
+class NameGeneratorScope {
+public:
+  explicit NameGeneratorScope(std::string prefix = "");
+  ~NameGeneratorScope();
+
+  NameGeneratorScope(const NameGeneratorScope &) = delete;
+  NameGeneratorScope &operator=(const NameGeneratorScope &) = delete;
+
+  /// Converts the provided string to a name unique in this scope.
+  std::string generateName(std::string base);
+
+private:
+  /// The previously active scope.
+  NameGeneratorScope *prevScope;
+  /// The prefix of all generated names.
+  std::string prefix;
+  /// The local counter.
+  unsigned counter;
+};
+
 } // namespace mlir::sdfg::utils
 
 #endif // SDFG_Utils_NameGenerator_H
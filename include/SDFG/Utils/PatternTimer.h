@@ -0,0 +1,41 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for the conversion pattern timing utility.
+
+#ifndef SDFG_Utils_PatternTimer_H
+#define SDFG_Utils_PatternTimer_H
+
+#include "mlir/Transforms/DialectConversion.h"
+#include "llvm/ADT/StringMap.h"
+
+namespace mlir::sdfg::utils {
+
+/// Accumulates the time spent in and the number of applications of conversion
+/// patterns, keyed by the name of the pattern.
+class PatternTimer {
+public:
+  /// Wraps every pattern of the set, which must only contain conversion
+  /// patterns, such that its applications are recorded by this timer. The
+  /// timer must outlive the patterns.
+  void instrument(RewritePatternSet &patterns);
+  /// Records a single application of the pattern with the provided name.
+  void record(StringRef name, double seconds, bool rewritten);
+  /// Prints the recorded applications, the slowest pattern first.
+  void print(raw_ostream &os, StringRef title) const;
+
+private:
+  struct Record {
+    /// The wall time spent in the pattern
+    double seconds = 0;
+    /// The number of times the pattern was applied
+    unsigned attempts = 0;
+    /// The number of times the pattern succeeded
+    unsigned rewrites = 0;
+  };
+
+  llvm::StringMap<Record> records;
+};
+
+} // namespace mlir::sdfg::utils
+
+#endif // SDFG_Utils_PatternTimer_H
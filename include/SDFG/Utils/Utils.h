@@ -6,6 +6,7 @@
 #define SDFG_Utils_H
 
 #include "AttributeToString.h"
+#include "CollectAccesses.h"
 #include "GetParents.h"
 #include "GetSizedType.h"
 #include "IDGenerator.h"
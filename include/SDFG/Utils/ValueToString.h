@@ -6,6 +6,7 @@
 #define SDFG_Utils_ValueToString_H
 
 #include "mlir/IR/Value.h"
+#include <memory>
 #include <string>
 
 namespace mlir::sdfg::utils {
@@ -15,6 +16,31 @@ std::string valueToString(Value value);
 /// Prints a value to a string. Optionally takes a context operation.
 std::string valueToString(Value value, Operation &op);
 
+/// Cached naming information of SDFGs.
+struct ValueNameCache;
+
+/// Enables caching of value names for its lifetime. While a scope is active,
+/// the SSA numbering of each SDFG is computed once and reused by
+/// valueToString. The IR must not be modified while a scope is active, unless
+/// the cache is invalidated afterwards. Scopes may be nested.
+class ValueNameScope {
+public:
+  ValueNameScope();
+  ~ValueNameScope();
+
+  ValueNameScope(const ValueNameScope &) = delete;
+  ValueNameScope &operator=(const ValueNameScope &) = delete;
+
+private:
+  ValueNameCache *prevCache;
+  std::unique_ptr<ValueNameCache> cache;
+};
+
+/// Drops all cached value names of the active scope.
+void invalidateValueNames();
+/// Drops the cached value names of the provided SDFG in the active scope.
+void invalidateValueNames(Operation &sdfg);
+
 } // namespace mlir::sdfg::utils
 
 #endif // SDFG_Utils_ValueToString_H
@@ -5,12 +5,17 @@
 #include "SDFG/Conversion/GenericToSDFG/PassDetail.h"
 #include "SDFG/Conversion/GenericToSDFG/Passes.h"
 #include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Utils/PatternTimer.h"
 #include "SDFG/Utils/Utils.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/AsmState.h"
 #include "mlir/IR/IRMapping.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Transforms/DialectConversion.h"
 
 using namespace mlir;
@@ -241,6 +246,313 @@ static Value getTransientValue(Value val) {
   return val;
 }
 
+/// Returns the symbolic expression of the provided loop bound if it is a
+/// constant or a symbol. The original value is checked for constants, as
+/// converted constants are only available through their transients.
+static Optional<std::string> getSymbolicBound(Value original, Value converted) {
+  if (Optional<int64_t> cst = getConstantIntValue(original))
+    return *cst < 0 ? "(" + std::to_string(*cst) + ")" : std::to_string(*cst);
+
+  if (converted.getDefiningOp() != nullptr &&
+      isa<SymOp>(converted.getDefiningOp()))
+    return cast<SymOp>(converted.getDefiningOp()).getExpr().str();
+
+  return std::nullopt;
+}
+
+namespace {
+/// The bounds of a map node under construction. Each bound is either a
+/// constant attribute or an operand, recorded in the number list of its kind
+/// (0: lower bounds, 1: upper bounds, 2: steps).
+struct MapBounds {
+  SmallVector<Value> operands;
+  SmallVector<Attribute> attrs[3];
+  SmallVector<Attribute> numLists[3];
+
+  /// Appends a constant bound of the provided kind.
+  void addAttr(Builder &builder, unsigned kind, Attribute attr) {
+    int32_t attrIdx = attrs[kind].size();
+    numLists[kind].push_back(builder.getI32IntegerAttr(-attrIdx - 1));
+    attrs[kind].push_back(attr);
+  }
+
+  /// Appends a bound of the provided kind given by an operand.
+  void addOperand(Builder &builder, unsigned kind, Value operand) {
+    numLists[kind].push_back(builder.getI32IntegerAttr(operands.size()));
+    operands.push_back(operand);
+  }
+};
+} // namespace
+
+/// Creates a map node with the provided bounds and number of parameters at the
+/// current insertion point. Leaves the insertion point in the body of the map.
+static MapNode createMap(PatternRewriter &rewriter, Location loc,
+                         MapBounds &bounds, unsigned numParams) {
+  OperationState state(loc, MapNode::getOperationName());
+  state.addAttribute("lowerBounds_numList",
+                     rewriter.getArrayAttr(bounds.numLists[0]));
+  state.addAttribute("upperBounds_numList",
+                     rewriter.getArrayAttr(bounds.numLists[1]));
+  state.addAttribute("steps_numList",
+                     rewriter.getArrayAttr(bounds.numLists[2]));
+
+  MLIRContext *ctx = rewriter.getContext();
+  MapNode::build(rewriter, state, sdfg::utils::generateID(ctx),
+                 sdfg::utils::generateID(ctx), bounds.operands,
+                 rewriter.getArrayAttr(bounds.attrs[0]),
+                 rewriter.getArrayAttr(bounds.attrs[1]),
+                 rewriter.getArrayAttr(bounds.attrs[2]));
+  MapNode mapNode = cast<MapNode>(rewriter.create(state));
+
+  SmallVector<Type> argTypes(numParams, rewriter.getIndexType());
+  SmallVector<Location> argLocs(numParams, loc);
+  rewriter.createBlock(&mapNode.getBody(), {}, argTypes, argLocs);
+  return mapNode;
+}
+
+//===----------------------------------------------------------------------===//
+// Delinearization
+//===----------------------------------------------------------------------===//
+
+/// Strips integer extensions and index casts from the value.
+static Value stripIntCasts(Value value) {
+  while (Operation *op = value.getDefiningOp()) {
+    if (!isa<arith::ExtSIOp, arith::ExtUIOp, arith::IndexCastOp,
+             mlir::LLVM::SExtOp, mlir::LLVM::ZExtOp>(op))
+      break;
+    value = op->getOperand(0);
+  }
+
+  return value;
+}
+
+/// Returns the inclusive range of the value if it can be bounded by constants.
+/// Supports constants, induction variables of loops with constant bounds and
+/// sums and differences of those.
+static Optional<std::pair<int64_t, int64_t>> getConstantRange(Value value) {
+  value = stripIntCasts(value);
+
+  if (Optional<int64_t> cst = getConstantIntValue(value))
+    return std::make_pair(*cst, *cst);
+
+  if (BlockArgument arg = value.dyn_cast<BlockArgument>()) {
+    Operation *parent = arg.getOwner()->getParentOp();
+    Value lowerBound, upperBound, step;
+
+    if (scf::ForOp forOp = dyn_cast_or_null<scf::ForOp>(parent)) {
+      if (arg != forOp.getInductionVar())
+        return std::nullopt;
+
+      lowerBound = forOp.getLowerBound();
+      upperBound = forOp.getUpperBound();
+      step = forOp.getStep();
+    } else if (scf::ParallelOp parallelOp =
+                   dyn_cast_or_null<scf::ParallelOp>(parent)) {
+      unsigned dim = arg.getArgNumber();
+      lowerBound = parallelOp.getLowerBound()[dim];
+      upperBound = parallelOp.getUpperBound()[dim];
+      step = parallelOp.getStep()[dim];
+    } else {
+      return std::nullopt;
+    }
+
+    Optional<int64_t> lb = getConstantIntValue(lowerBound);
+    Optional<int64_t> ub = getConstantIntValue(upperBound);
+    Optional<int64_t> st = getConstantIntValue(step);
+    if (!lb || !ub || !st || *st <= 0 || *ub <= *lb)
+      return std::nullopt;
+
+    return std::make_pair(*lb, *ub - 1);
+  }
+
+  Operation *op = value.getDefiningOp();
+  if (!op || !isa<arith::AddIOp, arith::SubIOp, mlir::LLVM::AddOp,
+                  mlir::LLVM::SubOp>(op))
+    return std::nullopt;
+
+  Optional<std::pair<int64_t, int64_t>> lhs =
+      getConstantRange(op->getOperand(0));
+  Optional<std::pair<int64_t, int64_t>> rhs =
+      getConstantRange(op->getOperand(1));
+  if (!lhs || !rhs)
+    return std::nullopt;
+
+  if (isa<arith::AddIOp, mlir::LLVM::AddOp>(op))
+    return std::make_pair(lhs->first + rhs->first, lhs->second + rhs->second);
+
+  return std::make_pair(lhs->first - rhs->second, lhs->second - rhs->first);
+}
+
+/// Delinearizes a linearized index of the form ((i0 * C1 + i1) * C2 + ...) + in
+/// into the operands holding the indices i0, ..., in and the constant extents
+/// C1, ..., Cn of the inner dimensions. An inner index is only split off if it
+/// provably stays within its extent, so that shifted stencil accesses such as
+/// i * C + j + 1 stay linear.
+static void delinearizeIndex(OpOperand &index,
+                             SmallVector<OpOperand *> &indices,
+                             SmallVector<int64_t> &extents) {
+  Operation *add = stripIntCasts(index.get()).getDefiningOp();
+
+  if (add && isa<arith::AddIOp, mlir::LLVM::AddOp>(add)) {
+    for (unsigned i = 0; i < 2; ++i) {
+      Operation *mul = stripIntCasts(add->getOperand(i)).getDefiningOp();
+      if (!mul || !isa<arith::MulIOp, mlir::LLVM::MulOp>(mul))
+        continue;
+
+      OpOperand &inner = add->getOpOperand(1 - i);
+      Optional<std::pair<int64_t, int64_t>> range =
+          getConstantRange(inner.get());
+
+      for (unsigned j = 0; j < 2; ++j) {
+        Optional<int64_t> extent = getConstantIntValue(mul->getOperand(j));
+        if (!extent.has_value() || extent.value() <= 1)
+          continue;
+
+        if (!range || range->first < 0 || range->second >= extent.value())
+          continue;
+
+        delinearizeIndex(mul->getOpOperand(1 - j), indices, extents);
+        extents.push_back(extent.value());
+        indices.push_back(&inner);
+        return;
+      }
+    }
+  }
+
+  indices.push_back(&index);
+}
+
+namespace {
+/// Accesses flat arrays with linearized indices through multi-dimensional
+/// views, so that the memlets stay analysable. The indices are analysed before
+/// the conversion, as the loops bounding them are gone once they are converted.
+class Delinearizer {
+public:
+  /// Collects the delinearizable accesses in the module.
+  void analyze(ModuleOp module) {
+    module.walk([&](Operation *op) {
+      OpOperand *index = nullptr;
+
+      if (mlir::LLVM::GEPOp gep = dyn_cast<mlir::LLVM::GEPOp>(op)) {
+        if (gep.getDynamicIndices().size() == 1 &&
+            gep.getRawConstantIndices().size() == 1)
+          index = &gep->getOpOperand(1);
+      } else if (memref::LoadOp load = dyn_cast<memref::LoadOp>(op)) {
+        if (load.getIndices().size() == 1)
+          index = &load->getOpOperand(1);
+      } else if (memref::StoreOp store = dyn_cast<memref::StoreOp>(op)) {
+        if (store.getIndices().size() == 1)
+          index = &store->getOpOperand(2);
+      }
+
+      if (!index)
+        return;
+
+      Access access;
+      delinearizeIndex(*index, access.indices, access.extents);
+      if (!access.extents.empty())
+        accesses[op] = access;
+    });
+  }
+
+  /// Rewrites a delinearized access to the provided flat array. Replaces the
+  /// array with its view and the index with the converted indices of the view.
+  /// Fails if the access stays linear.
+  LogicalResult rewrite(ConversionPatternRewriter &rewriter, Operation *op,
+                        Value &array, SmallVector<Value> &indices) {
+    auto it = accesses.find(op);
+    ArrayType arrayType = array.getType().dyn_cast<ArrayType>();
+    if (it == accesses.end() || !arrayType ||
+        sdfg::utils::getSizedType(arrayType).getShape().size() != 1)
+      return failure();
+
+    SmallVector<Value> dimIndices;
+    for (OpOperand *index : it->second.indices) {
+      Value dimIndex = rewriter.getRemappedValue(index->get());
+      // Intermediate values fused into tasklets are not available
+      if (!dimIndex)
+        return failure();
+      dimIndices.push_back(dimIndex);
+    }
+
+    Value view = getView(rewriter, op, array, it->second.extents);
+    if (!view)
+      return failure();
+
+    array = view;
+    indices = dimIndices;
+    return success();
+  }
+
+private:
+  struct Access {
+    SmallVector<OpOperand *> indices;
+    SmallVector<int64_t> extents;
+  };
+
+  /// Returns the view of the array with the provided inner extents. Views are
+  /// shared between all accesses with the same extents and placed right after
+  /// the array is defined.
+  Value getView(ConversionPatternRewriter &rewriter, Operation *op, Value array,
+                ArrayRef<int64_t> extents) {
+    for (std::pair<SmallVector<int64_t>, Value> &view : views[array])
+      if (ArrayRef<int64_t>(view.first) == extents)
+        return view.second;
+
+    Block *body = &getParentSDFG(op)->getRegion(0).front();
+    OpBuilder::InsertionGuard guard(rewriter);
+
+    if (BlockArgument arg = array.dyn_cast<BlockArgument>()) {
+      if (arg.getOwner() != body)
+        return nullptr;
+      rewriter.setInsertionPointToStart(body);
+    } else {
+      if (array.getDefiningOp()->getBlock() != body)
+        return nullptr;
+      rewriter.setInsertionPointAfterValue(array);
+    }
+
+    // The outer dimension is derived from the size of the flat array: static
+    // sizes are divided by the inner extents, symbolic sizes reuse the symbol
+    // of the flat array as an upper bound.
+    MLIRContext *ctx = rewriter.getContext();
+    SizedType flat = sdfg::utils::getSizedType(array.getType());
+    SmallVector<StringAttr> symbols;
+    SmallVector<int64_t> integers;
+    SmallVector<bool> shape = {flat.getShape()[0]};
+
+    if (flat.getShape()[0]) {
+      int64_t size = flat.getIntegers()[0];
+      int64_t inner = 1;
+      for (int64_t extent : extents)
+        inner *= extent;
+
+      // Operand-sized and ragged arrays stay linear
+      if (size < 0 || size % inner != 0)
+        return nullptr;
+
+      integers.push_back(size / inner);
+    } else {
+      symbols.push_back(flat.getSymbols()[0]);
+    }
+
+    integers.append(extents.begin(), extents.end());
+    shape.append(extents.size(), true);
+
+    SizedType sized = SizedType::get(ctx, flat.getElementType(), symbols,
+                                     integers, shape);
+
+    Value view = ViewCastOp::create(rewriter, op->getLoc(), array,
+                                    ArrayType::get(ctx, sized));
+    views[array].push_back({llvm::to_vector(extents), view});
+    return view;
+  }
+
+  DenseMap<Operation *, Access> accesses;
+  DenseMap<Value, SmallVector<std::pair<SmallVector<int64_t>, Value>>> views;
+};
+} // namespace
+
 //===----------------------------------------------------------------------===//
 // Func Patterns
 //===----------------------------------------------------------------------===//
@@ -526,10 +838,75 @@ public:
 // TODO: Implement func.constant conversion
 
 //===----------------------------------------------------------------------===//
-// Arith & Math Patterns
+// Arith, Math & Vector Patterns
 //===----------------------------------------------------------------------===//
 
-/// Wraps any arith and math operation into a tasklet.
+/// Returns true if the operation belongs to the arith or math dialect or is a
+/// vector operation without memory effects, such as a broadcast or reduction.
+static bool isArithMathOrVector(Operation &op) {
+  StringRef dialect = op.getDialect()->getNamespace();
+
+  if (dialect == vector::VectorDialect::getDialectNamespace())
+    return isMemoryEffectFree(&op);
+
+  return dialect == arith::ArithDialect::getDialectNamespace() ||
+         dialect == math::MathDialect::getDialectNamespace();
+}
+
+/// Collects the values defined outside of the provided sequence of operations
+/// as inputs and the results used outside of the sequence (or not used at all)
+/// as outputs.
+static void collectFusedValues(ArrayRef<Operation *> fused,
+                               SmallVectorImpl<Value> &inputs,
+                               SmallVectorImpl<Value> &outputs) {
+  llvm::SmallPtrSet<Operation *, 8> fusedSet(fused.begin(), fused.end());
+  auto isFused = [&](Operation *user) { return fusedSet.contains(user); };
+
+  for (Operation *fusedOp : fused) {
+    for (Value operand : fusedOp->getOperands())
+      if (!fusedSet.contains(operand.getDefiningOp()) &&
+          !llvm::is_contained(inputs, operand))
+        inputs.push_back(operand);
+
+    for (Value result : fusedOp->getResults())
+      if (result.use_empty() || !llvm::all_of(result.getUsers(), isFused))
+        outputs.push_back(result);
+  }
+}
+
+/// Creates a tasklet with the provided operands computing the provided
+/// sequence of operations. The inputs become the tasklet arguments and the
+/// outputs the tasklet results. Leaves the insertion point after the tasklet.
+static TaskletNode createFusedTasklet(PatternRewriter &rewriter, Location loc,
+                                      ArrayRef<Operation *> fused,
+                                      ArrayRef<Value> inputs,
+                                      ArrayRef<Value> outputs,
+                                      ValueRange operands) {
+  SmallVector<Type> resultTypes;
+  for (Value output : outputs)
+    resultTypes.push_back(output.getType());
+
+  TaskletNode task = TaskletNode::create(rewriter, loc, operands, resultTypes);
+
+  IRMapping mapping;
+  mapping.map(inputs, task.getBody().getArguments());
+
+  rewriter.updateRootInPlace(task, [&] {
+    for (Operation *fusedOp : fused)
+      task.getBody().getBlocks().front().push_back(fusedOp->clone(mapping));
+  });
+
+  SmallVector<Value> returnValues;
+  for (Value output : outputs)
+    returnValues.push_back(mapping.lookup(output));
+
+  sdfg::ReturnOp::create(rewriter, loc, returnValues);
+  rewriter.setInsertionPointAfter(task);
+  return task;
+}
+
+/// Wraps the maximal straight-line sequence of arith and math operations
+/// starting at the matched operation into a single tasklet.
 class OpToTasklet : public ConversionPattern {
 public:
   OpToTasklet(TypeConverter &converter, MLIRContext *context)
@@ -538,79 +915,90 @@ public:
   LogicalResult
   matchAndRewrite(Operation *op, ArrayRef<Value> operands,
                   ConversionPatternRewriter &rewriter) const override {
-    if (op->getDialect()->getNamespace() ==
-            arith::ArithDialect::getDialectNamespace() ||
-        op->getDialect()->getNamespace() ==
-            math::MathDialect::getDialectNamespace()) {
-
-      if (isa<TaskletNode>(op->getParentOp()))
-        return failure(); // Operation already in a
-                          // tasklet
-
-      std::string name = sdfg::utils::operationToString(*op);
-      StateNode state = StateNode::create(rewriter, op->getLoc(), name);
-
-      Operation *sdfg = getParentSDFG(state);
-      OpBuilder::InsertPoint ip = rewriter.saveInsertionPoint();
-      rewriter.setInsertionPointToStart(
-          &sdfg->getRegion(0).getBlocks().front());
-
-      SmallVector<AllocOp> allocs;
-
-      for (Type opType : op->getResultTypes()) {
-        ToArrayConverter tac;
-        Type newType = tac.convertType(opType);
-        SizedType sizedType =
-            SizedType::get(op->getLoc().getContext(), newType, {}, {}, {});
-        newType = ArrayType::get(op->getLoc().getContext(), sizedType);
-        AllocOp alloc = AllocOp::create(rewriter, op->getLoc(), newType,
-                                        "_" + name + "_tmp",
-                                        /*transient=*/true);
-        allocs.push_back(alloc);
-      }
+    if (!isArithMathOrVector(*op))
+      return failure();
 
-      rewriter.restoreInsertionPoint(ip);
+    if (isa<TaskletNode>(op->getParentOp()))
+      return failure(); // Operation already in a
+                        // tasklet
+
+    // Collect the sequence. It ends after an operation marked to be linked to
+    // the next state.
+    SmallVector<Operation *> fused = {op};
+    for (Operation *next = op->getNextNode();
+         next && isArithMathOrVector(*next) && !markedToLink(*fused.back());
+         next = next->getNextNode())
+      fused.push_back(next);
+
+    // Values defined outside of the sequence become tasklet operands. Results
+    // used outside of the sequence (or not used at all) become tasklet
+    // results.
+    SmallVector<Value> inputs;
+    SmallVector<Value> outputs;
+    collectFusedValues(fused, inputs, outputs);
 
-      SmallVector<Value> loadedOps =
-          createLoads(rewriter, op->getLoc(), operands);
+    std::string name = sdfg::utils::operationToString(*op);
+    StateNode state = StateNode::create(rewriter, op->getLoc(), name);
 
-      TaskletNode task = TaskletNode::create(rewriter, op->getLoc(), loadedOps,
-                                             op->getResultTypes());
+    Operation *sdfg = getParentSDFG(state);
+    OpBuilder::InsertPoint ip = rewriter.saveInsertionPoint();
+    rewriter.setInsertionPointToStart(&sdfg->getRegion(0).getBlocks().front());
 
-      IRMapping mapping;
-      mapping.map(op->getOperands(), task.getBody().getArguments());
+    SmallVector<AllocOp> allocs;
 
-      Operation *opClone = op->clone(mapping);
-      rewriter.updateRootInPlace(task, [&] {
-        task.getBody().getBlocks().front().push_front(opClone);
-      });
+    for (Value output : outputs) {
+      ToArrayConverter tac;
+      Type newType = tac.convertType(output.getType());
+      SizedType sizedType =
+          SizedType::get(op->getLoc().getContext(), newType, {}, {}, {});
+      newType = ArrayType::get(op->getLoc().getContext(), sizedType);
+      std::string outputName =
+          sdfg::utils::operationToString(*output.getDefiningOp());
+      AllocOp alloc =
+          AllocOp::create(rewriter, op->getLoc(), newType,
+                          "_" + outputName + "_tmp", /*transient=*/true);
+      allocs.push_back(alloc);
+    }
 
-      sdfg::ReturnOp::create(rewriter, opClone->getLoc(),
-                             opClone->getResults());
+    rewriter.restoreInsertionPoint(ip);
 
-      rewriter.setInsertionPointAfter(task);
+    SmallVector<Value> remappedInputs;
+    for (Value input : inputs) {
+      Value remapped = rewriter.getRemappedValue(input);
+      remappedInputs.push_back(remapped ? remapped : input);
+    }
 
-      SmallVector<Value> loads;
+    SmallVector<Value> loadedOps =
+        createLoads(rewriter, op->getLoc(), remappedInputs);
 
-      for (AllocOp alloc : allocs) {
-        StoreOp::create(rewriter, op->getLoc(), task.getResult(0), alloc,
-                        ValueRange());
+    TaskletNode task = createFusedTasklet(rewriter, op->getLoc(), fused,
+                                          inputs, outputs, loadedOps);
 
-        LoadOp load =
-            LoadOp::create(rewriter, op->getLoc(), alloc, ValueRange());
-        loads.push_back(load);
-      }
+    IRMapping loads;
 
-      rewriter.replaceOp(op, loads);
+    for (unsigned i = 0; i < allocs.size(); ++i) {
+      StoreOp::create(rewriter, op->getLoc(), task.getResult(i), allocs[i],
+                      ValueRange());
 
-      linkToLastState(rewriter, op->getLoc(), state);
-      if (markedToLink(*op))
-        linkToNextState(rewriter, op->getLoc(), state);
+      LoadOp load =
+          LoadOp::create(rewriter, op->getLoc(), allocs[i], ValueRange());
+      loads.map(outputs[i], load);
+    }
 
-      return success();
+    // Results only used inside of the sequence have no replacement, as all
+    // their users are replaced as well.
+    for (Operation *fusedOp : llvm::reverse(fused)) {
+      SmallVector<Value> replacements;
+      for (Value result : fusedOp->getResults())
+        replacements.push_back(loads.lookupOrNull(result));
+      rewriter.replaceOp(fusedOp, replacements);
     }
 
-    return failure();
+    linkToLastState(rewriter, op->getLoc(), state);
+    if (markedToLink(*fused.back()))
+      linkToNextState(rewriter, op->getLoc(), state);
+
+    return success();
   }
 };
 
@@ -621,7 +1009,10 @@ public:
 /// Converts a memref::LoadOp to a sdfg::LoadOp.
 class MemrefLoadToSDFG : public OpConversionPattern<memref::LoadOp> {
 public:
-  using OpConversionPattern<memref::LoadOp>::OpConversionPattern;
+  MemrefLoadToSDFG(TypeConverter &converter, MLIRContext *ctxt,
+                   Delinearizer &delinearizer)
+      : OpConversionPattern<memref::LoadOp>(converter, ctxt),
+        delinearizer(delinearizer) {}
 
   LogicalResult
   matchAndRewrite(memref::LoadOp op, OpAdaptor adaptor,
@@ -643,6 +1034,7 @@ public:
     Value memref = createLoad(rewriter, op.getLoc(), adaptor.getMemref());
 
     SmallVector<Value> indices = adaptor.getIndices();
+    (void)delinearizer.rewrite(rewriter, op, memref, indices);
     indices = createLoads(rewriter, op.getLoc(), indices);
 
     LoadOp load = LoadOp::create(rewriter, op.getLoc(), type, memref, indices);
@@ -658,12 +1050,18 @@ public:
     rewriter.replaceOp(op, {newLoad});
     return success();
   }
+
+private:
+  Delinearizer &delinearizer;
 };
 
 /// Converts a memref::StoreOp to a sdfg::StoreOp.
 class MemrefStoreToSDFG : public OpConversionPattern<memref::StoreOp> {
 public:
-  using OpConversionPattern<memref::StoreOp>::OpConversionPattern;
+  MemrefStoreToSDFG(TypeConverter &converter, MLIRContext *ctxt,
+                    Delinearizer &delinearizer)
+      : OpConversionPattern<memref::StoreOp>(converter, ctxt),
+        delinearizer(delinearizer) {}
 
   LogicalResult
   matchAndRewrite(memref::StoreOp op, OpAdaptor adaptor,
@@ -674,6 +1072,7 @@ public:
     Value memref = createLoad(rewriter, op.getLoc(), adaptor.getMemref());
 
     SmallVector<Value> indices = adaptor.getIndices();
+    (void)delinearizer.rewrite(rewriter, op, memref, indices);
     indices = createLoads(rewriter, op.getLoc(), indices);
 
     StoreOp::create(rewriter, op.getLoc(), val, memref, indices);
@@ -685,6 +1084,9 @@ public:
     rewriter.eraseOp(op);
     return success();
   }
+
+private:
+  Delinearizer &delinearizer;
 };
 
 /// Converts a memref::CopyOp to a sdfg::CopyOp.
@@ -1008,63 +1410,45 @@ public:
     ArrayAttr emptyArr = rewriter.getStrArrayAttr({});
     StringAttr emptyStr = rewriter.getStringAttr("1");
 
+    // Constant and symbolic bounds are written into the edges, which keeps
+    // the loop in the canonical shape DaCe detects as a for-loop. Other bounds
+    // are referenced through their transients.
+    Optional<std::string> lowerBound =
+        getSymbolicBound(op.getLowerBound(), adaptor.getLowerBound());
+    Optional<std::string> upperBound =
+        getSymbolicBound(op.getUpperBound(), adaptor.getUpperBound());
+    Optional<std::string> step =
+        getSymbolicBound(op.getStep(), adaptor.getStep());
+
+    Value lowerBoundRef =
+        lowerBound ? Value() : getTransientValue(adaptor.getLowerBound());
+    Value upperBoundRef =
+        upperBound ? Value() : getTransientValue(adaptor.getUpperBound());
+    Value stepRef = step ? Value() : getTransientValue(adaptor.getStep());
+
+    std::string condition = idxName + " < " + upperBound.value_or("ref");
+
     // Init -> Guard
-    if (adaptor.getLowerBound().getDefiningOp() != nullptr &&
-        isa<SymOp>(adaptor.getLowerBound().getDefiningOp())) {
-      SymOp symOp = cast<SymOp>(adaptor.getLowerBound().getDefiningOp());
-      std::string assignment = idxName + ": " + symOp.getExpr().str();
-      ArrayAttr initArr = rewriter.getStrArrayAttr({assignment});
-      EdgeOp::create(rewriter, op.getLoc(), init, guard, initArr, emptyStr,
-                     nullptr);
-    } else {
-      ArrayAttr initArr = rewriter.getStrArrayAttr({idxName + ": ref"});
-      EdgeOp::create(rewriter, op.getLoc(), init, guard, initArr, emptyStr,
-                     getTransientValue(adaptor.getLowerBound()));
-    }
+    ArrayAttr initArr =
+        rewriter.getStrArrayAttr({idxName + ": " + lowerBound.value_or("ref")});
+    EdgeOp::create(rewriter, op.getLoc(), init, guard, initArr, emptyStr,
+                   lowerBoundRef);
 
     // Guard -> Body
-    if (adaptor.getUpperBound().getDefiningOp() != nullptr &&
-        isa<SymOp>(adaptor.getUpperBound().getDefiningOp())) {
-      SymOp symOp = cast<SymOp>(adaptor.getUpperBound().getDefiningOp());
-      StringAttr guardStr =
-          rewriter.getStringAttr(idxName + " < " + symOp.getExpr());
-      EdgeOp::create(rewriter, op.getLoc(), guard, body, emptyArr, guardStr,
-                     nullptr);
-    } else {
-      StringAttr guardStr = rewriter.getStringAttr(idxName + " < ref");
-      EdgeOp::create(rewriter, op.getLoc(), guard, body, emptyArr, guardStr,
-                     getTransientValue(adaptor.getUpperBound()));
-    }
+    StringAttr guardStr = rewriter.getStringAttr(condition);
+    EdgeOp::create(rewriter, op.getLoc(), guard, body, emptyArr, guardStr,
+                   upperBoundRef);
 
     // Return -> Guard
-    if (adaptor.getStep().getDefiningOp() != nullptr &&
-        isa<SymOp>(adaptor.getStep().getDefiningOp())) {
-      SymOp symOp = cast<SymOp>(adaptor.getStep().getDefiningOp());
-      std::string assignment =
-          idxName + ": " + idxName + " + " + symOp.getExpr().str();
-      ArrayAttr returnArr = rewriter.getStrArrayAttr({assignment});
-      EdgeOp::create(rewriter, op.getLoc(), returnState, guard, returnArr,
-                     emptyStr, nullptr);
-    } else {
-      ArrayAttr returnArr =
-          rewriter.getStrArrayAttr({idxName + ": " + idxName + " + ref"});
-      EdgeOp::create(rewriter, op.getLoc(), returnState, guard, returnArr,
-                     emptyStr, getTransientValue(adaptor.getStep()));
-    }
+    ArrayAttr returnArr = rewriter.getStrArrayAttr(
+        {idxName + ": " + idxName + " + " + step.value_or("ref")});
+    EdgeOp::create(rewriter, op.getLoc(), returnState, guard, returnArr,
+                   emptyStr, stepRef);
 
     // Guard -> Exit
-    if (adaptor.getUpperBound().getDefiningOp() != nullptr &&
-        isa<SymOp>(adaptor.getUpperBound().getDefiningOp())) {
-      SymOp symOp = cast<SymOp>(adaptor.getUpperBound().getDefiningOp());
-      StringAttr exitStr = rewriter.getStringAttr("not(" + idxName + " < " +
-                                                  symOp.getExpr() + ")");
-      EdgeOp::create(rewriter, op.getLoc(), guard, exitState, emptyArr, exitStr,
-                     nullptr);
-    } else {
-      StringAttr exitStr = rewriter.getStringAttr("not(" + idxName + " < ref)");
-      EdgeOp::create(rewriter, op.getLoc(), guard, exitState, emptyArr, exitStr,
-                     getTransientValue(adaptor.getUpperBound()));
-    }
+    StringAttr exitStr = rewriter.getStringAttr("not(" + condition + ")");
+    EdgeOp::create(rewriter, op.getLoc(), guard, exitState, emptyArr, exitStr,
+                   upperBoundRef);
 
     if (markedToLink(*op))
       linkToNextState(rewriter, op->getLoc(), exitState);
@@ -1074,6 +1458,227 @@ public:
   }
 };
 
+/// Returns true if the parallel loop nest can be converted to a map nest. The
+/// bodies may only contain arith and math operations, nested parallel loops
+/// with constant bounds, and loads and stores indexed by induction variables.
+/// Reductions are not supported.
+static bool isMappable(scf::ParallelOp op, llvm::DenseSet<Value> &ivs) {
+  if (op.getNumResults() > 0)
+    return false;
+
+  for (Value iv : op.getInductionVars())
+    ivs.insert(iv);
+
+  auto isIV = [&](Value v) { return ivs.contains(v); };
+
+  for (Operation &nested : op.getBody()->without_terminator()) {
+    if (scf::ParallelOp inner = dyn_cast<scf::ParallelOp>(nested)) {
+      for (Value bound : inner.getOperands())
+        if (!getConstantIntValue(bound).has_value())
+          return false;
+
+      if (!isMappable(inner, ivs))
+        return false;
+      continue;
+    }
+
+    if (memref::LoadOp load = dyn_cast<memref::LoadOp>(nested)) {
+      if (!llvm::all_of(load.getIndices(), isIV))
+        return false;
+      continue;
+    }
+
+    if (memref::StoreOp store = dyn_cast<memref::StoreOp>(nested)) {
+      if (!llvm::all_of(store.getIndices(), isIV))
+        return false;
+      continue;
+    }
+
+    if (!isArithMathOrVector(nested) || nested.getNumRegions() > 0)
+      return false;
+  }
+
+  return true;
+}
+
+/// Converts scf::ParallelOp nests to map nests inside of a single state.
+class SCFParallelToSDFG : public OpConversionPattern<scf::ParallelOp> {
+public:
+  using OpConversionPattern<scf::ParallelOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(scf::ParallelOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    llvm::DenseSet<Value> ivs;
+    if (!isMappable(op, ivs))
+      return failure();
+
+    StateNode state = StateNode::create(rewriter, op.getLoc(), "parallel");
+
+    IRMapping mapping;
+    createMap(rewriter, op, adaptor.getLowerBound(), adaptor.getUpperBound(),
+              adaptor.getStep(), mapping);
+    convertBody(rewriter, op, mapping);
+
+    rewriter.setInsertionPointAfter(state);
+    linkToLastState(rewriter, op.getLoc(), state);
+    if (markedToLink(*op))
+      linkToNextState(rewriter, op.getLoc(), state);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  /// Returns the value to use for the provided value inside of the map nest.
+  /// Values defined outside of the nest are loaded inside of it.
+  Value lookup(ConversionPatternRewriter &rewriter, Location loc,
+               IRMapping &mapping, Value val) const {
+    if (mapping.contains(val))
+      return mapping.lookup(val);
+
+    Value remapped = rewriter.getRemappedValue(val);
+    return createLoad(rewriter, loc, remapped ? remapped : val);
+  }
+
+  /// Creates a map node with the bounds of the parallel loop at the current
+  /// insertion point and maps the induction variables to the map parameters.
+  /// Leaves the insertion point in the body of the map.
+  MapNode createMap(ConversionPatternRewriter &rewriter, scf::ParallelOp op,
+                    ValueRange lowerBounds, ValueRange upperBounds,
+                    ValueRange steps, IRMapping &mapping) const {
+    Location loc = op.getLoc();
+    MapBounds mapBounds;
+
+    for (unsigned i = 0; i < op.getNumLoops(); ++i) {
+      Value bounds[3] = {lowerBounds[i], upperBounds[i], steps[i]};
+      Value original[3] = {op.getLowerBound()[i], op.getUpperBound()[i],
+                           op.getStep()[i]};
+
+      for (unsigned b = 0; b < 3; ++b) {
+        // Map upper bounds are inclusive.
+        int64_t offset = b == 1 ? -1 : 0;
+
+        if (auto cst = getConstantIntValue(original[b])) {
+          mapBounds.addAttr(rewriter, b, rewriter.getIndexAttr(*cst + offset));
+          continue;
+        }
+
+        Value bound = createLoad(rewriter, loc, bounds[b]);
+        if (offset != 0)
+          bound = createOffset(rewriter, loc, bound, offset);
+
+        mapBounds.addOperand(rewriter, b, bound);
+      }
+    }
+
+    MapNode mapNode = ::createMap(rewriter, loc, mapBounds, op.getNumLoops());
+    mapping.map(op.getInductionVars(), mapNode.getBody().getArguments());
+    return mapNode;
+  }
+
+  /// Creates a tasklet adding the provided constant to the provided index.
+  Value createOffset(ConversionPatternRewriter &rewriter, Location loc,
+                     Value val, int64_t offset) const {
+    SmallVector<Value> operands = {val};
+    SmallVector<Type> resultTypes = {rewriter.getIndexType()};
+    TaskletNode task =
+        TaskletNode::create(rewriter, loc, operands, resultTypes);
+
+    OpBuilder builder(rewriter.getContext());
+    Block &body = task.getBody().front();
+    Value result;
+    rewriter.updateRootInPlace(task, [&] {
+      builder.setInsertionPointToEnd(&body);
+      Value cst = builder.create<arith::ConstantIndexOp>(loc, offset);
+      result = builder.create<arith::AddIOp>(loc, body.getArgument(0), cst);
+    });
+
+    sdfg::ReturnOp::create(rewriter, loc, result);
+    rewriter.setInsertionPointAfter(task);
+    return task.getResult(0);
+  }
+
+  /// Converts the body of the parallel loop into the current map body.
+  void convertBody(ConversionPatternRewriter &rewriter, scf::ParallelOp op,
+                   IRMapping &mapping) const {
+    Block *mapBody = rewriter.getInsertionBlock();
+    SmallVector<Operation *> ops;
+    for (Operation &nested : op.getBody()->without_terminator())
+      ops.push_back(&nested);
+
+    for (unsigned i = 0; i < ops.size(); ++i) {
+      Operation *nested = ops[i];
+      Location loc = nested->getLoc();
+      rewriter.setInsertionPointToEnd(mapBody);
+
+      if (scf::ParallelOp inner = dyn_cast<scf::ParallelOp>(nested)) {
+        createMap(rewriter, inner, inner.getLowerBound(),
+                  inner.getUpperBound(), inner.getStep(), mapping);
+        convertBody(rewriter, inner, mapping);
+        continue;
+      }
+
+      if (memref::LoadOp load = dyn_cast<memref::LoadOp>(nested)) {
+        Type type = getTypeConverter()->convertType(load.getType());
+        Value memref = lookup(rewriter, loc, mapping, load.getMemref());
+        SmallVector<Value> indices;
+        for (Value index : load.getIndices())
+          indices.push_back(mapping.lookup(index));
+
+        LoadOp newLoad = LoadOp::create(rewriter, loc, type, memref, indices);
+        mapping.map(load.getResult(), newLoad);
+        continue;
+      }
+
+      if (memref::StoreOp store = dyn_cast<memref::StoreOp>(nested)) {
+        Value val = lookup(rewriter, loc, mapping, store.getValue());
+        Value memref = lookup(rewriter, loc, mapping, store.getMemref());
+        SmallVector<Value> indices;
+        for (Value index : store.getIndices())
+          indices.push_back(mapping.lookup(index));
+
+        StoreOp::create(rewriter, loc, val, memref, indices);
+        continue;
+      }
+
+      // Constants only used as bounds of nested loops are folded into the
+      // maps.
+      if (isa<arith::ConstantOp>(nested) &&
+          llvm::all_of(nested->getUsers(), [](Operation *user) {
+            return isa<scf::ParallelOp>(user);
+          }))
+        continue;
+
+      // Fuse the straight-line sequence of arith and math operations into a
+      // single tasklet.
+      SmallVector<Operation *> fused = {nested};
+      while (i + 1 < ops.size() && isArithMathOrVector(*ops[i + 1]))
+        fused.push_back(ops[++i]);
+
+      createTasklet(rewriter, fused, mapping);
+    }
+  }
+
+  /// Wraps the provided sequence of arith and math operations into a tasklet
+  /// and maps their results to the results of the tasklet.
+  void createTasklet(ConversionPatternRewriter &rewriter,
+                     ArrayRef<Operation *> fused, IRMapping &mapping) const {
+    Location loc = fused.front()->getLoc();
+    SmallVector<Value> inputs;
+    SmallVector<Value> outputs;
+    collectFusedValues(fused, inputs, outputs);
+
+    SmallVector<Value> operands;
+    for (Value input : inputs)
+      operands.push_back(lookup(rewriter, loc, mapping, input));
+
+    TaskletNode task =
+        createFusedTasklet(rewriter, loc, fused, inputs, outputs, operands);
+    mapping.map(outputs, task.getResults());
+  }
+};
+
 /// Converts a scf::WhileOp to multiple states, modeling a while loop with
 /// assignment and conditional edges.
 class SCFWhileToSDFG : public OpConversionPattern<scf::WhileOp> {
@@ -1423,9 +2028,226 @@ public:
 // TODO: Implement scf.execute_region conversion
 // TODO: Implement scf.foreach_thread conversion
 // TODO: Implement scf.index_switch conversion
-// TODO: Implement scf.parallel conversion
 // TODO: Implement scf.reduce conversion
 
+//===----------------------------------------------------------------------===//
+// Linalg Patterns
+//===----------------------------------------------------------------------===//
+
+/// Returns the operation combining the input and the output in the body of the
+/// provided reduction if it is a sum or a product, which DaCe provides a
+/// reduction library node for. Returns nullptr otherwise.
+static Operation *getReduceCombiner(linalg::ReduceOp op) {
+  if (op.getInputs().size() != 1)
+    return nullptr;
+
+  Block &body = op.getCombiner().front();
+  if (body.getOperations().size() != 2)
+    return nullptr;
+
+  Operation &combiner = body.front();
+  if (!isa<arith::AddFOp, arith::AddIOp, arith::MulFOp, arith::MulIOp>(
+          combiner))
+    return nullptr;
+
+  // The combiners are commutative, so the arguments may appear in any order.
+  if (combiner.getOperand(0) == combiner.getOperand(1) ||
+      !llvm::all_of(combiner.getOperands(), [&](Value operand) {
+        return operand.getParentBlock() == &body &&
+               operand.isa<BlockArgument>();
+      }))
+    return nullptr;
+
+  if (body.getTerminator()->getOperand(0) != combiner.getResult(0))
+    return nullptr;
+
+  return &combiner;
+}
+
+/// Returns true if the provided linalg operation is converted to a library
+/// call.
+bool conversion::isLibraryOp(Operation *op) {
+  if (linalg::ReduceOp reduce = dyn_cast<linalg::ReduceOp>(op))
+    return getReduceCombiner(reduce) != nullptr;
+
+  return isa<linalg::MatmulOp, linalg::BatchMatmulOp, linalg::DotOp,
+             linalg::MatvecOp>(op);
+}
+
+/// Collects the bounds of a map ranging over the provided array with unit
+/// steps. Upper bounds are inclusive. Returns failure for dimensions of unknown
+/// size.
+static LogicalResult getMapBounds(PatternRewriter &rewriter, ArrayType type,
+                                  MapBounds &bounds) {
+  SizedType sized = type.getDimensions();
+  unsigned symIdx = 0;
+  unsigned intIdx = 0;
+
+  for (bool isInteger : sized.getShape()) {
+    bounds.addAttr(rewriter, 0, rewriter.getIndexAttr(0));
+    bounds.addAttr(rewriter, 2, rewriter.getIndexAttr(1));
+
+    if (!isInteger) {
+      std::string sym = sized.getSymbols()[symIdx++].str();
+      bounds.addAttr(rewriter, 1, rewriter.getStringAttr(sym + " - 1"));
+      continue;
+    }
+
+    int64_t size = sized.getIntegers()[intIdx++];
+    if (size < 0)
+      return failure();
+
+    bounds.addAttr(rewriter, 1, rewriter.getIndexAttr(size - 1));
+  }
+
+  return success();
+}
+
+/// Converts linalg operations with a DaCe library node equivalent (matmul,
+/// batch_matmul, dot, matvec) to a library call. As linalg accumulates into the
+/// output while the library nodes overwrite it, the result is computed into a
+/// transient and combined with the output element-wise.
+template <typename LinalgOpT>
+class LinalgToLibCall : public OpConversionPattern<LinalgOpT> {
+public:
+  LinalgToLibCall(TypeConverter &converter, MLIRContext *ctxt,
+                  StringRef callee, ArrayRef<StringRef> inputNames,
+                  StringRef outputName)
+      : OpConversionPattern<LinalgOpT>(converter, ctxt), callee(callee),
+        inputNames(inputNames.begin(), inputNames.end()),
+        outputName(outputName) {}
+
+  LogicalResult
+  matchAndRewrite(LinalgOpT op, typename LinalgOpT::Adaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!op.hasBufferSemantics() || !isLibraryOp(op))
+      return failure();
+
+    Location loc = op.getLoc();
+    unsigned numInputs = op.getNumDpsInputs();
+    Value output = adaptor.getOperands()[numInputs];
+    ArrayType outputType = output.getType().dyn_cast<ArrayType>();
+    if (!outputType)
+      return failure();
+
+    Type elemType = outputType.getDimensions().getElementType();
+    if (!elemType.isa<FloatType, IntegerType>())
+      return failure();
+
+    MapBounds bounds;
+    if (getMapBounds(rewriter, outputType, bounds).failed())
+      return failure();
+
+    StateNode state = StateNode::create(rewriter, loc, "libcall");
+
+    SmallVector<Value> operands =
+        createLoads(rewriter, loc, adaptor.getOperands().take_front(numInputs));
+    output = createLoad(rewriter, loc, output);
+
+    SmallVector<Type> resultTypes = {outputType};
+    LibCallOp libCall =
+        LibCallOp::create(rewriter, loc, resultTypes, callee, operands);
+
+    SmallVector<StringRef> inputs(inputNames.begin(), inputNames.end());
+    libCall->setAttr("inputs", rewriter.getStrArrayAttr(inputs));
+    libCall->setAttr("outputs", rewriter.getStrArrayAttr({outputName}));
+    if (DictionaryAttr properties = getProperties(op, rewriter))
+      libCall->setAttr("properties", properties);
+
+    // Combine the result with the output. Scalar outputs need no map.
+    unsigned rank = outputType.getDimensions().getRank();
+    ValueRange indices;
+    if (rank > 0)
+      indices = createMap(rewriter, loc, bounds, rank).getBody().getArguments();
+
+    SmallVector<Value> summands = {
+        LoadOp::create(rewriter, loc, elemType, libCall->getResult(0), indices),
+        LoadOp::create(rewriter, loc, elemType, output, indices)};
+
+    SmallVector<Type> sumTypes = {elemType};
+    TaskletNode task = TaskletNode::create(rewriter, loc, summands, sumTypes);
+
+    OpBuilder builder(rewriter.getContext());
+    Block &body = task.getBody().front();
+    Value sum;
+    rewriter.updateRootInPlace(task, [&] {
+      builder.setInsertionPointToEnd(&body);
+      sum = combine(builder, op, body.getArgument(0), body.getArgument(1));
+    });
+
+    sdfg::ReturnOp::create(rewriter, loc, sum);
+    rewriter.setInsertionPointAfter(task);
+    StoreOp::create(rewriter, loc, task.getResult(0), output, indices);
+
+    rewriter.setInsertionPointAfter(state);
+    linkToLastState(rewriter, loc, state);
+    if (markedToLink(*op))
+      linkToNextState(rewriter, loc, state);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+protected:
+  /// Returns the properties of the library node, if any.
+  virtual DictionaryAttr getProperties(LinalgOpT op,
+                                       PatternRewriter &rewriter) const {
+    return nullptr;
+  }
+
+  /// Combines an element of the library call result with the corresponding
+  /// element of the output. Defaults to accumulation.
+  virtual Value combine(OpBuilder &builder, LinalgOpT op, Value result,
+                        Value output) const {
+    if (result.getType().isa<FloatType>())
+      return builder.create<arith::AddFOp>(op.getLoc(), result, output);
+
+    return builder.create<arith::AddIOp>(op.getLoc(), result, output);
+  }
+
+private:
+  /// The classpath of the library node.
+  std::string callee;
+  /// The names of the input connectors of the library node.
+  SmallVector<std::string> inputNames;
+  /// The name of the output connector of the library node.
+  std::string outputName;
+};
+
+/// Converts sum and product reductions to DaCe reduction library nodes. Other
+/// reductions are converted to loops.
+class LinalgReduceToLibCall : public LinalgToLibCall<linalg::ReduceOp> {
+public:
+  LinalgReduceToLibCall(TypeConverter &converter, MLIRContext *ctxt)
+      : LinalgToLibCall<linalg::ReduceOp>(
+            converter, ctxt, "dace.libraries.standard.nodes.Reduce", {"_in"},
+            "_out") {}
+
+protected:
+  DictionaryAttr getProperties(linalg::ReduceOp op,
+                               PatternRewriter &rewriter) const override {
+    bool isSum = isa<arith::AddFOp, arith::AddIOp>(getReduceCombiner(op));
+    SmallVector<NamedAttribute> properties = {
+        rewriter.getNamedAttr("axes",
+                              rewriter.getI64ArrayAttr(op.getDimensions())),
+        rewriter.getNamedAttr("wcr", rewriter.getStringAttr(
+                                         isSum ? "lambda a, b: a + b"
+                                               : "lambda a, b: a * b")),
+        rewriter.getNamedAttr("identity",
+                              rewriter.getI64IntegerAttr(isSum ? 0 : 1))};
+    return rewriter.getDictionaryAttr(properties);
+  }
+
+  Value combine(OpBuilder &builder, linalg::ReduceOp op, Value result,
+                Value output) const override {
+    Block &body = op.getCombiner().front();
+    IRMapping mapping;
+    mapping.map(body.getArgument(0), result);
+    mapping.map(body.getArgument(1), output);
+    return builder.clone(*getReduceCombiner(op), mapping)->getResult(0);
+  }
+};
+
 //===----------------------------------------------------------------------===//
 // LLVM Patterns
 //===----------------------------------------------------------------------===//
@@ -1498,19 +2320,33 @@ public:
   }
 };
 
-/// Converts a LLVM::GEPOp to an index computation.
+/// Converts a LLVM::GEPOp to an index computation. Linearized indices into
+/// flat arrays are delinearized and accessed through a multi-dimensional view.
 class LLVMGEPToSDFG : public OpConversionPattern<mlir::LLVM::GEPOp> {
 public:
-  using OpConversionPattern<mlir::LLVM::GEPOp>::OpConversionPattern;
+  LLVMGEPToSDFG(TypeConverter &converter, MLIRContext *ctxt,
+                Delinearizer &delinearizer)
+      : OpConversionPattern<mlir::LLVM::GEPOp>(converter, ctxt),
+        delinearizer(delinearizer) {}
 
   LogicalResult
   matchAndRewrite(mlir::LLVM::GEPOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
     Value base = op.getBase();
-    ValueRange indices = op.getDynamicIndices();
+    SmallVector<Value> indices = llvm::to_vector(op.getDynamicIndices());
     SmallVector<Value> castedIndices;
 
+    Value view = adaptor.getBase();
+    if (succeeded(delinearizer.rewrite(rewriter, op, view, indices)))
+      base = view;
+
     for (Value idx : indices) {
+      // Delinearized indices may already be symbolic indices
+      if (idx.getType().isIndex()) {
+        castedIndices.push_back(idx);
+        continue;
+      }
+
       OpBuilder builder(op.getLoc()->getContext());
       OperationState state(op.getLoc(), arith::IndexCastOp::getOperationName());
 
@@ -1528,6 +2364,9 @@ public:
     rewriter.eraseOp(op);
     return success();
   }
+
+private:
+  Delinearizer &delinearizer;
 };
 
 /// Converts a LLVM::LoadOp to sdfg::LoadOp.
@@ -1714,7 +2553,8 @@ public:
 
 /// Registers all the patterns above in a RewritePatternSet.
 void populateGenericToSDFGConversionPatterns(RewritePatternSet &patterns,
-                                             TypeConverter &converter) {
+                                             TypeConverter &converter,
+                                             Delinearizer &delinearizer) {
   MLIRContext *ctxt = patterns.getContext();
 
   patterns.add<FuncToSDFG>(converter, ctxt);
@@ -1722,8 +2562,8 @@ void populateGenericToSDFGConversionPatterns(RewritePatternSet &patterns,
   patterns.add<CallToSDFG>(converter, ctxt);
   patterns.add<OpToTasklet>(converter, ctxt);
 
-  patterns.add<MemrefLoadToSDFG>(converter, ctxt);
-  patterns.add<MemrefStoreToSDFG>(converter, ctxt);
+  patterns.add<MemrefLoadToSDFG>(converter, ctxt, delinearizer);
+  patterns.add<MemrefStoreToSDFG>(converter, ctxt, delinearizer);
   patterns.add<MemrefCopyToSDFG>(converter, ctxt);
   patterns.add<MemrefGlobalToSDFG>(converter, ctxt);
   patterns.add<MemrefGetGlobalToSDFG>(converter, ctxt);
@@ -1733,14 +2573,29 @@ void populateGenericToSDFGConversionPatterns(RewritePatternSet &patterns,
   patterns.add<MemrefCastToSDFG>(converter, ctxt);
 
   patterns.add<SCFForToSDFG>(converter, ctxt);
+  patterns.add<SCFParallelToSDFG>(converter, ctxt);
   patterns.add<SCFWhileToSDFG>(converter, ctxt);
   patterns.add<SCFConditionToSDFG>(converter, ctxt);
   patterns.add<SCFIfToSDFG>(converter, ctxt);
   patterns.add<SCFYieldToSDFG>(converter, ctxt);
 
+  patterns.add<LinalgToLibCall<linalg::MatmulOp>>(
+      converter, ctxt, "dace.libraries.blas.nodes.MatMul",
+      ArrayRef<StringRef>{"_a", "_b"}, "_c");
+  patterns.add<LinalgToLibCall<linalg::BatchMatmulOp>>(
+      converter, ctxt, "dace.libraries.blas.nodes.BatchedMatMul",
+      ArrayRef<StringRef>{"_a", "_b"}, "_c");
+  patterns.add<LinalgToLibCall<linalg::DotOp>>(
+      converter, ctxt, "dace.libraries.blas.nodes.Dot",
+      ArrayRef<StringRef>{"_x", "_y"}, "_result");
+  patterns.add<LinalgToLibCall<linalg::MatvecOp>>(
+      converter, ctxt, "dace.libraries.blas.nodes.Gemv",
+      ArrayRef<StringRef>{"_A", "_x"}, "_y");
+  patterns.add<LinalgReduceToLibCall>(converter, ctxt);
+
   patterns.add<LLVMAllocaToSDFG>(converter, ctxt);
   patterns.add<LLVMBitcastToSDFG>(converter, ctxt);
-  patterns.add<LLVMGEPToSDFG>(converter, ctxt);
+  patterns.add<LLVMGEPToSDFG>(converter, ctxt, delinearizer);
   patterns.add<LLVMLoadToSDFG>(converter, ctxt);
   patterns.add<LLVMStoreToSDFG>(converter, ctxt);
   patterns.add<LLVMGlobalToSDFG>(converter, ctxt);
@@ -1759,6 +2614,7 @@ struct GenericToSDFGPass
       : mainFuncName(mainFuncName.str()) {}
 
   void runOnOperation() override;
+  void collectStatistics(ModuleOp module);
 };
 } // namespace
 
@@ -1799,9 +2655,27 @@ llvm::Optional<std::string> getMainFunctionName(ModuleOp moduleOp) {
   return std::nullopt;
 }
 
+/// Keeps scalar transients, such as loop-carried values and tasklet results,
+/// in registers instead of heap-allocating them at SDFG scope.
+static void inferScalarStorage(ModuleOp module) {
+  module.walk([](AllocOp allocOp) {
+    if (!allocOp.getTransient() || allocOp.isStream() || !allocOp.isScalar())
+      return;
+
+    Builder builder(allocOp.getContext());
+    if (!allocOp.getStorage().has_value())
+      allocOp.setStorageAttr(builder.getStringAttr("Register"));
+    if (!allocOp.getLifetime().has_value())
+      allocOp.setLifetimeAttr(builder.getStringAttr("Scope"));
+  });
+}
+
 /// Runs the pass on the top-level module operation.
 void GenericToSDFGPass::runOnOperation() {
   ModuleOp module = getOperation();
+  // Generated names restart for every module and are independent of other
+  // threads.
+  sdfg::utils::NameGeneratorScope nameScope;
 
   // FIXME: Find a way to get func name via CLI instead of inferring
   llvm::Optional<std::string> mainFuncNameOpt = getMainFunctionName(module);
@@ -1815,11 +2689,47 @@ void GenericToSDFGPass::runOnOperation() {
   SDFGTarget target(getContext());
   ToArrayConverter converter;
 
+  Delinearizer delinearizer;
+  delinearizer.analyze(module);
+
   RewritePatternSet patterns(&getContext());
-  populateGenericToSDFGConversionPatterns(patterns, converter);
+  populateGenericToSDFGConversionPatterns(patterns, converter, delinearizer);
+
+  sdfg::utils::PatternTimer timer;
+  if (patternTiming)
+    timer.instrument(patterns);
+
+  LogicalResult res = applyFullConversion(module, target, std::move(patterns));
+
+  if (patternTiming)
+    timer.print(llvm::errs(), "Generic to SDFG Pattern Timing");
 
-  if (applyFullConversion(module, target, std::move(patterns)).failed())
+  if (res.failed()) {
     signalPassFailure();
+    return;
+  }
+
+  inferScalarStorage(module);
+  sdfg::utils::renumberIDs(module);
+  collectStatistics(module);
+}
+
+/// Counts the states, tasklets, transients, edges and maps of the converted
+/// module.
+void GenericToSDFGPass::collectStatistics(ModuleOp module) {
+  module.walk([&](Operation *op) {
+    if (isa<StateNode>(op))
+      ++numStates;
+    else if (isa<TaskletNode>(op))
+      ++numTasklets;
+    else if (isa<EdgeOp>(op))
+      ++numEdges;
+    else if (isa<MapNode>(op))
+      ++numMaps;
+    else if (AllocOp allocOp = dyn_cast<AllocOp>(op))
+      if (allocOp.getTransient())
+        ++numTransients;
+  });
 }
 
 /// Returns a unique pointer to this pass.
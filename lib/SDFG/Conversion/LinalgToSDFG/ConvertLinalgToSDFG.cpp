@@ -1,14 +1,24 @@
 // Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
 
 /// This file defines a converter from the linalg dialect to the SDFG dialect.
+/// Linalg operations with a DaCe library node equivalent (matmul,
+/// batch_matmul, dot, matvec, sum and product reductions) are kept and
+/// converted to library calls by the generic conversion. All other linalg
+/// operations on buffers (generic, fill, convolutions, other reductions, ...)
+/// are lowered to loop nests, which the generic conversion turns into map nests
+/// or loops. Run this pass before --convert-to-sdfg.
 
+#include "SDFG/Conversion/GenericToSDFG/Passes.h"
 #include "SDFG/Conversion/LinalgToSDFG/PassDetail.h"
 #include "SDFG/Conversion/LinalgToSDFG/Passes.h"
 #include "SDFG/Dialect/Dialect.h"
 #include "SDFG/Utils/Utils.h"
 #include "mlir/Conversion/LLVMCommon/ConversionTarget.h"
 #include "mlir/Conversion/LLVMCommon/Pattern.h"
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/IR/AsmState.h"
@@ -26,6 +36,63 @@ struct SDFGTarget : public ConversionTarget {
   SDFGTarget(MLIRContext &ctx) : ConversionTarget(ctx) {
     // Every operation is legal (best effort)
     markUnknownOpDynamicallyLegal([](Operation *op) { return true; });
+    // Except for linalg operations on buffers without a library node
+    addDynamicallyLegalDialect<linalg::LinalgDialect>([](Operation *op) {
+      linalg::LinalgOp linalgOp = dyn_cast<linalg::LinalgOp>(op);
+      return !linalgOp || !linalgOp.hasBufferSemantics() ||
+             isLibraryOp(linalgOp);
+    });
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// Linalg Patterns
+//===----------------------------------------------------------------------===//
+
+/// Replaces the affine applies in the provided loop nest that select a single
+/// dimension with the corresponding operand, such that the loads and stores
+/// are indexed by the induction variables directly.
+static void foldDimApplies(PatternRewriter &rewriter, Operation *loop) {
+  SmallVector<AffineApplyOp> applies;
+  loop->walk([&](AffineApplyOp apply) { applies.push_back(apply); });
+
+  for (AffineApplyOp apply : applies) {
+    AffineMap map = apply.getAffineMap();
+    if (map.getNumResults() != 1 || map.getNumSymbols() != 0)
+      continue;
+
+    if (AffineDimExpr dim = map.getResult(0).dyn_cast<AffineDimExpr>())
+      rewriter.replaceOp(apply, apply.getMapOperands()[dim.getPosition()]);
+  }
+}
+
+/// Lowers linalg operations on buffers to loop nests. Operations without
+/// reduction dimensions are lowered to scf::ParallelOp nests (which become
+/// map nests), all others to scf::ForOp nests.
+class LinalgToLoops : public OpInterfaceConversionPattern<linalg::LinalgOp> {
+public:
+  using OpInterfaceConversionPattern<
+      linalg::LinalgOp>::OpInterfaceConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(linalg::LinalgOp op, ArrayRef<Value> operands,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!op.hasBufferSemantics() || isLibraryOp(op))
+      return failure();
+
+    FailureOr<linalg::LinalgLoops> loops =
+        op.getNumReductionLoops() == 0
+            ? linalg::linalgOpToParallelLoops(rewriter, op)
+            : linalg::linalgOpToLoops(rewriter, op);
+
+    if (failed(loops))
+      return failure();
+
+    if (!loops->empty())
+      foldDimApplies(rewriter, loops->front());
+
+    rewriter.eraseOp(op);
+    return success();
   }
 };
 
@@ -34,7 +101,11 @@ struct SDFGTarget : public ConversionTarget {
 //===----------------------------------------------------------------------===//
 
 /// Registers all the patterns above in a RewritePatternSet.
-void populateLinalgToSDFGConversionPatterns(RewritePatternSet &patterns) {}
+void populateLinalgToSDFGConversionPatterns(RewritePatternSet &patterns) {
+  MLIRContext *ctxt = patterns.getContext();
+
+  patterns.add<LinalgToLoops>(ctxt);
+}
 
 namespace {
 struct LinalgToSDFGPass
@@ -10,9 +10,11 @@
 //       Assignment: Insert block, add assignments at the end, cf.br
 //       Condition: Insert blocks (true/false), compute condition, cf.cond_br
 //
-// Alloc -> memref.alloc
+// Alloc -> memref.alloc (scalars in the function entry: memref.alloca)
+//          Statically sized arrays in states are hoisted to the function
+//          entry, allocations in the function entry are freed at every return
 // Load -> memref.load
-// Store -> memref.store
+// Store -> memref.store (with wcr: memref.atomic_rmw)
 // Copy -> memref.copy
 //
 // Alloc Symbol -> memref.alloc (int64)
@@ -21,11 +23,32 @@
 //      If expression: parse, build AST, create ops
 //
 // Return -> func.return
-// Tasklet -> func.func + func.call
+// Tasklet -> body inlined at the tasklet (vector ops in the body are kept as is)
+//   With outline-tasklets: func.func + func.call, passing the referenced
+//   symbols
 //
 // Map -> scf.parallel (or: affine.parallel, affine.for, scf.forall, scf.for)
 //
-// Consume -> TBD
+// With gpu-maps:
+//   GPU scheduled Map -> scf.parallel mapped to GPU blocks/threads
+//   Arrays only accessed in GPU maps -> gpu.alloc (GPU memory space)
+//   Copy from/to GPU memory -> gpu.memcpy
+//   Other arrays accessed in GPU maps -> staged around every GPU map:
+//     gpu.alloc + gpu.memcpy in, gpu.memcpy out (if written) + gpu.dealloc
+//
+// Stream -> memref<?xT> ring buffer + memref<2xi64> (head, tail) counters
+//           Stream arguments are passed along with their counters
+// Stream Push -> atomic tail increment, cf.assert (buffer not full),
+//                memref.store
+// Stream Pop -> atomic head increment, memref.load
+// Stream Length -> tail - head
+//
+// Consume -> scf.while (stream not empty and condition does not hold):
+//              take the elements [head, tail)
+//              scf.parallel over num_pes workers:
+//                scf.for over every num_pes-th element of [head, tail)
+//              set head to tail
+//            The quiescence condition is inlined into the loop condition
 //
 
 #include "SDFG/Conversion/SDFGToGeneric/OpCreators.h"
@@ -33,27 +56,69 @@
 #include "SDFG/Conversion/SDFGToGeneric/Passes.h"
 #include "SDFG/Conversion/SDFGToGeneric/SymbolicParser.h"
 #include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Utils/PatternTimer.h"
 #include "SDFG/Utils/Utils.h"
 #include "mlir/Dialect/ControlFlow/IR/ControlFlowOps.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/GPU/IR/GPUDialect.h"
+#include "mlir/Dialect/GPU/Transforms/ParallelLoopMapper.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/IR/AsmState.h"
 #include "mlir/IR/IRMapping.h"
 #include "mlir/Transforms/DialectConversion.h"
+#include "mlir/Transforms/Passes.h"
+#include "mlir/Transforms/RegionUtils.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/StringExtras.h"
 
 using namespace mlir;
 using namespace sdfg;
 using namespace conversion;
 
-/// Maps state name to their generated block
-llvm::StringMap<Block *> blockMap;
+/// Number of elements a lowered stream can hold at once if its allocation does
+/// not specify a buffer size
+constexpr int64_t streamCapacity = 1024;
+
+/// Memory space of arrays placed in GPU (global) memory
+constexpr int64_t gpuMemorySpace = 1;
+
+namespace {
+/// Bookkeeping of a single run of the conversion. Owned by the pass and passed
+/// to the patterns, so that independent runs do not share any state.
+struct ConversionState {
+  /// Maps states to their generated block
+  llvm::DenseMap<Operation *, Block *> blockMap;
+
+  /// For each function scope, map symbols to values
+  /// Function scope is determined by the function name
+  llvm::StringMap<llvm::StringMap<Value>> symbolMap;
+
+  /// Maps EdgeOps to their source and destination states, resolved once before
+  /// the conversion
+  llvm::DenseMap<Operation *, std::pair<Operation *, Operation *>> edgeStates;
+
+  /// Maps states to the number of their outgoing edges not converted yet
+  llvm::DenseMap<Operation *, unsigned> pendingOutEdges;
 
-/// For each function scope, map symbols to values
-/// Function scope is determined by the function name
-llvm::StringMap<llvm::StringMap<Value>> symbolMap;
+  /// Caches the parsed ASTs of symbolic expressions
+  llvm::StringMap<std::unique_ptr<ASTNode>> astCache;
 
-// HACK: Keeps track of processed EdgeOps
-llvm::DenseSet<EdgeOp> processedEdges;
+  /// Maps the ring buffers of lowered streams to their (head, tail) counters
+  llvm::DenseMap<Value, Value> streamCounters;
+
+  /// Maps consume scopes to detached copies of their quiescence condition,
+  /// which are inlined into the lowered consume scopes
+  llvm::DenseMap<Operation *, Operation *> conditionFuncs;
+
+  /// Allocations of arrays placed in GPU memory
+  llvm::DenseSet<Operation *> deviceArrays;
+
+  /// Allocations of arrays in states, which are resolved before the states are
+  /// converted
+  llvm::DenseSet<Operation *> stateAllocs;
+};
+} // namespace
 
 //===----------------------------------------------------------------------===//
 // Target & Type Converter
@@ -72,6 +137,8 @@ struct GenericTarget : public ConversionTarget {
     addLegalDialect<memref::MemRefDialect>();
     addLegalDialect<arith::ArithDialect>();
     addLegalDialect<scf::SCFDialect>();
+    // Vector operations of tasklets are kept as they are
+    addLegalDialect<vector::VectorDialect>();
     // All other operations are illegal
     markUnknownOpDynamicallyLegal([](Operation *op) { return false; });
   }
@@ -83,6 +150,7 @@ public:
   ToMemrefConverter() {
     addConversion([](Type type) { return type; });
     addConversion(convertArrayTypes);
+    addConversion(convertStreamTypes);
   }
 
   /// Attempts to convert array types to MemRef types.
@@ -105,12 +173,88 @@ public:
 
     return std::nullopt;
   }
+
+  /// Attempts to convert scalar stream types to MemRef types holding the ring
+  /// buffer of the stream. The capacity is chosen by the allocation.
+  static Optional<Type> convertStreamTypes(Type type) {
+    if (StreamType stream = type.dyn_cast<StreamType>()) {
+      SizedType sized = stream.getDimensions();
+      if (sized.getRank() > 0)
+        return std::nullopt;
+
+      return MemRefType::get({ShapedType::kDynamic}, sized.getElementType());
+    }
+
+    return std::nullopt;
+  }
 };
 
 //===----------------------------------------------------------------------===//
 // Helpers
 //===----------------------------------------------------------------------===//
 
+/// Returns true if the map is scheduled on the GPU.
+static bool isGPUMap(MapNode map) {
+  Optional<StringRef> schedule = map.getSchedule();
+  return schedule && schedule->startswith("GPU_");
+}
+
+/// Returns true if the operation is nested in a map scheduled on the GPU.
+static bool isInGPUMap(Operation *op) {
+  for (MapNode map = op->getParentOfType<MapNode>(); map;
+       map = map->getParentOfType<MapNode>())
+    if (isGPUMap(map))
+      return true;
+
+  return false;
+}
+
+/// Returns true if the allocated array can be placed in GPU memory, which is
+/// the case if it is only loaded from and stored to in GPU maps or copied.
+/// Other arrays accessed in GPU maps are staged in GPU memory around the maps.
+static bool isDeviceArray(AllocOp alloc) {
+  if (!alloc.getType().isa<ArrayType>() || isInGPUMap(alloc))
+    return false;
+
+  bool accessedOnDevice = false;
+
+  for (Operation *user : alloc->getUsers()) {
+    if (isa<CopyOp>(user))
+      continue;
+
+    if (!isa<LoadOp, StoreOp>(user) || !isInGPUMap(user))
+      return false;
+
+    accessedOnDevice = true;
+  }
+
+  return accessedOnDevice;
+}
+
+/// Returns true if the memref is placed in GPU memory.
+static bool isDeviceMemref(Value memref) {
+  MemRefType type = memref.getType().dyn_cast<MemRefType>();
+  if (!type)
+    return false;
+
+  IntegerAttr space = type.getMemorySpace().dyn_cast_or_null<IntegerAttr>();
+  return space && space.getInt() == gpuMemorySpace;
+}
+
+/// Resolves the source and destination states of the edges in the region of a
+/// (nested) SDFG and counts the outgoing edges of every state.
+static void collectStateMachine(ConversionState &state, Region &body) {
+  llvm::StringMap<Operation *> states;
+  for (StateNode stateNode : body.getOps<StateNode>())
+    states[stateNode.getSymName()] = stateNode;
+
+  for (EdgeOp edge : body.getOps<EdgeOp>()) {
+    Operation *src = states.lookup(edge.getSrc());
+    state.edgeStates[edge] = {src, states.lookup(edge.getDest())};
+    ++state.pendingOutEdges[src];
+  }
+}
+
 /// Gets the current function scope.
 llvm::StringRef getFunctionScope(Operation *op) {
   Operation *parent = op->getParentOfType<func::FuncOp>();
@@ -121,19 +265,31 @@ llvm::StringRef getFunctionScope(Operation *op) {
 }
 
 /// Creates operations that perform the symbolic expression.
-static Value symbolicExpressionToMLIR(PatternRewriter &rewriter, Operation *op,
+static Value symbolicExpressionToMLIR(ConversionState &state,
+                                      PatternRewriter &rewriter, Operation *op,
                                       StringRef symExpr,
                                       llvm::StringMap<Value> refMap = {}) {
-  std::unique_ptr<ASTNode> ast = SymbolicParser().parse(symExpr);
-  if (!ast)
+  std::unique_ptr<ASTNode> &ast = state.astCache[symExpr];
+  if (!ast) {
+    ast = SymbolicParser().parse(symExpr);
+    // Simplify once before the AST is cached
+    if (ast)
+      if (std::unique_ptr<ASTNode> simplified = ast->simplify())
+        ast = std::move(simplified);
+  }
+
+  if (!ast) {
     emitError(op->getLoc(), "failed to parse symbolic expression");
+    return nullptr;
+  }
 
-  return ast->codegen(rewriter, op->getLoc(), symbolMap[getFunctionScope(op)],
-                      refMap);
+  return ast->codegen(rewriter, op->getLoc(),
+                      state.symbolMap[getFunctionScope(op)], refMap);
 }
 
 /// Converts a numberlist (symbol, integer, operand) to Values.
-static SmallVector<Value> numberListToMLIR(PatternRewriter &rewriter,
+static SmallVector<Value> numberListToMLIR(ConversionState &state,
+                                           PatternRewriter &rewriter,
                                            Operation *op, StringRef attrName) {
   ArrayAttr attrList = op->getAttr(attrName).cast<ArrayAttr>();
   ArrayAttr numList =
@@ -153,7 +309,7 @@ static SmallVector<Value> numberListToMLIR(PatternRewriter &rewriter,
       else
         expression = std::to_string(attr.cast<IntegerAttr>().getInt());
 
-      Value val = symbolicExpressionToMLIR(rewriter, op, expression);
+      Value val = symbolicExpressionToMLIR(state, rewriter, op, expression);
       val =
           createIndexCast(rewriter, op->getLoc(), rewriter.getIndexType(), val);
       values.push_back(val);
@@ -166,14 +322,112 @@ static SmallVector<Value> numberListToMLIR(PatternRewriter &rewriter,
   return values;
 }
 
+/// Returns the type of the (head, tail) counters of lowered streams.
+static MemRefType getStreamCountersType(MLIRContext *ctx) {
+  return MemRefType::get({2}, IntegerType::get(ctx, 64));
+}
+
+/// Returns the positions of the streams in the provided types.
+static SmallVector<unsigned> getStreamPositions(TypeRange types) {
+  SmallVector<unsigned> positions;
+  for (unsigned i = 0; i < types.size(); ++i)
+    if (types[i].isa<StreamType>())
+      positions.push_back(i);
+  return positions;
+}
+
+/// Registers the counters of the stream arguments of a converted (nested)
+/// SDFG. The counters are passed in the arguments following the original
+/// arguments, in the order of the streams.
+static void registerStreamArguments(ConversionState &state, Block *entry,
+                                    unsigned numArgs,
+                                    ArrayRef<unsigned> streams) {
+  for (unsigned i = 0; i < streams.size(); ++i)
+    state.streamCounters[entry->getArgument(streams[i])] =
+        entry->getArgument(numArgs + i);
+}
+
+/// Returns the (head, tail) counters of the provided lowered stream or null if
+/// the stream is neither allocated by this pass nor passed as an argument.
+static Value getStreamCounters(ConversionState &state, Value buffer) {
+  auto it = state.streamCounters.find(buffer);
+  if (it == state.streamCounters.end())
+    return nullptr;
+
+  return it->second;
+}
+
+/// Returns the number of elements the ring buffer of a lowered stream holds as
+/// an i64.
+static Value getStreamCapacity(PatternRewriter &rewriter, Location loc,
+                               Value buffer) {
+  Value capacity = createDim(rewriter, loc, buffer, 0);
+  return createIndexCast(rewriter, loc, rewriter.getI64Type(), capacity);
+}
+
+/// Converts a position in a stream to an index into its ring buffer.
+static Value getStreamSlot(PatternRewriter &rewriter, Location loc,
+                           Value buffer, Value position) {
+  Value capacity = getStreamCapacity(rewriter, loc, buffer);
+  Value slot = createRemUI(rewriter, loc, position, capacity);
+  return createIndexCast(rewriter, loc, rewriter.getIndexType(), slot);
+}
+
+/// Inlines the body of the provided quiescence condition applied to the
+/// provided stream and returns its result.
+static Value inlineCondition(PatternRewriter &rewriter, func::FuncOp cond,
+                             Value stream) {
+  Block &body = cond.getBody().front();
+  IRMapping mapping;
+  mapping.map(body.getArgument(0), stream);
+
+  for (Operation &op : body.without_terminator())
+    rewriter.clone(op, mapping);
+
+  return mapping.lookupOrDefault(body.getTerminator()->getOperand(0));
+}
+
+/// Returns the atomic read-modify-write kind implementing the provided
+/// write-conflict resolution on values of the provided type.
+static llvm::Optional<arith::AtomicRMWKind> getAtomicRMWKind(StringRef wcr,
+                                                             Type type) {
+  bool isFloat = type.isa<FloatType>();
+
+  if (wcr == "add")
+    return isFloat ? arith::AtomicRMWKind::addf : arith::AtomicRMWKind::addi;
+
+  if (wcr == "mul")
+    return isFloat ? arith::AtomicRMWKind::mulf : arith::AtomicRMWKind::muli;
+
+  if (wcr == "min")
+    return isFloat ? arith::AtomicRMWKind::minf : arith::AtomicRMWKind::mins;
+
+  if (wcr == "max")
+    return isFloat ? arith::AtomicRMWKind::maxf : arith::AtomicRMWKind::maxs;
+
+  if (wcr == "and" && !isFloat)
+    return arith::AtomicRMWKind::andi;
+
+  if (wcr == "or" && !isFloat)
+    return arith::AtomicRMWKind::ori;
+
+  return llvm::None;
+}
+
 //===----------------------------------------------------------------------===//
 // SDFG, State & Edge Patterns
 //===----------------------------------------------------------------------===//
 
 /// Converts a SDFG node to func::FuncOp.
 class SDFGToFunc : public OpConversionPattern<SDFGNode> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<SDFGNode>::OpConversionPattern;
+  SDFGToFunc(TypeConverter &converter, MLIRContext *ctxt,
+             ConversionState &state)
+      : OpConversionPattern<SDFGNode>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(SDFGNode op, OpAdaptor adaptor,
@@ -188,6 +442,13 @@ public:
             .failed())
       return failure();
 
+    // Streams are passed along with their (head, tail) counters
+    SmallVector<unsigned> streams =
+        getStreamPositions(op.getBody().getArgumentTypes());
+    unsigned numArgs = op.getBody().getNumArguments();
+    MemRefType countersType = getStreamCountersType(rewriter.getContext());
+    convertedTypes.append(streams.size(), countersType);
+
     // Add symbols to signature
     SmallVector<StringAttr> symbols;
 
@@ -203,15 +464,21 @@ public:
         createFunc(rewriter, op.getLoc(), "sdfg", convertedTypes, {}, "public");
     funcOp.getBody().takeBody(op.getBody());
 
+    for (unsigned i = 0; i < streams.size(); ++i)
+      funcOp.getBody().addArgument(countersType, op.getLoc());
+
     // Add symbols to scope
     for (StringAttr sym : symbols)
-      symbolMap[getFunctionScope(op)][sym] =
+      state.symbolMap[getFunctionScope(op)][sym] =
           funcOp.getBody().addArgument(rewriter.getIndexType(), op.getLoc());
 
-    if (failed(rewriter.convertRegionTypes(&funcOp.getBody(),
-                                           *getTypeConverter())))
+    FailureOr<Block *> entry =
+        rewriter.convertRegionTypes(&funcOp.getBody(), *getTypeConverter());
+    if (failed(entry))
       return failure();
 
+    registerStreamArguments(state, *entry, numArgs, streams);
+
     rewriter.eraseOp(op);
     return success();
   }
@@ -219,8 +486,14 @@ public:
 
 /// Converts a nested SDFG node to func::FuncOp and func::CallOp.
 class NestedSDFGToFunc : public OpConversionPattern<NestedSDFGNode> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<NestedSDFGNode>::OpConversionPattern;
+  NestedSDFGToFunc(TypeConverter &converter, MLIRContext *ctxt,
+                   ConversionState &state)
+      : OpConversionPattern<NestedSDFGNode>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(NestedSDFGNode op, OpAdaptor adaptor,
@@ -228,9 +501,21 @@ public:
     // Create call
     std::string name = sdfg::utils::generateName("nested_sdfg");
 
-    // Propagate symbols
+    // Streams are passed along with their (head, tail) counters
     SmallVector<Value> operands = adaptor.getOperands();
-    for (llvm::StringMapEntry<Value> &v : symbolMap[getFunctionScope(op)])
+    SmallVector<unsigned> streams = getStreamPositions(op.getOperandTypes());
+    unsigned numArgs = op.getNumOperands();
+    MemRefType countersType = getStreamCountersType(rewriter.getContext());
+
+    for (unsigned idx : streams) {
+      Value counters = getStreamCounters(state, operands[idx]);
+      if (!counters)
+        return failure();
+      operands.push_back(counters);
+    }
+
+    // Propagate symbols
+    for (llvm::StringMapEntry<Value> &v : state.symbolMap[getFunctionScope(op)])
       operands.push_back(v.getValue());
 
     createCall(rewriter, op.getLoc(), {}, name, operands);
@@ -252,23 +537,31 @@ public:
             .failed())
       return failure();
 
+    operandTypes.append(streams.size(), countersType);
+
     // Add symbols to signature
-    for (llvm::StringMapEntry<Value> &v : symbolMap[getFunctionScope(op)])
+    for (llvm::StringMapEntry<Value> &v : state.symbolMap[getFunctionScope(op)])
       operandTypes.push_back(v.getValue().getType());
 
     func::FuncOp funcOp =
         createFunc(rewriter, op.getLoc(), name, operandTypes, {}, "private");
     funcOp.getBody().takeBody(op.getBody());
 
+    for (unsigned i = 0; i < streams.size(); ++i)
+      funcOp.getBody().addArgument(countersType, op.getLoc());
+
     // Add symbols to scope
-    for (llvm::StringMapEntry<Value> &v : symbolMap[getFunctionScope(op)])
-      symbolMap[name][v.getKey()] =
+    for (llvm::StringMapEntry<Value> &v : state.symbolMap[getFunctionScope(op)])
+      state.symbolMap[name][v.getKey()] =
           funcOp.getBody().addArgument(v.getValue().getType(), op.getLoc());
 
-    if (failed(rewriter.convertRegionTypes(&funcOp.getBody(),
-                                           *getTypeConverter())))
+    FailureOr<Block *> entry =
+        rewriter.convertRegionTypes(&funcOp.getBody(), *getTypeConverter());
+    if (failed(entry))
       return failure();
 
+    registerStreamArguments(state, *entry, numArgs, streams);
+
     rewriter.eraseOp(op);
     return success();
   }
@@ -276,8 +569,14 @@ public:
 
 /// Converts a state to a basic block.
 class StateToBlock : public OpConversionPattern<StateNode> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<StateNode>::OpConversionPattern;
+  StateToBlock(TypeConverter &converter, MLIRContext *ctxt,
+               ConversionState &state)
+      : OpConversionPattern<StateNode>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(StateNode op, OpAdaptor adaptor,
@@ -285,8 +584,8 @@ public:
     // Split the current basic block at the current position
     Block *newBlock = rewriter.createBlock(rewriter.getBlock()->getParent());
 
-    // Add the mapping from the sdfg.state's name to the new basic block
-    blockMap[op.getName()] = newBlock;
+    // Add the mapping from the sdfg.state to the new basic block
+    state.blockMap[op] = newBlock;
 
     // Connect to init block if it's an entry state
     if (op->hasAttrOfType<BoolAttr>("entry") &&
@@ -310,11 +609,9 @@ public:
     }
 
     // If there is an outward edge, do not add a return op
-    for (EdgeOp edge : op->getParentRegion()->getOps<EdgeOp>()) {
-      if (edge.getSrc().equals(op.getSymName())) {
-        rewriter.eraseOp(op);
-        return success();
-      }
+    if (state.pendingOutEdges.lookup(op) > 0) {
+      rewriter.eraseOp(op);
+      return success();
     }
 
     createReturn(rewriter, op.getLoc(), {});
@@ -326,16 +623,31 @@ public:
 /// Converts an edge to basic blocks (for assignments and conditions) and
 /// (conditional) branches.
 class EdgeToBranch : public OpConversionPattern<EdgeOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<EdgeOp>::OpConversionPattern;
+  EdgeToBranch(TypeConverter &converter, MLIRContext *ctxt,
+               ConversionState &state)
+      : OpConversionPattern<EdgeOp>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(EdgeOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
+    auto [src, dest] = state.edgeStates.lookup(op);
+    Block *srcBlock = state.blockMap.lookup(src);
+    Block *destBlock = state.blockMap.lookup(dest);
+    if (!srcBlock || !destBlock)
+      return failure();
+
+    // This edge is converted now
+    --state.pendingOutEdges[src];
+
     // If we don't have a condition or assignments, add a simple branch
     if (adaptor.getCondition().equals("1") && adaptor.getAssign().empty()) {
-      rewriter.setInsertionPointToEnd(blockMap[adaptor.getSrc()]);
-      createBranch(rewriter, op.getLoc(), {}, blockMap[adaptor.getDest()]);
+      rewriter.setInsertionPointToEnd(srcBlock);
+      createBranch(rewriter, op.getLoc(), {}, destBlock);
       rewriter.eraseOp(op);
       return success();
     }
@@ -349,35 +661,25 @@ public:
       // If we have a condition, create a second block (not taken path)
       Block *notTakenBlock =
           rewriter.createBlock(rewriter.getBlock()->getParent());
-      rewriter.setInsertionPointToEnd(blockMap[adaptor.getSrc()]);
+      rewriter.setInsertionPointToEnd(srcBlock);
       // Compute condition
       Value condition = symbolicExpressionToMLIR(
-          rewriter, op, adaptor.getCondition(), refMap);
+          state, rewriter, op, adaptor.getCondition(), refMap);
       // Add conditional branch
       createCondBranch(rewriter, op.getLoc(), condition, takenBlock,
                        notTakenBlock);
 
       // Update blockMap
-      blockMap[adaptor.getSrc()] = notTakenBlock;
+      state.blockMap[src] = notTakenBlock;
 
       // If there is no other edge op for the source state, add return statement
       // to the new block
-      bool hasEdge = false;
-
-      for (EdgeOp edge : rewriter.getBlock()->getParent()->getOps<EdgeOp>()) {
-        if (edge.getSrc().equals(adaptor.getSrc()) && edge != op &&
-            !processedEdges.contains(edge)) {
-          hasEdge = true;
-          break;
-        }
-      }
-
-      if (!hasEdge) {
+      if (state.pendingOutEdges.lookup(src) == 0) {
         rewriter.setInsertionPointToEnd(notTakenBlock);
         createReturn(rewriter, op.getLoc(), {});
       }
     } else {
-      rewriter.setInsertionPointToEnd(blockMap[adaptor.getSrc()]);
+      rewriter.setInsertionPointToEnd(srcBlock);
       createBranch(rewriter, op.getLoc(), {}, takenBlock);
       // No blockMap update because only one unconditial edge allowed per state
     }
@@ -386,14 +688,13 @@ public:
     rewriter.setInsertionPointToStart(takenBlock);
 
     for (Attribute assignment : adaptor.getAssign())
-      symbolicExpressionToMLIR(rewriter, op, cast<StringAttr>(assignment),
-                               refMap);
+      symbolicExpressionToMLIR(state, rewriter, op,
+                               cast<StringAttr>(assignment), refMap);
 
     // Create simple branch to destination
-    createBranch(rewriter, op.getLoc(), {}, blockMap[adaptor.getDest()]);
+    createBranch(rewriter, op.getLoc(), {}, destBlock);
 
     rewriter.eraseOp(op);
-    processedEdges.insert(op);
     return success();
   }
 };
@@ -404,8 +705,14 @@ public:
 
 /// Converts an allocation operation to memref::AllocOp.
 class AllocToAlloc : public OpConversionPattern<AllocOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<AllocOp>::OpConversionPattern;
+  AllocToAlloc(TypeConverter &converter, MLIRContext *ctxt,
+               ConversionState &state)
+      : OpConversionPattern<AllocOp>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(AllocOp op, OpAdaptor adaptor,
@@ -414,6 +721,23 @@ public:
     if (!memrefType || !memrefType.isa<MemRefType>())
       return failure();
 
+    // Statically sized arrays of states are allocated once in the entry of the
+    // function instead of every time the state is executed (e.g. in a loop).
+    // Streams stay in their state, as they start out empty in every execution.
+    MemRefType type = memrefType.cast<MemRefType>();
+    func::FuncOp funcOp = op->getParentOfType<func::FuncOp>();
+    if (state.stateAllocs.contains(op) && type.hasStaticShape() && funcOp)
+      rewriter.setInsertionPointToStart(&funcOp.getBody().front());
+
+    // Scalars allocated once per call live on the stack
+    if (op.getType().isa<ArrayType>() && type.getRank() == 0 &&
+        rewriter.getInsertionBlock()->isEntryBlock() &&
+        !state.deviceArrays.contains(op)) {
+      memref::AllocaOp allocaOp = createAlloca(rewriter, op.getLoc(), type);
+      rewriter.replaceOp(op, {allocaOp});
+      return success();
+    }
+
     SmallVector<Value> operands;
 
     if (ArrayType array = op.getType().dyn_cast<ArrayType>()) {
@@ -430,7 +754,7 @@ public:
           intIdx++;
           continue;
         } else {
-          val = symbolicExpressionToMLIR(rewriter, op,
+          val = symbolicExpressionToMLIR(state, rewriter, op,
                                          array.getSymbols()[symIdx++]);
           val = createIndexCast(rewriter, op.getLoc(), rewriter.getIndexType(),
                                 val);
@@ -439,11 +763,34 @@ public:
       }
 
     } else {
-      operands = adaptor.getOperands();
+      // The ring buffer holds as many elements as the stream buffers
+      int64_t capacity = streamCapacity;
+      if (op.getBufferSize().has_value())
+        capacity = op.getBufferSize().value().getSExtValue();
+      operands.push_back(createConstantIndex(rewriter, op.getLoc(), capacity));
     }
 
     memref::AllocOp allocOp = createAlloc(
         rewriter, op.getLoc(), memrefType.cast<MemRefType>(), operands);
+
+    // Streams additionally keep track of their head and tail
+    if (op.getType().isa<StreamType>()) {
+      MemRefType countersType = getStreamCountersType(rewriter.getContext());
+      memref::AllocOp counters =
+          createAlloc(rewriter, op.getLoc(), countersType, {});
+
+      Value zero = createConstantInt(rewriter, op.getLoc(), 0, 64);
+      for (int64_t i = 0; i < 2; ++i)
+        createStore(rewriter, op.getLoc(), zero, counters,
+                    createConstantIndex(rewriter, op.getLoc(), i).getResult());
+
+      state.streamCounters[allocOp] = counters;
+    }
+
+    // Placed in GPU memory once the conversion is done
+    if (state.deviceArrays.erase(op))
+      state.deviceArrays.insert(allocOp);
+
     rewriter.replaceOp(op, {allocOp});
     return success();
   }
@@ -451,13 +798,20 @@ public:
 
 /// Converts a load operation to memref::LoadOp.
 class LoadToLoad : public OpConversionPattern<LoadOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<LoadOp>::OpConversionPattern;
+  LoadToLoad(TypeConverter &converter, MLIRContext *ctxt,
+             ConversionState &state)
+      : OpConversionPattern<LoadOp>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(LoadOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    SmallVector<Value> indices = numberListToMLIR(rewriter, op, "indices");
+    SmallVector<Value> indices =
+        numberListToMLIR(state, rewriter, op, "indices");
 
     memref::LoadOp loadOp =
         createLoad(rewriter, op.getLoc(), adaptor.getArr(), indices);
@@ -466,15 +820,38 @@ public:
   }
 };
 
-/// Converts a store operation to memref::StoreOp.
+/// Converts a store operation to memref::StoreOp or, with write-conflict
+/// resolution, memref::AtomicRMWOp.
 class StoreToStore : public OpConversionPattern<StoreOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<StoreOp>::OpConversionPattern;
+  StoreToStore(TypeConverter &converter, MLIRContext *ctxt,
+               ConversionState &state)
+      : OpConversionPattern<StoreOp>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(StoreOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    SmallVector<Value> indices = numberListToMLIR(rewriter, op, "indices");
+    SmallVector<Value> indices =
+        numberListToMLIR(state, rewriter, op, "indices");
+
+    // Concurrent stores with write-conflict resolution become atomic.
+    if (op.getWcr().has_value()) {
+      llvm::Optional<arith::AtomicRMWKind> kind =
+          getAtomicRMWKind(op.getWcr().value(), adaptor.getVal().getType());
+      if (!kind.has_value())
+        return op.emitError("write-conflict resolution has no atomic "
+                            "equivalent");
+
+      createAtomicRMW(rewriter, op.getLoc(), kind.value(), adaptor.getVal(),
+                      adaptor.getArr(), indices);
+      rewriter.eraseOp(op);
+      return success();
+    }
+
     createStore(rewriter, op.getLoc(), adaptor.getVal(), adaptor.getArr(),
                 indices);
     rewriter.eraseOp(op);
@@ -496,20 +873,137 @@ public:
   }
 };
 
+//===----------------------------------------------------------------------===//
+// Stream Patterns
+//===----------------------------------------------------------------------===//
+
+/// Converts a stream push operation to an atomic increment of the tail and a
+/// memref::StoreOp. Pushing onto a full stream traps instead of overwriting
+/// elements that are not consumed yet.
+class StreamPushToStore : public OpConversionPattern<StreamPushOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
+public:
+  StreamPushToStore(TypeConverter &converter, MLIRContext *ctxt,
+                    ConversionState &state)
+      : OpConversionPattern<StreamPushOp>(converter, ctxt), state(state) {}
+
+  LogicalResult
+  matchAndRewrite(StreamPushOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value counters = getStreamCounters(state, adaptor.getStr());
+    if (!counters)
+      return failure();
+
+    Value one = createConstantInt(rewriter, op.getLoc(), 1, 64);
+    Value tailIdx = createConstantIndex(rewriter, op.getLoc(), 1);
+    Value tail = createAtomicRMW(rewriter, op.getLoc(),
+                                 arith::AtomicRMWKind::addi, one, counters,
+                                 tailIdx);
+
+    // The elements between the head and the tail are not consumed yet
+    Value headIdx = createConstantIndex(rewriter, op.getLoc(), 0);
+    Value head = createLoad(rewriter, op.getLoc(), counters, headIdx);
+    Value length = createSubI(rewriter, op.getLoc(), tail, head);
+    Value capacity =
+        getStreamCapacity(rewriter, op.getLoc(), adaptor.getStr());
+    Value fits = createCmpI(rewriter, op.getLoc(), arith::CmpIPredicate::slt,
+                            length, capacity);
+    createAssert(rewriter, op.getLoc(), fits, "stream buffer overflow");
+
+    Value slot = getStreamSlot(rewriter, op.getLoc(), adaptor.getStr(), tail);
+    createStore(rewriter, op.getLoc(), adaptor.getVal(), adaptor.getStr(),
+                slot);
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
+/// Converts a stream pop operation to an atomic increment of the head and a
+/// memref::LoadOp.
+class StreamPopToLoad : public OpConversionPattern<StreamPopOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
+public:
+  StreamPopToLoad(TypeConverter &converter, MLIRContext *ctxt,
+                  ConversionState &state)
+      : OpConversionPattern<StreamPopOp>(converter, ctxt), state(state) {}
+
+  LogicalResult
+  matchAndRewrite(StreamPopOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value counters = getStreamCounters(state, adaptor.getStr());
+    if (!counters)
+      return failure();
+
+    Value one = createConstantInt(rewriter, op.getLoc(), 1, 64);
+    Value headIdx = createConstantIndex(rewriter, op.getLoc(), 0);
+    Value head = createAtomicRMW(rewriter, op.getLoc(),
+                                 arith::AtomicRMWKind::addi, one, counters,
+                                 headIdx);
+
+    Value slot = getStreamSlot(rewriter, op.getLoc(), adaptor.getStr(), head);
+    memref::LoadOp loadOp =
+        createLoad(rewriter, op.getLoc(), adaptor.getStr(), slot);
+    rewriter.replaceOp(op, {loadOp});
+    return success();
+  }
+};
+
+/// Converts a stream length operation to the difference of tail and head.
+class StreamLengthToOps : public OpConversionPattern<StreamLengthOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
+public:
+  StreamLengthToOps(TypeConverter &converter, MLIRContext *ctxt,
+                    ConversionState &state)
+      : OpConversionPattern<StreamLengthOp>(converter, ctxt), state(state) {}
+
+  LogicalResult
+  matchAndRewrite(StreamLengthOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value counters = getStreamCounters(state, adaptor.getStr());
+    if (!counters)
+      return failure();
+
+    Value headIdx = createConstantIndex(rewriter, op.getLoc(), 0);
+    Value tailIdx = createConstantIndex(rewriter, op.getLoc(), 1);
+    Value head = createLoad(rewriter, op.getLoc(), counters, headIdx);
+    Value tail = createLoad(rewriter, op.getLoc(), counters, tailIdx);
+
+    Value length = createSubI(rewriter, op.getLoc(), tail, head);
+    length = createTruncI(rewriter, op.getLoc(), op.getType(), length);
+    rewriter.replaceOp(op, {length});
+    return success();
+  }
+};
+
 //===----------------------------------------------------------------------===//
 // Symbol Patterns
 //===----------------------------------------------------------------------===//
 
 /// Converts a symbol allocation operation to memref::AllocOp.
 class AllocSymbolToAlloc : public OpConversionPattern<AllocSymbolOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<AllocSymbolOp>::OpConversionPattern;
+  AllocSymbolToAlloc(TypeConverter &converter, MLIRContext *ctxt,
+                     ConversionState &state)
+      : OpConversionPattern<AllocSymbolOp>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(AllocSymbolOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
     allocSymbol(rewriter, op.getLoc(), op.getSym(),
-                symbolMap[getFunctionScope(op)]);
+                state.symbolMap[getFunctionScope(op)]);
     rewriter.eraseOp(op);
     return success();
   }
@@ -517,13 +1011,18 @@ public:
 
 /// Converts a symbolic expression to multiple builtin operations.
 class SymToOps : public OpConversionPattern<SymOp> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<SymOp>::OpConversionPattern;
+  SymToOps(TypeConverter &converter, MLIRContext *ctxt, ConversionState &state)
+      : OpConversionPattern<SymOp>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(SymOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    Value val = symbolicExpressionToMLIR(rewriter, op, op.getExpr());
+    Value val = symbolicExpressionToMLIR(state, rewriter, op, op.getExpr());
 
     if (op.getType().isIndex())
       val = createIndexCast(rewriter, op.getLoc(), op.getType(), val);
@@ -541,27 +1040,111 @@ public:
 // Tasklet Patterns
 //===----------------------------------------------------------------------===//
 
-/// Converts a tasklet to func::FuncOp and func::CallOp.
+/// Collects the strings in the provided attribute, including the ones nested
+/// in array attributes.
+static void collectStrings(Attribute attr, SmallVectorImpl<StringRef> &strs) {
+  if (StringAttr strAttr = attr.dyn_cast<StringAttr>())
+    strs.push_back(strAttr.getValue());
+  else if (ArrayAttr arrayAttr = attr.dyn_cast<ArrayAttr>())
+    for (Attribute elem : arrayAttr)
+      collectStrings(elem, strs);
+}
+
+/// Returns true if the provided symbolic expression references the provided
+/// symbol.
+static bool referencesSymbol(StringRef expr, StringRef sym) {
+  auto isIdentifierChar = [](char c) { return llvm::isAlnum(c) || c == '_'; };
+
+  for (size_t pos = expr.find(sym); pos != StringRef::npos;
+       pos = expr.find(sym, pos + 1)) {
+    size_t end = pos + sym.size();
+    if ((pos == 0 || !isIdentifierChar(expr[pos - 1])) &&
+        (end == expr.size() || !isIdentifierChar(expr[end])))
+      return true;
+  }
+
+  return false;
+}
+
+/// Returns the symbols of the current function scope the body of the provided
+/// tasklet references.
+static SmallVector<StringRef> getReferencedSymbols(ConversionState &state,
+                                                   TaskletNode op) {
+  SmallVector<StringRef> strs;
+  op.getBody().walk([&](Operation *nested) {
+    for (NamedAttribute attr : nested->getAttrs())
+      collectStrings(attr.getValue(), strs);
+  });
+
+  SmallVector<StringRef> symbols;
+  for (llvm::StringMapEntry<Value> &v : state.symbolMap[getFunctionScope(op)])
+    if (llvm::any_of(strs, [&](StringRef str) {
+          return referencesSymbol(str, v.getKey());
+        }))
+      symbols.push_back(v.getKey());
+
+  return symbols;
+}
+
+/// Converts a tasklet by inlining its body or, if enabled or the types of its
+/// values change, to func::FuncOp and func::CallOp.
 class TaskletToFunc : public OpConversionPattern<TaskletNode> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+  /// Flag indicating whether tasklets are always outlined into functions.
+  bool outline;
+
+  /// Clones the body of the tasklet in front of it and replaces the tasklet
+  /// with the returned values. Symbols in the body then resolve to the ones of
+  /// the surrounding function.
+  LogicalResult inlineTasklet(TaskletNode op, OpAdaptor adaptor,
+                              ConversionPatternRewriter &rewriter) const {
+    Block &body = op.getBody().front();
+    IRMapping mapping;
+    mapping.map(body.getArguments(), adaptor.getOperands());
+
+    for (Operation &nested : body.without_terminator())
+      rewriter.clone(nested, mapping);
+
+    SmallVector<Value> results;
+    for (Value operand : body.getTerminator()->getOperands())
+      results.push_back(mapping.lookupOrDefault(operand));
+
+    rewriter.replaceOp(op, results);
+    return success();
+  }
+
 public:
-  using OpConversionPattern<TaskletNode>::OpConversionPattern;
+  TaskletToFunc(TypeConverter &converter, MLIRContext *ctxt,
+                ConversionState &state, bool outline)
+      : OpConversionPattern<TaskletNode>(converter, ctxt), state(state),
+        outline(outline) {}
 
   LogicalResult
   matchAndRewrite(TaskletNode op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    // Create call
-    std::string name = sdfg::utils::generateName("tasklet");
-
     SmallVector<Type> resultTypes;
     if (getTypeConverter()
             ->convertTypes(op.getResultTypes(), resultTypes)
             .failed())
       return failure();
 
-    // Propagate symbols
+    // Inline the body if it can use the converted operands as they are
+    if (!outline && op.getBody().hasOneBlock() &&
+        getTypeConverter()->isLegal(op.getOperation()))
+      return inlineTasklet(op, adaptor, rewriter);
+
+    // Create call
+    std::string name = sdfg::utils::generateName("tasklet");
+
+    // Propagate the referenced symbols
+    SmallVector<StringRef> symbols = getReferencedSymbols(state, op);
+    llvm::StringMap<Value> &scope = state.symbolMap[getFunctionScope(op)];
+
     SmallVector<Value> operands = adaptor.getOperands();
-    for (llvm::StringMapEntry<Value> &v : symbolMap[getFunctionScope(op)])
-      operands.push_back(v.getValue());
+    for (StringRef sym : symbols)
+      operands.push_back(scope.lookup(sym));
 
     func::CallOp callOp =
         createCall(rewriter, op.getLoc(), resultTypes, name, operands);
@@ -582,17 +1165,17 @@ public:
       return failure();
 
     // Add symbols to signature
-    for (llvm::StringMapEntry<Value> &v : symbolMap[getFunctionScope(op)])
-      operandTypes.push_back(v.getValue().getType());
+    for (StringRef sym : symbols)
+      operandTypes.push_back(scope.lookup(sym).getType());
 
     func::FuncOp funcOp = createFunc(rewriter, op.getLoc(), name, operandTypes,
                                      resultTypes, "private");
     funcOp.getBody().takeBody(op.getBody());
 
     // Add symbols to scope
-    for (llvm::StringMapEntry<Value> &v : symbolMap[getFunctionScope(op)])
-      symbolMap[name][v.getKey()] =
-          funcOp.getBody().addArgument(v.getValue().getType(), op.getLoc());
+    for (StringRef sym : symbols)
+      state.symbolMap[name][sym] = funcOp.getBody().addArgument(
+          scope.lookup(sym).getType(), op.getLoc());
 
     if (failed(rewriter.convertRegionTypes(&funcOp.getBody(),
                                            *getTypeConverter())))
@@ -620,23 +1203,38 @@ public:
 // Map & Consume Patterns
 //===----------------------------------------------------------------------===//
 
-/// Converts a map scope to scf::ParallelOp.
+/// Converts a map scope to scf::ParallelOp. If enabled, maps scheduled on the
+/// GPU get mapped to GPU blocks (or threads for thread block schedules), so
+/// that -convert-parallel-loops-to-gpu turns them into gpu.launch.
 class MapToParallel : public OpConversionPattern<MapNode> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+  /// Flag indicating whether GPU maps get GPU mapping attributes.
+  bool gpuMaps;
+
 public:
-  using OpConversionPattern<MapNode>::OpConversionPattern;
+  MapToParallel(TypeConverter &converter, MLIRContext *ctxt,
+                ConversionState &state, bool gpuMaps)
+      : OpConversionPattern<MapNode>(converter, ctxt), state(state),
+        gpuMaps(gpuMaps) {}
 
   LogicalResult
   matchAndRewrite(MapNode op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
     SmallVector<Value> lowerBounds =
-        numberListToMLIR(rewriter, op, "lowerBounds");
+        numberListToMLIR(state, rewriter, op, "lowerBounds");
     SmallVector<Value> upperBounds =
-        numberListToMLIR(rewriter, op, "upperBounds");
-    SmallVector<Value> steps = numberListToMLIR(rewriter, op, "steps");
+        numberListToMLIR(state, rewriter, op, "upperBounds");
+    SmallVector<Value> steps = numberListToMLIR(state, rewriter, op, "steps");
 
     scf::ParallelOp parallelOp =
         createParallel(rewriter, op.getLoc(), lowerBounds, upperBounds, steps);
 
+    if (gpuMaps && isGPUMap(op) &&
+        setGPUMapping(rewriter, op, parallelOp).failed())
+      return failure();
+
     if (!op.getBodyRegion().empty() && !op.getBodyRegion().front().empty()) {
       parallelOp.getBodyRegion().takeBody(op.getBodyRegion());
       rewriter.setInsertionPointToEnd(parallelOp.getBody());
@@ -646,18 +1244,142 @@ public:
     rewriter.eraseOp(op);
     return success();
   }
+
+private:
+  /// Maps the dimensions of the parallel loop to GPU processors, the
+  /// innermost dimension to x. Dimensions beyond the third are sequential.
+  static LogicalResult setGPUMapping(PatternRewriter &rewriter, MapNode op,
+                                     scf::ParallelOp parallelOp) {
+    StringRef schedule = *op.getSchedule();
+    bool threads = schedule.startswith("GPU_ThreadBlock");
+
+    gpu::Processor processors[] = {
+        threads ? gpu::Processor::ThreadX : gpu::Processor::BlockX,
+        threads ? gpu::Processor::ThreadY : gpu::Processor::BlockY,
+        threads ? gpu::Processor::ThreadZ : gpu::Processor::BlockZ};
+
+    AffineMap identity = rewriter.getDimIdentityMap();
+    unsigned rank = parallelOp.getNumLoops();
+    SmallVector<gpu::ParallelLoopDimMappingAttr> mapping;
+
+    for (unsigned i = 0; i < rank; ++i) {
+      unsigned fromInner = rank - 1 - i;
+      gpu::Processor processor = fromInner < 3 ? processors[fromInner]
+                                               : gpu::Processor::Sequential;
+      mapping.push_back(gpu::ParallelLoopDimMappingAttr::get(
+          rewriter.getContext(), processor, identity, identity));
+    }
+
+    return gpu::setMappingAttr(parallelOp, mapping);
+  }
 };
 
-/// Converts a consume scope to TBD.
-class ConsumeToTODO : public OpConversionPattern<ConsumeNode> {
+/// Converts a consume scope to a working-queue loop. Every round takes the
+/// elements present in the stream and distributes them across num_pes workers
+/// in a scf::ParallelOp. Elements pushed during a round are consumed in the
+/// next one, until the stream is empty or the quiescence condition holds. The
+/// elements of a round are only released once the round is done, so pushes
+/// during the round cannot overwrite them.
+class ConsumeToParallel : public OpConversionPattern<ConsumeNode> {
+private:
+  /// The bookkeeping of the current conversion run.
+  ConversionState &state;
+
 public:
-  using OpConversionPattern<ConsumeNode>::OpConversionPattern;
+  ConsumeToParallel(TypeConverter &converter, MLIRContext *ctxt,
+                    ConversionState &state)
+      : OpConversionPattern<ConsumeNode>(converter, ctxt), state(state) {}
 
   LogicalResult
   matchAndRewrite(ConsumeNode op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    // TODO: Write lowering for consume nodes
-    return failure();
+    Value buffer = adaptor.getStream();
+    Value counters = getStreamCounters(state, buffer);
+    if (!counters)
+      return failure();
+
+    Location loc = op.getLoc();
+    int64_t numPes = 1;
+    if (op.getNumPes().has_value())
+      numPes = op.getNumPes().value().getSExtValue();
+
+    int64_t chunksize = 1;
+    if (op.getChunksize().has_value())
+      chunksize = op.getChunksize().value().getSExtValue();
+
+    // The counters hold the head at index zero and the tail at index one
+    Value zero = createConstantIndex(rewriter, loc, 0);
+    Value one = createConstantIndex(rewriter, loc, 1);
+    Value pes = createConstantIndex(rewriter, loc, numPes);
+
+    scf::WhileOp whileOp = createWhile(rewriter, loc);
+
+    // Continue as long as the stream is not empty and the quiescence condition
+    // does not hold. An empty stream cannot be refilled once every worker is
+    // done, so it ends the consumption regardless of the condition.
+    rewriter.createBlock(&whileOp.getBefore());
+    Value head = createLoad(rewriter, loc, counters, zero);
+    Value tail = createLoad(rewriter, loc, counters, one);
+    Value proceed =
+        createCmpI(rewriter, loc, arith::CmpIPredicate::slt, head, tail);
+
+    if (Operation *cond = state.conditionFuncs.lookup(op)) {
+      Value quiescent =
+          inlineCondition(rewriter, cast<func::FuncOp>(cond), op.getStream());
+      Value running = createXOrI(rewriter, loc, quiescent,
+                                 createConstantInt(rewriter, loc, 1, 1));
+      proceed = createAndI(rewriter, loc, proceed, running);
+    }
+
+    createCondition(rewriter, loc, proceed);
+
+    // Take the elements of this round
+    rewriter.createBlock(&whileOp.getAfter());
+    head = createLoad(rewriter, loc, counters, zero);
+    tail = createLoad(rewriter, loc, counters, one);
+
+    Value begin = createIndexCast(rewriter, loc, rewriter.getIndexType(), head);
+    Value end = createIndexCast(rewriter, loc, rewriter.getIndexType(), tail);
+
+    scf::ParallelOp parallelOp = createParallel(rewriter, loc, zero, pes, one);
+    // Release the elements of this round
+    createStore(rewriter, loc, tail, counters, zero);
+    createYield(rewriter, loc);
+
+    // Every worker processes every num_pes-th chunk of consecutive elements
+    rewriter.setInsertionPoint(parallelOp.getBody()->getTerminator());
+    Value pe = parallelOp.getInductionVars()[0];
+    Value chunk = createConstantIndex(rewriter, loc, chunksize);
+    Value offset = createMulI(rewriter, loc, pe, chunk);
+    Value first = createAddI(rewriter, loc, begin, offset);
+    Value stride = createConstantIndex(rewriter, loc, numPes * chunksize);
+    scf::ForOp forOp = createFor(rewriter, loc, first, end, stride);
+
+    // Chunks consist of a single element by default
+    if (chunksize > 1) {
+      rewriter.setInsertionPointToStart(forOp.getBody());
+      Value start = forOp.getInductionVar();
+      Value stop = createAddI(rewriter, loc, start, chunk);
+      stop = createMinSI(rewriter, loc, stop, end);
+      Value step = createConstantIndex(rewriter, loc, 1);
+      scf::ForOp chunkOp = createFor(rewriter, loc, start, stop, step);
+      createYield(rewriter, loc);
+      forOp = chunkOp;
+    }
+
+    rewriter.setInsertionPointToStart(forOp.getBody());
+    Value position = createIndexCast(rewriter, loc, rewriter.getI64Type(),
+                                     forOp.getInductionVar());
+    Value slot = getStreamSlot(rewriter, loc, buffer, position);
+    Value elem = createLoad(rewriter, loc, buffer, slot);
+
+    SmallVector<Value> bodyValues = {pe, elem};
+    rewriter.mergeBlocks(&op.getBody().front(), forOp.getBody(), bodyValues);
+    rewriter.setInsertionPointToEnd(forOp.getBody());
+    createYield(rewriter, loc);
+
+    rewriter.eraseOp(op);
+    return success();
   }
 };
 
@@ -666,45 +1388,384 @@ public:
 //===----------------------------------------------------------------------===//
 
 /// Registers all the patterns above in a RewritePatternSet.
-void populateSDFGToGenericConversionPatterns(RewritePatternSet &patterns,
-                                             TypeConverter &converter) {
+static void populateSDFGToGenericConversionPatterns(
+    RewritePatternSet &patterns, TypeConverter &converter,
+    ConversionState &state, bool gpuMaps, bool outlineTasklets) {
   MLIRContext *ctxt = patterns.getContext();
 
-  patterns.add<SDFGToFunc>(converter, ctxt);
-  patterns.add<NestedSDFGToFunc>(converter, ctxt);
-  patterns.add<StateToBlock>(converter, ctxt);
-  patterns.add<EdgeToBranch>(converter, ctxt);
-  patterns.add<AllocToAlloc>(converter, ctxt);
-  patterns.add<LoadToLoad>(converter, ctxt);
-  patterns.add<StoreToStore>(converter, ctxt);
+  patterns.add<SDFGToFunc>(converter, ctxt, state);
+  patterns.add<NestedSDFGToFunc>(converter, ctxt, state);
+  patterns.add<StateToBlock>(converter, ctxt, state);
+  patterns.add<EdgeToBranch>(converter, ctxt, state);
+  patterns.add<AllocToAlloc>(converter, ctxt, state);
+  patterns.add<LoadToLoad>(converter, ctxt, state);
+  patterns.add<StoreToStore>(converter, ctxt, state);
   patterns.add<CopyToCopy>(converter, ctxt);
-  patterns.add<AllocSymbolToAlloc>(converter, ctxt);
-  patterns.add<SymToOps>(converter, ctxt);
-  patterns.add<TaskletToFunc>(converter, ctxt);
+  patterns.add<StreamPushToStore>(converter, ctxt, state);
+  patterns.add<StreamPopToLoad>(converter, ctxt, state);
+  patterns.add<StreamLengthToOps>(converter, ctxt, state);
+  patterns.add<AllocSymbolToAlloc>(converter, ctxt, state);
+  patterns.add<SymToOps>(converter, ctxt, state);
+  patterns.add<TaskletToFunc>(converter, ctxt, state, outlineTasklets);
   patterns.add<ReturnToReturn>(converter, ctxt);
-  patterns.add<MapToParallel>(converter, ctxt);
-  patterns.add<ConsumeToTODO>(converter, ctxt);
+  patterns.add<MapToParallel>(converter, ctxt, state, gpuMaps);
+  patterns.add<ConsumeToParallel>(converter, ctxt, state);
 }
 
 namespace {
 struct SDFGToGenericPass
     : public sdfg::conversion::SDFGToGenericPassBase<SDFGToGenericPass> {
   void runOnOperation() override;
+  LogicalResult detachConditions(ModuleOp module, ConversionState &state);
+  void eraseConditions(ConversionState &state);
+  void placeDeviceArrays(ModuleOp module, ConversionState &state);
+  void stageHostArrays(ModuleOp module);
+  void insertDeallocs(ModuleOp module);
+  void collectStatistics(ModuleOp module);
 };
 } // namespace
 
 /// Runs the pass on the top-level module operation.
 void SDFGToGenericPass::runOnOperation() {
   ModuleOp module = getOperation();
+  // Generated names restart for every module and are independent of other
+  // threads.
+  sdfg::utils::NameGeneratorScope nameScope;
+  // The bookkeeping starts empty for every run
+  ConversionState state;
+
+  if (detachConditions(module, state).failed()) {
+    eraseConditions(state);
+    signalPassFailure();
+    return;
+  }
+
+  // Resolve the state machines once instead of searching the edges of a state
+  // for every converted state and edge
+  module.walk([&](Operation *op) {
+    if (SDFGNode sdfg = dyn_cast<SDFGNode>(op))
+      collectStateMachine(state, sdfg.getBody());
+    else if (NestedSDFGNode nested = dyn_cast<NestedSDFGNode>(op))
+      collectStateMachine(state, nested.getBody());
+  });
+
+  module.walk([&](AllocOp alloc) {
+    if (gpuMaps && isDeviceArray(alloc))
+      state.deviceArrays.insert(alloc);
+
+    if (alloc.isInState() && alloc.getType().isa<ArrayType>())
+      state.stateAllocs.insert(alloc);
+  });
 
   GenericTarget target(getContext());
   ToMemrefConverter converter;
 
   RewritePatternSet patterns(&getContext());
-  populateSDFGToGenericConversionPatterns(patterns, converter);
+  populateSDFGToGenericConversionPatterns(patterns, converter, state, gpuMaps,
+                                          outlineTasklets);
+
+  sdfg::utils::PatternTimer timer;
+  if (patternTiming)
+    timer.instrument(patterns);
+
+  LogicalResult res = applyFullConversion(module, target, std::move(patterns));
+
+  if (patternTiming)
+    timer.print(llvm::errs(), "SDFG to Generic Pattern Timing");
+
+  eraseConditions(state);
+
+  if (res.failed()) {
+    signalPassFailure();
+    return;
+  }
 
-  if (applyFullConversion(module, target, std::move(patterns)).failed())
+  placeDeviceArrays(module, state);
+  if (gpuMaps)
+    stageHostArrays(module);
+  insertDeallocs(module);
+
+  // Symbol loads are hoisted out of the loops during the conversion. Move the
+  // computations depending on them (e.g. map bounds) out of the loops as well
+  // and merge the duplicates.
+  OpPassManager cleanup(ModuleOp::getOperationName());
+  cleanup.addPass(createLoopInvariantCodeMotionPass());
+  cleanup.addPass(createCSEPass());
+  if (failed(runPipeline(cleanup, module))) {
     signalPassFailure();
+    return;
+  }
+
+  collectStatistics(module);
+}
+
+/// Replaces the quiescence conditions of the consume scopes by detached copies,
+/// which are inlined into the lowered consume scopes. The conditions take
+/// streams, so they cannot remain as functions. Fails if a condition cannot be
+/// inlined.
+LogicalResult SDFGToGenericPass::detachConditions(ModuleOp module,
+                                                  ConversionState &state) {
+  llvm::SmallPtrSet<Operation *, 4> conditions;
+
+  WalkResult result = module.walk([&](ConsumeNode consume) {
+    if (!consume.getConditionAttr())
+      return WalkResult::advance();
+
+    func::FuncOp cond = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(
+        consume, consume.getConditionAttr());
+    ArrayRef<Type> results = cond.getFunctionType().getResults();
+
+    if (!cond.getBody().hasOneBlock() || results.size() != 1 ||
+        !results[0].isInteger(1)) {
+      consume.emitError("quiescence condition must be a single block "
+                        "returning an i1");
+      return WalkResult::interrupt();
+    }
+
+    state.conditionFuncs[consume] = cond->clone();
+    conditions.insert(cond);
+    return WalkResult::advance();
+  });
+
+  if (result.wasInterrupted())
+    return failure();
+
+  for (Operation *cond : conditions) {
+    auto uses = SymbolTable::getSymbolUses(cond, cond->getParentOp());
+    if (!uses || llvm::any_of(*uses, [](SymbolTable::SymbolUse use) {
+          return !isa<ConsumeNode>(use.getUser());
+        })) {
+      cond->emitError("quiescence condition is used outside of consume "
+                      "scopes");
+      return failure();
+    }
+
+    cond->erase();
+  }
+
+  return success();
+}
+
+/// Erases the detached copies of the quiescence conditions.
+void SDFGToGenericPass::eraseConditions(ConversionState &state) {
+  for (auto &[consume, cond] : state.conditionFuncs)
+    cond->erase();
+  state.conditionFuncs.clear();
+}
+
+/// Moves the arrays only accessed in GPU maps to GPU memory and turns the
+/// copies from and to GPU memory into gpu.memcpy.
+void SDFGToGenericPass::placeDeviceArrays(ModuleOp module,
+                                          ConversionState &state) {
+  if (state.deviceArrays.empty())
+    return;
+
+  OpBuilder builder(&getContext());
+  Attribute memorySpace = builder.getI64IntegerAttr(gpuMemorySpace);
+
+  for (Operation *op : state.deviceArrays) {
+    memref::AllocOp allocOp = cast<memref::AllocOp>(op);
+    MemRefType type =
+        MemRefType::Builder(allocOp.getType()).setMemorySpace(memorySpace);
+
+    builder.setInsertionPoint(allocOp);
+    gpu::AllocOp gpuAlloc = builder.create<gpu::AllocOp>(
+        allocOp.getLoc(), type, /*asyncToken=*/Type(),
+        /*asyncDependencies=*/ValueRange(), allocOp.getDynamicSizes(),
+        allocOp.getSymbolOperands());
+
+    // Device arrays are only used by loads, stores and copies, which accept
+    // any memory space
+    allocOp.getResult().replaceAllUsesWith(gpuAlloc.getMemref());
+    allocOp.erase();
+  }
+
+  state.deviceArrays.clear();
+
+  module.walk([&](memref::CopyOp copyOp) {
+    if (!isDeviceMemref(copyOp.getSource()) &&
+        !isDeviceMemref(copyOp.getTarget()))
+      return;
+
+    builder.setInsertionPoint(copyOp);
+    builder.create<gpu::MemcpyOp>(copyOp.getLoc(), /*asyncToken=*/Type(),
+                                  /*asyncDependencies=*/ValueRange(),
+                                  copyOp.getTarget(), copyOp.getSource());
+    copyOp.erase();
+  });
+}
+
+/// Returns the memref the provided operation accesses and whether it writes it,
+/// or null if the operation is neither a load nor a store.
+static std::pair<Value, bool> getAccessedMemref(Operation *op) {
+  if (memref::LoadOp loadOp = dyn_cast<memref::LoadOp>(op))
+    return {loadOp.getMemref(), false};
+  if (memref::StoreOp storeOp = dyn_cast<memref::StoreOp>(op))
+    return {storeOp.getMemref(), true};
+  if (memref::AtomicRMWOp rmwOp = dyn_cast<memref::AtomicRMWOp>(op))
+    return {rmwOp.getMemref(), true};
+  return {nullptr, false};
+}
+
+/// Stages the host arrays accessed in GPU maps in GPU memory, so that no kernel
+/// dereferences host memory. Every such array gets a GPU buffer for the
+/// duration of the map, which is copied in before the map and, if the map
+/// writes the array, copied out after the map. Maps whose host arrays cannot
+/// be copied as a whole (e.g. strided views) are executed on the host instead.
+void SDFGToGenericPass::stageHostArrays(ModuleOp module) {
+  OpBuilder builder(&getContext());
+  Attribute memorySpace = builder.getI64IntegerAttr(gpuMemorySpace);
+  StringRef mappingAttr = gpu::getMappingAttrName();
+
+  // Maps nested in GPU maps are part of the same kernel
+  SmallVector<scf::ParallelOp> kernels;
+  module.walk<WalkOrder::PreOrder>([&](scf::ParallelOp parallelOp) {
+    if (!parallelOp->hasAttr(mappingAttr))
+      return WalkResult::advance();
+
+    kernels.push_back(parallelOp);
+    return WalkResult::skip();
+  });
+
+  for (scf::ParallelOp kernel : kernels) {
+    // Maps the host arrays to whether the kernel writes them
+    llvm::MapVector<Value, bool> hostArrays;
+    bool copyable = true;
+
+    kernel.walk([&](Operation *op) {
+      auto [array, write] = getAccessedMemref(op);
+      if (!array || isDeviceMemref(array) ||
+          kernel.getRegion().isAncestor(array.getParentRegion()))
+        return;
+
+      hostArrays[array] |= write;
+      copyable &= array.getType().cast<MemRefType>().getLayout().isIdentity();
+    });
+
+    if (hostArrays.empty())
+      continue;
+
+    if (!copyable) {
+      kernel.emitWarning("GPU map accesses host arrays that cannot be copied "
+                         "to GPU memory, executing it on the host");
+      kernel.walk([&](scf::ParallelOp nested) {
+        nested->removeAttr(mappingAttr);
+      });
+      continue;
+    }
+
+    Location loc = kernel.getLoc();
+
+    for (auto &[array, written] : hostArrays) {
+      MemRefType type = array.getType().cast<MemRefType>();
+      builder.setInsertionPoint(kernel);
+
+      SmallVector<Value> sizes;
+      for (int64_t i = 0; i < type.getRank(); ++i)
+        if (type.isDynamicDim(i))
+          sizes.push_back(builder.create<memref::DimOp>(loc, array, i));
+
+      MemRefType deviceType =
+          MemRefType::Builder(type).setMemorySpace(memorySpace);
+      gpu::AllocOp gpuAlloc = builder.create<gpu::AllocOp>(
+          loc, deviceType, /*asyncToken=*/Type(),
+          /*asyncDependencies=*/ValueRange(), sizes,
+          /*symbolOperands=*/ValueRange());
+      Value device = gpuAlloc.getMemref();
+
+      builder.create<gpu::MemcpyOp>(loc, /*asyncToken=*/Type(),
+                                    /*asyncDependencies=*/ValueRange(), device,
+                                    array);
+      replaceAllUsesInRegionWith(array, device, kernel.getRegion());
+
+      builder.setInsertionPointAfter(kernel);
+      if (written)
+        builder.create<gpu::MemcpyOp>(loc, /*asyncToken=*/Type(),
+                                      /*asyncDependencies=*/ValueRange(),
+                                      array, device);
+      builder.create<gpu::DeallocOp>(loc, /*asyncToken=*/Type(),
+                                     /*asyncDependencies=*/ValueRange(),
+                                     device);
+    }
+  }
+}
+
+/// Frees the provided memref or GPU allocation at the current insertion point.
+static void createDealloc(OpBuilder &builder, Location loc, Operation *op) {
+  if (memref::AllocOp allocOp = dyn_cast<memref::AllocOp>(op)) {
+    builder.create<memref::DeallocOp>(loc, allocOp);
+    return;
+  }
+
+  builder.create<gpu::DeallocOp>(loc, /*asyncToken=*/Type(),
+                                 /*asyncDependencies=*/ValueRange(),
+                                 cast<gpu::AllocOp>(op).getMemref());
+}
+
+/// Frees the allocations of the provided block at its end, which are only used
+/// in the block. These are the dynamically sized transients of the lowered
+/// state, which are allocated every time the state is executed (e.g. in a
+/// loop).
+static void freeBlockAllocs(OpBuilder &builder, Block &block) {
+  Operation *terminator = block.getTerminator();
+  auto isLocal = [&](Operation *user) {
+    Operation *ancestor = block.findAncestorOpInBlock(*user);
+    return ancestor && ancestor != terminator;
+  };
+
+  SmallVector<Operation *> allocs;
+  for (Operation &op : block)
+    if (isa<memref::AllocOp, gpu::AllocOp>(op) &&
+        llvm::all_of(op.getUsers(), isLocal))
+      allocs.push_back(&op);
+
+  builder.setInsertionPoint(terminator);
+  for (Operation *op : llvm::reverse(allocs))
+    createDealloc(builder, terminator->getLoc(), op);
+}
+
+/// Frees the allocations in the entry block of every function before each of
+/// its returns. These allocations are executed exactly once per call and
+/// dominate every return. Allocations in the other blocks are freed at the end
+/// of their block.
+void SDFGToGenericPass::insertDeallocs(ModuleOp module) {
+  OpBuilder builder(&getContext());
+
+  module.walk([&](func::FuncOp funcOp) {
+    if (funcOp.isExternal())
+      return;
+
+    for (Block &block : llvm::drop_begin(funcOp.getBody()))
+      freeBlockAllocs(builder, block);
+
+    SmallVector<Operation *> allocs;
+    for (Operation &op : funcOp.getBody().front())
+      if (isa<memref::AllocOp, gpu::AllocOp>(op))
+        allocs.push_back(&op);
+
+    if (allocs.empty())
+      return;
+
+    funcOp.walk([&](func::ReturnOp returnOp) {
+      builder.setInsertionPoint(returnOp);
+
+      for (Operation *op : llvm::reverse(allocs))
+        createDealloc(builder, returnOp.getLoc(), op);
+    });
+  });
+}
+
+/// Counts the functions, blocks and loops of the lowered module.
+void SDFGToGenericPass::collectStatistics(ModuleOp module) {
+  module.walk([&](Operation *op) {
+    if (func::FuncOp funcOp = dyn_cast<func::FuncOp>(op)) {
+      ++numFuncs;
+      numBlocks += funcOp.getBody().getBlocks().size();
+    }
+
+    if (isa<scf::ParallelOp, scf::WhileOp, scf::ForOp>(op))
+      ++numLoops;
+  });
 }
 
 /// Returns a unique pointer to this pass.
@@ -66,6 +66,16 @@ cf::CondBranchOp conversion::createCondBranch(PatternRewriter &rewriter,
   return cast<cf::CondBranchOp>(rewriter.create(state));
 }
 
+/// Builds, creates and inserts a cf::AssertOp.
+cf::AssertOp conversion::createAssert(PatternRewriter &rewriter, Location loc,
+                                      Value condition, StringRef message) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, cf::AssertOp::getOperationName());
+
+  cf::AssertOp::build(builder, state, condition, message);
+  return cast<cf::AssertOp>(rewriter.create(state));
+}
+
 /// Builds, creates and inserts a memref::AllocOp.
 memref::AllocOp conversion::createAlloc(PatternRewriter &rewriter, Location loc,
                                         MemRefType memrefType,
@@ -77,6 +87,16 @@ memref::AllocOp conversion::createAlloc(PatternRewriter &rewriter, Location loc,
   return cast<memref::AllocOp>(rewriter.create(state));
 }
 
+/// Builds, creates and inserts a memref::AllocaOp.
+memref::AllocaOp conversion::createAlloca(PatternRewriter &rewriter,
+                                          Location loc, MemRefType memrefType) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, memref::AllocaOp::getOperationName());
+
+  memref::AllocaOp::build(builder, state, memrefType);
+  return cast<memref::AllocaOp>(rewriter.create(state));
+}
+
 /// Builds, creates and inserts a memref::LoadOp.
 memref::LoadOp conversion::createLoad(PatternRewriter &rewriter, Location loc,
                                       Value memref, ValueRange indices) {
@@ -108,6 +128,30 @@ memref::CopyOp conversion::createCopy(PatternRewriter &rewriter, Location loc,
   return cast<memref::CopyOp>(rewriter.create(state));
 }
 
+/// Builds, creates and inserts a memref::AtomicRMWOp.
+memref::AtomicRMWOp conversion::createAtomicRMW(PatternRewriter &rewriter,
+                                                Location loc,
+                                                arith::AtomicRMWKind kind,
+                                                Value value, Value memref,
+                                                ValueRange indices) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, memref::AtomicRMWOp::getOperationName());
+
+  memref::AtomicRMWOp::build(builder, state, value.getType(), kind, value,
+                             memref, indices);
+  return cast<memref::AtomicRMWOp>(rewriter.create(state));
+}
+
+/// Builds, creates and inserts a memref::DimOp.
+memref::DimOp conversion::createDim(PatternRewriter &rewriter, Location loc,
+                                    Value memref, int64_t index) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, memref::DimOp::getOperationName());
+
+  memref::DimOp::build(builder, state, memref, index);
+  return cast<memref::DimOp>(rewriter.create(state));
+}
+
 /// Allocates a symbol as a memref<i64> if it's not already allocated and
 /// populates the symbol map.
 void conversion::allocSymbol(PatternRewriter &rewriter, Location loc,
@@ -141,6 +185,17 @@ arith::ConstantIntOp conversion::createConstantInt(PatternRewriter &rewriter,
   return cast<arith::ConstantIntOp>(rewriter.create(state));
 }
 
+/// Builds, creates and inserts an arith::ConstantIndexOp.
+arith::ConstantIndexOp
+conversion::createConstantIndex(PatternRewriter &rewriter, Location loc,
+                                int64_t val) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, arith::ConstantIndexOp::getOperationName());
+
+  arith::ConstantIndexOp::build(builder, state, val);
+  return cast<arith::ConstantIndexOp>(rewriter.create(state));
+}
+
 /// Builds, creates and inserts an arith::AddIOp.
 arith::AddIOp conversion::createAddI(PatternRewriter &rewriter, Location loc,
                                      Value a, Value b) {
@@ -202,6 +257,16 @@ arith::RemSIOp conversion::createRemSI(PatternRewriter &rewriter, Location loc,
   return cast<arith::RemSIOp>(rewriter.create(state));
 }
 
+/// Builds, creates and inserts an arith::RemUIOp.
+arith::RemUIOp conversion::createRemUI(PatternRewriter &rewriter, Location loc,
+                                       Value a, Value b) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, arith::RemUIOp::getOperationName());
+
+  arith::RemUIOp::build(builder, state, a, b);
+  return cast<arith::RemUIOp>(rewriter.create(state));
+}
+
 /// Builds, creates and inserts an arith::OrIOp.
 arith::OrIOp conversion::createOrI(PatternRewriter &rewriter, Location loc,
                                    Value a, Value b) {
@@ -222,6 +287,16 @@ arith::AndIOp conversion::createAndI(PatternRewriter &rewriter, Location loc,
   return cast<arith::AndIOp>(rewriter.create(state));
 }
 
+/// Builds, creates and inserts an arith::MinSIOp.
+arith::MinSIOp conversion::createMinSI(PatternRewriter &rewriter, Location loc,
+                                       Value a, Value b) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, arith::MinSIOp::getOperationName());
+
+  arith::MinSIOp::build(builder, state, a, b);
+  return cast<arith::MinSIOp>(rewriter.create(state));
+}
+
 /// Builds, creates and inserts an arith::XOrIOp.
 arith::XOrIOp conversion::createXOrI(PatternRewriter &rewriter, Location loc,
                                      Value a, Value b) {
@@ -306,6 +381,39 @@ scf::ParallelOp conversion::createParallel(PatternRewriter &rewriter,
   return cast<scf::ParallelOp>(rewriter.create(state));
 }
 
+/// Builds, creates and inserts a scf::ForOp with an empty body.
+scf::ForOp conversion::createFor(PatternRewriter &rewriter, Location loc,
+                                 Value lowerBound, Value upperBound,
+                                 Value step) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, scf::ForOp::getOperationName());
+
+  // Providing a body builder prevents the creation of the terminator
+  scf::ForOp::build(builder, state, lowerBound, upperBound, step, {},
+                    [](OpBuilder &, Location, Value, ValueRange) {});
+  return cast<scf::ForOp>(rewriter.create(state));
+}
+
+/// Builds, creates and inserts a scf::WhileOp without results and with empty
+/// regions.
+scf::WhileOp conversion::createWhile(PatternRewriter &rewriter, Location loc) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, scf::WhileOp::getOperationName());
+
+  scf::WhileOp::build(builder, state, TypeRange(), ValueRange());
+  return cast<scf::WhileOp>(rewriter.create(state));
+}
+
+/// Builds, creates and inserts a scf::ConditionOp.
+scf::ConditionOp conversion::createCondition(PatternRewriter &rewriter,
+                                             Location loc, Value condition) {
+  OpBuilder builder(loc->getContext());
+  OperationState state(loc, scf::ConditionOp::getOperationName());
+
+  scf::ConditionOp::build(builder, state, condition, ValueRange());
+  return cast<scf::ConditionOp>(rewriter.create(state));
+}
+
 /// Builds, creates and inserts a scf::YieldOp.
 scf::YieldOp conversion::createYield(PatternRewriter &rewriter, Location loc) {
   OpBuilder builder(loc->getContext());
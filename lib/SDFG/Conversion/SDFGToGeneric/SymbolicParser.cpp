@@ -67,6 +67,7 @@ LETTER      ::= [_a-zA-Z];
 
 #include "SDFG/Conversion/SDFGToGeneric/SymbolicParser.h"
 #include "SDFG/Conversion/SDFGToGeneric/OpCreators.h"
+#include "llvm/Support/MathExtras.h"
 #include <regex>
 
 using namespace mlir;
@@ -74,6 +75,55 @@ using namespace sdfg::conversion;
 
 namespace mlir::sdfg::conversion {
 
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+/// Returns true if the provided operation or any nested operation stores to
+/// the provided memref.
+static bool storesTo(Operation *op, Value memref) {
+  WalkResult result = op->walk([&](memref::StoreOp store) {
+    return store.getMemRef() == memref ? WalkResult::interrupt()
+                                       : WalkResult::advance();
+  });
+  return result.wasInterrupted();
+}
+
+/// Returns a load of the provided symbol. Symbols do not change inside of
+/// loops, so the load is hoisted out of all loops that neither define nor store
+/// to the symbol. A load of the symbol preceding the insertion point without an
+/// intervening store is reused.
+static Value loadSymbol(PatternRewriter &rewriter, Location loc,
+                        Value memref) {
+  Block *block = rewriter.getInsertionBlock();
+  Block::iterator point = rewriter.getInsertionPoint();
+
+  while (Operation *parent = block->getParentOp()) {
+    if (!isa<scf::ParallelOp, scf::ForOp, scf::WhileOp>(parent) ||
+        parent->isAncestor(memref.getParentRegion()->getParentOp()) ||
+        storesTo(parent, memref) || !parent->getBlock())
+      break;
+
+    point = Block::iterator(parent);
+    block = parent->getBlock();
+  }
+
+  for (Block::iterator it = point; it != block->begin();) {
+    Operation &op = *--it;
+
+    if (memref::LoadOp load = dyn_cast<memref::LoadOp>(op))
+      if (load.getMemRef() == memref && load.getIndices().empty())
+        return load;
+
+    if (storesTo(&op, memref))
+      break;
+  }
+
+  OpBuilder::InsertionGuard guard(rewriter);
+  rewriter.setInsertionPoint(block, point);
+  return createLoad(rewriter, loc, memref, {});
+}
+
 //===----------------------------------------------------------------------===//
 // AST Nodes
 //===----------------------------------------------------------------------===//
@@ -116,7 +166,7 @@ Value VarNode::codegen(PatternRewriter &rewriter, Location loc,
   }
 
   allocSymbol(rewriter, loc, name, symbolMap);
-  return createLoad(rewriter, loc, symbolMap[name], {});
+  return loadSymbol(rewriter, loc, symbolMap[name]);
 }
 
 /// Converts the assignment node into MLIR code. SymbolMap is used for
@@ -179,8 +229,13 @@ Value BinOpNode::codegen(PatternRewriter &rewriter, Location loc,
     return createDivSI(rewriter, loc, lVal, rVal);
   case FLOORDIV:
     return createFloorDivSI(rewriter, loc, lVal, rVal);
-  case MOD:
-    return createRemSI(rewriter, loc, lVal, rVal);
+  case MOD: {
+    // Symbolic expressions follow the Python semantics, so the result takes
+    // the sign of the divisor: l % r = l - (l // r) * r
+    Value quotient = createFloorDivSI(rewriter, loc, lVal, rVal);
+    Value product = createMulI(rewriter, loc, quotient, rVal);
+    return createSubI(rewriter, loc, lVal, product);
+  }
   case EXP:
     break;
   // TODO: Implement EXP case
@@ -217,6 +272,273 @@ Value BinOpNode::codegen(PatternRewriter &rewriter, Location loc,
   return lVal;
 }
 
+//===----------------------------------------------------------------------===//
+// Simplification
+//===----------------------------------------------------------------------===//
+
+/// Largest exponent for which a power of a symbol is expanded into
+/// multiplications.
+static constexpr int64_t maxExpandedExponent = 16;
+
+/// Returns the value of the provided node if it is an integer constant.
+static Optional<int64_t> getIntValue(const std::unique_ptr<ASTNode> &node) {
+  if (IntNode *intNode = dynamic_cast<IntNode *>(node.get()))
+    return intNode->value;
+  return std::nullopt;
+}
+
+/// Returns the value of the provided node if it is a boolean constant.
+static Optional<bool> getBoolValue(const std::unique_ptr<ASTNode> &node) {
+  if (BoolNode *boolNode = dynamic_cast<BoolNode *>(node.get()))
+    return boolNode->value;
+  return std::nullopt;
+}
+
+/// Returns an integer node if the provided value fits into one.
+static std::unique_ptr<ASTNode> makeInt(int64_t value) {
+  if (!llvm::isInt<32>(value))
+    return nullptr;
+  return std::make_unique<IntNode>(value);
+}
+
+/// Computes base ** exp by squaring. Returns std::nullopt on overflow.
+static Optional<int64_t> foldExp(int64_t base, int64_t exp) {
+  int64_t result = 1;
+
+  for (; exp > 0; exp >>= 1) {
+    if (exp & 1) {
+      result *= base;
+      if (!llvm::isInt<32>(result))
+        return std::nullopt;
+    }
+
+    if (exp > 1) {
+      base *= base;
+      if (!llvm::isInt<32>(base))
+        return std::nullopt;
+    }
+  }
+
+  return result;
+}
+
+/// Folds a binary operation on two integer constants. The operations follow the
+/// semantics of the generated operations, so the floor division and the modulo
+/// follow the Python semantics of symbolic expressions. Returns null if the
+/// operation cannot be folded.
+static std::unique_ptr<ASTNode> foldBinOp(BinOpNode::BinOp op, int64_t l,
+                                          int64_t r) {
+  switch (op) {
+  case BinOpNode::ADD:
+    return makeInt(l + r);
+  case BinOpNode::SUB:
+    return makeInt(l - r);
+  case BinOpNode::MUL:
+    return makeInt(l * r);
+  case BinOpNode::DIV:
+    if (r == 0)
+      return nullptr;
+    return makeInt(l / r);
+  case BinOpNode::FLOORDIV: {
+    if (r == 0)
+      return nullptr;
+    int64_t result = l / r;
+    if ((l % r != 0) && ((l < 0) != (r < 0)))
+      result--;
+    return makeInt(result);
+  }
+  case BinOpNode::MOD: {
+    if (r == 0)
+      return nullptr;
+    int64_t result = l % r;
+    if (result != 0 && ((result < 0) != (r < 0)))
+      result += r;
+    return makeInt(result);
+  }
+  case BinOpNode::EXP: {
+    if (r < 0)
+      return nullptr;
+    Optional<int64_t> result = foldExp(l, r);
+    if (!result.has_value())
+      return nullptr;
+    return makeInt(result.value());
+  }
+  case BinOpNode::BIT_OR:
+    return makeInt(l | r);
+  case BinOpNode::BIT_XOR:
+    return makeInt(l ^ r);
+  case BinOpNode::BIT_AND:
+    return makeInt(l & r);
+  case BinOpNode::LSHIFT:
+    if (r < 0 || r >= 32)
+      return nullptr;
+    return makeInt(static_cast<int64_t>(static_cast<uint64_t>(l) << r));
+  case BinOpNode::RSHIFT:
+    if (r < 0 || r >= 64)
+      return nullptr;
+    return makeInt(l >> r);
+  case BinOpNode::LOG_OR:
+    return std::make_unique<BoolNode>(l != 0 || r != 0);
+  case BinOpNode::LOG_AND:
+    return std::make_unique<BoolNode>(l != 0 && r != 0);
+  case BinOpNode::EQ:
+    return std::make_unique<BoolNode>(l == r);
+  case BinOpNode::NE:
+    return std::make_unique<BoolNode>(l != r);
+  case BinOpNode::LT:
+    return std::make_unique<BoolNode>(l < r);
+  case BinOpNode::LE:
+    return std::make_unique<BoolNode>(l <= r);
+  case BinOpNode::GT:
+    return std::make_unique<BoolNode>(l > r);
+  case BinOpNode::GE:
+    return std::make_unique<BoolNode>(l >= r);
+  }
+
+  return nullptr;
+}
+
+/// Simplifies the provided node in place.
+static void simplifyInPlace(std::unique_ptr<ASTNode> &node) {
+  if (std::unique_ptr<ASTNode> simplified = node->simplify())
+    node = std::move(simplified);
+}
+
+/// Base case: Nodes without children remain as they are.
+std::unique_ptr<ASTNode> ASTNode::simplify() { return nullptr; }
+
+/// Simplifies the assigned expression. Returns null as the assignment remains.
+std::unique_ptr<ASTNode> AssignNode::simplify() {
+  simplifyInPlace(expr);
+  return nullptr;
+}
+
+/// Simplifies the unary operation node. Returns the node replacing this node
+/// or null if this node remains.
+std::unique_ptr<ASTNode> UnOpNode::simplify() {
+  simplifyInPlace(expr);
+  Optional<int64_t> intVal = getIntValue(expr);
+
+  switch (op) {
+  case ADD:
+    return std::move(expr);
+  case SUB:
+    if (intVal.has_value())
+      return makeInt(-intVal.value());
+    // --x = x
+    if (UnOpNode *inner = dynamic_cast<UnOpNode *>(expr.get()))
+      if (inner->op == SUB)
+        return std::move(inner->expr);
+    break;
+  case LOG_NOT:
+    if (Optional<bool> boolVal = getBoolValue(expr))
+      return std::make_unique<BoolNode>(!boolVal.value());
+    break;
+  case BIT_NOT:
+    if (intVal.has_value())
+      return makeInt(~intVal.value());
+    break;
+  }
+
+  return nullptr;
+}
+
+/// Simplifies the binary operation node. Returns the node replacing this node
+/// or null if this node remains.
+std::unique_ptr<ASTNode> BinOpNode::simplify() {
+  simplifyInPlace(left);
+  simplifyInPlace(right);
+
+  Optional<int64_t> l = getIntValue(left);
+  Optional<int64_t> r = getIntValue(right);
+
+  if (l.has_value() && r.has_value())
+    return foldBinOp(op, l.value(), r.value());
+
+  // Algebraic identities and strength reduction
+  switch (op) {
+  case ADD:
+    if (r == 0)
+      return std::move(left);
+    if (l == 0)
+      return std::move(right);
+    break;
+  case SUB:
+    if (r == 0)
+      return std::move(left);
+    break;
+  case MUL:
+    if (l == 0 || r == 0)
+      return std::make_unique<IntNode>(0);
+    if (r == 1)
+      return std::move(left);
+    if (l == 1)
+      return std::move(right);
+    if (r.has_value() && *r > 0 && llvm::isPowerOf2_64(*r))
+      return std::make_unique<BinOpNode>(
+          std::move(left), LSHIFT,
+          std::make_unique<IntNode>(llvm::Log2_64(*r)));
+    if (l.has_value() && *l > 0 && llvm::isPowerOf2_64(*l))
+      return std::make_unique<BinOpNode>(
+          std::move(right), LSHIFT,
+          std::make_unique<IntNode>(llvm::Log2_64(*l)));
+    break;
+  case DIV:
+    if (r == 1)
+      return std::move(left);
+    break;
+  case FLOORDIV:
+    // Arithmetic shifts round towards negative infinity as well
+    if (r.has_value() && *r > 0 && llvm::isPowerOf2_64(*r))
+      return std::make_unique<BinOpNode>(
+          std::move(left), RSHIFT,
+          std::make_unique<IntNode>(llvm::Log2_64(*r)));
+    break;
+  case MOD:
+    if (r == 1)
+      return std::make_unique<IntNode>(0);
+    // Masking matches the Python semantics for positive divisors
+    if (r.has_value() && *r > 0 && llvm::isPowerOf2_64(*r))
+      return std::make_unique<BinOpNode>(std::move(left), BIT_AND,
+                                         std::make_unique<IntNode>(*r - 1));
+    break;
+  case EXP:
+    if (r == 0)
+      return std::make_unique<IntNode>(1);
+    if (r == 1)
+      return std::move(left);
+    // Expand powers of symbols into multiplications
+    if (VarNode *var = dynamic_cast<VarNode *>(left.get())) {
+      if (!r.has_value() || *r < 0 || *r > maxExpandedExponent)
+        break;
+
+      std::unique_ptr<ASTNode> product = std::move(left);
+      for (int64_t i = 1; i < *r; ++i)
+        product = std::make_unique<BinOpNode>(
+            std::move(product), MUL, std::make_unique<VarNode>(var->name));
+      return product;
+    }
+    break;
+  case BIT_OR:
+  case BIT_XOR:
+  case LSHIFT:
+  case RSHIFT:
+    if (r == 0)
+      return std::move(left);
+    if (l == 0 && (op == BIT_OR || op == BIT_XOR))
+      return std::move(right);
+    break;
+  case BIT_AND:
+    if (l == 0 || r == 0)
+      return std::make_unique<IntNode>(0);
+    break;
+  default:
+    break;
+  }
+
+  return nullptr;
+}
+
 //===----------------------------------------------------------------------===//
 // Tokenizer
 //===----------------------------------------------------------------------===//
@@ -261,6 +261,24 @@ static size_t getNumListSize(Operation *op, StringRef attrName) {
   return numList.size();
 }
 
+/// Returns true if the provided name is a DaCe instrumentation type.
+bool sdfg::isInstrumentationType(StringRef instrument) {
+  return llvm::is_contained({"No_Instrumentation", "Timer", "PAPI_Counters",
+                             "LIKWID_CPU", "LIKWID_GPU", "GPU_Events", "FPGA"},
+                            instrument);
+}
+
+/// Verifies that the optional instrument attribute of the provided operation
+/// names a DaCe instrumentation type.
+static LogicalResult verifyInstrument(Operation *op,
+                                      Optional<StringRef> instrument) {
+  if (instrument && !isInstrumentationType(*instrument))
+    return op->emitOpError("failed to verify that instrument is a valid "
+                           "instrumentation type");
+
+  return success();
+}
+
 //===----------------------------------------------------------------------===//
 // SDFGNode
 //===----------------------------------------------------------------------===//
@@ -270,7 +288,8 @@ SDFGNode SDFGNode::create(PatternRewriter &rewriter, Location loc,
                           unsigned num_args, TypeRange args) {
   OpBuilder builder(loc->getContext());
   OperationState state(loc, getOperationName());
-  build(builder, state, utils::generateID(), nullptr, num_args);
+  build(builder, state, utils::generateID(builder.getContext()), nullptr,
+        num_args);
   SDFGNode sdfg = cast<SDFGNode>(rewriter.create(state));
 
   std::vector<Location> locs = {};
@@ -291,8 +310,8 @@ ParseResult SDFGNode::parse(OpAsmParser &parser, OperationState &result) {
   if (parser.parseOptionalAttrDict(result.attributes))
     return failure();
 
-  IntegerAttr intAttr =
-      parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  IntegerAttr intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("ID", intAttr);
 
   SmallVector<OpAsmParser::Argument, 4> args;
@@ -337,7 +356,7 @@ LogicalResult SDFGNode::verify() {
   if (getBody().getOps<StateNode>().empty())
     return emitOpError() << "must contain at least one state";
 
-  return success();
+  return verifyInstrument(*this, getInstrument());
 }
 
 /// Verifies the correct structure of symbols in a SDFG node.
@@ -369,6 +388,113 @@ void SDFGNode::registerConfigs(GeneratorOpBuilder::Config &config) {
   for (unsigned i = 0; i < 3; ++i)
     (void)config.registerConfig<unsigned>(
         "sdfg.array_dim" + std::to_string(i) + "_limit", 64);
+
+  // Scale controls for stress inputs. Zero keeps the sampled sizes.
+  (void)config.registerConfig<unsigned>("sdfg.num_states", 0);
+  (void)config.registerConfig<unsigned>("sdfg.num_arrays", 0);
+}
+
+/// Appends a map nest storing to a sampled array to the provided state. A
+/// non-zero depth fixes the number of nested maps and a non-zero number of
+/// tasklets passes the stored value through a chain of tasklets.
+LogicalResult generateAffineMapStore(GeneratorOpBuilder &builder,
+                                     StateNode stateNode, unsigned depth = 0,
+                                     unsigned numTasklets = 0);
+
+/// Builds an affine map node iterating over the provided dimension size.
+Operation *buildAffineMapNode(GeneratorOpBuilder &builder, unsigned dim);
+
+/// Generates the entry state and a sampled number of additional states and
+/// edges in the provided SDFG node. If no entry state can be generated, the
+/// allocations are removed one by one until it succeeds.
+static LogicalResult
+generateSampledStates(GeneratorOpBuilder &builder, SDFGNode sdfgNode,
+                      SmallVectorImpl<Operation *> &allocations) {
+  // Ensure entry state.
+  Operation *entryStateOp = StateNode::generate(builder);
+  while (!entryStateOp && !allocations.empty()) {
+    allocations.back()->erase();
+    allocations.pop_back();
+    entryStateOp = StateNode::generate(builder);
+  }
+
+  if (!entryStateOp)
+    return failure();
+
+  StateNode entryState = cast<StateNode>(entryStateOp);
+
+  // Ensure maps and stores are present in scientific mode. Instead of
+  // regenerating the entry state until it contains both, the missing
+  // operations are appended to it. Without a suitable array the entry state
+  // is kept as is.
+  if (builder.config.get<unsigned>("sdfg.scientific").value() &&
+      (!hasNestedOp<MapNode>(entryState) || !hasNestedOp<StoreOp>(entryState)))
+    (void)generateAffineMapStore(builder, entryState);
+
+  sdfgNode.setEntry(entryState.getName());
+
+  // Generate additional states and edges.
+  unsigned length = builder.sampleGeometric<unsigned>();
+  for (unsigned i = 0; i < length; ++i)
+    if (builder.sampleBool())
+      StateNode::generate(builder);
+    else
+      EdgeOp::generate(builder);
+
+  return success();
+}
+
+/// Generates the provided number of states in the provided SDFG node and
+/// chains them with unconditional edges. Every state contains a map nest of
+/// depth `sdfg.map_depth` over one of the allocated arrays, which loads from
+/// the array, passes the value through a chain of `sdfg.tasklets_per_state`
+/// tasklets and stores it back. The size of the SDFG therefore only depends
+/// on the configuration. Fails if no statically sized array is allocated.
+static LogicalResult generateScaledStates(GeneratorOpBuilder &builder,
+                                          SDFGNode sdfgNode,
+                                          unsigned numStates) {
+  Block *body = &sdfgNode.getBody().front();
+  // At least one map is needed to iterate over the array.
+  unsigned depth =
+      std::max(builder.config.get<unsigned>("sdfg.map_depth").value(), 1u);
+  unsigned numTasklets =
+      builder.config.get<unsigned>("sdfg.tasklets_per_state").value();
+  StateNode prevState = nullptr;
+
+  for (unsigned i = 0; i < numStates; ++i) {
+    builder.setInsertionPointToEnd(body);
+    OperationState state(builder.getUnknownLoc(),
+                         StateNode::getOperationName());
+    StateNode::build(builder, state, utils::generateID(builder.getContext()),
+                     utils::generateName("state"));
+    Operation *op = builder.create(state);
+    if (!op)
+      return failure();
+
+    StateNode stateNode = cast<StateNode>(op);
+    builder.createBlock(&stateNode.getBody());
+
+    if (generateAffineMapStore(builder, stateNode, depth, numTasklets)
+            .failed())
+      return failure();
+
+    builder.setInsertionPointToEnd(body);
+    if (prevState) {
+      OperationState edgeState(builder.getUnknownLoc(),
+                               EdgeOp::getOperationName());
+      EdgeOp::build(builder, edgeState, prevState.getName(),
+                    stateNode.getName(), builder.getArrayAttr({}), "1",
+                    nullptr);
+      if (!builder.create(edgeState))
+        return failure();
+    } else {
+      sdfgNode.setEntry(stateNode.getName());
+    }
+
+    prevState = stateNode;
+  }
+
+  return success();
 }
 
 Operation *SDFGNode::generate(GeneratorOpBuilder &builder) {
@@ -381,7 +507,7 @@ Operation *SDFGNode::generate(GeneratorOpBuilder &builder) {
     return nullptr;
 
   OperationState state(builder.getUnknownLoc(), getOperationName());
-  build(builder, state, utils::generateID(), nullptr, 0);
+  build(builder, state, utils::generateID(builder.getContext()), nullptr, 0);
   Operation *op = builder.create(state);
   if (!op)
     return nullptr;
@@ -393,6 +519,9 @@ Operation *SDFGNode::generate(GeneratorOpBuilder &builder) {
   unsigned length = builder.sampleGeometric<unsigned>() + 1;
   if (!!builder.config.get<unsigned>("sdfg.scientific").value())
     length = builder.sampleUniform<unsigned>(2, 5);
+  if (unsigned numArrays =
+          builder.config.get<unsigned>("sdfg.num_arrays").value())
+    length = numArrays;
 
   llvm::SmallVector<Operation *> allocations;
   for (unsigned i = 0; i < length; ++i) {
@@ -402,40 +531,17 @@ Operation *SDFGNode::generate(GeneratorOpBuilder &builder) {
     allocations.push_back(op);
   }
 
-  // Ensure entry state.
-  Operation *entryStateOp = StateNode::generate(builder);
-  while (!entryStateOp) {
-    allocations.back()->erase();
-    allocations.pop_back();
-    entryStateOp = StateNode::generate(builder);
-    if (allocations.empty() && !entryStateOp)
+  // Generate states and edges.
+  if (unsigned numStates =
+          builder.config.get<unsigned>("sdfg.num_states").value()) {
+    if (generateScaledStates(builder, sdfgNode, numStates).failed()) {
+      sdfgNode.erase();
       return nullptr;
+    }
+  } else if (generateSampledStates(builder, sdfgNode, allocations).failed()) {
+    return nullptr;
   }
 
-  // Ensure maps and stores are present in scientific mode.
-  for (int i = 0; builder.config.get<unsigned>("sdfg.scientific").value() &&
-                  (!hasNestedOp<MapNode>(entryStateOp) ||
-                   !hasNestedOp<StoreOp>(entryStateOp)) &&
-                  i < 100;
-       ++i) {
-    entryStateOp->erase();
-    builder.setInsertionPointToEnd(&sdfgNode.getBody().back());
-    entryStateOp = StateNode::generate(builder);
-    while (!entryStateOp)
-      entryStateOp = StateNode::generate(builder);
-  }
-
-  StateNode entryState = cast<StateNode>(entryStateOp);
-  sdfgNode.setEntry(entryState.getName());
-
-  // Generate additional states and edges.
-  length = builder.sampleGeometric<unsigned>();
-  for (unsigned i = 0; i < length; ++i)
-    if (builder.sampleBool())
-      StateNode::generate(builder);
-    else
-      EdgeOp::generate(builder);
-
   // Add arguments.
   builder.setInsertionPointToEnd(body);
   llvm::SmallVector<Value> values = builder.collectValues(
@@ -528,7 +634,8 @@ NestedSDFGNode NestedSDFGNode::create(PatternRewriter &rewriter, Location loc,
   OpBuilder builder(loc->getContext());
   OperationState state(loc, getOperationName());
 
-  build(builder, state, utils::generateID(), nullptr, num_args, args);
+  build(builder, state, utils::generateID(builder.getContext()), nullptr,
+        num_args, args);
   NestedSDFGNode sdfg = cast<NestedSDFGNode>(rewriter.create(state));
 
   std::vector<Location> locs = {};
@@ -550,8 +657,8 @@ ParseResult NestedSDFGNode::parse(OpAsmParser &parser, OperationState &result) {
   if (parser.parseOptionalAttrDict(result.attributes))
     return failure();
 
-  IntegerAttr intAttr =
-      parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  IntegerAttr intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("ID", intAttr);
 
   SmallVector<OpAsmParser::Argument, 4> args;
@@ -661,8 +768,8 @@ Operation *NestedSDFGNode::generate(GeneratorOpBuilder &builder) {
   // Create NestedSDFGNode.
   OperationState state(builder.getUnknownLoc(),
                        NestedSDFGNode::getOperationName());
-  NestedSDFGNode::build(builder, state, utils::generateID(), nullptr, 0,
-                        arguments);
+  NestedSDFGNode::build(builder, state, utils::generateID(builder.getContext()),
+                        nullptr, 0, arguments);
   Operation *op = builder.create(state);
   if (!op)
     return nullptr;
@@ -728,7 +835,8 @@ StateNode StateNode::create(PatternRewriter &rewriter, Location loc,
                             StringRef name) {
   OpBuilder builder(loc->getContext());
   OperationState state(loc, getOperationName());
-  build(builder, state, utils::generateID(), utils::generateName(name.str()));
+  build(builder, state, utils::generateID(builder.getContext()),
+        utils::generateName(name.str()));
   StateNode stateNode = cast<StateNode>(rewriter.create(state));
   rewriter.createBlock(&stateNode.getBody());
   return stateNode;
@@ -743,7 +851,8 @@ StateNode StateNode::create(PatternRewriter &rewriter, Location loc) {
 StateNode StateNode::create(Location loc, StringRef name) {
   OpBuilder builder(loc->getContext());
   OperationState state(loc, getOperationName());
-  build(builder, state, utils::generateID(), utils::generateName(name.str()));
+  build(builder, state, utils::generateID(builder.getContext()),
+        utils::generateName(name.str()));
   return cast<StateNode>(Operation::create(state));
 }
 
@@ -752,8 +861,8 @@ ParseResult StateNode::parse(OpAsmParser &parser, OperationState &result) {
   if (parser.parseOptionalAttrDict(result.attributes))
     return failure();
 
-  IntegerAttr intAttr =
-      parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  IntegerAttr intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("ID", intAttr);
 
   StringAttr sym_nameAttr;
@@ -787,11 +896,15 @@ LogicalResult StateNode::verify() {
     if (oper.getDialect() != (*this)->getDialect() &&
         !dyn_cast<func::FuncOp>(oper))
       return emitOpError("does not support other dialects");
-  return success();
+
+  return verifyInstrument(*this, getInstrument());
 }
 
 void StateNode::registerConfigs(GeneratorOpBuilder::Config &config) {
   (void)config.registerConfig<unsigned>("sdfg.single_state", 1);
+  // Contents of the states generated by `sdfg.num_states`.
+  (void)config.registerConfig<unsigned>("sdfg.map_depth", 1);
+  (void)config.registerConfig<unsigned>("sdfg.tasklets_per_state", 1);
 }
 
 Operation *StateNode::generate(GeneratorOpBuilder &builder) {
@@ -814,7 +927,8 @@ Operation *StateNode::generate(GeneratorOpBuilder &builder) {
       return nullptr;
 
   OperationState state(builder.getUnknownLoc(), getOperationName());
-  build(builder, state, utils::generateID(), utils::generateName("state"));
+  build(builder, state, utils::generateID(builder.getContext()),
+        utils::generateName("state"));
   Operation *op = builder.create(state);
   if (!op)
     return nullptr;
@@ -840,7 +954,8 @@ TaskletNode TaskletNode::create(PatternRewriter &rewriter, Location location,
                                 ValueRange operands, TypeRange results) {
   OpBuilder builder(location->getContext());
   OperationState state(location, getOperationName());
-  build(builder, state, results, utils::generateID(), operands);
+  build(builder, state, results, utils::generateID(builder.getContext()),
+        operands);
 
   TaskletNode task = cast<TaskletNode>(rewriter.create(state));
 
@@ -857,7 +972,8 @@ TaskletNode TaskletNode::create(Location location, ValueRange operands,
                                 TypeRange results) {
   OpBuilder builder(location->getContext());
   OperationState state(location, getOperationName());
-  build(builder, state, results, utils::generateID(), operands);
+  build(builder, state, results, utils::generateID(builder.getContext()),
+        operands);
 
   TaskletNode task = cast<TaskletNode>(Operation::create(state));
 
@@ -874,8 +990,8 @@ ParseResult TaskletNode::parse(OpAsmParser &parser, OperationState &result) {
   if (parser.parseOptionalAttrDict(result.attributes))
     return failure();
 
-  IntegerAttr intAttr =
-      parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  IntegerAttr intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("ID", intAttr);
 
   SmallVector<OpAsmParser::Argument, 4> args;
@@ -907,7 +1023,7 @@ LogicalResult TaskletNode::verify() {
   if (getNumOperands() != getBody().getNumArguments())
     emitOpError() << "must have matching amount of operands and arguments";
 
-  return success();
+  return verifyInstrument(*this, getInstrument());
 }
 
 void TaskletNode::registerConfigs(GeneratorOpBuilder::Config &config) {
@@ -952,7 +1068,8 @@ Operation *TaskletNode::generate(GeneratorOpBuilder &builder) {
   if (!arguments.has_value())
     return nullptr;
 
-  build(builder, state, {}, utils::generateID(), arguments.value());
+  build(builder, state, {}, utils::generateID(builder.getContext()),
+        arguments.value());
   Operation *op = builder.create(state);
   if (!op)
     return nullptr;
@@ -1059,10 +1176,19 @@ std::string TaskletNode::getOutputName(unsigned idx) {
 // MapNode
 //===----------------------------------------------------------------------===//
 
+/// Returns true if the provided name is a DaCe schedule type supported on maps.
+static bool isMapSchedule(StringRef schedule) {
+  return llvm::is_contained(
+      {"Default", "Sequential", "MPI", "CPU_Multicore", "Unrolled",
+       "GPU_Default", "GPU_Device", "GPU_ThreadBlock",
+       "GPU_ThreadBlock_Dynamic", "GPU_Persistent", "FPGA_Device"},
+      schedule);
+}
+
 /// Attempts to parse a map node.
 ParseResult MapNode::parse(OpAsmParser &parser, OperationState &result) {
-  IntegerAttr intAttr =
-      parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  IntegerAttr intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("entryID", intAttr);
 
   if (parser.parseOptionalAttrDict(result.attributes))
@@ -1100,7 +1226,8 @@ ParseResult MapNode::parse(OpAsmParser &parser, OperationState &result) {
   if (parseRegion(parser, result, ivs, /*enableShadowing=*/false))
     return failure();
 
-  intAttr = parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("exitID", intAttr);
   return success();
 }
@@ -1145,17 +1272,72 @@ LogicalResult MapNode::verify() {
     return emitOpError("failed to verify that size of "
                        "steps matches size of arguments");
 
+  if (getSchedule() && !isMapSchedule(*getSchedule()))
+    return emitOpError("failed to verify that schedule is a valid "
+                       "map schedule");
+
+  if (getSchedule() && getSchedule()->startswith("GPU_") && var_count > 3)
+    return emitOpError("failed to verify that maps with a GPU schedule have "
+                       "at most three dimensions");
+
+  if (IntegerAttr collapse = getCollapseAttr())
+    if (collapse.getInt() < 1 || collapse.getInt() > (int64_t)var_count)
+      return emitOpError("failed to verify that collapse is between one "
+                         "and the number of arguments");
+
+  if (IntegerAttr chunkSize = getOmpChunkSizeAttr())
+    if (chunkSize.getInt() < 0)
+      return emitOpError("failed to verify that omp_chunk_size is a "
+                         "non-negative integer");
+
+  if (ArrayAttr tileSizes = getTileSizesAttr()) {
+    if (tileSizes.size() != var_count)
+      return emitOpError("failed to verify that size of "
+                         "tile sizes matches size of arguments");
+
+    for (Attribute tileSize : tileSizes)
+      if (tileSize.cast<IntegerAttr>().getInt() < 1)
+        return emitOpError("failed to verify that tile sizes are "
+                           "positive integers");
+  }
+
   // Verify that no other dialect is used in the body
   for (Operation &oper : getBody().getOps())
     if (oper.getDialect() != (*this)->getDialect())
       return emitOpError("does not support other dialects");
 
-  return success();
+  return verifyInstrument(*this, getInstrument());
 }
 
 /// Returns the body of the map node.
 Region &MapNode::getLoopBody() { return getBody(); }
 
+/// Builds an affine map node iterating over the provided dimension size. The
+/// body is left empty and the insertion point is not changed.
+Operation *buildAffineMapNode(GeneratorOpBuilder &builder, unsigned dim) {
+  OperationState state(builder.getUnknownLoc(), MapNode::getOperationName());
+
+  ArrayAttr numList = builder.getArrayAttr({builder.getI32IntegerAttr(-1)});
+  state.addAttribute("lowerBounds_numList", numList);
+  state.addAttribute("upperBounds_numList", numList);
+  state.addAttribute("steps_numList", numList);
+
+  MapNode::build(builder, state, sdfg::utils::generateID(builder.getContext()),
+                 sdfg::utils::generateID(builder.getContext()), {},
+                 builder.getArrayAttr({builder.getIndexAttr(0)}),
+                 builder.getArrayAttr({builder.getIndexAttr(dim - 1)}),
+                 builder.getArrayAttr({builder.getIndexAttr(1)}));
+  Operation *op = builder.create(state);
+  if (!op)
+    return nullptr;
+
+  OpBuilder::InsertionGuard guard(builder);
+  MapNode mapNode = cast<MapNode>(op);
+  builder.createBlock(&mapNode.getBody(), {}, {builder.getIndexType()},
+                      builder.getUnknownLocs(1));
+  return op;
+}
+
 /// Affine MapNodes.
 Operation *generateAffineMapNode(GeneratorOpBuilder &builder) {
   // Select array and dimension
@@ -1206,27 +1388,14 @@ Operation *generateAffineMapNode(GeneratorOpBuilder &builder) {
     possibleDims.push_back(dim);
   unsigned dim = builder.sample(possibleDims).value();
 
-  OperationState state(builder.getUnknownLoc(), MapNode::getOperationName());
-
-  ArrayAttr numList = builder.getArrayAttr({builder.getI32IntegerAttr(-1)});
-  state.addAttribute("lowerBounds_numList", numList);
-  state.addAttribute("upperBounds_numList", numList);
-  state.addAttribute("steps_numList", numList);
-
-  MapNode::build(builder, state, sdfg::utils::generateID(),
-                 sdfg::utils::generateID(), {},
-                 builder.getArrayAttr({builder.getIndexAttr(0)}),
-                 builder.getArrayAttr({builder.getIndexAttr(dim - 1)}),
-                 builder.getArrayAttr({builder.getIndexAttr(1)}));
-  Operation *op = builder.create(state);
+  Operation *op = buildAffineMapNode(builder, dim);
   if (!op)
     return nullptr;
 
   MapNode mapNode = cast<MapNode>(op);
-  Block *body =
-      builder.createBlock(&mapNode.getBody(), {}, {builder.getIndexType()},
-                          builder.getUnknownLocs(1));
-  if (builder.generateBlock(body).failed() || body->empty()) {
+  builder.setInsertionPointToStart(&mapNode.getBody().front());
+  if (builder.generateBlock(&mapNode.getBody().front()).failed() ||
+      mapNode.getBody().front().empty()) {
     mapNode.erase();
     return nullptr;
   }
@@ -1294,8 +1463,9 @@ Operation *MapNode::generate(GeneratorOpBuilder &builder) {
   state.addAttribute("upperBounds_numList", builder.getArrayAttr(ub_numList));
   state.addAttribute("steps_numList", builder.getArrayAttr(st_numList));
 
-  MapNode::build(builder, state, utils::generateID(), utils::generateID(),
-                 operands, builder.getArrayAttr(lb_attrList),
+  MapNode::build(builder, state, utils::generateID(builder.getContext()),
+                 utils::generateID(builder.getContext()), operands,
+                 builder.getArrayAttr(lb_attrList),
                  builder.getArrayAttr(ub_attrList),
                  builder.getArrayAttr(st_attrList));
   Operation *op = builder.create(state);
@@ -1320,8 +1490,8 @@ Operation *MapNode::generate(GeneratorOpBuilder &builder) {
 
 /// Attempts to parse a consume node.
 ParseResult ConsumeNode::parse(OpAsmParser &parser, OperationState &result) {
-  IntegerAttr intAttr =
-      parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  IntegerAttr intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("entryID", intAttr);
 
   if (parser.parseOptionalAttrDict(result.attributes))
@@ -1366,7 +1536,8 @@ ParseResult ConsumeNode::parse(OpAsmParser &parser, OperationState &result) {
   if (parser.parseRegion(*body, ivs))
     return failure();
 
-  intAttr = parser.getBuilder().getI32IntegerAttr(utils::generateID());
+  intAttr = parser.getBuilder().getI32IntegerAttr(
+      utils::generateID(parser.getContext()));
   result.addAttribute("exitID", intAttr);
   return success();
 }
@@ -1388,6 +1559,9 @@ LogicalResult ConsumeNode::verify() {
     return emitOpError("failed to verify that number of "
                        "processing elements is at least one");
 
+  if (getChunksize().has_value() && getChunksize().value().isNonPositive())
+    return emitOpError("failed to verify that chunk size is at least one");
+
   // Verify that no other dialect is used in the body
   for (Operation &oper : getBody().getOps())
     if (oper.getDialect() != (*this)->getDialect())
@@ -1544,6 +1718,11 @@ LogicalResult EdgeOp::verifySymbolUses(SymbolTableCollection &symbolTable) {
   return success();
 }
 
+/// Returns true if the edge is always taken and does not assign any symbols.
+bool EdgeOp::isUnconditional() {
+  return getCondition() == "1" && getAssign().empty() && !getRef();
+}
+
 Operation *EdgeOp::generate(GeneratorOpBuilder &builder) {
   Block *block = builder.getBlock();
   if (!block)
@@ -1655,6 +1834,30 @@ LogicalResult AllocOp::verify() {
     return emitOpError("failed to verify that return type "
                        "doesn't contain dimensions of size zero");
 
+  if (getStorage().has_value() &&
+      !llvm::is_contained({"Default", "Register", "CPU_Heap", "CPU_ThreadLocal",
+                           "GPU_Global", "GPU_Shared"},
+                          getStorage().value()))
+    return emitOpError("failed to verify that storage is a valid "
+                       "storage type");
+
+  if (getLifetime().has_value() &&
+      !llvm::is_contained({"Scope", "State", "SDFG", "Persistent"},
+                          getLifetime().value()))
+    return emitOpError("failed to verify that lifetime is a valid "
+                       "allocation lifetime");
+
+  if (getStorage().value_or("") == "Register" && isStream())
+    return emitOpError("failed to verify that streams are not "
+                       "stored in registers");
+
+  if (getBufferSize().has_value() && !isStream())
+    return emitOpError("failed to verify that buffer size is only "
+                       "specified for streams");
+
+  if (getBufferSize().has_value() && getBufferSize().value().isNonPositive())
+    return emitOpError("failed to verify that buffer size is at least one");
+
   return success();
 }
 
@@ -2043,6 +2246,12 @@ StoreOp StoreOp::create(Location loc, Value val, Value mem) {
   return cast<StoreOp>(Operation::create(state));
 }
 
+/// Returns true if the provided string is a write-conflict resolution.
+static bool isWCR(StringRef wcr) {
+  return llvm::is_contained({"add", "mul", "min", "max", "and", "or"}, wcr) ||
+         wcr.startswith("lambda");
+}
+
 /// Attempts to parse a store operation.
 ParseResult StoreOp::parse(OpAsmParser &parser, OperationState &result) {
   if (parser.parseOptionalAttrDict(result.attributes))
@@ -2109,6 +2318,10 @@ LogicalResult StoreOp::verify() {
   if (idx_size != mem_size)
     return emitOpError("incorrect number of indices for store");
 
+  if (getWcr().has_value() && !isWCR(getWcr().value()))
+    return emitOpError("failed to verify that wcr is a valid write-conflict "
+                       "resolution");
+
   return success();
 }
 
@@ -2170,6 +2383,162 @@ Operation *generateAffineStoreOp(GeneratorOpBuilder &builder) {
   return builder.create(state);
 }
 
+/// Builds a tasklet taking the provided value and returning a value of the
+/// same type. Integers and floats are doubled, other values are forwarded.
+static Operation *buildChainTasklet(GeneratorOpBuilder &builder,
+                                    Value input) {
+  Type type = input.getType();
+  OperationState state(builder.getUnknownLoc(),
+                       TaskletNode::getOperationName());
+  TaskletNode::build(builder, state, {},
+                     utils::generateID(builder.getContext()), input);
+  Operation *op = builder.create(state);
+  if (!op)
+    return nullptr;
+
+  OpBuilder::InsertionGuard guard(builder);
+  TaskletNode taskletNode = cast<TaskletNode>(op);
+  Block *body = builder.createBlock(&taskletNode.getBody(), {}, type,
+                                    builder.getUnknownLoc());
+  builder.setInsertionPointToEnd(body);
+  Value result = body->getArgument(0);
+
+  StringRef opName = type.isa<FloatType>() ? "arith.addf"
+                     : type.isIntOrIndex() ? "arith.addi"
+                                           : "";
+  if (!opName.empty()) {
+    OperationState addState(builder.getUnknownLoc(), opName);
+    addState.addOperands({result, result});
+    addState.addTypes(type);
+    Operation *addOp = builder.create(addState);
+    if (!addOp) {
+      taskletNode.erase();
+      return nullptr;
+    }
+    result = addOp->getResult(0);
+  }
+
+  state = OperationState(builder.getUnknownLoc(), ReturnOp::getOperationName());
+  ReturnOp::build(builder, state, result);
+  if (!builder.create(state)) {
+    taskletNode.erase();
+    return nullptr;
+  }
+
+  llvm::SmallVector<Type> resultTypes = {type};
+  op = builder.addResultTypes(taskletNode, resultTypes);
+  taskletNode.erase();
+  return op;
+}
+
+/// Appends a map nest iterating over a sampled array to the provided state.
+/// The innermost map stores to that array and loads the stored value from it
+/// if no other value of the element type is available. A non-zero depth
+/// fixes the number of maps: surplus maps have a single iteration and surplus
+/// dimensions are accessed at index zero. With tasklets, the value is always
+/// loaded and passed through a chain of that many tasklets before the store.
+LogicalResult generateAffineMapStore(GeneratorOpBuilder &builder,
+                                     StateNode stateNode, unsigned depth,
+                                     unsigned numTasklets) {
+  OpBuilder::InsertionGuard guard(builder);
+  builder.setInsertionPointToEnd(&stateNode.getBody().front());
+
+  // Sample a statically sized array.
+  llvm::Optional<Value> array = builder.sampleValue(
+      [](const Value &v) {
+        ArrayType arrayType = v.getType().dyn_cast<ArrayType>();
+        return arrayType && !arrayType.getIntegers().empty() &&
+               arrayType.getSymbols().empty() &&
+               arrayType.getDimensions().getUndefRank() == 0 &&
+               !arrayType.getDimensions().hasZeros();
+      },
+      /*unusedFirst=*/true);
+
+  if (!array.has_value())
+    return failure();
+  Value arrayValue = array.value();
+  ArrayType arrayType = arrayValue.getType().cast<ArrayType>();
+
+  // Create a map for every dimension.
+  ArrayRef<int64_t> dims = arrayType.getIntegers();
+  if (depth == 0)
+    depth = dims.size();
+
+  MapNode outerMap = nullptr;
+  llvm::SmallVector<Value> indices;
+  for (unsigned d = 0; d < depth; ++d) {
+    Operation *op = buildAffineMapNode(builder, d < dims.size() ? dims[d] : 1);
+    if (!op) {
+      if (outerMap)
+        outerMap.erase();
+      return failure();
+    }
+
+    MapNode mapNode = cast<MapNode>(op);
+    if (!outerMap)
+      outerMap = mapNode;
+
+    if (d < dims.size())
+      indices.push_back(mapNode.getBody().getArgument(0));
+    builder.setInsertionPointToStart(&mapNode.getBody().front());
+  }
+
+  // Dimensions without a map are accessed at index zero.
+  SmallVector<Attribute> constIndices;
+  SmallVector<Attribute> numList;
+  for (unsigned d = 0; d < dims.size(); ++d) {
+    if (d < depth) {
+      numList.push_back(builder.getI32IntegerAttr(d));
+      continue;
+    }
+
+    int32_t constIdx = constIndices.size();
+    numList.push_back(builder.getI32IntegerAttr(-constIdx - 1));
+    constIndices.push_back(builder.getI32IntegerAttr(0));
+  }
+
+  // Sample value or load it from the array.
+  llvm::Optional<Value> value;
+  if (numTasklets == 0)
+    value = builder.sampleValueOfType(arrayType.getElementType(),
+                                      /*unusedFirst=*/true);
+
+  if (!value.has_value()) {
+    OperationState state(builder.getUnknownLoc(), LoadOp::getOperationName());
+    state.addAttribute("indices", builder.getArrayAttr(constIndices));
+    state.addAttribute("indices_numList", builder.getArrayAttr(numList));
+    LoadOp::build(builder, state, arrayType.getElementType(), indices,
+                  arrayValue);
+    Operation *loadOp = builder.create(state);
+    if (!loadOp) {
+      outerMap.erase();
+      return failure();
+    }
+    value = loadOp->getResult(0);
+  }
+
+  for (unsigned t = 0; t < numTasklets; ++t) {
+    Operation *tasklet = buildChainTasklet(builder, value.value());
+    if (!tasklet) {
+      outerMap.erase();
+      return failure();
+    }
+    value = tasklet->getResult(0);
+  }
+
+  // Create StoreOp.
+  OperationState state(builder.getUnknownLoc(), StoreOp::getOperationName());
+  state.addAttribute("indices", builder.getArrayAttr(constIndices));
+  state.addAttribute("indices_numList", builder.getArrayAttr(numList));
+  StoreOp::build(builder, state, indices, value.value(), arrayValue);
+  if (!builder.create(state)) {
+    outerMap.erase();
+    return failure();
+  }
+
+  return success();
+}
+
 Operation *StoreOp::generate(GeneratorOpBuilder &builder) {
   Block *block = builder.getBlock();
   if (!block)
@@ -0,0 +1,124 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file defines a pass collapsing linear chains of states in the SDFG
+/// dialect.
+
+#include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/PassDetail.h"
+#include "SDFG/Transforms/Passes.h"
+#include "SDFG/Utils/Utils.h"
+
+using namespace mlir;
+using namespace sdfg;
+using namespace transforms;
+
+//===----------------------------------------------------------------------===//
+// State Collapsing
+//===----------------------------------------------------------------------===//
+
+/// Collapses every linear chain of states joined by unconditional edges into a
+/// single state.
+static void collapseStates(Operation *sdfg) {
+  Block &body = sdfg->getRegion(0).front();
+  MLIRContext *ctx = sdfg->getContext();
+
+  if (body.getOps<StateNode>().empty())
+    return;
+
+  SmallVector<StringRef> order;
+  llvm::StringMap<StateNode> states;
+  for (StateNode state : body.getOps<StateNode>()) {
+    order.push_back(state.getSymName());
+    states[state.getSymName()] = state;
+  }
+
+  llvm::StringMap<SmallVector<EdgeOp>> outEdges;
+  llvm::StringMap<SmallVector<EdgeOp>> inEdges;
+  for (EdgeOp edge : body.getOps<EdgeOp>()) {
+    outEdges[edge.getSrc()].push_back(edge);
+    inEdges[edge.getDest()].push_back(edge);
+  }
+
+  StringRef entryName = utils::getEntryStateName(sdfg);
+
+  for (StringRef name : order) {
+    StateNode state = states.lookup(name);
+    if (!state)
+      continue;
+
+    sdfg::utils::Accesses accesses;
+    if (sdfg::utils::collectAccesses(state, accesses).failed())
+      continue;
+
+    // Absorbs the successors of the state as long as the chain is linear.
+    while (outEdges[name].size() == 1) {
+      EdgeOp edge = outEdges[name].front();
+      StringRef succName = edge.getDest();
+
+      if (succName == name || succName == entryName ||
+          !edge.isUnconditional() || inEdges[succName].size() != 1)
+        break;
+
+      StateNode succ = states.lookup(succName);
+      sdfg::utils::Accesses succAccesses;
+      if (!succ || sdfg::utils::collectAccesses(succ, succAccesses).failed())
+        break;
+
+      // Reads and writes of the same container are chained by access nodes,
+      // but nothing orders a read in the state before a later write.
+      if (llvm::any_of(succAccesses.writes,
+                       [&](Value v) { return accesses.reads.contains(v); }))
+        break;
+
+      Block &block = state.getBody().front();
+      Block &succBlock = succ.getBody().front();
+      block.getOperations().splice(block.end(), succBlock.getOperations());
+
+      FlatSymbolRefAttr srcAttr = FlatSymbolRefAttr::get(ctx, name);
+      SmallVector<EdgeOp> succOutEdges = outEdges[succName];
+      for (EdgeOp outEdge : succOutEdges)
+        outEdge.setSrcAttr(srcAttr);
+
+      outEdges[name] = succOutEdges;
+      outEdges.erase(succName);
+      inEdges.erase(succName);
+      states.erase(succName);
+
+      edge.erase();
+      succ.erase();
+
+      accesses.reads.insert(succAccesses.reads.begin(),
+                            succAccesses.reads.end());
+      accesses.writes.insert(succAccesses.writes.begin(),
+                             succAccesses.writes.end());
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct CollapseStatesPass
+    : public sdfg::transforms::CollapseStatesPassBase<CollapseStatesPass> {
+  void runOnOperation() override;
+};
+} // namespace
+
+/// Runs the pass on the top-level module operation.
+void CollapseStatesPass::runOnOperation() {
+  SmallVector<Operation *> sdfgs;
+  getOperation().walk([&](Operation *op) {
+    if (isa<SDFGNode, NestedSDFGNode>(op))
+      sdfgs.push_back(op);
+  });
+
+  for (Operation *sdfg : sdfgs)
+    collapseStates(sdfg);
+}
+
+/// Returns a unique pointer to this pass.
+std::unique_ptr<Pass> transforms::createCollapseStatesPass() {
+  return std::make_unique<CollapseStatesPass>();
+}
@@ -0,0 +1,258 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file defines a pass eliminating redundant loads, stores, transients and
+/// states in the SDFG dialect.
+
+#include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/PassDetail.h"
+#include "SDFG/Transforms/Passes.h"
+#include "SDFG/Utils/Utils.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+using namespace mlir;
+using namespace sdfg;
+using namespace transforms;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+/// Returns true if the provided value is a transient that is only accessed by
+/// loads and stores. No other operation can read or write such a transient.
+static bool isPlainTransient(Value array) {
+  AllocOp allocOp = array.getDefiningOp<AllocOp>();
+  if (!allocOp || !allocOp.getTransient() || allocOp.isStream())
+    return false;
+
+  for (Operation *user : array.getUsers()) {
+    if (isa<LoadOp>(user))
+      continue;
+
+    StoreOp storeOp = dyn_cast<StoreOp>(user);
+    if (!storeOp || storeOp.getVal() == array)
+      return false;
+  }
+
+  return true;
+}
+
+/// Returns true if the provided tasklet is unused and free of side effects.
+static bool isDeadTasklet(TaskletNode tasklet) {
+  if (!tasklet->use_empty())
+    return false;
+
+  WalkResult result = tasklet.getBody().walk([](Operation *op) {
+    if (op->hasTrait<OpTrait::IsTerminator>() || isMemoryEffectFree(op))
+      return WalkResult::advance();
+    return WalkResult::interrupt();
+  });
+
+  return !result.wasInterrupted();
+}
+
+/// Returns true if the store writes the element the load reads, i.e. both use
+/// the same index operands and constant indices.
+static bool accessesSameElement(StoreOp storeOp, LoadOp loadOp) {
+  return llvm::equal(storeOp.getIndices(), loadOp.getIndices()) &&
+         storeOp->getAttr("indices") == loadOp->getAttr("indices") &&
+         storeOp->getAttr("indices_numList") ==
+             loadOp->getAttr("indices_numList");
+}
+
+//===----------------------------------------------------------------------===//
+// Load & Store Elimination
+//===----------------------------------------------------------------------===//
+
+/// Forwards stored values to subsequent loads of the same transient element in
+/// the provided block and its nested scopes. Returns true if any load was
+/// replaced.
+static bool forwardStores(Block &block) {
+  bool changed = false;
+  // Maps every transient to its last store in the block.
+  llvm::DenseMap<Value, StoreOp> lastStores;
+
+  for (Operation &op : llvm::make_early_inc_range(block)) {
+    if (StoreOp storeOp = dyn_cast<StoreOp>(op)) {
+      // Stores with write-conflict resolution combine the value with the
+      // element, so the stored value is not the value of the element.
+      if (storeOp.getWcr().has_value())
+        lastStores.erase(storeOp.getArr());
+      else if (isPlainTransient(storeOp.getArr()))
+        lastStores[storeOp.getArr()] = storeOp;
+      continue;
+    }
+
+    if (LoadOp loadOp = dyn_cast<LoadOp>(op)) {
+      StoreOp storeOp = lastStores.lookup(loadOp.getArr());
+      if (!storeOp || !accessesSameElement(storeOp, loadOp))
+        continue;
+
+      loadOp.getRes().replaceAllUsesWith(storeOp.getVal());
+      loadOp.erase();
+      changed = true;
+      continue;
+    }
+
+    if (op.getNumRegions() == 0 || isa<TaskletNode>(op))
+      continue;
+
+    // Stores in nested scopes overwrite the tracked elements.
+    op.walk([&](StoreOp storeOp) { lastStores.erase(storeOp.getArr()); });
+
+    if (isa<MapNode, ConsumeNode>(op))
+      for (Block &nested : op.getRegion(0))
+        changed |= forwardStores(nested);
+  }
+
+  return changed;
+}
+
+/// Removes unused loads and side effect free tasklets. Returns true if any
+/// operation was removed.
+static bool eraseDeadOps(ModuleOp module) {
+  SmallVector<Operation *> deadOps;
+
+  module.walk([&](Operation *op) {
+    if (isa<LoadOp>(op) && op->use_empty())
+      deadOps.push_back(op);
+
+    if (TaskletNode tasklet = dyn_cast<TaskletNode>(op))
+      if (isDeadTasklet(tasklet))
+        deadOps.push_back(op);
+  });
+
+  for (Operation *op : deadOps)
+    op->erase();
+
+  return !deadOps.empty();
+}
+
+/// Removes transients that are never read together with the stores into them.
+/// Returns true if any transient was removed.
+static bool eraseUnreadTransients(ModuleOp module) {
+  SmallVector<AllocOp> unread;
+
+  module.walk([&](AllocOp allocOp) {
+    if (isPlainTransient(allocOp.getResult()) &&
+        llvm::none_of(allocOp->getUsers(),
+                      [](Operation *user) { return isa<LoadOp>(user); }))
+      unread.push_back(allocOp);
+  });
+
+  for (AllocOp allocOp : unread) {
+    for (Operation *user : llvm::make_early_inc_range(allocOp->getUsers()))
+      user->erase();
+    allocOp.erase();
+  }
+
+  return !unread.empty();
+}
+
+//===----------------------------------------------------------------------===//
+// State Elimination
+//===----------------------------------------------------------------------===//
+
+/// Merges one empty state into its unconditional successor or predecessor.
+/// Returns true if a state was removed.
+static bool mergeEmptyState(Operation *sdfg) {
+  Block &body = sdfg->getRegion(0).front();
+  MLIRContext *ctx = sdfg->getContext();
+
+  if (body.getOps<StateNode>().empty())
+    return false;
+
+  llvm::StringMap<StateNode> states;
+  for (StateNode state : body.getOps<StateNode>())
+    states[state.getSymName()] = state;
+
+  llvm::StringMap<SmallVector<EdgeOp>> outEdges;
+  llvm::StringMap<SmallVector<EdgeOp>> inEdges;
+  for (EdgeOp edge : body.getOps<EdgeOp>()) {
+    outEdges[edge.getSrc()].push_back(edge);
+    inEdges[edge.getDest()].push_back(edge);
+  }
+
+  StringRef entryName = utils::getEntryStateName(sdfg);
+
+  for (EdgeOp edge : body.getOps<EdgeOp>()) {
+    StringRef src = edge.getSrc();
+    StringRef dest = edge.getDest();
+
+    if (src == dest || !edge.isUnconditional() || outEdges[src].size() != 1 ||
+        inEdges[dest].size() != 1)
+      continue;
+
+    StateNode srcState = states.lookup(src);
+    StateNode destState = states.lookup(dest);
+    if (!srcState || !destState)
+      continue;
+
+    // Empty successor: its outgoing edges leave from the predecessor instead.
+    if (destState.getBody().front().empty() && dest != entryName) {
+      FlatSymbolRefAttr srcAttr = FlatSymbolRefAttr::get(ctx, src);
+      for (EdgeOp outEdge : outEdges[dest])
+        outEdge.setSrcAttr(srcAttr);
+
+      edge.erase();
+      destState.erase();
+      return true;
+    }
+
+    // Empty predecessor: its incoming edges lead to the successor instead.
+    if (srcState.getBody().front().empty()) {
+      FlatSymbolRefAttr destAttr = FlatSymbolRefAttr::get(ctx, dest);
+      for (EdgeOp inEdge : inEdges[src])
+        inEdge.setDestAttr(destAttr);
+
+      if (src == entryName)
+        sdfg->setAttr("entry", destAttr);
+
+      edge.erase();
+      srcState.erase();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct EliminateTransientsPass
+    : public sdfg::transforms::EliminateTransientsPassBase<
+          EliminateTransientsPass> {
+  void runOnOperation() override;
+};
+} // namespace
+
+/// Runs the pass on the top-level module operation.
+void EliminateTransientsPass::runOnOperation() {
+  ModuleOp module = getOperation();
+
+  for (bool changed = true; changed;) {
+    changed = false;
+    module.walk([&](StateNode state) {
+      changed |= forwardStores(state.getBody().front());
+    });
+    changed |= eraseDeadOps(module);
+    changed |= eraseUnreadTransients(module);
+  }
+
+  SmallVector<Operation *> sdfgs;
+  module.walk([&](Operation *op) {
+    if (isa<SDFGNode, NestedSDFGNode>(op))
+      sdfgs.push_back(op);
+  });
+
+  for (Operation *sdfg : sdfgs)
+    while (mergeEmptyState(sdfg))
+      ;
+}
+
+/// Returns a unique pointer to this pass.
+std::unique_ptr<Pass> transforms::createEliminateTransientsPass() {
+  return std::make_unique<EliminateTransientsPass>();
+}
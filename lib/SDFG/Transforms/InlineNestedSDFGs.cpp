@@ -0,0 +1,202 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file defines a pass inlining nested SDFGs with a single state into the
+/// state containing them in the SDFG dialect.
+
+#include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/PassDetail.h"
+#include "SDFG/Transforms/Passes.h"
+#include "SDFG/Utils/Utils.h"
+
+using namespace mlir;
+using namespace sdfg;
+using namespace transforms;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+/// Collects the data containers accessed in the state containing the provided
+/// nested SDFG, split into the accesses before and after it in program order.
+static LogicalResult
+collectSurroundingAccesses(NestedSDFGNode nested, sdfg::utils::Accesses &before,
+                           sdfg::utils::Accesses &after) {
+  StateNode state = nested->getParentOfType<StateNode>();
+
+  for (Operation *anchor = nested; anchor != state;
+       anchor = anchor->getParentOp()) {
+    bool passed = false;
+
+    for (Operation &op : *anchor->getBlock()) {
+      if (&op == anchor) {
+        passed = true;
+        continue;
+      }
+
+      if (sdfg::utils::collectAccesses(&op, passed ? after : before).failed())
+        return failure();
+    }
+  }
+
+  return success();
+}
+
+/// Returns true if a container of the provided SDFG outside of the excluded
+/// nested SDFG carries the provided name.
+static bool isContainerNameUsed(Operation *sdfg, StringRef name,
+                                NestedSDFGNode excluded) {
+  WalkResult result = sdfg->walk<WalkOrder::PreOrder>([&](Operation *op) {
+    if (op == excluded)
+      return WalkResult::skip();
+
+    AllocOp alloc = dyn_cast<AllocOp>(op);
+    if (alloc && alloc.getName().value_or("") == name)
+      return WalkResult::interrupt();
+
+    return WalkResult::advance();
+  });
+
+  return result.wasInterrupted();
+}
+
+/// Returns the state of the provided nested SDFG if it can be inlined into the
+/// state containing it, i.e. it consists of a single state, its arguments have
+/// the types of the operands and inlining does not reorder accesses. Nested
+/// SDFGs with more than the provided number of operations are not inlined,
+/// unless the number is zero.
+static StateNode getInlinableState(NestedSDFGNode nested,
+                                   unsigned maxOperations) {
+  Block &body = nested.getBody().front();
+  StateNode state = nullptr;
+  bool hasAllocs = false;
+
+  for (Operation &op : body) {
+    if (StateNode stateNode = dyn_cast<StateNode>(op)) {
+      if (state)
+        return nullptr;
+      state = stateNode;
+      continue;
+    }
+
+    // Allocations with parameters depend on the inner control flow.
+    if (AllocOp alloc = dyn_cast<AllocOp>(op)) {
+      if (!alloc.getParams().empty())
+        return nullptr;
+      hasAllocs = true;
+      continue;
+    }
+
+    if (!isa<AllocSymbolOp>(op))
+      return nullptr;
+  }
+
+  if (!state || state.getInstrument())
+    return nullptr;
+
+  for (BlockArgument arg : body.getArguments())
+    if (arg.getType() != nested.getOperand(arg.getArgNumber()).getType())
+      return nullptr;
+
+  // Operations defining symbols, e.g. consume conditions, could clash with the
+  // symbols of the surrounding state.
+  for (Operation &op : state.getBody().front()) {
+    if (isa<SymbolOpInterface>(op))
+      return nullptr;
+    if (isa<AllocOp>(op))
+      hasAllocs = true;
+  }
+
+  // Allocations cannot be placed in maps and consume scopes. They must not be
+  // hoisted out of them either, as every iteration uses its own containers.
+  if (hasAllocs && !isa<StateNode>(nested->getParentOp()))
+    return nullptr;
+
+  if (maxOperations > 0) {
+    unsigned numOperations = 0;
+    nested.getBody().walk([&](Operation *) { ++numOperations; });
+    if (numOperations > maxOperations)
+      return nullptr;
+  }
+
+  sdfg::utils::Accesses accesses;
+  sdfg::utils::Accesses before;
+  sdfg::utils::Accesses after;
+  if (sdfg::utils::collectAccesses(nested, accesses, nested).failed() ||
+      collectSurroundingAccesses(nested, before, after).failed())
+    return nullptr;
+
+  // Access nodes order reads after writes of the same container, but nothing
+  // orders a read before a later write once the boundary is gone.
+  if (llvm::any_of(accesses.writes,
+                   [&](Value v) { return before.reads.contains(v); }) ||
+      llvm::any_of(after.writes,
+                   [&](Value v) { return accesses.reads.contains(v); }))
+    return nullptr;
+
+  return state;
+}
+
+//===----------------------------------------------------------------------===//
+// Nested SDFG Inlining
+//===----------------------------------------------------------------------===//
+
+/// Inlines the provided nested SDFG, consisting of the provided state, into the
+/// surrounding scope. The containers of the nested SDFG become transients of
+/// the surrounding state.
+static void inlineNestedSDFG(NestedSDFGNode nested, StateNode state) {
+  Block &body = nested.getBody().front();
+  Operation *sdfg = utils::getParentSDFG(*nested);
+
+  for (BlockArgument arg : body.getArguments())
+    arg.replaceAllUsesWith(nested.getOperand(arg.getArgNumber()));
+
+  for (Operation &op : llvm::make_early_inc_range(body)) {
+    if (isa<StateNode>(op))
+      continue;
+
+    if (AllocOp alloc = dyn_cast<AllocOp>(op)) {
+      alloc.setTransient(true);
+
+      if (alloc.getName().has_value() &&
+          isContainerNameUsed(sdfg, alloc.getName().value(), nested))
+        alloc.removeNameAttr();
+    }
+
+    op.moveBefore(nested);
+  }
+
+  Block *block = nested->getBlock();
+  block->getOperations().splice(Block::iterator(nested),
+                                state.getBody().front().getOperations());
+  nested.erase();
+}
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct InlineNestedSDFGsPass
+    : public sdfg::transforms::InlineNestedSDFGsPassBase<
+          InlineNestedSDFGsPass> {
+  void runOnOperation() override;
+};
+} // namespace
+
+/// Runs the pass on the top-level module operation.
+void InlineNestedSDFGsPass::runOnOperation() {
+  // Innermost nested SDFGs come first, so that their parents can be inlined
+  // afterwards.
+  SmallVector<NestedSDFGNode> nestedNodes;
+  getOperation().walk(
+      [&](NestedSDFGNode nested) { nestedNodes.push_back(nested); });
+
+  for (NestedSDFGNode nested : nestedNodes)
+    if (StateNode state = getInlinableState(nested, maxOperations))
+      inlineNestedSDFG(nested, state);
+}
+
+/// Returns a unique pointer to this pass.
+std::unique_ptr<Pass> transforms::createInlineNestedSDFGsPass() {
+  return std::make_unique<InlineNestedSDFGsPass>();
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file defines a pass collapsing perfectly nested maps in the SDFG
+/// dialect.
+
+#include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/PassDetail.h"
+#include "SDFG/Transforms/Passes.h"
+
+using namespace mlir;
+using namespace sdfg;
+using namespace transforms;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+/// The number lists describing the range of a map.
+static constexpr StringLiteral rangeAttrNames[] = {"lowerBounds", "upperBounds",
+                                                   "steps"};
+
+/// Returns true if the provided attribute describes the map itself (IDs and
+/// range) rather than how DaCe should schedule it.
+static bool isStructuralAttr(StringRef name) {
+  return name == "entryID" || name == "exitID" || name.endswith("_numList") ||
+         llvm::is_contained(rangeAttrNames, name);
+}
+
+/// Returns the map nested in the provided map if it is the only operation in
+/// its body and can be collapsed into it, i.e. its range does not depend on
+/// the outer map and it does not carry scheduling attributes.
+static MapNode getCollapsibleMap(MapNode outer) {
+  Block &body = outer.getBody().front();
+  if (!llvm::hasSingleElement(body))
+    return nullptr;
+
+  MapNode inner = dyn_cast<MapNode>(body.front());
+  if (!inner)
+    return nullptr;
+
+  // Per-argument scheduling attributes of the outer map do not cover the new
+  // arguments.
+  if (outer.getCollapse() || outer.getTileSizes())
+    return nullptr;
+
+  for (NamedAttribute attr : inner->getAttrs())
+    if (!isStructuralAttr(attr.getName().strref()))
+      return nullptr;
+
+  for (Value operand : inner->getOperands())
+    if (operand.getParentRegion() == &outer.getBody())
+      return nullptr;
+
+  return inner;
+}
+
+/// Concatenates the number lists of the outer and the inner map, shifting the
+/// attribute and operand references of the inner map.
+static void concatNumLists(MapNode outer, MapNode inner, StringRef name,
+                           OperationState &state) {
+  Builder builder(outer.getContext());
+  ArrayAttr outerAttrs = outer->getAttrOfType<ArrayAttr>(name);
+  ArrayAttr innerAttrs = inner->getAttrOfType<ArrayAttr>(name);
+  std::string numListName = name.str() + "_numList";
+
+  SmallVector<Attribute> attrs(outerAttrs.begin(), outerAttrs.end());
+  attrs.append(innerAttrs.begin(), innerAttrs.end());
+
+  ArrayAttr outerNumList = outer->getAttrOfType<ArrayAttr>(numListName);
+  SmallVector<Attribute> numList(outerNumList.begin(), outerNumList.end());
+
+  for (Attribute attr : inner->getAttrOfType<ArrayAttr>(numListName)) {
+    int32_t num = attr.cast<IntegerAttr>().getInt();
+    if (num < 0)
+      num -= outerAttrs.size();
+    else
+      num += outer->getNumOperands();
+    numList.push_back(builder.getI32IntegerAttr(num));
+  }
+
+  state.attributes.set(name, builder.getArrayAttr(attrs));
+  state.attributes.set(numListName, builder.getArrayAttr(numList));
+}
+
+//===----------------------------------------------------------------------===//
+// Map Collapsing
+//===----------------------------------------------------------------------===//
+
+/// Collapses the provided maps into a single map iterating over the arguments
+/// of the outer map followed by the ones of the inner map. Returns the
+/// collapsed map.
+static MapNode collapseMaps(MapNode outer, MapNode inner) {
+  OpBuilder builder(outer);
+  OperationState state(outer.getLoc(), MapNode::getOperationName());
+  state.addAttributes(outer->getAttrs());
+  for (StringRef name : rangeAttrNames)
+    concatNumLists(outer, inner, name, state);
+
+  state.addOperands(outer->getOperands());
+  state.addOperands(inner->getOperands());
+  state.addRegion();
+  MapNode collapsed = cast<MapNode>(builder.create(state));
+
+  Block &outerBody = outer.getBody().front();
+  Block &innerBody = inner.getBody().front();
+  SmallVector<Type> types(outerBody.getArgumentTypes());
+  types.append(innerBody.getArgumentTypes().begin(),
+               innerBody.getArgumentTypes().end());
+  SmallVector<Location> locs(types.size(), outer.getLoc());
+  Block *body = builder.createBlock(&collapsed.getBody(), {}, types, locs);
+
+  for (BlockArgument arg : outerBody.getArguments())
+    arg.replaceAllUsesWith(body->getArgument(arg.getArgNumber()));
+
+  for (BlockArgument arg : innerBody.getArguments())
+    arg.replaceAllUsesWith(body->getArgument(outerBody.getNumArguments() +
+                                             arg.getArgNumber()));
+
+  body->getOperations().splice(body->end(), innerBody.getOperations());
+  outer.erase();
+  return collapsed;
+}
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct MapCollapsePass
+    : public sdfg::transforms::MapCollapsePassBase<MapCollapsePass> {
+  void runOnOperation() override;
+};
+} // namespace
+
+/// Runs the pass on the top-level module operation.
+void MapCollapsePass::runOnOperation() {
+  // Outer maps are visited first. Collapsing them only moves the maps nested
+  // deeper, so a single pass over the collected maps suffices.
+  SmallVector<MapNode> maps;
+  getOperation().walk<WalkOrder::PreOrder>(
+      [&](MapNode mapNode) { maps.push_back(mapNode); });
+
+  llvm::SmallPtrSet<Operation *, 8> erased;
+  for (MapNode outer : maps) {
+    if (erased.contains(outer))
+      continue;
+
+    while (MapNode inner = getCollapsibleMap(outer)) {
+      erased.insert(outer);
+      erased.insert(inner);
+      outer = collapseMaps(outer, inner);
+    }
+  }
+}
+
+/// Returns a unique pointer to this pass.
+std::unique_ptr<Pass> transforms::createMapCollapsePass() {
+  return std::make_unique<MapCollapsePass>();
+}
@@ -0,0 +1,180 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file defines a pass fusing sibling maps over identical ranges in the
+/// SDFG dialect.
+
+#include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/PassDetail.h"
+#include "SDFG/Transforms/Passes.h"
+#include "SDFG/Utils/Utils.h"
+
+using namespace mlir;
+using namespace sdfg;
+using namespace transforms;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+/// Collects the arrays the provided map accesses. Fails if the map contains
+/// accesses other than loads and stores, as only those can be checked for
+/// pointwise accesses.
+static LogicalResult collectMapAccesses(MapNode mapNode,
+                                        sdfg::utils::Accesses &accesses) {
+  if (sdfg::utils::collectAccesses(mapNode, accesses).failed())
+    return failure();
+
+  for (auto &[array, ops] : accesses.ops)
+    if (!llvm::all_of(ops, [](Operation *op) {
+          return isa<LoadOp, StoreOp>(op);
+        }))
+      return failure();
+
+  return success();
+}
+
+/// Returns the attributes of the provided map without its IDs.
+static DictionaryAttr getAttrsWithoutIDs(MapNode mapNode) {
+  NamedAttrList attrs(mapNode->getAttrs());
+  attrs.erase("entryID");
+  attrs.erase("exitID");
+  return attrs.getDictionary(mapNode.getContext());
+}
+
+/// Returns true if both maps iterate over the same range with the same
+/// scheduling attributes.
+static bool haveSameRange(MapNode first, MapNode second) {
+  return first.getBody().getNumArguments() ==
+             second.getBody().getNumArguments() &&
+         llvm::equal(first->getOperands(), second->getOperands()) &&
+         getAttrsWithoutIDs(first) == getAttrsWithoutIDs(second);
+}
+
+/// Returns the index operands of the provided load or store, replacing the
+/// arguments of the second map by the ones of the first map.
+static SmallVector<Value> getIndices(Operation *access, MapNode first,
+                                     MapNode second) {
+  OperandRange indices = isa<LoadOp>(access)
+                             ? cast<LoadOp>(access).getIndices()
+                             : cast<StoreOp>(access).getIndices();
+  SmallVector<Value> res;
+
+  for (Value index : indices) {
+    BlockArgument arg = index.dyn_cast<BlockArgument>();
+    if (arg && arg.getOwner() == &second.getBody().front())
+      index = first.getBody().getArgument(arg.getArgNumber());
+    res.push_back(index);
+  }
+
+  return res;
+}
+
+/// Returns true if every access to the array in both maps touches the same
+/// element, which is different for every iteration. Then every iteration of
+/// the fused map only depends on itself.
+static bool isPointwise(ArrayRef<Operation *> accesses, MapNode first,
+                        MapNode second) {
+  Operation *ref = accesses.front();
+  SmallVector<Value> refIndices = getIndices(ref, first, second);
+
+  // Using every argument makes the accessed element unique per iteration.
+  for (BlockArgument arg : first.getBody().getArguments())
+    if (!llvm::is_contained(refIndices, arg))
+      return false;
+
+  for (Operation *access : accesses)
+    if (access->getAttr("indices") != ref->getAttr("indices") ||
+        access->getAttr("indices_numList") !=
+            ref->getAttr("indices_numList") ||
+        getIndices(access, first, second) != refIndices)
+      return false;
+
+  return true;
+}
+
+/// Returns true if the provided maps can be fused. Arrays written by one map
+/// and accessed by the other must be accessed pointwise.
+static bool canFuse(MapNode first, MapNode second) {
+  if (!haveSameRange(first, second))
+    return false;
+
+  sdfg::utils::Accesses firstAccesses;
+  sdfg::utils::Accesses secondAccesses;
+  if (collectMapAccesses(first, firstAccesses).failed() ||
+      collectMapAccesses(second, secondAccesses).failed())
+    return false;
+
+  for (auto &[array, accesses] : firstAccesses.ops) {
+    auto it = secondAccesses.ops.find(array);
+    if (it == secondAccesses.ops.end())
+      continue;
+
+    if (!firstAccesses.writes.contains(array) &&
+        !secondAccesses.writes.contains(array))
+      continue;
+
+    SmallVector<Operation *> shared(accesses);
+    shared.append(it->second);
+    if (!isPointwise(shared, first, second))
+      return false;
+  }
+
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Map Fusion
+//===----------------------------------------------------------------------===//
+
+/// Fuses the second map into the first one by appending its body.
+static void fuseMaps(MapNode first, MapNode second) {
+  Block &firstBody = first.getBody().front();
+  Block &secondBody = second.getBody().front();
+
+  for (BlockArgument arg : secondBody.getArguments())
+    arg.replaceAllUsesWith(firstBody.getArgument(arg.getArgNumber()));
+
+  firstBody.getOperations().splice(firstBody.end(),
+                                   secondBody.getOperations());
+  second.erase();
+}
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct MapFusionPass
+    : public sdfg::transforms::MapFusionPassBase<MapFusionPass> {
+  void runOnOperation() override;
+};
+} // namespace
+
+/// Runs the pass on the top-level module operation.
+void MapFusionPass::runOnOperation() {
+  // Outer maps are visited first. Fusing them only moves the nested maps, so a
+  // single pass over the collected maps suffices.
+  SmallVector<MapNode> maps;
+  getOperation().walk<WalkOrder::PreOrder>(
+      [&](MapNode mapNode) { maps.push_back(mapNode); });
+
+  llvm::SmallPtrSet<Operation *, 8> erased;
+  for (MapNode first : maps) {
+    if (erased.contains(first))
+      continue;
+
+    while (MapNode second =
+               dyn_cast_or_null<MapNode>(first->getNextNode())) {
+      if (!canFuse(first, second))
+        break;
+
+      erased.insert(second);
+      fuseMaps(first, second);
+    }
+  }
+}
+
+/// Returns a unique pointer to this pass.
+std::unique_ptr<Pass> transforms::createMapFusionPass() {
+  return std::make_unique<MapFusionPass>();
+}
@@ -0,0 +1,468 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file defines a pass specializing symbols to constant values in the
+/// SDFG dialect.
+
+#include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/PassDetail.h"
+#include "SDFG/Transforms/Passes.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CheckedArithmetic.h"
+#include <limits>
+
+using namespace mlir;
+using namespace sdfg;
+using namespace transforms;
+
+//===----------------------------------------------------------------------===//
+// Expressions
+//===----------------------------------------------------------------------===//
+
+namespace {
+/// Evaluates integer expressions consisting of literals, the arithmetic
+/// operators + - * / // % **, comparisons and parentheses. Any other
+/// expression (e.g. one containing symbols) or any overflowing operation
+/// fails to evaluate.
+class ExpressionFolder {
+public:
+  ExpressionFolder(StringRef expr) : expr(expr) {}
+
+  /// Evaluates the entire expression. Returns std::nullopt on failure.
+  Optional<int64_t> fold() {
+    Optional<int64_t> val = parseComparison();
+    skipSpaces();
+    if (!val || pos != expr.size())
+      return std::nullopt;
+    return val;
+  }
+
+private:
+  StringRef expr;
+  size_t pos = 0;
+
+  /// Skips any whitespace at the current position.
+  void skipSpaces() {
+    while (pos < expr.size() && llvm::isSpace(expr[pos]))
+      ++pos;
+  }
+
+  /// Consumes the provided token if it is at the current position.
+  bool consume(StringRef token) {
+    skipSpaces();
+    if (!expr.drop_front(pos).startswith(token))
+      return false;
+    pos += token.size();
+    return true;
+  }
+
+  /// Adds two optional integers. Returns std::nullopt on overflow.
+  static Optional<int64_t> add(Optional<int64_t> lhs, Optional<int64_t> rhs) {
+    if (!lhs || !rhs)
+      return std::nullopt;
+    if (auto res = llvm::checkedAdd(*lhs, *rhs))
+      return *res;
+    return std::nullopt;
+  }
+
+  /// Subtracts two optional integers. Returns std::nullopt on overflow.
+  static Optional<int64_t> sub(Optional<int64_t> lhs, Optional<int64_t> rhs) {
+    if (!lhs || !rhs)
+      return std::nullopt;
+    if (auto res = llvm::checkedSub(*lhs, *rhs))
+      return *res;
+    return std::nullopt;
+  }
+
+  /// Multiplies two optional integers. Returns std::nullopt on overflow.
+  static Optional<int64_t> mul(Optional<int64_t> lhs, Optional<int64_t> rhs) {
+    if (!lhs || !rhs)
+      return std::nullopt;
+    if (auto res = llvm::checkedMul(*lhs, *rhs))
+      return *res;
+    return std::nullopt;
+  }
+
+  /// Parses a comparison of two sums.
+  Optional<int64_t> parseComparison() {
+    Optional<int64_t> lhs = parseSum();
+    if (!lhs)
+      return std::nullopt;
+
+    for (StringRef op : {"==", "!=", "<=", ">=", "<", ">"}) {
+      if (!consume(op))
+        continue;
+
+      Optional<int64_t> rhs = parseSum();
+      if (!rhs)
+        return std::nullopt;
+
+      if (op == "==")
+        return *lhs == *rhs;
+      if (op == "!=")
+        return *lhs != *rhs;
+      if (op == "<=")
+        return *lhs <= *rhs;
+      if (op == ">=")
+        return *lhs >= *rhs;
+      if (op == "<")
+        return *lhs < *rhs;
+      return *lhs > *rhs;
+    }
+
+    return lhs;
+  }
+
+  /// Parses a sequence of additions and subtractions.
+  Optional<int64_t> parseSum() {
+    Optional<int64_t> lhs = parseProduct();
+
+    while (lhs) {
+      if (consume("+"))
+        lhs = add(lhs, parseProduct());
+      else if (consume("-"))
+        lhs = sub(lhs, parseProduct());
+      else
+        break;
+    }
+
+    return lhs;
+  }
+
+  /// Parses a sequence of multiplications, divisions and modulos. Divisions
+  /// only fold if they are exact and use floor semantics otherwise.
+  Optional<int64_t> parseProduct() {
+    Optional<int64_t> lhs = parseUnary();
+
+    while (lhs) {
+      skipSpaces();
+      if (expr.drop_front(pos).startswith("**"))
+        break;
+
+      if (consume("*")) {
+        lhs = mul(lhs, parseUnary());
+        continue;
+      }
+
+      bool isFloorDiv = consume("//");
+      bool isDiv = !isFloorDiv && consume("/");
+      bool isMod = !isFloorDiv && !isDiv && consume("%");
+      if (!isFloorDiv && !isDiv && !isMod)
+        break;
+
+      Optional<int64_t> rhs = parseUnary();
+      if (!rhs || *rhs == 0 ||
+          (*lhs == std::numeric_limits<int64_t>::min() && *rhs == -1) ||
+          (isDiv && *lhs % *rhs != 0))
+        return std::nullopt;
+
+      int64_t quot = *lhs / *rhs;
+      if ((*lhs % *rhs != 0) && ((*lhs < 0) != (*rhs < 0)))
+        --quot;
+      lhs = isMod ? *lhs - quot * *rhs : quot;
+    }
+
+    return lhs;
+  }
+
+  /// Parses a unary plus or minus.
+  Optional<int64_t> parseUnary() {
+    if (consume("-")) {
+      return sub(0, parseUnary());
+    }
+
+    if (consume("+"))
+      return parseUnary();
+
+    return parsePower();
+  }
+
+  /// Parses an exponentiation with a non-negative exponent, computed by
+  /// repeated squaring.
+  Optional<int64_t> parsePower() {
+    Optional<int64_t> base = parsePrimary();
+    if (!base || !consume("**"))
+      return base;
+
+    Optional<int64_t> exp = parseUnary();
+    if (!exp || *exp < 0)
+      return std::nullopt;
+
+    Optional<int64_t> res = 1;
+    Optional<int64_t> square = base;
+    for (int64_t e = *exp; e > 0 && res; e >>= 1) {
+      if (e & 1)
+        res = mul(res, square);
+      if (e > 1)
+        square = mul(square, square);
+      if (!square)
+        return std::nullopt;
+    }
+    return res;
+  }
+
+  /// Parses an integer literal or a parenthesized expression.
+  Optional<int64_t> parsePrimary() {
+    if (consume("(")) {
+      Optional<int64_t> val = parseComparison();
+      if (!val || !consume(")"))
+        return std::nullopt;
+      return val;
+    }
+
+    skipSpaces();
+    size_t start = pos;
+    while (pos < expr.size() && llvm::isDigit(expr[pos]))
+      ++pos;
+
+    int64_t val;
+    if (start == pos || (pos < expr.size() && llvm::isAlnum(expr[pos])) ||
+        expr.slice(start, pos).getAsInteger(10, val))
+      return std::nullopt;
+
+    return val;
+  }
+};
+} // namespace
+
+/// Replaces every occurrence of the specialized symbols in the expression by
+/// their value.
+static std::string substituteSymbols(StringRef expr,
+                                     const llvm::StringMap<int64_t> &values) {
+  std::string res;
+
+  for (size_t i = 0; i < expr.size();) {
+    // Copy numeric literals entirely, so that their suffixes are not
+    // mistaken for symbols.
+    if (llvm::isDigit(expr[i])) {
+      size_t start = i;
+      while (i < expr.size() && (llvm::isAlnum(expr[i]) || expr[i] == '.'))
+        ++i;
+      res += expr.slice(start, i).str();
+      continue;
+    }
+
+    if (!llvm::isAlpha(expr[i]) && expr[i] != '_') {
+      res += expr[i++];
+      continue;
+    }
+
+    size_t start = i;
+    while (i < expr.size() && (llvm::isAlnum(expr[i]) || expr[i] == '_'))
+      ++i;
+
+    StringRef name = expr.slice(start, i);
+    auto it = values.find(name);
+    if (it == values.end()) {
+      res += name.str();
+      continue;
+    }
+
+    std::string val = std::to_string(it->second);
+    res += it->second < 0 ? "(" + val + ")" : val;
+  }
+
+  return res;
+}
+
+/// Substitutes the specialized symbols in the expression and folds the result
+/// to a single integer if possible.
+static std::string specializeExpr(StringRef expr,
+                                  const llvm::StringMap<int64_t> &values) {
+  std::string res = substituteSymbols(expr, values);
+  if (Optional<int64_t> val = ExpressionFolder(res).fold())
+    return std::to_string(*val);
+  return res;
+}
+
+//===----------------------------------------------------------------------===//
+// Specialization
+//===----------------------------------------------------------------------===//
+
+/// Specializes the symbolic dimensions of array and stream types. Dimensions
+/// folding to non-negative integers become constant dimensions.
+static Type specializeType(Type type, const llvm::StringMap<int64_t> &values) {
+  SizedType sized;
+  if (ArrayType array = type.dyn_cast<ArrayType>())
+    sized = array.getDimensions();
+  else if (StreamType stream = type.dyn_cast<StreamType>())
+    sized = stream.getDimensions();
+  else
+    return type;
+
+  SmallVector<StringAttr> symbols;
+  SmallVector<int64_t> integers;
+  SmallVector<bool> shape;
+  unsigned symIdx = 0;
+  unsigned intIdx = 0;
+
+  for (bool isInt : sized.getShape()) {
+    if (isInt) {
+      integers.push_back(sized.getIntegers()[intIdx++]);
+      shape.push_back(true);
+      continue;
+    }
+
+    std::string expr =
+        specializeExpr(sized.getSymbols()[symIdx++].getValue(), values);
+    int64_t val;
+    if (!StringRef(expr).getAsInteger(10, val) && val >= 0) {
+      integers.push_back(val);
+      shape.push_back(true);
+      continue;
+    }
+
+    symbols.push_back(StringAttr::get(type.getContext(), expr));
+    shape.push_back(false);
+  }
+
+  SizedType specialized =
+      SizedType::get(type.getContext(), sized.getElementType(), symbols,
+                     integers, shape);
+
+  if (type.isa<ArrayType>())
+    return ArrayType::get(type.getContext(), specialized);
+  return StreamType::get(type.getContext(), specialized);
+}
+
+/// Specializes the symbolic expressions of a number list attribute (e.g. map
+/// bounds or memlet indices). Expressions folding to integers become integer
+/// attributes, so the number list itself stays valid.
+static ArrayAttr specializeNumList(ArrayAttr list,
+                                   const llvm::StringMap<int64_t> &values) {
+  Builder builder(list.getContext());
+  SmallVector<Attribute> attrs;
+
+  for (Attribute attr : list) {
+    StringAttr strAttr = attr.dyn_cast<StringAttr>();
+    if (!strAttr) {
+      attrs.push_back(attr);
+      continue;
+    }
+
+    std::string expr = specializeExpr(strAttr.getValue(), values);
+    int32_t val;
+    if (!StringRef(expr).getAsInteger(10, val))
+      attrs.push_back(builder.getI32IntegerAttr(val));
+    else
+      attrs.push_back(builder.getStringAttr(expr));
+  }
+
+  return builder.getArrayAttr(attrs);
+}
+
+/// Specializes the condition and the assignments of an edge. Fails if the
+/// edge assigns a specialized symbol.
+static LogicalResult specializeEdge(EdgeOp edge,
+                                    const llvm::StringMap<int64_t> &values) {
+  Builder builder(edge.getContext());
+  SmallVector<std::string> assignments;
+
+  for (Attribute attr : edge.getAssign()) {
+    std::pair<StringRef, StringRef> kv =
+        attr.cast<StringAttr>().getValue().split(':');
+    StringRef sym = kv.first.trim();
+
+    if (values.count(sym))
+      return edge.emitError("cannot specialize symbol '")
+             << sym << "' assigned on an edge";
+
+    assignments.push_back(sym.str() + ": " +
+                          specializeExpr(kv.second.trim(), values));
+  }
+
+  SmallVector<StringRef> assignRefs(assignments.begin(), assignments.end());
+  edge.setAssignAttr(builder.getStrArrayAttr(assignRefs));
+  edge.setConditionAttr(
+      builder.getStringAttr(specializeExpr(edge.getCondition(), values)));
+  return success();
+}
+
+/// Specializes the attributes, the result types and the block argument types
+/// of an operation.
+static void specializeOp(Operation *op,
+                         const llvm::StringMap<int64_t> &values) {
+  if (SymOp symOp = dyn_cast<SymOp>(op))
+    symOp.setExprAttr(StringAttr::get(
+        op->getContext(), specializeExpr(symOp.getExpr(), values)));
+
+  SmallVector<StringAttr> lists;
+  for (NamedAttribute attr : op->getAttrs()) {
+    StringRef name = attr.getName().strref();
+    if (name.consume_back("_numList"))
+      lists.push_back(StringAttr::get(op->getContext(), name));
+  }
+
+  for (StringAttr name : lists)
+    if (ArrayAttr list = op->getAttrOfType<ArrayAttr>(name))
+      op->setAttr(name, specializeNumList(list, values));
+
+  for (OpResult res : op->getResults())
+    res.setType(specializeType(res.getType(), values));
+
+  for (Region &region : op->getRegions())
+    for (Block &block : region)
+      for (BlockArgument arg : block.getArguments())
+        arg.setType(specializeType(arg.getType(), values));
+}
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct SpecializeSymbolsPass
+    : public sdfg::transforms::SpecializeSymbolsPassBase<
+          SpecializeSymbolsPass> {
+  void runOnOperation() override;
+};
+} // namespace
+
+/// Runs the pass on the top-level module operation.
+void SpecializeSymbolsPass::runOnOperation() {
+  ModuleOp module = getOperation();
+  llvm::StringMap<int64_t> values;
+
+  for (StringRef entry : symbols) {
+    std::pair<StringRef, StringRef> kv = entry.split('=');
+    StringRef sym = kv.first.trim();
+    int64_t val;
+
+    if (sym.empty() || kv.second.trim().getAsInteger(10, val)) {
+      emitError(module.getLoc(), "invalid symbol specialization '")
+          << entry << "', expected 'symbol=integer'";
+      return signalPassFailure();
+    }
+
+    values[sym] = val;
+  }
+
+  if (values.empty())
+    return;
+
+  WalkResult result = module.walk([&](EdgeOp edge) {
+    if (failed(specializeEdge(edge, values)))
+      return WalkResult::interrupt();
+    return WalkResult::advance();
+  });
+
+  if (result.wasInterrupted())
+    return signalPassFailure();
+
+  SmallVector<AllocSymbolOp> allocSymbols;
+  module.walk([&](Operation *op) {
+    if (AllocSymbolOp allocSymbolOp = dyn_cast<AllocSymbolOp>(op))
+      if (values.count(allocSymbolOp.getSym()))
+        allocSymbols.push_back(allocSymbolOp);
+
+    specializeOp(op, values);
+  });
+
+  for (AllocSymbolOp allocSymbolOp : allocSymbols)
+    allocSymbolOp.erase();
+}
+
+/// Returns a unique pointer to this pass.
+std::unique_ptr<Pass> transforms::createSpecializeSymbolsPass() {
+  return std::make_unique<SpecializeSymbolsPass>();
+}
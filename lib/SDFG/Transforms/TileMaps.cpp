@@ -0,0 +1,370 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file defines a pass tiling maps in the SDFG dialect.
+
+#include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/PassDetail.h"
+#include "SDFG/Transforms/Passes.h"
+#include "SDFG/Utils/Utils.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include <variant>
+
+using namespace mlir;
+using namespace sdfg;
+using namespace transforms;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+namespace {
+/// The number lists describing the range of a map under construction.
+struct MapRange {
+  SmallVector<Value> operands;
+  /// Lower bounds, upper bounds and steps.
+  SmallVector<Attribute> attrs[3];
+  SmallVector<Attribute> numLists[3];
+
+  /// Appends an attribute (integer or symbolic expression) to a number list.
+  void addAttr(Builder &builder, unsigned list, Attribute attr) {
+    numLists[list].push_back(
+        builder.getI32IntegerAttr(-(int32_t)attrs[list].size() - 1));
+    attrs[list].push_back(attr);
+  }
+
+  /// Appends an operand to a number list.
+  void addOperand(Builder &builder, unsigned list, Value val) {
+    numLists[list].push_back(builder.getI32IntegerAttr(operands.size()));
+    operands.push_back(val);
+  }
+};
+} // namespace
+
+/// The number lists describing the range of a map.
+static constexpr StringLiteral rangeAttrNames[] = {"lowerBounds", "upperBounds",
+                                                   "steps"};
+
+/// Returns the attribute of a dimension in a number list of the map or nullptr
+/// if the dimension is given as an operand.
+static Attribute getRangeAttr(MapNode mapNode, unsigned list, unsigned dim) {
+  StringRef name = rangeAttrNames[list];
+  ArrayAttr numList =
+      mapNode->getAttrOfType<ArrayAttr>(name.str() + "_numList");
+  int32_t num = numList[dim].cast<IntegerAttr>().getInt();
+  if (num >= 0)
+    return nullptr;
+  return mapNode->getAttrOfType<ArrayAttr>(name)[-num - 1];
+}
+
+/// Returns the operand of a dimension in a number list of the map or nullptr
+/// if the dimension is given as an attribute.
+static Value getRangeOperand(MapNode mapNode, unsigned list, unsigned dim) {
+  StringRef name = rangeAttrNames[list];
+  ArrayAttr numList =
+      mapNode->getAttrOfType<ArrayAttr>(name.str() + "_numList");
+  int32_t num = numList[dim].cast<IntegerAttr>().getInt();
+  if (num < 0)
+    return nullptr;
+  return mapNode->getOperand(num);
+}
+
+/// Copies a dimension of a number list of the map to the provided range.
+static void copyRange(Builder &builder, MapNode mapNode, unsigned list,
+                      unsigned dim, MapRange &range) {
+  if (Attribute attr = getRangeAttr(mapNode, list, dim))
+    range.addAttr(builder, list, attr);
+  else
+    range.addOperand(builder, list, getRangeOperand(mapNode, list, dim));
+}
+
+/// Returns the integer value of a dimension in a number list if it is
+/// constant.
+static Optional<int64_t> getConstantRange(MapNode mapNode, unsigned list,
+                                          unsigned dim) {
+  if (IntegerAttr intAttr =
+          getRangeAttr(mapNode, list, dim).dyn_cast_or_null<IntegerAttr>())
+    return intAttr.getInt();
+  return std::nullopt;
+}
+
+/// Computes tile sizes for the map from the cache size, such that the elements
+/// of every accessed array in a tile fit into the cache. Returns a tile size
+/// per map dimension, where one stands for an untiled dimension.
+static SmallVector<int64_t> computeTileSizes(MapNode mapNode,
+                                             int64_t cacheSize) {
+  unsigned numDims = mapNode.getBody().getNumArguments();
+  llvm::SmallPtrSet<Value, 4> arrays;
+  int64_t elemBytes = 1;
+
+  mapNode.getBody().walk([&](Operation *op) {
+    Value array;
+    if (LoadOp loadOp = dyn_cast<LoadOp>(op))
+      array = loadOp.getArr();
+    if (StoreOp storeOp = dyn_cast<StoreOp>(op))
+      array = storeOp.getArr();
+    if (!array)
+      return;
+
+    arrays.insert(array);
+    Type elemType = array.getType().cast<ArrayType>().getElementType();
+    if (elemType.isIntOrFloat())
+      elemBytes = std::max<int64_t>(elemBytes,
+                                    (elemType.getIntOrFloatBitWidth() + 7) / 8);
+    else
+      elemBytes = std::max<int64_t>(elemBytes, 8);
+  });
+
+  SmallVector<int64_t> tileSizes(numDims, 1);
+  if (arrays.empty())
+    return tileSizes;
+
+  // Largest power of two whose tile fits into the cache.
+  int64_t budget = cacheSize / (arrays.size() * elemBytes);
+  int64_t tileSize = 1;
+  while (true) {
+    int64_t elems = 1;
+    for (unsigned i = 0; i < numDims; ++i)
+      elems *= tileSize * 2;
+    if (elems > budget)
+      break;
+    tileSize *= 2;
+  }
+
+  tileSizes.assign(numDims, tileSize);
+  return tileSizes;
+}
+
+/// Returns the tile size of every map dimension. Dimensions with non-constant
+/// or non-positive steps and dimensions fitting into a single tile are not
+/// tiled and get a tile size of one.
+static SmallVector<int64_t> getTileSizes(MapNode mapNode,
+                                         ArrayRef<int64_t> defaultSizes,
+                                         int64_t cacheSize) {
+  unsigned numDims = mapNode.getBody().getNumArguments();
+  SmallVector<int64_t> tileSizes;
+
+  if (ArrayAttr attr = mapNode.getTileSizesAttr()) {
+    for (Attribute tileSize : attr)
+      tileSizes.push_back(tileSize.cast<IntegerAttr>().getInt());
+  } else if (!defaultSizes.empty()) {
+    // Repeat the last tile size for the remaining dimensions.
+    for (unsigned i = 0; i < numDims; ++i)
+      tileSizes.push_back(defaultSizes[std::min<size_t>(
+          i, defaultSizes.size() - 1)]);
+  } else {
+    tileSizes = computeTileSizes(mapNode, cacheSize);
+  }
+
+  for (unsigned i = 0; i < numDims; ++i) {
+    Optional<int64_t> step = getConstantRange(mapNode, 2, i);
+    if (!step || *step <= 0) {
+      tileSizes[i] = 1;
+      continue;
+    }
+
+    Optional<int64_t> lb = getConstantRange(mapNode, 0, i);
+    Optional<int64_t> ub = getConstantRange(mapNode, 1, i);
+    if (lb && ub && (*ub - *lb) / *step + 1 <= tileSizes[i])
+      tileSizes[i] = 1;
+  }
+
+  return tileSizes;
+}
+
+/// Creates a map with the provided range at the current insertion point and
+/// leaves the insertion point in its body.
+static MapNode createMap(OpBuilder &builder, Location loc, MapRange &range,
+                         unsigned numArgs) {
+  OperationState state(loc, MapNode::getOperationName());
+  state.addAttribute("lowerBounds_numList",
+                     builder.getArrayAttr(range.numLists[0]));
+  state.addAttribute("upperBounds_numList",
+                     builder.getArrayAttr(range.numLists[1]));
+  state.addAttribute("steps_numList", builder.getArrayAttr(range.numLists[2]));
+
+  MLIRContext *ctx = builder.getContext();
+  MapNode::build(builder, state, sdfg::utils::generateID(ctx),
+                 sdfg::utils::generateID(ctx), range.operands,
+                 builder.getArrayAttr(range.attrs[0]),
+                 builder.getArrayAttr(range.attrs[1]),
+                 builder.getArrayAttr(range.attrs[2]));
+  MapNode mapNode = cast<MapNode>(builder.create(state));
+
+  SmallVector<Type> argTypes(numArgs, builder.getIndexType());
+  SmallVector<Location> argLocs(numArgs, loc);
+  builder.createBlock(&mapNode.getBody(), {}, argTypes, argLocs);
+  return mapNode;
+}
+
+/// Creates a tasklet computing the inclusive upper bound of every tile, i.e.
+/// the minimum of the last iteration in the tile and the upper bound of the
+/// map. The bounds are given as the start of the tile, the tile extent minus
+/// one step and the upper bound of the map (an index or an integer).
+static TaskletNode
+createTileBounds(OpBuilder &builder, Location loc, ArrayRef<Value> starts,
+                 ArrayRef<int64_t> extents,
+                 ArrayRef<std::variant<Value, int64_t>> upperBounds) {
+  SmallVector<Value> operands(starts.begin(), starts.end());
+  for (const std::variant<Value, int64_t> &ub : upperBounds)
+    if (const Value *val = std::get_if<Value>(&ub))
+      operands.push_back(*val);
+
+  SmallVector<Type> resultTypes(starts.size(), builder.getIndexType());
+  TaskletNode task = TaskletNode::create(loc, operands, resultTypes);
+  builder.insert(task);
+
+  OpBuilder::InsertionGuard guard(builder);
+  Block &body = task.getBody().front();
+  builder.setInsertionPointToEnd(&body);
+
+  SmallVector<Value> results;
+  unsigned ubArg = starts.size();
+  for (unsigned i = 0; i < starts.size(); ++i) {
+    Value extent = builder.create<arith::ConstantIndexOp>(loc, extents[i]);
+    Value last =
+        builder.create<arith::AddIOp>(loc, body.getArgument(i), extent);
+
+    Value ub;
+    if (const int64_t *cst = std::get_if<int64_t>(&upperBounds[i]))
+      ub = builder.create<arith::ConstantIndexOp>(loc, *cst);
+    else
+      ub = body.getArgument(ubArg++);
+
+    results.push_back(builder.create<arith::MinSIOp>(loc, last, ub));
+  }
+
+  builder.insert(sdfg::ReturnOp::create(loc, results));
+  return task;
+}
+
+//===----------------------------------------------------------------------===//
+// Map Tiling
+//===----------------------------------------------------------------------===//
+
+/// Tiles the provided map with the provided tile sizes. The outer map iterates
+/// over the tiles of the tiled dimensions and keeps the scheduling attributes.
+/// The inner map iterates over the elements of a tile, where the upper bounds
+/// are clamped to the map range for the remainder tiles, and over the untiled
+/// dimensions.
+static void tileMap(MapNode mapNode, ArrayRef<int64_t> tileSizes) {
+  OpBuilder builder(mapNode);
+  Location loc = mapNode.getLoc();
+  unsigned numDims = tileSizes.size();
+
+  // Outer map over the tiles.
+  MapRange outerRange;
+  SmallVector<unsigned> tiledDims;
+  for (unsigned i = 0; i < numDims; ++i) {
+    if (tileSizes[i] <= 1)
+      continue;
+
+    tiledDims.push_back(i);
+    copyRange(builder, mapNode, 0, i, outerRange);
+    copyRange(builder, mapNode, 1, i, outerRange);
+    int64_t step = *getConstantRange(mapNode, 2, i);
+    outerRange.addAttr(builder, 2,
+                       builder.getI32IntegerAttr(step * tileSizes[i]));
+  }
+
+  MapNode outer = createMap(builder, loc, outerRange, tiledDims.size());
+  for (NamedAttribute attr : mapNode->getAttrs()) {
+    StringRef name = attr.getName().strref();
+    if (!outer->hasAttr(name) && name != "tile_sizes" && name != "collapse")
+      outer->setAttr(name, attr.getValue());
+  }
+
+  if (IntegerAttr collapse = mapNode.getCollapseAttr())
+    outer.setCollapseAttr(builder.getI64IntegerAttr(
+        std::min<int64_t>(collapse.getInt(), tiledDims.size())));
+
+  // Upper bounds of the tiles.
+  SmallVector<Value> starts;
+  SmallVector<int64_t> extents;
+  SmallVector<std::variant<Value, int64_t>> upperBounds;
+  for (unsigned t = 0; t < tiledDims.size(); ++t) {
+    unsigned dim = tiledDims[t];
+    int64_t step = *getConstantRange(mapNode, 2, dim);
+    starts.push_back(outer.getBody().getArgument(t));
+    extents.push_back((tileSizes[dim] - 1) * step);
+
+    if (Value val = getRangeOperand(mapNode, 1, dim)) {
+      upperBounds.push_back(val);
+    } else if (Optional<int64_t> cst = getConstantRange(mapNode, 1, dim)) {
+      upperBounds.push_back(*cst);
+    } else {
+      StringAttr expr = getRangeAttr(mapNode, 1, dim).cast<StringAttr>();
+      SymOp symOp =
+          SymOp::create(loc, builder.getIndexType(), expr.getValue());
+      builder.insert(symOp);
+      upperBounds.push_back(symOp.getRes());
+    }
+  }
+
+  TaskletNode bounds =
+      createTileBounds(builder, loc, starts, extents, upperBounds);
+
+  // Inner map over the elements of a tile.
+  MapRange innerRange;
+  unsigned tile = 0;
+  for (unsigned i = 0; i < numDims; ++i) {
+    if (tileSizes[i] <= 1) {
+      for (unsigned list = 0; list < 3; ++list)
+        copyRange(builder, mapNode, list, i, innerRange);
+      continue;
+    }
+
+    innerRange.addOperand(builder, 0, outer.getBody().getArgument(tile));
+    innerRange.addOperand(builder, 1, bounds.getResult(tile));
+    copyRange(builder, mapNode, 2, i, innerRange);
+    ++tile;
+  }
+
+  MapNode inner = createMap(builder, loc, innerRange, numDims);
+  Block &body = mapNode.getBody().front();
+  for (BlockArgument arg : body.getArguments())
+    arg.replaceAllUsesWith(inner.getBody().getArgument(arg.getArgNumber()));
+
+  inner.getBody().front().getOperations().splice(
+      inner.getBody().front().end(), body.getOperations());
+  mapNode.erase();
+}
+
+//===----------------------------------------------------------------------===//
+// Pass
+//===----------------------------------------------------------------------===//
+
+namespace {
+struct TileMapsPass : public sdfg::transforms::TileMapsPassBase<TileMapsPass> {
+  void runOnOperation() override;
+};
+} // namespace
+
+/// Runs the pass on the top-level module operation.
+void TileMapsPass::runOnOperation() {
+  SmallVector<MapNode> maps;
+  getOperation().walk([&](MapNode mapNode) {
+    // GPU maps use the tile sizes as the thread block size.
+    Optional<StringRef> schedule = mapNode.getSchedule();
+    if (schedule && schedule->startswith("GPU_"))
+      return;
+
+    if (!isa<MapNode>(mapNode->getParentOp()))
+      maps.push_back(mapNode);
+  });
+
+  SmallVector<int64_t> defaultSizes(tileSizes.begin(), tileSizes.end());
+  for (MapNode mapNode : maps) {
+    SmallVector<int64_t> sizes =
+        getTileSizes(mapNode, defaultSizes, cacheSize);
+    if (llvm::any_of(sizes, [](int64_t size) { return size > 1; }))
+      tileMap(mapNode, sizes);
+  }
+
+  sdfg::utils::renumberIDs(getOperation());
+}
+
+/// Returns a unique pointer to this pass.
+std::unique_ptr<Pass> transforms::createTileMapsPass() {
+  return std::make_unique<TileMapsPass>();
+}
@@ -0,0 +1,24 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains the functionality shared by all emitters.
+
+#include "SDFG/Translate/Emitter.h"
+#include "llvm/ADT/DenseSet.h"
+
+using namespace mlir;
+using namespace sdfg;
+using namespace emitter;
+
+/// Prints a list of NamedAttributes as key-value pairs.
+void Emitter::printAttributes(ArrayRef<NamedAttribute> arr,
+                              ArrayRef<StringRef> elidedAttrs) {
+
+  llvm::SmallDenseSet<StringRef> elidedAttrsSet(elidedAttrs.begin(),
+                                                elidedAttrs.end());
+
+  for (NamedAttribute attr : arr) {
+    if (elidedAttrsSet.contains(attr.getName().strref()))
+      continue;
+    printKVPair(attr.getName().strref(), attr.getValue());
+  }
+}
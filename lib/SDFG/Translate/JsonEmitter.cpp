@@ -10,13 +10,23 @@ using namespace mlir;
 using namespace sdfg;
 using namespace emitter;
 
-/// Creates a new JSON emitter.
-JsonEmitter::JsonEmitter(raw_ostream &os) : os(os) {
+namespace {
+/// Size of the output buffer used in compact mode.
+constexpr size_t compactBufferSize = 1 << 20;
+} // namespace
+
+/// Creates a new JSON emitter. In compact mode indentation and newlines are
+/// omitted and the output is written through a large buffer.
+JsonEmitter::JsonEmitter(raw_ostream &os, bool compact)
+    : os(os), compact(compact) {
   indentation = 0;
   error = false;
   firstEntry = true;
   emptyLine = true;
   symStack.clear();
+
+  if (compact && os.GetBufferSize() < compactBufferSize)
+    os.SetBufferSize(compactBufferSize);
 }
 
 /// Checks for errors (open objects/lists) and adds trailing newline. Returns
@@ -35,12 +45,20 @@ LogicalResult JsonEmitter::finish() {
     os.resetColor();
     error = true;
   }
+  if (compact && !emptyLine) {
+    os << "\n";
+    emptyLine = true;
+  }
   newLine(); // Makes sure to have a trailing newline
+  os.flush();
   return failure(error);
 }
 
 /// Increases the indentation level.
-void JsonEmitter::indent() { indentation += 2; }
+void JsonEmitter::indent() {
+  if (!compact)
+    indentation += 2;
+}
 /// Decreases the indentation level.
 void JsonEmitter::unindent() {
   indentation = indentation >= 2 ? indentation - 2 : 0;
@@ -48,7 +66,7 @@ void JsonEmitter::unindent() {
 
 /// Starts a new line in the output stream.
 void JsonEmitter::newLine() {
-  if (emptyLine)
+  if (emptyLine || compact)
     return;
   os << "\n";
   emptyLine = true;
@@ -56,7 +74,7 @@ void JsonEmitter::newLine() {
 
 /// Prints a literal string to the output stream.
 void JsonEmitter::printLiteral(StringRef str) {
-  if (emptyLine)
+  if (emptyLine && indentation > 0)
     os.indent(indentation);
   os << str;
   emptyLine = false;
@@ -97,8 +115,7 @@ void JsonEmitter::startObject() {
 /// Starts a new named (keyed) JSON object.
 void JsonEmitter::startNamedObject(StringRef name) {
   startEntry();
-  printString(name);
-  printLiteral(": ");
+  printKey(name);
   printLiteral("{");
   if (symStack.empty() || symStack.back() == SYM::SQUARE) {
     // Can't have keyed values as root object or in a list
@@ -122,11 +139,27 @@ void JsonEmitter::endObject() {
   firstEntry = false;
 }
 
+/// Starts a new JSON list. Only used for root lists.
+void JsonEmitter::startList() {
+  startEntry();
+  printLiteral("[");
+  if (!symStack.empty()) {
+    // Unnamed lists are only supported as root
+    os.changeColor(os.RED, /*Bold=*/true);
+    printLiteral(" <<<<<<<<<<<< Started unnamed list in a nested scope");
+    os.resetColor();
+    error = true;
+  }
+  symStack.push_back(SYM::SQUARE);
+  indent();
+  newLine();
+  firstEntry = true;
+}
+
 /// Starts a new named JSON list.
 void JsonEmitter::startNamedList(StringRef name) {
   startEntry();
-  printString(name);
-  printLiteral(": ");
+  printKey(name);
   printLiteral("[");
   if (!symStack.empty() && symStack.back() == SYM::SQUARE) {
     // Can't have keyed values in a list
@@ -162,8 +195,7 @@ void JsonEmitter::startEntry() {
 /// into string.
 void JsonEmitter::printKVPair(StringRef key, StringRef val, bool stringify) {
   startEntry();
-  printString(key);
-  printLiteral(": ");
+  printKey(key);
   if (stringify)
     printString(val);
   else
@@ -174,8 +206,7 @@ void JsonEmitter::printKVPair(StringRef key, StringRef val, bool stringify) {
 /// into string.
 void JsonEmitter::printKVPair(StringRef key, int val, bool stringify) {
   startEntry();
-  printString(key);
-  printLiteral(": ");
+  printKey(key);
   if (stringify)
     printInt(val);
   else
@@ -186,8 +217,7 @@ void JsonEmitter::printKVPair(StringRef key, int val, bool stringify) {
 /// into string.
 void JsonEmitter::printKVPair(StringRef key, Attribute val, bool stringify) {
   startEntry();
-  printString(key);
-  printLiteral(": ");
+  printKey(key);
   if (StringAttr strAttr = val.dyn_cast<StringAttr>()) {
     strAttr.print(os);
   } else {
@@ -199,20 +229,6 @@ void JsonEmitter::printKVPair(StringRef key, Attribute val, bool stringify) {
   }
 }
 
-/// Prints a list of NamedAttributes as key-value pairs.
-void JsonEmitter::printAttributes(ArrayRef<NamedAttribute> arr,
-                                  ArrayRef<StringRef> elidedAttrs) {
-
-  llvm::SmallDenseSet<StringRef> elidedAttrsSet(elidedAttrs.begin(),
-                                                elidedAttrs.end());
-
-  for (NamedAttribute attr : arr) {
-    if (elidedAttrsSet.contains(attr.getName().strref()))
-      continue;
-    printKVPair(attr.getName().strref(), attr.getValue());
-  }
-}
-
 /// Tries to pop a symbol from the symStack, checking for matching symbols.
 void JsonEmitter::tryPop(SYM sym) {
   if (symStack.empty()) {
@@ -242,3 +258,9 @@ void JsonEmitter::tryPop(SYM sym) {
     symStack.pop_back();
   }
 }
+
+/// Prints a quoted key followed by a colon.
+void JsonEmitter::printKey(StringRef key) {
+  printString(key);
+  printLiteral(compact ? ":" : ": ");
+}
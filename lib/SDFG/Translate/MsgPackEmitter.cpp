@@ -0,0 +1,230 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains a MessagePack emitter, which encodes the same document
+/// structure as the JSON emitter in a compact binary format.
+
+#include "SDFG/Translate/MsgPackEmitter.h"
+#include "llvm/ADT/bit.h"
+#include <string>
+
+using namespace mlir;
+using namespace sdfg;
+using namespace emitter;
+
+/// Creates a new MessagePack emitter.
+MsgPackEmitter::MsgPackEmitter(raw_ostream &os) : os(os) { error = false; }
+
+/// Checks for errors (open objects/lists) and writes the buffered document
+/// to the output stream. Returns a LogicalResult indicating success or
+/// failure.
+LogicalResult MsgPackEmitter::finish() {
+  while (!containerStack.empty()) {
+    endContainer(containerStack.back().isMap);
+    error = true;
+  }
+
+  os.write(buffer.data(), buffer.size());
+  buffer.clear();
+  return failure(error);
+}
+
+/// Prints a string to the output stream.
+void MsgPackEmitter::printString(StringRef str) {
+  countEntry(/*keyed=*/false);
+  writeString(str);
+}
+
+/// Prints a literal value (null, true, false or a number) to the output
+/// stream.
+void MsgPackEmitter::printLiteral(StringRef str) {
+  countEntry(/*keyed=*/false);
+  writeLiteral(str);
+}
+
+/// Starts a new map.
+void MsgPackEmitter::startObject() {
+  countEntry(/*keyed=*/false);
+  startContainer(/*isMap=*/true);
+}
+
+/// Starts a new named (keyed) map.
+void MsgPackEmitter::startNamedObject(StringRef name) {
+  countEntry(/*keyed=*/true);
+  writeString(name);
+  startContainer(/*isMap=*/true);
+}
+
+/// Ends the current map.
+void MsgPackEmitter::endObject() { endContainer(/*isMap=*/true); }
+
+/// Starts a new named array.
+void MsgPackEmitter::startNamedList(StringRef name) {
+  countEntry(/*keyed=*/true);
+  writeString(name);
+  startContainer(/*isMap=*/false);
+}
+
+/// Ends the current array.
+void MsgPackEmitter::endList() { endContainer(/*isMap=*/false); }
+
+/// Starts a new entry in the current map or array. Entries are counted when
+/// they are printed, so this is a no-op.
+void MsgPackEmitter::startEntry() {}
+
+/// Prints a key-value pair to the output stream. If desired, turns the value
+/// into string.
+void MsgPackEmitter::printKVPair(StringRef key, StringRef val, bool stringify) {
+  countEntry(/*keyed=*/true);
+  writeString(key);
+  if (stringify)
+    writeString(val);
+  else
+    writeLiteral(val);
+}
+
+/// Prints a key-value pair to the output stream. If desired, turns the value
+/// into string.
+void MsgPackEmitter::printKVPair(StringRef key, int val, bool stringify) {
+  countEntry(/*keyed=*/true);
+  writeString(key);
+  if (stringify)
+    writeString(std::to_string(val));
+  else
+    writeInt(val);
+}
+
+/// Prints a key-value pair to the output stream. If desired, turns the value
+/// into string.
+void MsgPackEmitter::printKVPair(StringRef key, Attribute val, bool stringify) {
+  countEntry(/*keyed=*/true);
+  writeString(key);
+
+  if (StringAttr strAttr = val.dyn_cast<StringAttr>()) {
+    writeString(strAttr.getValue());
+    return;
+  }
+
+  std::string str;
+  llvm::raw_string_ostream strStream(str);
+  val.print(strStream);
+  strStream.flush();
+
+  if (stringify)
+    writeString(str);
+  else
+    writeLiteral(str);
+}
+
+/// Counts a new entry in the current container, checking that it is of the
+/// expected kind.
+void MsgPackEmitter::countEntry(bool keyed) {
+  if (containerStack.empty()) {
+    // Only a single unkeyed root value is allowed
+    if (keyed || !buffer.empty())
+      error = true;
+    return;
+  }
+
+  // Keyed entries only in maps, unkeyed entries only in arrays
+  if (containerStack.back().isMap != keyed)
+    error = true;
+
+  containerStack.back().size++;
+}
+
+/// Starts a new container with a size header patched on closing.
+void MsgPackEmitter::startContainer(bool isMap) {
+  containerStack.push_back({isMap, buffer.size(), 0});
+  // map32 / array32 headers, so that the size can be patched in place
+  buffer.push_back(isMap ? '\xdf' : '\xdd');
+  writeBE(0, 4);
+}
+
+/// Ends the current container, checking for matching kinds.
+void MsgPackEmitter::endContainer(bool isMap) {
+  if (containerStack.empty()) {
+    error = true;
+    return;
+  }
+
+  Container container = containerStack.pop_back_val();
+  if (container.isMap != isMap)
+    error = true;
+
+  for (unsigned i = 0; i < 4; ++i)
+    buffer[container.offset + 1 + i] = (container.size >> (8 * (3 - i))) & 0xff;
+}
+
+/// Writes a big-endian unsigned integer of the given byte width.
+void MsgPackEmitter::writeBE(uint64_t val, unsigned bytes) {
+  for (unsigned i = bytes; i > 0; --i)
+    buffer.push_back((val >> (8 * (i - 1))) & 0xff);
+}
+
+/// Writes a string.
+void MsgPackEmitter::writeString(StringRef str) {
+  size_t size = str.size();
+
+  if (size < 32) {
+    buffer.push_back(0xa0 | size);
+  } else if (size <= UINT8_MAX) {
+    buffer.push_back('\xd9');
+    writeBE(size, 1);
+  } else if (size <= UINT16_MAX) {
+    buffer.push_back('\xda');
+    writeBE(size, 2);
+  } else {
+    buffer.push_back('\xdb');
+    writeBE(size, 4);
+  }
+
+  buffer.append(str.begin(), str.end());
+}
+
+/// Writes a signed integer.
+void MsgPackEmitter::writeInt(int64_t val) {
+  // Positive and negative fixint
+  if (val >= -32 && val < 128) {
+    buffer.push_back(val & 0xff);
+    return;
+  }
+
+  buffer.push_back('\xd3');
+  writeBE(val, 8);
+}
+
+/// Writes a value given as a JSON literal (null, true, false or numbers).
+/// Other literals are written as strings.
+void MsgPackEmitter::writeLiteral(StringRef str) {
+  str = str.trim();
+
+  if (str == "null") {
+    buffer.push_back('\xc0');
+    return;
+  }
+
+  if (str == "false") {
+    buffer.push_back('\xc2');
+    return;
+  }
+
+  if (str == "true") {
+    buffer.push_back('\xc3');
+    return;
+  }
+
+  int64_t intVal;
+  if (!str.getAsInteger(10, intVal)) {
+    writeInt(intVal);
+    return;
+  }
+
+  double floatVal;
+  if (!str.getAsDouble(floatVal)) {
+    buffer.push_back('\xcb');
+    writeBE(llvm::bit_cast<uint64_t>(floatVal), 8);
+    return;
+  }
+
+  writeString(str);
+}
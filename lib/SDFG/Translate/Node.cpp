@@ -3,6 +3,9 @@
 /// This file contains the nodes of the internal IR used by the translator.
 
 #include "SDFG/Translate/Node.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSwitch.h"
 
 using namespace mlir;
 using namespace sdfg;
@@ -77,6 +80,23 @@ std::string dtypeToString(DType t) {
   return "Unsupported DType";
 }
 
+/// Prints the DaCe dtype of the provided element type. One-dimensional vector
+/// types are printed as dace.vector of their element type.
+void printDtype(emitter::Emitter &jemit, Type t) {
+  VectorType vecType = t.dyn_cast<VectorType>();
+  if (!vecType || vecType.getRank() != 1) {
+    jemit.printKVPair("dtype", dtypeToString(typeToDtype(t)));
+    return;
+  }
+
+  jemit.startNamedObject("dtype");
+  jemit.printKVPair("type", "vector");
+  jemit.printKVPair("dtype",
+                    dtypeToString(typeToDtype(vecType.getElementType())));
+  jemit.printKVPair("elements", std::to_string(vecType.getNumElements()));
+  jemit.endObject(); // dtype
+}
+
 /// Converts a CodeLanguage to a string.
 std::string codeLanguageToString(CodeLanguage lang) {
   switch (lang) {
@@ -93,7 +113,7 @@ std::string codeLanguageToString(CodeLanguage lang) {
 
 /// Prints an array of ranges to the output stream.
 void printRangeVector(std::vector<translation::Range> ranges, std::string name,
-                      emitter::JsonEmitter &jemit) {
+                      emitter::Emitter &jemit) {
   if (ranges.empty()) {
     jemit.printKVPair(name, "null", /*stringify=*/false);
     return;
@@ -109,7 +129,7 @@ void printRangeVector(std::vector<translation::Range> ranges, std::string name,
 }
 
 /// Prints source location information as debug information.
-void printLocation(Location loc, emitter::JsonEmitter &jemit) {
+void printLocation(Location loc, emitter::Emitter &jemit) {
   jemit.startNamedObject("debuginfo");
   jemit.printKVPair("type", "DebugInfo");
 
@@ -138,23 +158,175 @@ void printLocation(Location loc, emitter::JsonEmitter &jemit) {
   jemit.endObject(); // debuginfo
 }
 
+/// Converts a write-conflict resolution to a Python lambda.
+std::string wcrToLambda(StringRef wcr) {
+  return llvm::StringSwitch<std::string>(wcr)
+      .Case("add", "lambda a, b: a + b")
+      .Case("mul", "lambda a, b: a * b")
+      .Case("min", "lambda a, b: min(a, b)")
+      .Case("max", "lambda a, b: max(a, b)")
+      .Case("and", "lambda a, b: a & b")
+      .Case("or", "lambda a, b: a | b")
+      .Default(wcr.str());
+}
+
+/// Returns the array the provided value views or null if it is not a view.
+Value getViewedArray(Value value) {
+  if (ViewCastOp viewCast = value.getDefiningOp<ViewCastOp>())
+    return viewCast.getSrc();
+
+  if (SubviewOp subview = value.getDefiningOp<SubviewOp>())
+    return subview.getSrc();
+
+  return nullptr;
+}
+
+/// Returns the ranges of the viewed array the provided view covers. Empty
+/// ranges cover the entire array.
+std::vector<translation::Range> getViewRanges(Value view) {
+  std::vector<translation::Range> ranges;
+
+  SubviewOp subview = view.getDefiningOp<SubviewOp>();
+  if (!subview)
+    return ranges;
+
+  for (unsigned i = 0; i < subview.getOffsets().size(); ++i) {
+    std::string offset =
+        utils::attributeToString(subview.getOffsets()[i], *subview);
+    std::string size =
+        utils::attributeToString(subview.getSizes()[i], *subview);
+    std::string stride =
+        utils::attributeToString(subview.getStrides()[i], *subview);
+
+    std::string end = offset + " + (" + size + " - 1) * " + stride;
+    ranges.push_back(translation::Range(offset, end, stride, "1"));
+  }
+
+  return ranges;
+}
+
+/// Returns true if the symbolic expression mentions the provided name.
+bool mentionsName(StringRef expr, StringRef name) {
+  if (name.empty())
+    return false;
+
+  auto isIdentChar = [](char c) { return llvm::isAlnum(c) || c == '_'; };
+
+  for (size_t pos = expr.find(name); pos != StringRef::npos;
+       pos = expr.find(name, pos + 1)) {
+    size_t end = pos + name.size();
+    if ((pos == 0 || !isIdentChar(expr[pos - 1])) &&
+        (end == expr.size() || !isIdentChar(expr[end])))
+      return true;
+  }
+
+  return false;
+}
+
+/// Returns the number of elements covered by the range as a symbolic
+/// expression.
+std::string getRangeSize(const translation::Range &range) {
+  if (range.start == range.end)
+    return "1";
+
+  int64_t start, end, step;
+  if (!StringRef(range.start).getAsInteger(10, start) &&
+      !StringRef(range.end).getAsInteger(10, end) &&
+      !StringRef(range.step).getAsInteger(10, step) && step > 0)
+    return std::to_string(end < start ? 0 : (end - start) / step + 1);
+
+  std::string size = "(" + range.end + ") - (" + range.start + ") + 1";
+  if (range.step == "1")
+    return size;
+
+  return "int_ceil(" + size + ", " + range.step + ")";
+}
+
+/// Returns the product of the symbolic factors. Constant factors are folded.
+std::string multiplyVolumes(ArrayRef<std::string> factors) {
+  int64_t constant = 1;
+  std::string product;
+
+  for (const std::string &factor : factors) {
+    int64_t value;
+    if (!StringRef(factor).getAsInteger(10, value)) {
+      constant *= value;
+      continue;
+    }
+
+    if (!product.empty())
+      product.append(" * ");
+    product.append("(" + factor + ")");
+  }
+
+  if (product.empty())
+    return std::to_string(constant);
+
+  if (constant == 1)
+    return product;
+
+  return std::to_string(constant) + " * " + product;
+}
+
+/// Returns the number of elements covered by the subset as a symbolic
+/// expression.
+std::string getSubsetVolume(ArrayRef<translation::Range> subset) {
+  std::vector<std::string> factors;
+  for (const translation::Range &range : subset)
+    factors.push_back(getRangeSize(range));
+  return multiplyVolumes(factors);
+}
+
+//===----------------------------------------------------------------------===//
+// NodeArena
+//===----------------------------------------------------------------------===//
+
+/// The current arena of this thread.
+thread_local NodeArena *NodeArena::current = nullptr;
+
+/// Destroys all implementations allocated in the arena. The implementations
+/// only refer to each other through handles, so the order does not matter.
+NodeArena::~NodeArena() {
+  for (Emittable *object : objects)
+    object->~Emittable();
+}
+
 //===----------------------------------------------------------------------===//
 // Array
 //===----------------------------------------------------------------------===//
 
-/// Emits this array to the output stream.
-void Array::emit(emitter::JsonEmitter &jemit) {
-  jemit.startNamedObject(name);
+/// Returns the strides of the array if its elements are stored contiguously.
+std::vector<std::string> Array::getContiguousStrides() {
+  std::vector<std::string> strideList = {"1"};
+  unsigned intStrideIdx = shape.getIntegers().size() - 1;
+  unsigned symStrideIdx = shape.getSymbols().size() - 1;
 
-  // FIXME: Rewrite to check with sdfg args instead of string
-  bool isArg = false;
-  if (name.find("arg") != std::string::npos) {
-    isArg = true;
+  for (unsigned i = 1; i < shape.getShape().size(); ++i) {
+    if (shape.getShape()[i]) {
+      strideList.push_back(strideList.back() + " * " +
+                           std::to_string(shape.getIntegers()[intStrideIdx]));
+      intStrideIdx--;
+    } else {
+      strideList.push_back(strideList.back() + " * " +
+                           shape.getSymbols()[symStrideIdx].str());
+      symStrideIdx--;
+    }
   }
 
+  std::reverse(strideList.begin(), strideList.end());
+  return strideList;
+}
+
+/// Emits this array to the output stream.
+void Array::emit(emitter::Emitter &jemit) {
+  jemit.startNamedObject(name);
+
+  // Scalar arguments are passed by reference, so they remain arrays.
   if (stream) {
     jemit.printKVPair("type", "Stream");
-  } else if (shape.getShape().empty() && !isArg) {
+  } else if (view) {
+    jemit.printKVPair("type", "View");
+  } else if (shape.getShape().empty() && !argument) {
     jemit.printKVPair("type", "Scalar");
   } else {
     jemit.printKVPair("type", "Array");
@@ -165,8 +337,16 @@ void Array::emit(emitter::JsonEmitter &jemit) {
   jemit.printKVPair("transient", transient ? "true" : "false",
                     /*stringify=*/false);
 
-  jemit.printKVPair("dtype",
-                    dtypeToString(typeToDtype(shape.getElementType())));
+  if (!storage.empty())
+    jemit.printKVPair("storage", storage);
+
+  if (!lifetime.empty())
+    jemit.printKVPair("lifetime", lifetime);
+
+  if (stream && !bufferSize.empty())
+    jemit.printKVPair("buffer_size", bufferSize);
+
+  printDtype(jemit, shape.getElementType());
 
   jemit.startNamedList("shape");
 
@@ -177,32 +357,14 @@ void Array::emit(emitter::JsonEmitter &jemit) {
 
   unsigned intIdx = 0;
   unsigned symIdx = 0;
-  SmallVector<std::string> strideList = {"1"};
-  unsigned intStrideIdx = shape.getIntegers().size() - 1;
-  unsigned symStrideIdx = shape.getSymbols().size() - 1;
 
   for (unsigned i = 0; i < shape.getShape().size(); ++i) {
     jemit.startEntry();
     if (shape.getShape()[i]) {
       jemit.printString(std::to_string(shape.getIntegers()[intIdx]));
-
-      if (i > 0) {
-        std::string newString =
-            strideList.back() + " * " +
-            std::to_string(shape.getIntegers()[intStrideIdx]);
-        strideList.push_back(newString);
-        intStrideIdx--;
-      }
       ++intIdx;
     } else {
       jemit.printString(shape.getSymbols()[symIdx].str());
-
-      if (i > 0) {
-        std::string newString =
-            strideList.back() + " * " + shape.getSymbols()[symStrideIdx].str();
-        strideList.push_back(newString);
-        symStrideIdx--;
-      }
       ++symIdx;
     }
   }
@@ -212,9 +374,10 @@ void Array::emit(emitter::JsonEmitter &jemit) {
   if (!shape.getShape().empty()) {
     jemit.startNamedList("strides");
 
-    for (int i = strideList.size() - 1; i >= 0; --i) {
+    for (const std::string &stride :
+         strides.empty() ? getContiguousStrides() : strides) {
       jemit.startEntry();
-      jemit.printString(strideList[i]);
+      jemit.printString(stride);
     }
 
     jemit.endList(); // strides
@@ -229,7 +392,7 @@ void Array::emit(emitter::JsonEmitter &jemit) {
 //===----------------------------------------------------------------------===//
 
 /// Emits this range to the output stream.
-void translation::Range::emit(emitter::JsonEmitter &jemit) {
+void translation::Range::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("start", start);
   jemit.printKVPair("end", end);
@@ -242,6 +405,12 @@ void translation::Range::emit(emitter::JsonEmitter &jemit) {
 // InterstateEdge
 //===----------------------------------------------------------------------===//
 
+/// Creates an interstate edge between the provided states.
+InterstateEdge::InterstateEdge(Location location, State source,
+                               State destination)
+    : ptr(NodeArena::create<InterstateEdgeImpl>(location, source,
+                                                destination)) {}
+
 /// Sets the condition of the interstate edge.
 void InterstateEdge::setCondition(Condition condition) {
   ptr->setCondition(condition);
@@ -253,7 +422,7 @@ void InterstateEdge::addAssignment(Assignment assignment) {
 }
 
 /// Emits the interstate edge to the output stream.
-void InterstateEdge::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void InterstateEdge::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Sets the condition of the interstate edge.
 void InterstateEdgeImpl::setCondition(Condition condition) {
@@ -266,7 +435,7 @@ void InterstateEdgeImpl::addAssignment(Assignment assignment) {
 }
 
 /// Emits the interstate edge to the output stream.
-void InterstateEdgeImpl::emit(emitter::JsonEmitter &jemit) {
+void InterstateEdgeImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "Edge");
   jemit.printKVPair("src", source.getID());
@@ -280,7 +449,7 @@ void InterstateEdgeImpl::emit(emitter::JsonEmitter &jemit) {
   jemit.startNamedObject("attributes");
 
   jemit.startNamedObject("assignments");
-  for (Assignment a : assignments)
+  for (const Assignment &a : assignments)
     jemit.printKVPair(a.key, a.value);
   jemit.endObject(); // assignments
 
@@ -301,16 +470,42 @@ void InterstateEdgeImpl::emit(emitter::JsonEmitter &jemit) {
 //===----------------------------------------------------------------------===//
 
 /// Returns the source connector of this edge.
-Connector MultiEdge::getSource() { return source; }
+const Connector &MultiEdge::getSource() { return source; }
 
 /// Returns the destination connector of this edge.
-Connector MultiEdge::getDestination() { return destination; }
+const Connector &MultiEdge::getDestination() { return destination; }
 
 /// Makes this edge a dependency edge.
 void MultiEdge::makeDependence() { depEdge = true; }
 
+/// Returns true if this edge is a dependency edge.
+bool MultiEdge::isDependence() { return depEdge; }
+
+/// Returns the moved subset, which is the subset of the source connector or
+/// the subset of the destination connector if the source has none.
+std::vector<Range> MultiEdge::getSubset() {
+  return source.ranges.empty() ? destination.ranges : source.ranges;
+}
+
+/// Sets the moved subset.
+void MultiEdge::setSubset(std::vector<Range> subset) {
+  source.setRanges(subset);
+}
+
+/// Returns the number of moved elements. Empty if unknown.
+StringRef MultiEdge::getVolume() { return volume; }
+
+/// Returns true if the volume is only an upper bound.
+bool MultiEdge::isDynamic() { return dynamic; }
+
+/// Sets the number of moved elements and whether it is only an upper bound.
+void MultiEdge::setVolume(StringRef volume, bool dynamic) {
+  this->volume = volume.str();
+  this->dynamic = dynamic;
+}
+
 /// Emits this edge to the output stream.
-void MultiEdge::emit(emitter::JsonEmitter &jemit) {
+void MultiEdge::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "MultiConnectorEdge");
 
@@ -341,6 +536,16 @@ void MultiEdge::emit(emitter::JsonEmitter &jemit) {
   printRangeVector(destination.ranges, "other_subset", jemit);
   printRangeVector(destination.ranges, "dst_subset", jemit);
 
+  // An exact volume spares DaCe from propagating the memlet on import.
+  if (!volume.empty() && !depEdge) {
+    jemit.printKVPair("volume", volume);
+    jemit.printKVPair("dynamic", dynamic ? "true" : "false",
+                      /*stringify=*/false);
+  }
+
+  if (!destination.wcr.empty() && !depEdge)
+    jemit.printKVPair("wcr", wcrToLambda(destination.wcr));
+
   jemit.endObject(); // attributes
   jemit.endObject(); // data
   jemit.endObject(); // attributes
@@ -382,7 +587,7 @@ bool Node::hasParent() { return getParent().ptr != nullptr; }
 /// Returns the top-level SDFG.
 SDFG Node::getSDFG() {
   if (type == NType::SDFG) {
-    return SDFG(std::static_pointer_cast<SDFGImpl>(ptr));
+    return SDFG(static_cast<SDFGImpl *>(ptr));
   }
   return ptr->getParent().getSDFG();
 }
@@ -390,7 +595,7 @@ SDFG Node::getSDFG() {
 /// Returns the surrounding state.
 State Node::getState() {
   if (type == NType::State) {
-    return State(std::static_pointer_cast<StateImpl>(ptr));
+    return State(static_cast<StateImpl *>(ptr));
   }
   return ptr->getParent().getState();
 }
@@ -399,8 +604,13 @@ State Node::getState() {
 /// name.
 void Node::addAttribute(Attribute attribute) { ptr->addAttribute(attribute); }
 
+/// Sets the DaCe instrumentation type of the node.
+void Node::setInstrument(StringRef instrument) {
+  ptr->setInstrument(instrument);
+}
+
 /// Emits this node to the output stream.
-void Node::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void Node::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Sets the ID of the node.
 void NodeImpl::setID(unsigned id) { this->id = id; }
@@ -420,6 +630,17 @@ void NodeImpl::setName(StringRef name) {
 /// Returns the name of the node.
 StringRef NodeImpl::getName() { return name; }
 
+/// Sets the DaCe instrumentation type of the node.
+void NodeImpl::setInstrument(StringRef instrument) {
+  this->instrument = instrument.str();
+}
+
+/// Emits the instrumentation type, if any, to the output stream.
+void NodeImpl::emitInstrument(emitter::Emitter &jemit) {
+  if (!instrument.empty())
+    jemit.printKVPair("instrument", instrument);
+}
+
 /// Sets the parent of the node.
 void NodeImpl::setParent(Node parent) { this->parent = parent; }
 
@@ -433,12 +654,19 @@ void NodeImpl::addAttribute(Attribute attribute) {
 }
 
 /// Emits this node to the output stream.
-void NodeImpl::emit(emitter::JsonEmitter &jemit) {}
+void NodeImpl::emit(emitter::Emitter &jemit) {}
 
 //===----------------------------------------------------------------------===//
 // ConnectorNode
 //===----------------------------------------------------------------------===//
 
+/// Refers to the provided connector node implementation.
+ConnectorNode::ConnectorNode(ConnectorNodeImpl *ptr) : Node(ptr), ptr(ptr) {}
+
+/// Refers to the connector node implementation of the provided node.
+ConnectorNode::ConnectorNode(Node n)
+    : Node(n), ptr(static_cast<ConnectorNodeImpl *>(Node::ptr)) {}
+
 /// Adds an incoming connector.
 void ConnectorNode::addInConnector(Connector connector) {
   ptr->addInConnector(connector);
@@ -460,11 +688,11 @@ unsigned ConnectorNode::getOutConnectorCount() {
 }
 
 /// Emits the connectors to the output stream.
-void ConnectorNode::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void ConnectorNode::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Adds an incoming connector.
 void ConnectorNodeImpl::addInConnector(Connector connector) {
-  for (Connector c : inConnectors)
+  for (const Connector &c : inConnectors)
     if (c.name == connector.name && c.parent == connector.parent) {
       if (c == connector) {
         return;
@@ -480,7 +708,7 @@ void ConnectorNodeImpl::addInConnector(Connector connector) {
 
 /// Adds an outgoing connector.
 void ConnectorNodeImpl::addOutConnector(Connector connector) {
-  for (Connector c : outConnectors)
+  for (const Connector &c : outConnectors)
     if (c.name == connector.name && c.parent == connector.parent) {
       if (c == connector) {
         return;
@@ -505,9 +733,9 @@ unsigned ConnectorNodeImpl::getOutConnectorCount() {
 }
 
 /// Emits the connectors to the output stream.
-void ConnectorNodeImpl::emit(emitter::JsonEmitter &jemit) {
+void ConnectorNodeImpl::emit(emitter::Emitter &jemit) {
   jemit.startNamedObject("in_connectors");
-  for (Connector c : inConnectors) {
+  for (const Connector &c : inConnectors) {
     if (c.isNull)
       continue;
     jemit.printKVPair(c.name, "null", /*stringify=*/false);
@@ -515,7 +743,7 @@ void ConnectorNodeImpl::emit(emitter::JsonEmitter &jemit) {
   jemit.endObject(); // in_connectors
 
   jemit.startNamedObject("out_connectors");
-  for (Connector c : outConnectors) {
+  for (const Connector &c : outConnectors) {
     if (c.isNull)
       continue;
     jemit.printKVPair(c.name, "null", /*stringify=*/false);
@@ -527,6 +755,13 @@ void ConnectorNodeImpl::emit(emitter::JsonEmitter &jemit) {
 // ScopeNode
 //===----------------------------------------------------------------------===//
 
+/// Refers to the provided scope node implementation.
+ScopeNode::ScopeNode(ScopeNodeImpl *ptr) : ConnectorNode(ptr), ptr(ptr) {}
+
+/// Refers to the scope node implementation of the provided node.
+ScopeNode::ScopeNode(Node n)
+    : ConnectorNode(n), ptr(static_cast<ScopeNodeImpl *>(Node::ptr)) {}
+
 /// Adds a connector node to the scope.
 void ScopeNode::addNode(ConnectorNode node) {
   if (!node.hasParent()) {
@@ -575,7 +810,7 @@ void ScopeNode::addDependency(Value value, Connector connector) {
 }
 
 /// Emits all nodes and edges to the output stream.
-void ScopeNode::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void ScopeNode::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Adds a connector node to the scope.
 void ScopeNodeImpl::addNode(ConnectorNode node) {
@@ -595,11 +830,31 @@ void ScopeNodeImpl::routeWrite(Connector from, Connector to, Value mapValue) {
 }
 
 /// Adds an edge to the scope.
-void ScopeNodeImpl::addEdge(MultiEdge edge) { edges.push_back(edge); }
+void ScopeNodeImpl::addEdge(MultiEdge edge) { insertEdge(edge); }
+
+/// Appends an edge to the scope and updates the edge adjacency.
+void ScopeNodeImpl::insertEdge(MultiEdge edge) {
+  unsigned idx = edges.size();
+  outEdges[edge.getSource().parent.getImpl()].push_back(idx);
+  inEdges[edge.getDestination().parent.getImpl()].push_back(idx);
+  edges.push_back(edge);
+}
+
+/// Returns true if the node has an incoming edge in the scope.
+bool ScopeNodeImpl::hasInEdge(ConnectorNode node) {
+  auto it = inEdges.find(node.getImpl());
+  return it != inEdges.end() && !it->second.empty();
+}
+
+/// Returns true if the node has an outgoing edge in the scope.
+bool ScopeNodeImpl::hasOutEdge(ConnectorNode node) {
+  auto it = outEdges.find(node.getImpl());
+  return it != outEdges.end() && !it->second.empty();
+}
 
 /// Maps the MLIR value to the specified connector.
 void ScopeNodeImpl::mapConnector(Value value, Connector connector) {
-  auto res = lut.insert({utils::valueToString(value), connector});
+  auto res = lut.insert({value, connector});
 
   if (!res.second)
     res.first->second = connector;
@@ -607,11 +862,12 @@ void ScopeNodeImpl::mapConnector(Value value, Connector connector) {
 
 /// Returns the connector associated with a MLIR value.
 Connector ScopeNodeImpl::lookup(Value value) {
-  if (lut.find(utils::valueToString(value)) == lut.end()) {
+  auto it = lut.find(value);
+  if (it == lut.end()) {
     emitError(location,
               "Tried to lookup nonexistent value in ScopeNodeImpl::lookup");
   }
-  return lut.find(utils::valueToString(value))->second;
+  return it->second;
 }
 
 /// Adds a dependency edge between the MLIR and the connector.
@@ -622,14 +878,14 @@ void ScopeNodeImpl::addDependency(Value value, Connector connector) {
 }
 
 /// Emits all nodes and edges to the output stream.
-void ScopeNodeImpl::emit(emitter::JsonEmitter &jemit) {
+void ScopeNodeImpl::emit(emitter::Emitter &jemit) {
   jemit.startNamedList("nodes");
-  for (ConnectorNode cn : nodes)
+  for (ConnectorNode &cn : nodes)
     cn.emit(jemit);
   jemit.endList(); // nodes
 
   jemit.startNamedList("edges");
-  for (MultiEdge me : edges)
+  for (MultiEdge &me : edges)
     me.emit(jemit);
   jemit.endList(); // edges
 }
@@ -638,6 +894,17 @@ void ScopeNodeImpl::emit(emitter::JsonEmitter &jemit) {
 // SDFG
 //===----------------------------------------------------------------------===//
 
+/// Refers to the provided SDFG implementation.
+SDFG::SDFG(SDFGImpl *ptr) : Node(ptr), ptr(ptr) { type = NType::SDFG; }
+
+/// Creates a SDFG in the current node arena.
+SDFG::SDFG(Location location) : SDFG(NodeArena::create<SDFGImpl>(location)) {}
+
+/// Refers to the SDFG implementation of the provided node.
+SDFG::SDFG(Node n) : Node(n), ptr(static_cast<SDFGImpl *>(Node::ptr)) {
+  type = NType::SDFG;
+}
+
 /// Returns the state associated with the provided name.
 State SDFG::lookup(StringRef name) { return ptr->lookup(name); }
 
@@ -660,26 +927,38 @@ void SDFG::addArg(Array arg) { ptr->addArg(arg); }
 void SDFG::addSymbol(Symbol symbol) { ptr->addSymbol(symbol); }
 
 /// Returns an array of all symbols in the SDFG.
-std::vector<Symbol> SDFG::getSymbols() { return ptr->getSymbols(); }
+const std::vector<Symbol> &SDFG::getSymbols() { return ptr->getSymbols(); }
 
 /// Sets all non-argument arrays to transient.
 void SDFG::setNestedTransient() { ptr->setNestedTransient(); }
 
 /// Emits the SDFG to the output stream.
-void SDFG::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); };
+void SDFG::emit(emitter::Emitter &jemit) { ptr->emit(jemit); };
 
 /// Emits the SDFG as a nested SDFG to the output stream.
-void SDFG::emitNested(emitter::JsonEmitter &jemit) { ptr->emitNested(jemit); };
+void SDFG::emitNested(emitter::Emitter &jemit) { ptr->emitNested(jemit); };
+
+/// Starts emitting the SDFG to the output stream, such that its states can be
+/// emitted as soon as they are collected.
+void SDFG::beginStream(emitter::Emitter &jemit) { ptr->beginStream(jemit); }
+
+/// Emits the provided state of a streamed SDFG and releases its contents.
+void SDFG::streamState(State state, emitter::Emitter &jemit) {
+  ptr->streamState(state, jemit);
+}
+
+/// Finishes emitting a streamed SDFG once all states are collected.
+void SDFG::endStream(emitter::Emitter &jemit) { ptr->endStream(jemit); }
 
-/// Global counter for the ID of SDFGs.
-unsigned SDFGImpl::list_id = 0;
+/// Global counter for the ID of SDFGs, assigned in emission order.
+thread_local unsigned SDFGImpl::list_id = 0;
 
 /// Returns the state associated with the provided name.
 State SDFGImpl::lookup(StringRef name) { return lut.find(name.str())->second; }
 
 /// Adds a state to the SDFG.
 void SDFGImpl::addState(State state) {
-  state.setParent(SDFG(shared_from_this()));
+  state.setParent(SDFG(this));
   state.setID(states.size());
   states.push_back(state);
 
@@ -705,15 +984,22 @@ void SDFGImpl::addArray(Array array) { arrays.push_back(array); }
 
 /// Adds an array (data container) to the SDFG and marks it as an argument.
 void SDFGImpl::addArg(Array arg) {
+  arg.argument = true;
   args.push_back(arg);
   addArray(arg);
 }
 
-/// Adds a symbol to the SDFG.
-void SDFGImpl::addSymbol(Symbol symbol) { symbols.push_back(symbol); }
+/// Adds a symbol to the SDFG unless a symbol with the same name exists.
+void SDFGImpl::addSymbol(Symbol symbol) {
+  if (llvm::any_of(symbols,
+                   [&](const Symbol &s) { return s.name == symbol.name; }))
+    return;
+
+  symbols.push_back(symbol);
+}
 
 /// Returns an array of all symbols in the SDFG.
-std::vector<Symbol> SDFGImpl::getSymbols() { return symbols; }
+const std::vector<Symbol> &SDFGImpl::getSymbols() { return symbols; }
 
 /// Sets all non-argument arrays to transient.
 void SDFGImpl::setNestedTransient() {
@@ -723,30 +1009,77 @@ void SDFGImpl::setNestedTransient() {
 }
 
 /// Emits the SDFG to the output stream.
-void SDFGImpl::emit(emitter::JsonEmitter &jemit) {
+void SDFGImpl::emit(emitter::Emitter &jemit) {
+  // IDs are assigned in pre-order, which keeps them deterministic regardless
+  // of the order in which the SDFGs were collected.
+  SDFGImpl::list_id = 0;
   jemit.startObject();
   emitBody(jemit);
 }
 
 /// Emits the SDFG as a nested SDFG to the output stream.
-void SDFGImpl::emitNested(emitter::JsonEmitter &jemit) {
+void SDFGImpl::emitNested(emitter::Emitter &jemit) {
   jemit.startNamedObject("sdfg");
   emitBody(jemit);
 }
 
 /// Emits the body of the SDFG to the output stream.
-void SDFGImpl::emitBody(emitter::JsonEmitter &jemit) {
+void SDFGImpl::emitBody(emitter::Emitter &jemit) {
+  id = SDFGImpl::list_id++;
+  jemit.printKVPair("type", "SDFG");
+  jemit.printKVPair("sdfg_list_id", id, /*stringify=*/false);
+  jemit.printKVPair("start_state", startState.getID(),
+                    /*stringify=*/false);
+  emitAttributes(jemit);
+
+  jemit.startNamedList("nodes");
+  for (State &s : states)
+    s.emit(jemit);
+  jemit.endList(); // nodes
+
+  emitEdges(jemit);
+  jemit.endObject();
+}
+
+/// Starts emitting the SDFG to the output stream, such that its states can be
+/// emitted as soon as they are collected.
+void SDFGImpl::beginStream(emitter::Emitter &jemit) {
+  SDFGImpl::list_id = 0;
+  jemit.startObject();
+
+  id = SDFGImpl::list_id++;
   jemit.printKVPair("type", "SDFG");
   jemit.printKVPair("sdfg_list_id", id, /*stringify=*/false);
+  jemit.startNamedList("nodes");
+}
+
+/// Emits the provided state of a streamed SDFG and releases its contents.
+void SDFGImpl::streamState(State state, emitter::Emitter &jemit) {
+  state.emit(jemit);
+  state.release();
+}
+
+/// Finishes emitting a streamed SDFG once all states are collected. The arrays
+/// are only known at this point, so the attributes follow the states.
+void SDFGImpl::endStream(emitter::Emitter &jemit) {
+  jemit.endList(); // nodes
+  emitEdges(jemit);
+
   jemit.printKVPair("start_state", startState.getID(),
                     /*stringify=*/false);
+  emitAttributes(jemit);
+  jemit.endObject();
+}
 
+/// Emits the attributes of the SDFG to the output stream.
+void SDFGImpl::emitAttributes(emitter::Emitter &jemit) {
   jemit.startNamedObject("attributes");
   printLocation(location, jemit);
   jemit.printKVPair("name", name);
+  emitInstrument(jemit);
 
   jemit.startNamedList("arg_names");
-  for (Array a : args) {
+  for (const Array &a : args) {
     jemit.startEntry();
     jemit.printString(a.name);
   }
@@ -756,39 +1089,105 @@ void SDFGImpl::emitBody(emitter::JsonEmitter &jemit) {
   jemit.endObject(); // constants_prop
 
   jemit.startNamedObject("_arrays");
-  for (Array a : arrays)
+  for (Array &a : arrays)
     a.emit(jemit);
   jemit.endObject(); // _arrays
 
   jemit.startNamedObject("symbols");
-  for (Symbol s : symbols)
+  for (const Symbol &s : symbols)
     jemit.printKVPair(s.name, dtypeToString(s.type));
   jemit.endObject(); // symbols
 
   jemit.endObject(); // attributes
+}
 
-  jemit.startNamedList("nodes");
-  for (State s : states)
-    s.emit(jemit);
-  jemit.endList(); // nodes
-
+/// Emits the interstate edges of the SDFG to the output stream.
+void SDFGImpl::emitEdges(emitter::Emitter &jemit) {
   jemit.startNamedList("edges");
-  for (InterstateEdge e : edges)
+  for (InterstateEdge &e : edges)
     e.emit(jemit);
   jemit.endList(); // edges
+}
 
-  jemit.endObject();
+/// Replays a nested SDFG recorded by emitNested to the output stream. The IDs
+/// of the contained SDFGs are assigned in emission order and the inherited
+/// symbols are added to all of them, as if the SDFG was emitted in place.
+void SDFGImpl::emitRecording(
+    emitter::Emitter &jemit,
+    ArrayRef<emitter::RecordingEmitter::Event> recording,
+    ArrayRef<Symbol> inherited) {
+  using Kind = emitter::RecordingEmitter::Kind;
+  // The keys of the open objects and lists.
+  SmallVector<StringRef> openKeys;
+
+  for (const emitter::RecordingEmitter::Event &event : recording) {
+    switch (event.kind) {
+    case Kind::Object:
+    case Kind::NamedObject:
+    case Kind::NamedList:
+      openKeys.push_back(event.key);
+      break;
+
+    case Kind::EndObject: {
+      // The symbols of every SDFG as well as the symbol mappings of every
+      // nested SDFG end with the inherited symbols.
+      bool inAttributes =
+          openKeys.size() >= 2 && openKeys[openKeys.size() - 2] == "attributes";
+
+      if (inAttributes && openKeys.back() == "symbols")
+        for (const Symbol &s : inherited)
+          jemit.printKVPair(s.name, dtypeToString(s.type));
+
+      if (inAttributes && openKeys.back() == "symbol_mapping")
+        for (const Symbol &s : inherited)
+          jemit.printKVPair(s.name, s.name);
+
+      if (!openKeys.empty())
+        openKeys.pop_back();
+      break;
+    }
+
+    case Kind::EndList:
+      if (!openKeys.empty())
+        openKeys.pop_back();
+      break;
+
+    case Kind::KVInt:
+      if (event.key == "sdfg_list_id") {
+        jemit.printKVPair(event.key, SDFGImpl::list_id++, event.stringify);
+        continue;
+      }
+      break;
+
+    default:
+      break;
+    }
+
+    emitter::RecordingEmitter::replay(event, jemit);
+  }
 }
 
 //===----------------------------------------------------------------------===//
 // NestedSDFG
 //===----------------------------------------------------------------------===//
 
+/// Creates a nested SDFG in the current node arena.
+NestedSDFG::NestedSDFG(Location location, SDFG sdfg)
+    : ConnectorNode(NodeArena::create<NestedSDFGImpl>(location, sdfg)),
+      ptr(static_cast<NestedSDFGImpl *>(ConnectorNode::ptr)) {}
+
+/// Creates a nested SDFG replaying the provided recording in the current node
+/// arena.
+NestedSDFG::NestedSDFG(Location location,
+                       std::vector<emitter::RecordingEmitter::Event> recording)
+    : ConnectorNode(NodeArena::create<NestedSDFGImpl>(location, recording)),
+      ptr(static_cast<NestedSDFGImpl *>(ConnectorNode::ptr)) {}
+
 /// Emits the nested SDFG to the output stream.
-void NestedSDFG::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void NestedSDFG::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Emits the nested SDFG to the output stream.
-void NestedSDFGImpl::emit(emitter::JsonEmitter &jemit) {
+void NestedSDFGImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "NestedSDFG");
   jemit.printKVPair("id", id, /*stringify=*/false);
@@ -799,13 +1198,18 @@ void NestedSDFGImpl::emit(emitter::JsonEmitter &jemit) {
   ConnectorNodeImpl::emit(jemit);
 
   jemit.startNamedObject("symbol_mapping");
-  for (Symbol s : parent.getSDFG().getSymbols()) {
+  SDFG parentSDFG = parent.getSDFG();
+  for (const Symbol &s : parentSDFG.getSymbols()) {
     jemit.printKVPair(s.name, s.name);
-    sdfg.addSymbol(s);
+    if (recording.empty())
+      sdfg.addSymbol(s);
   }
   jemit.endObject(); // symbol_mapping
 
-  sdfg.emitNested(jemit);
+  if (recording.empty())
+    sdfg.emitNested(jemit);
+  else
+    SDFGImpl::emitRecording(jemit, recording, parentSDFG.getSymbols());
 
   jemit.endObject(); // attributes
   jemit.endObject();
@@ -815,22 +1219,35 @@ void NestedSDFGImpl::emit(emitter::JsonEmitter &jemit) {
 // State
 //===----------------------------------------------------------------------===//
 
+/// Refers to the provided state implementation.
+State::State(StateImpl *ptr) : ScopeNode(ptr), ptr(ptr) { type = NType::State; }
+
+/// Creates a state in the current node arena.
+State::State(Location location)
+    : State(NodeArena::create<StateImpl>(location)) {}
+
 /// Modified lookup function creates access nodes if the value could not be
 /// found.
 Connector State::lookup(Value value) { return ptr->lookup(value); }
 
+/// Computes the exact subsets and volumes of the memlets entering and
+/// leaving maps.
+void State::propagateMemlets() { ptr->propagateMemlets(); }
+
+/// Releases the nodes and edges of the state once it has been emitted.
+void State::release() { ptr->release(); }
+
 /// Emits the state node to the output stream.
-void State::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void State::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Modified lookup function creates access nodes if the value could not be
 /// found.
 Connector StateImpl::lookup(Value value) {
-  if (lut.find(utils::valueToString(value)) == lut.end()) {
+  if (lut.find(value) == lut.end()) {
     std::string name = utils::valueToString(value);
     bool init = false;
 
-    if (value.getDefiningOp() != nullptr) {
-      AllocOp allocOp = cast<AllocOp>(value.getDefiningOp());
+    if (AllocOp allocOp = value.getDefiningOp<AllocOp>()) {
       name = allocOp.getName().value_or(name);
       init = allocOp->hasAttr("init");
     }
@@ -839,6 +1256,16 @@ Connector StateImpl::lookup(Value value) {
     access.setName(name);
     addNode(access);
 
+    // Views read the section of the array they view.
+    if (Value viewed = getViewedArray(value)) {
+      Connector viewedOut = lookup(viewed);
+      viewedOut.setRanges(getViewRanges(value));
+
+      Connector viewIn(access, "views");
+      access.addInConnector(viewIn);
+      addEdge(MultiEdge(location, viewedOut, viewIn));
+    }
+
     Connector accOut(access);
     accOut.setData(name);
     access.addOutConnector(accOut);
@@ -849,8 +1276,203 @@ Connector StateImpl::lookup(Value value) {
   return ScopeNodeImpl::lookup(value);
 }
 
+/// Adds a multiedge from the source to the destination connector. Writes to
+/// views are written back to the array they view.
+void StateImpl::routeWrite(Connector from, Connector to, Value mapValue) {
+  ScopeNodeImpl::routeWrite(from, to, mapValue);
+
+  Value viewed = getViewedArray(mapValue);
+  if (!viewed)
+    return;
+
+  std::string name = utils::valueToString(viewed);
+  bool init = false;
+
+  if (AllocOp allocOp = viewed.getDefiningOp<AllocOp>()) {
+    name = allocOp.getName().value_or(name);
+    init = allocOp->hasAttr("init");
+  }
+
+  Connector viewOut(to.parent, "views");
+  viewOut.setData(name);
+  viewOut.setRanges(getViewRanges(mapValue));
+  to.parent.addOutConnector(viewOut);
+
+  Access access(location, init);
+  access.setName(name);
+
+  Connector accIn(access);
+  accIn.setData(name);
+  access.addInConnector(accIn);
+
+  routeWrite(viewOut, accIn, viewed);
+}
+
+/// Computes the memlet moved by an edge in a single iteration of the
+/// surrounding scope. Returns false if it is not known exactly.
+bool StateImpl::getMemlet(MultiEdge &edge, std::vector<Range> &subset,
+                          std::string &volume, bool &dynamic) {
+  if (edge.isDependence())
+    return false;
+
+  subset = edge.getSubset();
+  if (!subset.empty()) {
+    volume = edge.getVolume().empty() ? getSubsetVolume(subset)
+                                      : edge.getVolume().str();
+    dynamic = edge.isDynamic();
+    return true;
+  }
+
+  // Access nodes inside of a map forward the memlets written to them.
+  ConnectorNode source = edge.getSource().parent;
+  if (source.getType() != NType::Access)
+    return false;
+
+  return uniteMemlets(inEdges.lookup(source.getImpl()), subset, volume,
+                      dynamic);
+}
+
+/// Computes the union of the memlets moved by the provided edges in a single
+/// iteration of the surrounding scope. Returns false if it is not known
+/// exactly.
+bool StateImpl::uniteMemlets(ArrayRef<unsigned> edgeIndices,
+                             std::vector<Range> &subset, std::string &volume,
+                             bool &dynamic) {
+  if (edgeIndices.empty())
+    return false;
+
+  std::vector<std::string> volumes;
+  dynamic = false;
+
+  for (unsigned idx : edgeIndices) {
+    std::vector<Range> edgeSubset;
+    std::string edgeVolume;
+    bool edgeDynamic;
+
+    if (!getMemlet(edges[idx], edgeSubset, edgeVolume, edgeDynamic))
+      return false;
+
+    // Only identical subsets can be united without overapproximation.
+    if (!volumes.empty() && edgeSubset != subset)
+      return false;
+
+    subset = edgeSubset;
+    volumes.push_back(edgeVolume);
+    dynamic |= edgeDynamic;
+  }
+
+  volume = volumes.size() == 1 ? volumes.front()
+                               : "(" + llvm::join(volumes, ") + (") + ")";
+  return true;
+}
+
+/// Propagates the memlets of the map body to the edges entering the map.
+void StateImpl::propagateMapEntry(MapEntry entry) {
+  for (unsigned inIdx : inEdges.lookup(entry.getImpl())) {
+    StringRef inName = edges[inIdx].getDestination().name;
+    if (!inName.startswith("IN_"))
+      continue;
+
+    std::string outName = "OUT_" + inName.drop_front(3).str();
+    SmallVector<unsigned> outIdxs;
+
+    for (unsigned outIdx : outEdges.lookup(entry.getImpl())) {
+      MultiEdge &outEdge = edges[outIdx];
+      if (outEdge.isDependence() || outEdge.getSource().name != outName)
+        continue;
+
+      std::vector<Range> subset = outEdge.getSubset();
+      if (!subset.empty() && outEdge.getVolume().empty())
+        outEdge.setVolume(getSubsetVolume(subset), /*dynamic=*/false);
+
+      outIdxs.push_back(outIdx);
+    }
+
+    std::vector<Range> subset;
+    std::string volume;
+    bool dynamic;
+
+    if (!uniteMemlets(outIdxs, subset, volume, dynamic) ||
+        !entry.propagate(subset, volume))
+      continue;
+
+    edges[inIdx].setSubset(subset);
+    edges[inIdx].setVolume(volume, dynamic);
+  }
+}
+
+/// Propagates the memlets of the map body to the edges leaving the map.
+void StateImpl::propagateMapExit(MapEntry entry) {
+  MapExit exit = entry.getExit();
+
+  for (unsigned outIdx : outEdges.lookup(exit.getImpl())) {
+    StringRef outName = edges[outIdx].getSource().name;
+    if (!outName.startswith("OUT_"))
+      continue;
+
+    std::string inName = "IN_" + outName.drop_front(4).str();
+    SmallVector<unsigned> inIdxs;
+
+    for (unsigned inIdx : inEdges.lookup(exit.getImpl())) {
+      MultiEdge &inEdge = edges[inIdx];
+      if (inEdge.isDependence() || inEdge.getDestination().name != inName)
+        continue;
+
+      // Annotate the edge with the memlet moved in a single iteration.
+      std::vector<Range> subset;
+      std::string volume;
+      bool dynamic;
+
+      if (getMemlet(inEdge, subset, volume, dynamic)) {
+        if (inEdge.getSubset().empty())
+          inEdge.setSubset(subset);
+        if (inEdge.getVolume().empty())
+          inEdge.setVolume(volume, dynamic);
+      }
+
+      inIdxs.push_back(inIdx);
+    }
+
+    std::vector<Range> subset;
+    std::string volume;
+    bool dynamic;
+
+    if (!uniteMemlets(inIdxs, subset, volume, dynamic) ||
+        !entry.propagate(subset, volume))
+      continue;
+
+    edges[outIdx].setSubset(subset);
+    edges[outIdx].setVolume(volume, dynamic);
+  }
+}
+
+/// Computes the exact subsets and volumes of the memlets entering and
+/// leaving maps.
+void StateImpl::propagateMemlets() {
+  // Nested maps are added after their parent map, so propagating in reverse
+  // order handles the innermost maps first.
+  for (ConnectorNode &node : llvm::reverse(nodes)) {
+    if (node.getType() != NType::MapEntry)
+      continue;
+
+    MapEntry entry(node);
+    propagateMapEntry(entry);
+    propagateMapExit(entry);
+  }
+}
+
+/// Releases the nodes and edges of the state once it has been emitted. Their
+/// implementations are freed with the arena they are allocated in.
+void StateImpl::release() {
+  lut.clear();
+  nodes.clear();
+  edges.clear();
+  inEdges.clear();
+  outEdges.clear();
+}
+
 /// Emits the state node to the output stream.
-void StateImpl::emit(emitter::JsonEmitter &jemit) {
+void StateImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "SDFGState");
   printLocation(location, jemit);
@@ -858,6 +1480,7 @@ void StateImpl::emit(emitter::JsonEmitter &jemit) {
   jemit.printKVPair("id", id, /*stringify=*/false);
 
   jemit.startNamedObject("attributes");
+  emitInstrument(jemit);
   jemit.endObject(); // attributes
 
   ScopeNodeImpl::emit(jemit);
@@ -868,6 +1491,11 @@ void StateImpl::emit(emitter::JsonEmitter &jemit) {
 // Tasklet
 //===----------------------------------------------------------------------===//
 
+/// Creates a tasklet in the current node arena.
+Tasklet::Tasklet(Location location)
+    : ConnectorNode(NodeArena::create<TaskletImpl>(location)),
+      ptr(static_cast<TaskletImpl *>(ConnectorNode::ptr)) {}
+
 /// Sets the code of the tasklet.
 void Tasklet::setCode(Code code) { ptr->setCode(code); }
 
@@ -882,7 +1510,7 @@ void Tasklet::setHasSideEffect(bool hasSideEffect) {
 }
 
 /// Emits the tasklet to the output stream.
-void Tasklet::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void Tasklet::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Sets the code of the tasklet.
 void TaskletImpl::setCode(Code code) { this->code = code; }
@@ -898,7 +1526,7 @@ void TaskletImpl::setHasSideEffect(bool hasSideEffect) {
 }
 
 /// Emits the tasklet to the output stream.
-void TaskletImpl::emit(emitter::JsonEmitter &jemit) {
+void TaskletImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "Tasklet");
   jemit.printKVPair("label", name);
@@ -907,6 +1535,7 @@ void TaskletImpl::emit(emitter::JsonEmitter &jemit) {
   jemit.startNamedObject("attributes");
   printLocation(location, jemit);
   jemit.printKVPair("label", name);
+  emitInstrument(jemit);
 
   jemit.startNamedObject("code");
   jemit.printKVPair("string_data", code.data);
@@ -930,21 +1559,52 @@ void TaskletImpl::emit(emitter::JsonEmitter &jemit) {
 // Library
 //===----------------------------------------------------------------------===//
 
+/// Creates a library node in the current node arena.
+Library::Library(Location location)
+    : ConnectorNode(NodeArena::create<LibraryImpl>(location)),
+      ptr(static_cast<LibraryImpl *>(ConnectorNode::ptr)) {}
+
 /// Sets the library code path.
 void Library::setClasspath(StringRef classpath) {
   ptr->setClasspath(classpath);
 }
 
+/// Adds a property of the library node. If desired, turns the value into a
+/// string.
+void Library::addProperty(StringRef key, StringRef value, bool stringify) {
+  ptr->addProperty(key, value, stringify);
+}
+
+/// Adds a list-valued property of the library node. If desired, turns the
+/// values into strings.
+void Library::addProperty(StringRef key, ArrayRef<std::string> values,
+                          bool stringify) {
+  ptr->addProperty(key, values, stringify);
+}
+
 /// Emits the library node to the output stream.
-void Library::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void Library::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Sets the library code path.
 void LibraryImpl::setClasspath(StringRef classpath) {
   this->classpath = classpath.str();
 }
 
+/// Adds a property of the library node. If desired, turns the value into a
+/// string.
+void LibraryImpl::addProperty(StringRef key, StringRef value, bool stringify) {
+  properties.push_back({key.str(), value.str(), stringify});
+}
+
+/// Adds a list-valued property of the library node. If desired, turns the
+/// values into strings.
+void LibraryImpl::addProperty(StringRef key, ArrayRef<std::string> values,
+                              bool stringify) {
+  listProperties.push_back({key.str(), values.vec(), stringify});
+}
+
 /// Emits the library node to the output stream.
-void LibraryImpl::emit(emitter::JsonEmitter &jemit) {
+void LibraryImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "LibraryNode");
   jemit.printKVPair("label", name);
@@ -954,6 +1614,22 @@ void LibraryImpl::emit(emitter::JsonEmitter &jemit) {
   jemit.startNamedObject("attributes");
   printLocation(location, jemit);
   jemit.printKVPair("name", name);
+  for (const std::tuple<std::string, std::string, bool> &property : properties)
+    jemit.printKVPair(std::get<0>(property), std::get<1>(property),
+                      std::get<2>(property));
+
+  for (const std::tuple<std::string, std::vector<std::string>, bool>
+           &property : listProperties) {
+    jemit.startNamedList(std::get<0>(property));
+    for (const std::string &value : std::get<1>(property)) {
+      jemit.startEntry();
+      if (std::get<2>(property))
+        jemit.printString(value);
+      else
+        jemit.printLiteral(value);
+    }
+    jemit.endList();
+  }
   ConnectorNodeImpl::emit(jemit);
   jemit.endObject(); // attributes
 
@@ -964,17 +1640,30 @@ void LibraryImpl::emit(emitter::JsonEmitter &jemit) {
 // Access
 //===----------------------------------------------------------------------===//
 
+/// Creates an access node in the current node arena.
+Access::Access(Location location, bool init)
+    : ConnectorNode(NodeArena::create<AccessImpl>(location, init)),
+      ptr(static_cast<AccessImpl *>(ConnectorNode::ptr)) {
+  type = NType::Access;
+}
+
+/// Refers to the access node implementation of the provided node.
+Access::Access(ConnectorNode n)
+    : ConnectorNode(n), ptr(static_cast<AccessImpl *>(ConnectorNode::ptr)) {
+  type = NType::Access;
+}
+
 /// Returns true if this access node should initialize.
 bool Access::getInit() { return ptr->getInit(); }
 
 /// Emits the access node to the output stream
-void Access::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void Access::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Returns true if this access node should initialize.
 bool AccessImpl::getInit() { return init; }
 
 /// Emits the access node to the output stream
-void AccessImpl::emit(emitter::JsonEmitter &jemit) {
+void AccessImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "AccessNode");
   jemit.printKVPair("label", name);
@@ -996,6 +1685,19 @@ void AccessImpl::emit(emitter::JsonEmitter &jemit) {
 // Map
 //===----------------------------------------------------------------------===//
 
+/// Creates a map entry in the current node arena.
+MapEntry::MapEntry(Location location)
+    : ScopeNode(NodeArena::create<MapEntryImpl>(location)),
+      ptr(static_cast<MapEntryImpl *>(Node::ptr)) {
+  type = NType::MapEntry;
+}
+
+/// Refers to the map entry implementation of the provided node.
+MapEntry::MapEntry(Node n)
+    : ScopeNode(n), ptr(static_cast<MapEntryImpl *>(Node::ptr)) {
+  type = NType::MapEntry;
+}
+
 /// Adds a parameter to the map entry.
 void MapEntry::addParam(StringRef param) { ptr->addParam(param); }
 
@@ -1036,8 +1738,30 @@ void MapEntry::addDependency(Value value, Connector connector) {
   ptr->addDependency(value, connector);
 }
 
+/// Sets the DaCe schedule type of the map.
+void MapEntry::setSchedule(StringRef schedule) { ptr->setSchedule(schedule); }
+
+/// Sets the number of collapsed dimensions.
+void MapEntry::setCollapse(int collapse) { ptr->setCollapse(collapse); }
+
+/// Sets the OpenMP chunk size.
+void MapEntry::setOmpChunkSize(int chunkSize) {
+  ptr->setOmpChunkSize(chunkSize);
+}
+
+/// Sets the tile sizes of the map dimensions.
+void MapEntry::setTileSizes(ArrayRef<int> tileSizes) {
+  ptr->setTileSizes(tileSizes);
+}
+
+/// Propagates the memlet moved in a single iteration to the memlet moved by
+/// the whole map. Returns false if the result would not be exact.
+bool MapEntry::propagate(std::vector<Range> &subset, std::string &volume) {
+  return ptr->propagate(subset, volume);
+}
+
 /// Emits the map entry to the output stream.
-void MapEntry::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void MapEntry::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Adds a parameter to the map entry.
 void MapEntryImpl::addParam(StringRef param) { params.push_back(param.str()); }
@@ -1064,21 +1788,15 @@ void MapEntryImpl::connectDanglingNodes() {
 
   // Connect all pending writes that are not read in this map.
   for (const auto &[from, to, mapValue] : writeQueue) {
-    bool skip = false;
-    for (MultiEdge edge : edges)
-      skip |= edge.getSource().parent == from.parent;
-    if (skip)
+    if (hasOutEdge(from.parent))
       continue;
 
     routeOut(from, to, mapValue);
   }
 
   // Connect all nodes without an ingoing edge.
-  for (ConnectorNode node : nodes) {
-    bool skip = false;
-    for (MultiEdge edge : edges)
-      skip |= edge.getDestination().parent == node;
-    if (skip || node.getType() == NType::ConsumeExit ||
+  for (ConnectorNode &node : nodes) {
+    if (hasInEdge(node) || node.getType() == NType::ConsumeExit ||
         node.getType() == NType::MapExit)
       continue;
 
@@ -1089,11 +1807,8 @@ void MapEntryImpl::connectDanglingNodes() {
   }
 
   // Connect all nodes without an outgoing edge.
-  for (ConnectorNode node : nodes) {
-    bool skip = false;
-    for (MultiEdge edge : edges)
-      skip |= edge.getSource().parent == node;
-    if (skip || node.getType() == NType::ConsumeEntry ||
+  for (ConnectorNode &node : nodes) {
+    if (hasOutEdge(node) || node.getType() == NType::ConsumeEntry ||
         node.getType() == NType::MapEntry)
       continue;
 
@@ -1106,7 +1821,7 @@ void MapEntryImpl::connectDanglingNodes() {
 
 /// Adds a connector node to the scope.
 void MapEntryImpl::addNode(ConnectorNode node) {
-  node.setParent(MapEntry(shared_from_this()));
+  node.setParent(MapEntry(this));
   parent.getState().addNode(node);
   nodes.push_back(node);
 }
@@ -1116,6 +1831,7 @@ void MapEntryImpl::routeOut(Connector from, Connector to, Value mapValue) {
   MapExit mapExit = getExit();
   Connector in(mapExit, "IN_" + utils::valueToString(mapValue));
   in.setData(from.data);
+  in.setWCR(to.wcr);
   mapExit.addInConnector(in);
   addEdge(MultiEdge(location, from, in));
 
@@ -1138,6 +1854,7 @@ void MapEntryImpl::routeWrite(Connector from, Connector to, Value mapValue) {
   Connector accIn(access);
   accIn.setData(to.data);
   accIn.setRanges(to.ranges);
+  accIn.setWCR(to.wcr);
   access.addInConnector(accIn);
 
   addNode(access);
@@ -1155,12 +1872,12 @@ void MapEntryImpl::routeWrite(Connector from, Connector to, Value mapValue) {
 /// Adds an edge to the scope.
 void MapEntryImpl::addEdge(MultiEdge edge) {
   parent.getState().addEdge(edge);
-  edges.push_back(edge);
+  insertEdge(edge);
 }
 
 /// Maps the MLIR value to the specified connector.
 void MapEntryImpl::mapConnector(Value value, Connector connector) {
-  auto res = lut.insert({utils::valueToString(value), connector});
+  auto res = lut.insert({value, connector});
 
   if (!res.second)
     res.first->second = connector;
@@ -1169,11 +1886,11 @@ void MapEntryImpl::mapConnector(Value value, Connector connector) {
 /// Returns the connector associated with a MLIR value, inserting map
 /// connectors when needed.
 Connector MapEntryImpl::lookup(Value value) {
-  if (lut.find(utils::valueToString(value)) == lut.end()) {
+  if (lut.find(value) == lut.end()) {
     ScopeNode scope(parent);
     Connector srcConn = scope.lookup(value);
 
-    MapEntry mapEntry(shared_from_this());
+    MapEntry mapEntry(this);
     Connector dstConn(mapEntry, "IN_" + utils::valueToString(value));
     dstConn.setData(srcConn.data);
     addInConnector(dstConn);
@@ -1193,8 +1910,8 @@ Connector MapEntryImpl::lookup(Value value) {
 
 /// Adds a dependency edge between the MLIR and the connector.
 void MapEntryImpl::addDependency(Value value, Connector connector) {
-  if (lut.find(utils::valueToString(value)) == lut.end()) {
-    MapEntry entry(shared_from_this());
+  if (lut.find(value) == lut.end()) {
+    MapEntry entry(this);
     Connector mapIn(entry);
     addInConnector(mapIn);
     Connector mapOut(entry);
@@ -1214,8 +1931,66 @@ void MapEntryImpl::addDependency(Value value, Connector connector) {
   addEdge(edge);
 }
 
+/// Sets the DaCe schedule type of the map.
+void MapEntryImpl::setSchedule(StringRef schedule) {
+  this->schedule = schedule.str();
+}
+
+/// Sets the number of collapsed dimensions.
+void MapEntryImpl::setCollapse(int collapse) { this->collapse = collapse; }
+
+/// Sets the OpenMP chunk size.
+void MapEntryImpl::setOmpChunkSize(int chunkSize) { ompChunkSize = chunkSize; }
+
+/// Sets the tile sizes of the map dimensions.
+void MapEntryImpl::setTileSizes(ArrayRef<int> tileSizes) {
+  this->tileSizes.assign(tileSizes.begin(), tileSizes.end());
+}
+
+/// Propagates the memlet moved in a single iteration to the memlet moved by
+/// the whole map. Returns false if the result would not be exact.
+bool MapEntryImpl::propagate(std::vector<Range> &subset, std::string &volume) {
+  // Ranges depending on dynamic map inputs vary between executions.
+  for (const Connector &connector : inConnectors)
+    for (const Range &range : ranges)
+      if (!connector.isNull &&
+          (mentionsName(range.start, connector.name) ||
+           mentionsName(range.end, connector.name) ||
+           mentionsName(range.step, connector.name)))
+        return false;
+
+  for (const std::string &param : params)
+    if (mentionsName(volume, param))
+      return false;
+
+  std::vector<Range> propagated;
+  for (const Range &dim : subset) {
+    // Dimensions indexed by a parameter cover the range of the parameter.
+    size_t paramIdx = llvm::find(params, dim.start) - params.begin();
+    if (dim.start == dim.end && paramIdx < ranges.size()) {
+      propagated.push_back(ranges[paramIdx]);
+      continue;
+    }
+
+    for (const std::string &param : params)
+      if (mentionsName(dim.start, param) || mentionsName(dim.end, param) ||
+          mentionsName(dim.step, param))
+        return false;
+
+    propagated.push_back(dim);
+  }
+
+  std::vector<std::string> factors = {volume};
+  for (const Range &range : ranges)
+    factors.push_back(getRangeSize(range));
+
+  subset = propagated;
+  volume = multiplyVolumes(factors);
+  return true;
+}
+
 /// Emits the map entry to the output stream.
-void MapEntryImpl::emit(emitter::JsonEmitter &jemit) {
+void MapEntryImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "MapEntry");
   jemit.printKVPair("label", getName());
@@ -1227,7 +2002,7 @@ void MapEntryImpl::emit(emitter::JsonEmitter &jemit) {
   jemit.printKVPair("label", getName());
 
   jemit.startNamedList("params");
-  for (std::string s : params) {
+  for (const std::string &s : params) {
     jemit.startEntry();
     jemit.printString(s);
   }
@@ -1235,12 +2010,39 @@ void MapEntryImpl::emit(emitter::JsonEmitter &jemit) {
 
   printRangeVector(ranges, "range", jemit);
 
+  if (!schedule.empty())
+    jemit.printKVPair("schedule", schedule);
+
+  emitInstrument(jemit);
+
+  jemit.printKVPair("collapse", collapse, /*stringify=*/false);
+  jemit.printKVPair("omp_chunk_size", ompChunkSize, /*stringify=*/false);
+
+  // DaCe has no tiling property on maps, GPU schedules use the tile sizes as
+  // the thread block size. The block size is given as [x, y, z], with x being
+  // the innermost dimension.
+  if (!tileSizes.empty() && StringRef(schedule).startswith("GPU_")) {
+    jemit.startNamedList("gpu_block_size");
+    for (int tileSize : llvm::reverse(tileSizes)) {
+      jemit.startEntry();
+      jemit.printLiteral(std::to_string(tileSize));
+    }
+    jemit.endList(); // gpu_block_size
+  }
+
   ConnectorNodeImpl::emit(jemit);
   jemit.endObject(); // attributes */
 
   jemit.endObject();
 }
 
+/// Creates a map exit in the current node arena.
+MapExit::MapExit(Location location)
+    : ConnectorNode(NodeArena::create<MapExitImpl>(location)),
+      ptr(static_cast<MapExitImpl *>(ConnectorNode::ptr)) {
+  type = NType::MapExit;
+}
+
 /// Sets the map entry this map exit belongs to.
 void MapExit::setEntry(MapEntry entry) { ptr->setEntry(entry); }
 
@@ -1248,7 +2050,7 @@ void MapExit::setEntry(MapEntry entry) { ptr->setEntry(entry); }
 MapEntry MapExit::getEntry() { return ptr->getEntry(); }
 
 /// Emits the map exit to the output stream.
-void MapExit::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void MapExit::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Sets the map entry this map exit belongs to.
 void MapExitImpl::setEntry(MapEntry entry) { this->entry = entry; }
@@ -1257,7 +2059,7 @@ void MapExitImpl::setEntry(MapEntry entry) { this->entry = entry; }
 MapEntry MapExitImpl::getEntry() { return entry; }
 
 /// Emits the map exit to the output stream.
-void MapExitImpl::emit(emitter::JsonEmitter &jemit) {
+void MapExitImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "MapExit");
   jemit.printKVPair("label", name);
@@ -1277,6 +2079,19 @@ void MapExitImpl::emit(emitter::JsonEmitter &jemit) {
 // Consume
 //===----------------------------------------------------------------------===//
 
+/// Creates a consume entry in the current node arena.
+ConsumeEntry::ConsumeEntry(Location location)
+    : ScopeNode(NodeArena::create<ConsumeEntryImpl>(location)),
+      ptr(static_cast<ConsumeEntryImpl *>(Node::ptr)) {
+  type = NType::ConsumeEntry;
+}
+
+/// Refers to the consume entry implementation of the provided node.
+ConsumeEntry::ConsumeEntry(Node n)
+    : ScopeNode(n), ptr(static_cast<ConsumeEntryImpl *>(Node::ptr)) {
+  type = NType::ConsumeEntry;
+}
+
 /// Sets the consume exit this consume entry belongs to.
 void ConsumeEntry::setExit(ConsumeExit exit) { ptr->setExit(exit); }
 
@@ -1320,7 +2135,7 @@ void ConsumeEntry::setCondition(Code condition) {
 }
 
 /// Emits the consume entry to the output stream.
-void ConsumeEntry::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void ConsumeEntry::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Sets the consume exit this consume entry belongs to.
 void ConsumeEntryImpl::setExit(ConsumeExit exit) { this->exit = exit; }
@@ -1330,7 +2145,7 @@ ConsumeExit ConsumeEntryImpl::getExit() { return exit; }
 
 /// Adds a connector node to the scope.
 void ConsumeEntryImpl::addNode(ConnectorNode node) {
-  node.setParent(ConsumeEntry(shared_from_this()));
+  node.setParent(ConsumeEntry(this));
   getParent().getState().addNode(node);
 }
 
@@ -1343,6 +2158,7 @@ void ConsumeEntryImpl::routeWrite(Connector from, Connector to,
                "IN_" + std::to_string(consumeExit.getInConnectorCount()));
   in.setData(from.data);
   in.setRanges(from.ranges);
+  in.setWCR(to.wcr);
   consumeExit.addInConnector(in);
 
   MultiEdge edge(location, from, in);
@@ -1365,7 +2181,7 @@ void ConsumeEntryImpl::addEdge(MultiEdge edge) {
 
 /// Maps the MLIR value to the specified connector.
 void ConsumeEntryImpl::mapConnector(Value value, Connector connector) {
-  auto res = lut.insert({utils::valueToString(value), connector});
+  auto res = lut.insert({value, connector});
 
   if (!res.second)
     res.first->second = connector;
@@ -1374,9 +2190,9 @@ void ConsumeEntryImpl::mapConnector(Value value, Connector connector) {
 /// Returns the connector associated with a MLIR value, inserting consume
 /// connectors when needed.
 Connector ConsumeEntryImpl::lookup(Value value) {
-  if (lut.find(utils::valueToString(value)) == lut.end()) {
+  if (lut.find(value) == lut.end()) {
     ScopeNode scope(parent);
-    ConsumeEntry entry(shared_from_this());
+    ConsumeEntry entry(this);
 
     Connector srcConn = scope.lookup(value);
     Connector dstConn(entry, "IN_" + utils::valueToString(value));
@@ -1399,8 +2215,8 @@ Connector ConsumeEntryImpl::lookup(Value value) {
 
 /// Adds a dependency edge between the MLIR and the connector.
 void ConsumeEntryImpl::addDependency(Value value, Connector connector) {
-  if (lut.find(utils::valueToString(value)) == lut.end()) {
-    ConsumeEntry entry(shared_from_this());
+  if (lut.find(value) == lut.end()) {
+    ConsumeEntry entry(this);
     Connector consIn(entry);
     addInConnector(consIn);
     Connector consOut(entry);
@@ -1435,7 +2251,7 @@ void ConsumeEntryImpl::setCondition(Code condition) {
 }
 
 /// Emits the consume entry to the output stream.
-void ConsumeEntryImpl::emit(emitter::JsonEmitter &jemit) {
+void ConsumeEntryImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "ConsumeEntry");
   jemit.printKVPair("label", getName());
@@ -1465,17 +2281,24 @@ void ConsumeEntryImpl::emit(emitter::JsonEmitter &jemit) {
   jemit.endObject();
 }
 
+/// Creates a consume exit in the current node arena.
+ConsumeExit::ConsumeExit(Location location)
+    : ConnectorNode(NodeArena::create<ConsumeExitImpl>(location)),
+      ptr(static_cast<ConsumeExitImpl *>(ConnectorNode::ptr)) {
+  type = NType::ConsumeExit;
+}
+
 /// Sets the consume entry this consume exit belongs to.
 void ConsumeExit::setEntry(ConsumeEntry entry) { ptr->setEntry(entry); }
 
 /// Emits the consume exit to the output stream.
-void ConsumeExit::emit(emitter::JsonEmitter &jemit) { ptr->emit(jemit); }
+void ConsumeExit::emit(emitter::Emitter &jemit) { ptr->emit(jemit); }
 
 /// Sets the consume entry this consume exit belongs to.
 void ConsumeExitImpl::setEntry(ConsumeEntry entry) { this->entry = entry; }
 
 /// Emits the consume exit to the output stream.
-void ConsumeExitImpl::emit(emitter::JsonEmitter &jemit) {
+void ConsumeExitImpl::emit(emitter::Emitter &jemit) {
   jemit.startObject();
   jemit.printKVPair("type", "ConsumeExit");
   jemit.printKVPair("label", name);
@@ -0,0 +1,223 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains an emitter recording the emitter calls, so that an
+/// emitted document can be stored and replayed later on.
+
+#include "SDFG/Translate/RecordingEmitter.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace mlir;
+using namespace sdfg;
+using namespace emitter;
+
+/// Checks for errors (open objects/lists). Returns a LogicalResult indicating
+/// success or failure.
+LogicalResult RecordingEmitter::finish() {
+  if (!openStack.empty())
+    error = true;
+  return failure(error);
+}
+
+/// Records a string.
+void RecordingEmitter::printString(StringRef str) {
+  events.push_back({Kind::String, "", str.str()});
+}
+
+/// Records a literal value.
+void RecordingEmitter::printLiteral(StringRef str) {
+  events.push_back({Kind::Literal, "", str.str()});
+}
+
+/// Records the start of a new object.
+void RecordingEmitter::startObject() {
+  events.push_back({Kind::Object, "", ""});
+  openStack.push_back(true);
+}
+
+/// Records the start of a new named (keyed) object.
+void RecordingEmitter::startNamedObject(StringRef name) {
+  events.push_back({Kind::NamedObject, name.str(), ""});
+  openStack.push_back(true);
+}
+
+/// Records the end of the current object.
+void RecordingEmitter::endObject() {
+  events.push_back({Kind::EndObject, "", ""});
+  tryPop(/*isObject=*/true);
+}
+
+/// Records the start of a new named list.
+void RecordingEmitter::startNamedList(StringRef name) {
+  events.push_back({Kind::NamedList, name.str(), ""});
+  openStack.push_back(false);
+}
+
+/// Records the end of the current list.
+void RecordingEmitter::endList() {
+  events.push_back({Kind::EndList, "", ""});
+  tryPop(/*isObject=*/false);
+}
+
+/// Records the start of a new entry.
+void RecordingEmitter::startEntry() {
+  events.push_back({Kind::Entry, "", ""});
+}
+
+/// Records a key-value pair.
+void RecordingEmitter::printKVPair(StringRef key, StringRef val,
+                                   bool stringify) {
+  events.push_back({Kind::KVString, key.str(), val.str(), stringify});
+}
+
+/// Records a key-value pair.
+void RecordingEmitter::printKVPair(StringRef key, int val, bool stringify) {
+  events.push_back({Kind::KVInt, key.str(), std::to_string(val), stringify});
+}
+
+/// Records a key-value pair. Attributes are recorded by their printed value.
+void RecordingEmitter::printKVPair(StringRef key, Attribute val,
+                                   bool stringify) {
+  if (StringAttr strAttr = val.dyn_cast<StringAttr>()) {
+    printKVPair(key, strAttr.getValue(), /*stringify=*/true);
+    return;
+  }
+
+  std::string str;
+  llvm::raw_string_ostream strStream(str);
+  val.print(strStream);
+  strStream.flush();
+
+  printKVPair(key, StringRef(str), stringify);
+}
+
+/// Serializes the recorded emitter calls to a string. Every call is stored on
+/// its own line as the kind, the stringify flag and the length-prefixed key and
+/// value.
+std::string RecordingEmitter::str() {
+  std::string str;
+  llvm::raw_string_ostream os(str);
+
+  for (const Event &event : events)
+    os << static_cast<char>(event.kind) << (event.stringify ? '1' : '0')
+       << event.key.size() << ':' << event.key << event.value.size() << ':'
+       << event.value << '\n';
+
+  os.flush();
+  return str;
+}
+
+/// Parses a length-prefixed field of a serialized recording. Returns failure if
+/// it is malformed.
+static LogicalResult parseField(StringRef &str, std::string &field) {
+  size_t colon = str.find(':');
+  if (colon == StringRef::npos)
+    return failure();
+
+  size_t size;
+  if (str.take_front(colon).getAsInteger(10, size) ||
+      str.size() < colon + 1 + size)
+    return failure();
+
+  field = str.substr(colon + 1, size).str();
+  str = str.drop_front(colon + 1 + size);
+  return success();
+}
+
+/// Parses a serialized recording. Returns failure if it is malformed.
+LogicalResult RecordingEmitter::parse(StringRef str,
+                                      std::vector<Event> &events) {
+  RecordingEmitter recorder;
+
+  while (!str.empty()) {
+    if (str.size() < 2)
+      return failure();
+
+    Event event;
+    event.kind = static_cast<Kind>(str[0]);
+    event.stringify = str[1] == '1';
+    str = str.drop_front(2);
+
+    if (parseField(str, event.key).failed() ||
+        parseField(str, event.value).failed() || !str.consume_front("\n"))
+      return failure();
+
+    switch (event.kind) {
+    case Kind::String:
+    case Kind::Literal:
+    case Kind::Object:
+    case Kind::NamedObject:
+    case Kind::EndObject:
+    case Kind::NamedList:
+    case Kind::EndList:
+    case Kind::Entry:
+    case Kind::KVString:
+      break;
+    case Kind::KVInt: {
+      int val;
+      if (StringRef(event.value).getAsInteger(10, val))
+        return failure();
+      break;
+    }
+    default:
+      return failure();
+    }
+
+    // Replaying on a recorder checks that objects and lists are balanced.
+    replay(event, recorder);
+  }
+
+  if (recorder.finish().failed())
+    return failure();
+
+  events = recorder.getEvents();
+  return success();
+}
+
+/// Replays a single recorded emitter call on the provided emitter.
+void RecordingEmitter::replay(const Event &event, Emitter &em) {
+  switch (event.kind) {
+  case Kind::String:
+    em.printString(event.value);
+    break;
+  case Kind::Literal:
+    em.printLiteral(event.value);
+    break;
+  case Kind::Object:
+    em.startObject();
+    break;
+  case Kind::NamedObject:
+    em.startNamedObject(event.key);
+    break;
+  case Kind::EndObject:
+    em.endObject();
+    break;
+  case Kind::NamedList:
+    em.startNamedList(event.key);
+    break;
+  case Kind::EndList:
+    em.endList();
+    break;
+  case Kind::Entry:
+    em.startEntry();
+    break;
+  case Kind::KVString:
+    em.printKVPair(event.key, StringRef(event.value), event.stringify);
+    break;
+  case Kind::KVInt: {
+    int val = 0;
+    StringRef(event.value).getAsInteger(10, val);
+    em.printKVPair(event.key, val, event.stringify);
+    break;
+  }
+  }
+}
+
+/// Tries to pop a symbol from the openStack, checking for matching kinds.
+void RecordingEmitter::tryPop(bool isObject) {
+  if (openStack.empty() || openStack.back() != isObject) {
+    error = true;
+    return;
+  }
+
+  openStack.pop_back();
+}
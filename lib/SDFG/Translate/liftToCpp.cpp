@@ -0,0 +1,786 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains a C++ lifter, which lifts MLIR operations to typed C++
+/// code. Unlike the Python lifter, it preserves the fixed-width integer and
+/// floating-point semantics of the operations, so DaCe does not need to infer
+/// or promote any types.
+
+#include "SDFG/Translate/liftToCpp.h"
+#include "SDFG/Utils/Utils.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include <limits>
+
+using namespace mlir;
+using namespace sdfg;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+/// Returns the C++ type of the provided type or an empty string if there is
+/// none.
+static std::string getCppType(Type t) {
+  if (t.isInteger(1))
+    return "bool";
+
+  if (t.isIndex())
+    return "int64_t";
+
+  if (t.isInteger(8) || t.isInteger(16) || t.isInteger(32) || t.isInteger(64))
+    return "int" + std::to_string(t.getIntOrFloatBitWidth()) + "_t";
+
+  if (t.isF16())
+    return "dace::float16";
+
+  if (t.isF32())
+    return "float";
+
+  if (t.isF64())
+    return "double";
+
+  // DaCe maps one-dimensional vectors to the vector extensions of the compiler.
+  if (VectorType vecType = t.dyn_cast<VectorType>()) {
+    std::string elemType = getCppType(vecType.getElementType());
+    if (vecType.getRank() != 1 || elemType.empty() || elemType == "bool")
+      return "";
+
+    return "dace::vec<" + elemType + ", " +
+           std::to_string(vecType.getNumElements()) + ">";
+  }
+
+  return "";
+}
+
+/// Returns the unsigned C++ type of the provided integer type or an empty
+/// string if there is none.
+static std::string getUnsignedCppType(Type t) {
+  if (t.isInteger(1))
+    return "bool";
+
+  if (!t.isIntOrIndex())
+    return "";
+
+  std::string type = getCppType(t);
+  return type.empty() ? "" : "u" + type;
+}
+
+/// Casts the provided expression to the provided C++ type.
+static std::string castTo(StringRef type, StringRef expr) {
+  return "static_cast<" + type.str() + ">(" + expr.str() + ")";
+}
+
+/// Returns the name of the operand with the provided index.
+static std::string getOperandName(Operation &op, unsigned idx) {
+  return sdfg::utils::valueToString(op.getOperand(idx), op);
+}
+
+/// Returns the name of the operand with the provided index, reinterpreted as
+/// an unsigned integer. Returns an empty string if there is no such type.
+static std::string getUnsignedOperandName(Operation &op, unsigned idx) {
+  std::string type = getUnsignedCppType(op.getOperand(idx).getType());
+  if (type.empty())
+    return "";
+
+  return castTo(type, getOperandName(op, idx));
+}
+
+/// Combines the two operands of the operation with the provided operator.
+static std::string binary(Operation &op, StringRef opStr) {
+  return getOperandName(op, 0) + " " + opStr.str() + " " +
+         getOperandName(op, 1);
+}
+
+/// Combines the two operands of the operation, reinterpreted as unsigned
+/// integers, with the provided operator.
+static std::string unsignedBinary(Operation &op, StringRef opStr) {
+  return getUnsignedOperandName(op, 0) + " " + opStr.str() + " " +
+         getUnsignedOperandName(op, 1);
+}
+
+/// Combines the two integer expressions of the provided type with the provided
+/// operator in unsigned arithmetic, which wraps around on overflow just like
+/// the integer operations of MLIR. Signed overflow would be undefined behavior
+/// in C++.
+static std::string wrap(Type type, StringRef lhs, StringRef opStr,
+                        StringRef rhs) {
+  std::string wideType =
+      type.isIndex() || type.getIntOrFloatBitWidth() > 32 ? "uint64_t"
+                                                          : "uint32_t";
+
+  return castTo(getCppType(type), castTo(wideType, lhs) + " " + opStr.str() +
+                                      " " + castTo(wideType, rhs));
+}
+
+/// Combines the two operands of the operation with the provided operator in
+/// wrapping arithmetic.
+static std::string wrappingBinary(Operation &op, StringRef opStr) {
+  return wrap(op.getResult(0).getType(), getOperandName(op, 0), opStr,
+              getOperandName(op, 1));
+}
+
+/// Calls the provided function with all operands of the operation.
+static std::string call(Operation &op, StringRef function) {
+  std::string expr = function.str() + "(";
+
+  for (unsigned i = 0; i < op.getNumOperands(); ++i) {
+    if (i > 0)
+      expr.append(", ");
+    expr.append(getOperandName(op, i));
+  }
+
+  return expr + ")";
+}
+
+/// Broadcasts the first operand of the operation to all elements of the vector
+/// result.
+static std::string splat(Operation &op) {
+  Type type = op.getResult(0).getType();
+  std::string operand = getOperandName(op, 0);
+  std::string expr = getCppType(type) + "{";
+
+  for (int64_t i = 0; i < type.cast<VectorType>().getNumElements(); ++i) {
+    if (i > 0)
+      expr.append(", ");
+    expr.append(operand);
+  }
+
+  return expr + "}";
+}
+
+/// Combines the two vector operands of the operation element by element with
+/// the provided operator in wrapping arithmetic.
+static std::string wrappingVectorBinary(Operation &op, StringRef opStr) {
+  VectorType type = op.getResult(0).getType().cast<VectorType>();
+  std::string lhs = getOperandName(op, 0);
+  std::string rhs = getOperandName(op, 1);
+  std::string expr = getCppType(type) + "{";
+
+  for (int64_t i = 0; i < type.getNumElements(); ++i) {
+    if (i > 0)
+      expr.append(", ");
+
+    std::string idx = "[" + std::to_string(i) + "]";
+    expr.append(wrap(type.getElementType(), lhs + idx, opStr, rhs + idx));
+  }
+
+  return expr + "}";
+}
+
+/// Returns true if any operand or result of the operation is a vector.
+static bool hasVectorType(Operation &op) {
+  auto isVector = [](Type t) { return t.isa<VectorType>(); };
+  return llvm::any_of(op.getOperandTypes(), isVector) ||
+         llvm::any_of(op.getResultTypes(), isVector);
+}
+
+/// Returns true if the provided name is an output connector of the tasklet.
+static bool isOutputName(StringRef name, Operation &source) {
+  TaskletNode tasklet = dyn_cast<TaskletNode>(source);
+  if (!tasklet)
+    return false;
+
+  for (unsigned i = 0; i < tasklet.getNumResults(); ++i)
+    if (tasklet.getOutputName(i) == name)
+      return true;
+
+  return false;
+}
+
+/// Assigns the expression to the single result of the operation. Declares the
+/// result unless it is an output connector, which DaCe declares itself.
+static Optional<std::string> assign(Operation &op, Operation &source,
+                                    StringRef expr) {
+  if (op.getNumResults() != 1)
+    return std::nullopt;
+
+  std::string type = getCppType(op.getResult(0).getType());
+  if (type.empty())
+    return std::nullopt;
+
+  std::string nameOut = sdfg::utils::valueToString(op.getResult(0), op);
+  if (isOutputName(nameOut, source))
+    return nameOut + " = " + expr.str() + ";";
+
+  return type + " " + nameOut + " = " + expr.str() + ";";
+}
+
+//===----------------------------------------------------------------------===//
+// Lifting
+//===----------------------------------------------------------------------===//
+
+/// Converts a single operation on vectors to a single line of C++ code. Only
+/// element-wise arithmetic and register-level vector operations are supported.
+/// If successful, returns C++ code as a string.
+static Optional<std::string> liftVectorOperationToCpp(Operation &op,
+                                                      Operation &source) {
+  for (Type type : op.getOperandTypes())
+    if (getCppType(type).empty())
+      return std::nullopt;
+
+  //===--------------------------------------------------------------------===//
+  // Arith
+  //===--------------------------------------------------------------------===//
+
+  if (isa<arith::AddFOp>(op))
+    return assign(op, source, binary(op, "+"));
+
+  if (isa<arith::AddIOp>(op))
+    return assign(op, source, wrappingVectorBinary(op, "+"));
+
+  if (isa<arith::SubFOp>(op))
+    return assign(op, source, binary(op, "-"));
+
+  if (isa<arith::SubIOp>(op))
+    return assign(op, source, wrappingVectorBinary(op, "-"));
+
+  if (isa<arith::MulFOp>(op))
+    return assign(op, source, binary(op, "*"));
+
+  if (isa<arith::MulIOp>(op))
+    return assign(op, source, wrappingVectorBinary(op, "*"));
+
+  if (isa<arith::DivFOp, arith::DivSIOp>(op))
+    return assign(op, source, binary(op, "/"));
+
+  if (isa<arith::RemSIOp>(op))
+    return assign(op, source, binary(op, "%"));
+
+  if (isa<arith::AndIOp>(op))
+    return assign(op, source, binary(op, "&"));
+
+  if (isa<arith::OrIOp>(op))
+    return assign(op, source, binary(op, "|"));
+
+  if (isa<arith::XOrIOp>(op))
+    return assign(op, source, binary(op, "^"));
+
+  if (isa<arith::NegFOp>(op))
+    return assign(op, source, "-" + getOperandName(op, 0));
+
+  if (arith::ConstantOp constOp = dyn_cast<arith::ConstantOp>(op)) {
+    DenseElementsAttr elements =
+        constOp.getValue().dyn_cast<DenseElementsAttr>();
+    if (!elements)
+      return std::nullopt;
+
+    std::string vals;
+    for (Attribute elem : elements.getValues<Attribute>()) {
+      if (!vals.empty())
+        vals.append(", ");
+
+      if (FloatAttr floatAttr = elem.dyn_cast<FloatAttr>()) {
+        if (!floatAttr.getValue().isFinite())
+          return std::nullopt;
+
+        SmallVector<char> floatVec;
+        floatAttr.getValue().toString(floatVec);
+        vals.append(floatVec.begin(), floatVec.end());
+      } else if (IntegerAttr intAttr = elem.dyn_cast<IntegerAttr>()) {
+        int64_t val = intAttr.getValue().getSExtValue();
+        vals.append(val == std::numeric_limits<int64_t>::min()
+                        ? "INT64_MIN"
+                        : std::to_string(val));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    return assign(op, source,
+                  getCppType(op.getResult(0).getType()) + "{" + vals + "}");
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Vector
+  //===--------------------------------------------------------------------===//
+
+  if (vector::BroadcastOp broadcastOp = dyn_cast<vector::BroadcastOp>(op)) {
+    Type sourceType = broadcastOp.getSource().getType();
+    if (!sourceType.isa<VectorType>())
+      return assign(op, source, splat(op));
+
+    if (sourceType != broadcastOp.getType())
+      return std::nullopt;
+
+    return assign(op, source, getOperandName(op, 0));
+  }
+
+  if (isa<vector::SplatOp>(op))
+    return assign(op, source, splat(op));
+
+  if (vector::ExtractElementOp extractOp =
+          dyn_cast<vector::ExtractElementOp>(op)) {
+    if (!extractOp.getPosition())
+      return std::nullopt;
+
+    return assign(op, source,
+                  getOperandName(op, 0) + "[" + getOperandName(op, 1) + "]");
+  }
+
+  // Copies the vector and overwrites a single element of the copy.
+  if (vector::InsertElementOp insertOp =
+          dyn_cast<vector::InsertElementOp>(op)) {
+    if (!insertOp.getPosition())
+      return std::nullopt;
+
+    Optional<std::string> copy = assign(op, source, getOperandName(op, 1));
+    if (!copy.has_value())
+      return std::nullopt;
+
+    std::string nameOut = sdfg::utils::valueToString(op.getResult(0), op);
+    return copy.value() + "\\n" + nameOut + "[" + getOperandName(op, 2) +
+           "] = " + getOperandName(op, 0) + ";";
+  }
+
+  if (isa<vector::FMAOp>(op))
+    return assign(op, source,
+                  getOperandName(op, 0) + " * " + getOperandName(op, 1) +
+                      " + " + getOperandName(op, 2));
+
+  if (vector::ReductionOp reductionOp = dyn_cast<vector::ReductionOp>(op)) {
+    std::string opStr;
+    switch (reductionOp.getKind()) {
+    case vector::CombiningKind::ADD:
+      opStr = " + ";
+      break;
+    case vector::CombiningKind::MUL:
+      opStr = " * ";
+      break;
+    case vector::CombiningKind::AND:
+      opStr = " & ";
+      break;
+    case vector::CombiningKind::OR:
+      opStr = " | ";
+      break;
+    case vector::CombiningKind::XOR:
+      opStr = " ^ ";
+      break;
+    default:
+      return std::nullopt;
+    }
+
+    std::string vec =
+        sdfg::utils::valueToString(reductionOp.getVector(), op);
+    std::string expr =
+        reductionOp.getAcc()
+            ? sdfg::utils::valueToString(reductionOp.getAcc(), op)
+            : "";
+
+    VectorType vecType = reductionOp.getVector().getType().cast<VectorType>();
+    for (int64_t i = 0; i < vecType.getNumElements(); ++i) {
+      if (!expr.empty())
+        expr.append(opStr);
+      expr.append(vec + "[" + std::to_string(i) + "]");
+    }
+
+    return assign(op, source, expr);
+  }
+
+  return std::nullopt;
+}
+
+/// Converts a single operation to a single line of C++ code. If successful,
+/// returns C++ code as a string.
+static Optional<std::string> liftOperationToCpp(Operation &op,
+                                                Operation &source) {
+  if (hasVectorType(op) && !isa<sdfg::ReturnOp>(op))
+    return liftVectorOperationToCpp(op, source);
+
+  //===--------------------------------------------------------------------===//
+  // Arith
+  //===--------------------------------------------------------------------===//
+
+  // Integer arithmetic on i1 wraps around, which bool does not.
+  if (isa<arith::AddIOp, arith::SubIOp, arith::MulIOp, arith::DivSIOp,
+          arith::DivUIOp, arith::RemSIOp, arith::RemUIOp, arith::ShLIOp,
+          arith::ShRSIOp, arith::ShRUIOp, arith::MaxSIOp, arith::MaxUIOp,
+          arith::MinSIOp, arith::MinUIOp, arith::CmpIOp>(op) &&
+      op.getOperand(0).getType().isInteger(1))
+    return std::nullopt;
+
+  if (isa<arith::AddFOp>(op))
+    return assign(op, source, binary(op, "+"));
+
+  if (isa<arith::SubFOp>(op))
+    return assign(op, source, binary(op, "-"));
+
+  if (isa<arith::MulFOp>(op))
+    return assign(op, source, binary(op, "*"));
+
+  if (isa<arith::AddIOp>(op))
+    return assign(op, source, wrappingBinary(op, "+"));
+
+  if (isa<arith::SubIOp>(op))
+    return assign(op, source, wrappingBinary(op, "-"));
+
+  if (isa<arith::MulIOp>(op))
+    return assign(op, source, wrappingBinary(op, "*"));
+
+  if (isa<arith::ShLIOp>(op))
+    return assign(op, source, wrappingBinary(op, "<<"));
+
+  if (isa<arith::DivFOp, arith::DivSIOp>(op))
+    return assign(op, source, binary(op, "/"));
+
+  if (isa<arith::RemSIOp>(op))
+    return assign(op, source, binary(op, "%"));
+
+  if (isa<arith::RemFOp>(op))
+    return assign(op, source, call(op, "std::fmod"));
+
+  if (isa<arith::AndIOp>(op))
+    return assign(op, source, binary(op, "&"));
+
+  if (isa<arith::OrIOp>(op))
+    return assign(op, source, binary(op, "|"));
+
+  if (isa<arith::XOrIOp>(op))
+    return assign(op, source, binary(op, "^"));
+
+  if (isa<arith::ShRSIOp>(op))
+    return assign(op, source, binary(op, ">>"));
+
+  if (isa<arith::NegFOp>(op))
+    return assign(op, source, "-" + getOperandName(op, 0));
+
+  // Unsigned operations reinterpret their operands.
+  if (isa<arith::DivUIOp, arith::RemUIOp, arith::ShRUIOp>(op)) {
+    if (getUnsignedOperandName(op, 0).empty())
+      return std::nullopt;
+
+    std::string opStr = isa<arith::DivUIOp>(op)   ? "/"
+                        : isa<arith::RemUIOp>(op) ? "%"
+                                                  : ">>";
+    return assign(op, source, unsignedBinary(op, opStr));
+  }
+
+  if (isa<arith::MaxFOp, arith::MaxSIOp, arith::MinFOp, arith::MinSIOp>(op)) {
+    std::string lhs = getOperandName(op, 0);
+    std::string rhs = getOperandName(op, 1);
+    std::string cmp = isa<arith::MaxFOp, arith::MaxSIOp>(op) ? " > " : " < ";
+    return assign(op, source,
+                  "(" + lhs + cmp + rhs + " ? " + lhs + " : " + rhs + ")");
+  }
+
+  if (isa<arith::MaxUIOp, arith::MinUIOp>(op)) {
+    if (getUnsignedOperandName(op, 0).empty())
+      return std::nullopt;
+
+    std::string cmp = isa<arith::MaxUIOp>(op) ? ">" : "<";
+    return assign(op, source,
+                  "(" + unsignedBinary(op, cmp) + " ? " +
+                      getOperandName(op, 0) + " : " + getOperandName(op, 1) +
+                      ")");
+  }
+
+  if (arith::CmpIOp cmp = dyn_cast<arith::CmpIOp>(op)) {
+    std::string predicate;
+    bool isUnsigned = false;
+
+    switch (cmp.getPredicate()) {
+    case arith::CmpIPredicate::eq:
+      predicate = "==";
+      break;
+
+    case arith::CmpIPredicate::ne:
+      predicate = "!=";
+      break;
+
+    case arith::CmpIPredicate::uge:
+      isUnsigned = true;
+      [[fallthrough]];
+    case arith::CmpIPredicate::sge:
+      predicate = ">=";
+      break;
+
+    case arith::CmpIPredicate::ugt:
+      isUnsigned = true;
+      [[fallthrough]];
+    case arith::CmpIPredicate::sgt:
+      predicate = ">";
+      break;
+
+    case arith::CmpIPredicate::ule:
+      isUnsigned = true;
+      [[fallthrough]];
+    case arith::CmpIPredicate::sle:
+      predicate = "<=";
+      break;
+
+    case arith::CmpIPredicate::ult:
+      isUnsigned = true;
+      [[fallthrough]];
+    case arith::CmpIPredicate::slt:
+      predicate = "<";
+      break;
+    }
+
+    if (!isUnsigned)
+      return assign(op, source, binary(op, predicate));
+
+    if (getUnsignedOperandName(op, 0).empty())
+      return std::nullopt;
+
+    return assign(op, source, unsignedBinary(op, predicate));
+  }
+
+  if (arith::CmpFOp cmp = dyn_cast<arith::CmpFOp>(op)) {
+    std::string lhs = getOperandName(op, 0);
+    std::string rhs = getOperandName(op, 1);
+    std::string predicate;
+
+    switch (cmp.getPredicate()) {
+    case arith::CmpFPredicate::OEQ:
+    case arith::CmpFPredicate::UEQ:
+      predicate = "==";
+      break;
+
+    case arith::CmpFPredicate::ONE:
+    case arith::CmpFPredicate::UNE:
+      predicate = "!=";
+      break;
+
+    case arith::CmpFPredicate::OGE:
+    case arith::CmpFPredicate::UGE:
+      predicate = ">=";
+      break;
+
+    case arith::CmpFPredicate::OGT:
+    case arith::CmpFPredicate::UGT:
+      predicate = ">";
+      break;
+
+    case arith::CmpFPredicate::OLE:
+    case arith::CmpFPredicate::ULE:
+      predicate = "<=";
+      break;
+
+    case arith::CmpFPredicate::OLT:
+    case arith::CmpFPredicate::ULT:
+      predicate = "<";
+      break;
+
+    case arith::CmpFPredicate::ORD:
+      return assign(op, source,
+                    "!std::isnan(" + lhs + ") && !std::isnan(" + rhs + ")");
+
+    case arith::CmpFPredicate::UNO:
+      return assign(op, source,
+                    "std::isnan(" + lhs + ") || std::isnan(" + rhs + ")");
+
+    case arith::CmpFPredicate::AlwaysFalse:
+      return assign(op, source, "false");
+
+    case arith::CmpFPredicate::AlwaysTrue:
+      return assign(op, source, "true");
+    }
+
+    return assign(op, source, binary(op, predicate));
+  }
+
+  if (isa<arith::ConstantOp>(op)) {
+    std::string val;
+
+    if (arith::ConstantFloatOp flop = dyn_cast<arith::ConstantFloatOp>(op)) {
+      if (!flop.value().isFinite())
+        return std::nullopt;
+
+      SmallVector<char> flopVec;
+      flop.value().toString(flopVec);
+      val = std::string(flopVec.begin(), flopVec.end());
+    } else if (arith::ConstantIntOp iop = dyn_cast<arith::ConstantIntOp>(op)) {
+      if (iop.getType().isInteger(1))
+        val = iop.value() != 0 ? "true" : "false";
+      else if (iop.value() == std::numeric_limits<int64_t>::min())
+        val = "INT64_MIN";
+      else
+        val = std::to_string(iop.value());
+    } else if (arith::ConstantIndexOp iop =
+                   dyn_cast<arith::ConstantIndexOp>(op)) {
+      val = std::to_string(iop.value());
+    } else {
+      return std::nullopt;
+    }
+
+    return assign(op, source, val);
+  }
+
+  if (arith::SelectOp selectOp = dyn_cast<arith::SelectOp>(op)) {
+    std::string cond =
+        sdfg::utils::valueToString(selectOp.getCondition(), op);
+    std::string trueVal =
+        sdfg::utils::valueToString(selectOp.getTrueValue(), op);
+    std::string falseVal =
+        sdfg::utils::valueToString(selectOp.getFalseValue(), op);
+    return assign(op, source, cond + " ? " + trueVal + " : " + falseVal);
+  }
+
+  // Sign extensions of i1 turn true into -1.
+  if (isa<arith::SIToFPOp, arith::ExtSIOp>(op) &&
+      op.getOperand(0).getType().isInteger(1)) {
+    std::string type = getCppType(op.getResult(0).getType());
+    return assign(op, source, "-" + castTo(type, getOperandName(op, 0)));
+  }
+
+  // Truncations to i1 keep the lowest bit.
+  if (isa<arith::TruncIOp>(op) && op.getResult(0).getType().isInteger(1))
+    return assign(op, source, "(" + getOperandName(op, 0) + " & 1) != 0");
+
+  // Casts behave like their C++ equivalents.
+  if (isa<arith::SIToFPOp, arith::FPToSIOp, arith::ExtSIOp, arith::ExtFOp,
+          arith::TruncIOp, arith::TruncFOp, arith::IndexCastOp>(op)) {
+    std::string type = getCppType(op.getResult(0).getType());
+    return assign(op, source, castTo(type, getOperandName(op, 0)));
+  }
+
+  // Zero extensions first reinterpret the operand as unsigned.
+  if (isa<arith::UIToFPOp, arith::ExtUIOp, arith::IndexCastUIOp>(op)) {
+    std::string operand = getUnsignedOperandName(op, 0);
+    if (operand.empty())
+      return std::nullopt;
+
+    std::string type = getCppType(op.getResult(0).getType());
+    return assign(op, source, castTo(type, operand));
+  }
+
+  if (isa<arith::FPToUIOp>(op)) {
+    std::string unsignedType = getUnsignedCppType(op.getResult(0).getType());
+    if (unsignedType.empty())
+      return std::nullopt;
+
+    std::string type = getCppType(op.getResult(0).getType());
+    return assign(op, source,
+                  castTo(type, castTo(unsignedType, getOperandName(op, 0))));
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Math
+  //===--------------------------------------------------------------------===//
+
+  if (isa<math::SqrtOp>(op))
+    return assign(op, source, call(op, "std::sqrt"));
+
+  if (isa<math::RsqrtOp>(op))
+    return assign(op, source, "1 / " + call(op, "std::sqrt"));
+
+  if (isa<math::CbrtOp>(op))
+    return assign(op, source, call(op, "std::cbrt"));
+
+  if (isa<math::ExpOp>(op))
+    return assign(op, source, call(op, "std::exp"));
+
+  if (isa<math::Exp2Op>(op))
+    return assign(op, source, call(op, "std::exp2"));
+
+  if (isa<math::ExpM1Op>(op))
+    return assign(op, source, call(op, "std::expm1"));
+
+  if (isa<math::LogOp>(op))
+    return assign(op, source, call(op, "std::log"));
+
+  if (isa<math::Log2Op>(op))
+    return assign(op, source, call(op, "std::log2"));
+
+  if (isa<math::Log10Op>(op))
+    return assign(op, source, call(op, "std::log10"));
+
+  if (isa<math::Log1pOp>(op))
+    return assign(op, source, call(op, "std::log1p"));
+
+  if (isa<math::PowFOp, math::FPowIOp>(op))
+    return assign(op, source, call(op, "std::pow"));
+
+  if (isa<math::SinOp>(op))
+    return assign(op, source, call(op, "std::sin"));
+
+  if (isa<math::CosOp>(op))
+    return assign(op, source, call(op, "std::cos"));
+
+  if (isa<math::TanOp>(op))
+    return assign(op, source, call(op, "std::tan"));
+
+  if (isa<math::TanhOp>(op))
+    return assign(op, source, call(op, "std::tanh"));
+
+  if (isa<math::AtanOp>(op))
+    return assign(op, source, call(op, "std::atan"));
+
+  if (isa<math::Atan2Op>(op))
+    return assign(op, source, call(op, "std::atan2"));
+
+  if (isa<math::ErfOp>(op))
+    return assign(op, source, call(op, "std::erf"));
+
+  if (isa<math::CeilOp>(op))
+    return assign(op, source, call(op, "std::ceil"));
+
+  if (isa<math::FloorOp>(op))
+    return assign(op, source, call(op, "std::floor"));
+
+  if (isa<math::TruncOp>(op))
+    return assign(op, source, call(op, "std::trunc"));
+
+  if (isa<math::RoundOp>(op))
+    return assign(op, source, call(op, "std::round"));
+
+  // Uses the default rounding mode, which rounds half to even.
+  if (isa<math::RoundEvenOp>(op))
+    return assign(op, source, call(op, "std::nearbyint"));
+
+  if (isa<math::AbsFOp>(op))
+    return assign(op, source, call(op, "std::fabs"));
+
+  if (isa<math::AbsIOp>(op))
+    return assign(op, source, call(op, "std::abs"));
+
+  if (isa<math::CopySignOp>(op))
+    return assign(op, source, call(op, "std::copysign"));
+
+  if (isa<math::FmaOp>(op))
+    return assign(op, source, call(op, "std::fma"));
+
+  //===--------------------------------------------------------------------===//
+  // LLVM
+  //===--------------------------------------------------------------------===//
+
+  if (isa<mlir::LLVM::UndefOp>(op))
+    return assign(op, source, "-1");
+
+  //===--------------------------------------------------------------------===//
+  // SDFG
+  //===--------------------------------------------------------------------===//
+
+  if (isa<sdfg::ReturnOp>(op) && isa<TaskletNode>(source)) {
+    std::string code = "";
+    TaskletNode tasklet = cast<TaskletNode>(source);
+
+    for (unsigned i = 0; i < op.getNumOperands(); ++i) {
+      // Only copy if the output connector differs from the variable name.
+      std::string name = getOperandName(op, i);
+      if (name == tasklet.getOutputName(i))
+        continue;
+
+      if (!code.empty())
+        code.append("\\n");
+      code.append(tasklet.getOutputName(i) + " = " + name + ";");
+    }
+    return code;
+  }
+
+  return std::nullopt;
+}
+
+/// Converts the operations in the first region of op to typed C++ code. If
+/// successful, returns C++ code as a string.
+Optional<std::string> translation::liftToCpp(Operation &op) {
+  std::string code = "";
+
+  for (Operation &oper : op.getRegion(0).getOps()) {
+    Optional<std::string> line = liftOperationToCpp(oper, op);
+    if (!line.has_value())
+      return std::nullopt;
+
+    code.append(line.value() + "\\n");
+  }
+
+  return code;
+}
@@ -2,39 +2,326 @@
 
 /// This file contains the translation pass registration.
 
+#include "SDFG/Translate/MsgPackEmitter.h"
+#include "SDFG/Translate/RecordingEmitter.h"
 #include "SDFG/Translate/Translation.h"
 #include "mlir/InitAllDialects.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include <memory>
+#include <mutex>
 
 //===----------------------------------------------------------------------===//
 // SDFG registration
 //===----------------------------------------------------------------------===//
 
+/// Translates the module using the provided emitter and options and checks the
+/// output.
+static mlir::LogicalResult
+translateWithEmitter(mlir::ModuleOp module, mlir::sdfg::emitter::Emitter &em,
+                     llvm::StringRef format,
+                     const mlir::sdfg::translation::TranslationOptions &opts) {
+  mlir::LogicalResult res =
+      mlir::sdfg::translation::translateToSDFG(module, em, opts);
+  mlir::LogicalResult eRes = em.finish();
+
+  if (res.failed()) {
+    return mlir::failure();
+  } else if (eRes.failed()) {
+    emitError(module.getLoc(), "Invalid " + format + " generated");
+    return mlir::failure();
+  }
+
+  return mlir::success();
+}
+
+namespace {
+/// Emits the top-level SDFGs of a module as a list in module order while they
+/// are translated in parallel. The first unfinished SDFG is emitted directly,
+/// all following ones are recorded until their predecessors are finished. This
+/// keeps streamed states streaming and releases every recording as soon as it
+/// is emitted.
+class OrderedListEmitter {
+public:
+  OrderedListEmitter(mlir::sdfg::emitter::Emitter &output, size_t numSDFGs)
+      : output(output) {
+    for (size_t i = 0; i < numSDFGs; ++i)
+      entries.push_back(std::make_unique<Entry>(*this));
+
+    if (!entries.empty())
+      entries.front()->direct = true;
+  }
+
+  /// Returns the emitter of the i-th SDFG.
+  mlir::sdfg::emitter::Emitter *getEmitter(size_t idx) {
+    return entries[idx].get();
+  }
+
+  /// Marks the i-th SDFG as translated and emits the recordings of the SDFGs
+  /// that are now at the front of the list.
+  void finished(size_t idx) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[idx]->done = true;
+
+    while (front < entries.size() && entries[front]->done) {
+      entries[front]->direct = false;
+      if (++front == entries.size())
+        break;
+
+      Entry &next = *entries[front];
+      for (const mlir::sdfg::emitter::RecordingEmitter::Event &event :
+           next.recorder.getEvents())
+        mlir::sdfg::emitter::RecordingEmitter::replay(event, output);
+      next.recorder = mlir::sdfg::emitter::RecordingEmitter();
+      next.direct = true;
+    }
+  }
+
+private:
+  /// The emitter of a single SDFG, forwarding to the output while the SDFG is
+  /// at the front of the list and recording otherwise.
+  struct Entry : public mlir::sdfg::emitter::Emitter {
+    Entry(OrderedListEmitter &parent) : parent(parent) {}
+
+    /// The output is checked as a whole once all SDFGs are emitted.
+    mlir::LogicalResult finish() override { return mlir::success(); }
+
+    void printString(llvm::StringRef str) override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().printString(str);
+    }
+    void printLiteral(llvm::StringRef str) override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().printLiteral(str);
+    }
+    void startObject() override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().startObject();
+    }
+    void startNamedObject(llvm::StringRef name) override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().startNamedObject(name);
+    }
+    void endObject() override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().endObject();
+    }
+    void startNamedList(llvm::StringRef name) override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().startNamedList(name);
+    }
+    void endList() override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().endList();
+    }
+    void startEntry() override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().startEntry();
+    }
+    void printKVPair(llvm::StringRef key, llvm::StringRef val,
+                     bool stringify = true) override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().printKVPair(key, val, stringify);
+    }
+    void printKVPair(llvm::StringRef key, int val,
+                     bool stringify = true) override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().printKVPair(key, val, stringify);
+    }
+    void printKVPair(llvm::StringRef key, mlir::Attribute val,
+                     bool stringify = true) override {
+      std::lock_guard<std::mutex> lock(parent.mutex);
+      get().printKVPair(key, val, stringify);
+    }
+
+    /// Returns the emitter the calls are currently forwarded to.
+    mlir::sdfg::emitter::Emitter &get() {
+      if (direct)
+        return parent.output;
+      return recorder;
+    }
+
+    OrderedListEmitter &parent;
+    mlir::sdfg::emitter::RecordingEmitter recorder;
+    /// Whether the SDFG is at the front of the list.
+    bool direct = false;
+    /// Whether the SDFG is translated.
+    bool done = false;
+  };
+
+  mlir::sdfg::emitter::Emitter &output;
+  llvm::SmallVector<std::unique_ptr<Entry>> entries;
+  /// The index of the first SDFG that is not yet emitted completely.
+  size_t front = 0;
+  /// Serializes the emitter calls of the translating threads.
+  std::mutex mutex;
+};
+} // namespace
+
+/// Translates every top-level SDFG of the module. Writes the i-th SDFG to
+/// `<i>.json` in the provided output directory or, if it is empty, all SDFGs as
+/// a JSON array to the output stream. No files are kept if a SDFG fails.
+static mlir::LogicalResult
+translateAllSDFGs(mlir::ModuleOp module, llvm::raw_ostream &output,
+                  llvm::StringRef outputDir, bool compact,
+                  const mlir::sdfg::translation::TranslationOptions &opts) {
+  using namespace mlir::sdfg::emitter;
+
+  size_t numSDFGs = llvm::range_size(module.getOps<mlir::sdfg::SDFGNode>());
+
+  if (outputDir.empty()) {
+    JsonEmitter jemit(output, compact);
+    jemit.startList();
+
+    OrderedListEmitter list(jemit, numSDFGs);
+    llvm::SmallVector<Emitter *> emitters;
+    for (size_t i = 0; i < numSDFGs; ++i)
+      emitters.push_back(list.getEmitter(i));
+
+    if (mlir::sdfg::translation::translateToSDFGs(
+            module, emitters, opts, [&](size_t idx) { list.finished(idx); })
+            .failed())
+      return mlir::failure();
+
+    jemit.endList();
+    if (jemit.finish().failed()) {
+      emitError(module.getLoc(), "Invalid JSON generated");
+      return mlir::failure();
+    }
+
+    return mlir::success();
+  }
+
+  if (std::error_code ec = llvm::sys::fs::create_directories(outputDir)) {
+    emitError(module.getLoc(),
+              "Failed to create " + outputDir + ": " + ec.message());
+    return mlir::failure();
+  }
+
+  // The files are removed again unless all SDFGs are translated.
+  llvm::SmallVector<std::unique_ptr<llvm::ToolOutputFile>> files;
+  llvm::SmallVector<std::unique_ptr<Emitter>> emitters;
+  for (size_t i = 0; i < numSDFGs; ++i) {
+    llvm::SmallString<128> path(outputDir);
+    llvm::sys::path::append(path, std::to_string(i) + ".json");
+
+    std::error_code ec;
+    files.push_back(std::make_unique<llvm::ToolOutputFile>(
+        path, ec, llvm::sys::fs::OF_None));
+    if (ec) {
+      emitError(module.getLoc(),
+                "Failed to open " + path.str() + ": " + ec.message());
+      return mlir::failure();
+    }
+
+    emitters.push_back(
+        std::make_unique<JsonEmitter>(files.back()->os(), compact));
+  }
+
+  llvm::SmallVector<Emitter *> emitterPtrs;
+  for (std::unique_ptr<Emitter> &em : emitters)
+    emitterPtrs.push_back(em.get());
+
+  mlir::LogicalResult res =
+      mlir::sdfg::translation::translateToSDFGs(module, emitterPtrs, opts);
+
+  for (std::unique_ptr<Emitter> &em : emitters)
+    if (em->finish().failed() && res.succeeded()) {
+      emitError(module.getLoc(), "Invalid JSON generated");
+      res = mlir::failure();
+    }
+
+  if (res.failed())
+    return mlir::failure();
+
+  for (std::unique_ptr<llvm::ToolOutputFile> &file : files)
+    file->keep();
+  return mlir::success();
+}
+
+/// Registers the dialects needed for the SDFG translation.
+void mlir::sdfg::translation::registerTranslationDialects(
+    mlir::DialectRegistry &registry) {
+  registry.insert<mlir::sdfg::SDFGDialect>();
+  registry.insert<mlir::func::FuncDialect>();
+  registry.insert<mlir::arith::ArithDialect>();
+  registry.insert<mlir::math::MathDialect>();
+  registry.insert<mlir::LLVM::LLVMDialect>();
+  registry.insert<mlir::vector::VectorDialect>();
+}
+
 /// Registers SDFG to SDFG IR translation.
 void mlir::sdfg::translation::registerToSDFGTranslation() {
+  static llvm::cl::opt<bool> compactJSON(
+      "sdfg-compact-json",
+      llvm::cl::desc("Emit the SDFG JSON without indentation and newlines"),
+      llvm::cl::init(false));
+
+  static llvm::cl::opt<bool> cppTasklets(
+      "sdfg-cpp-tasklets",
+      llvm::cl::desc("Emit tasklets as typed C++ code instead of Python"),
+      llvm::cl::init(false));
+
+  static llvm::cl::opt<std::string> instrumentMaps(
+      "sdfg-instrument-maps",
+      llvm::cl::desc("Instrument every top-level map with the provided DaCe "
+                     "instrumentation type"),
+      llvm::cl::init(""));
+
+  static llvm::cl::opt<std::string> cacheDir(
+      "sdfg-cache-dir",
+      llvm::cl::desc("Directory caching the translation of nested SDFGs "
+                     "across runs"),
+      llvm::cl::init(""));
+
+  static llvm::cl::opt<bool> streamStates(
+      "sdfg-stream-states",
+      llvm::cl::desc("Emit every state as soon as it is translated to bound "
+                     "the memory usage on large SDFGs"),
+      llvm::cl::init(false));
+
+  static llvm::cl::opt<std::string> outputDir(
+      "sdfg-output-dir",
+      llvm::cl::desc("Directory receiving one JSON file per top-level SDFG "
+                     "with --mlir-to-sdfgs instead of a single JSON array"),
+      llvm::cl::init(""));
+
+  static auto getOptions = []() {
+    mlir::sdfg::translation::TranslationOptions options;
+    if (cppTasklets)
+      options.taskletLanguage = mlir::sdfg::translation::CodeLanguage::CPP;
+    options.mapInstrumentation = instrumentMaps;
+    options.cacheDirectory = cacheDir;
+    options.streamStates = streamStates;
+    return options;
+  };
+
   mlir::TranslateFromMLIRRegistration registration(
       "mlir-to-sdfg", "Generates a SDFG JSON",
       [](mlir::ModuleOp module, llvm::raw_ostream &output) {
-        mlir::sdfg::emitter::JsonEmitter jemit(output);
-
-        mlir::LogicalResult res =
-            mlir::sdfg::translation::translateToSDFG(module, jemit);
-        mlir::LogicalResult jRes = jemit.finish();
+        mlir::sdfg::emitter::JsonEmitter jemit(output, compactJSON);
+        return translateWithEmitter(module, jemit, "JSON", getOptions());
+      },
+      mlir::sdfg::translation::registerTranslationDialects);
 
-        if (res.failed()) {
-          return mlir::failure();
-        } else if (jRes.failed()) {
-          emitError(module.getLoc(), "Invalid JSON generated");
-          return mlir::failure();
-        }
+  mlir::TranslateFromMLIRRegistration multiRegistration(
+      "mlir-to-sdfgs",
+      "Generates a SDFG JSON for every top-level SDFG of the module",
+      [](mlir::ModuleOp module, llvm::raw_ostream &output) {
+        return translateAllSDFGs(module, output, outputDir, compactJSON,
+                                 getOptions());
+      },
+      mlir::sdfg::translation::registerTranslationDialects);
 
-        return mlir::success();
+  mlir::TranslateFromMLIRRegistration msgpackRegistration(
+      "mlir-to-sdfg-msgpack", "Generates a SDFG in MessagePack format",
+      [](mlir::ModuleOp module, llvm::raw_ostream &output) {
+        mlir::sdfg::emitter::MsgPackEmitter memit(output);
+        return translateWithEmitter(module, memit, "MessagePack",
+                                    getOptions());
       },
-      [](mlir::DialectRegistry &registry) {
-        registry.insert<mlir::sdfg::SDFGDialect>();
-        registry.insert<mlir::func::FuncDialect>();
-        registry.insert<mlir::arith::ArithDialect>();
-        registry.insert<mlir::math::MathDialect>();
-        registry.insert<mlir::LLVM::LLVMDialect>();
-      });
+      mlir::sdfg::translation::registerTranslationDialects);
 }
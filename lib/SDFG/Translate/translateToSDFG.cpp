@@ -3,18 +3,34 @@
 /// This file contains function to translate the SDFG dialect to the SDFG IR. It
 /// performs the translation in two passes. First it collects all operations and
 /// generates an internal IR, which in the second pass is used to generate JSON.
+/// In streaming mode the states of the top-level SDFG are instead emitted as
+/// soon as they are collected, which bounds the memory to the largest state.
+/// Modules with several top-level SDFGs are translated one SDFG per emitter.
 
 #include "SDFG/Translate/Node.h"
 #include "SDFG/Translate/Translation.h"
+#include "SDFG/Translate/liftToCpp.h"
 #include "SDFG/Translate/liftToPython.h"
 #include "SDFG/Utils/Utils.h"
+#include "mlir/IR/Threading.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include <regex>
 #include <string>
 
 using namespace mlir;
 using namespace sdfg;
 
+namespace {
+/// The recorded emission of a nested SDFG.
+using Recording = std::vector<emitter::RecordingEmitter::Event>;
+} // namespace
+
 //===----------------------------------------------------------------------===//
 // Helpers
 //===----------------------------------------------------------------------===//
@@ -34,6 +50,12 @@ insertTransientArray(Location location, translation::Connector connector,
                   /*stream=*/false, /*init=*/false,
                   sdfg::utils::getSizedType(value.getType()));
 
+  // Scalar temporaries only live in the scope that produces them.
+  if (array.shape.getShape().empty()) {
+    array.storage = "Register";
+    array.lifetime = "Scope";
+  }
+
   SDFG sdfg = scope.getSDFG();
   sdfg.addArray(array);
 
@@ -57,6 +79,60 @@ insertTransientArray(Location location, translation::Connector connector,
   return accOut;
 }
 
+/// Returns the strides of the provided array. Subviews keep the strides of the
+/// array they view.
+static std::vector<std::string> getArrayStrides(Value array) {
+  using namespace translation;
+
+  SizedType shape = sdfg::utils::getSizedType(array.getType());
+  Array contiguous(sdfg::utils::valueToString(array), /*transient=*/true,
+                   /*stream=*/false, /*init=*/false, shape);
+
+  SubviewOp subview = array.getDefiningOp<SubviewOp>();
+  if (!subview)
+    return contiguous.getContiguousStrides();
+
+  std::vector<std::string> srcStrides = getArrayStrides(subview.getSrc());
+  bool rankReduced = subview.getSizes().size() != shape.getRank();
+  std::vector<std::string> strides;
+
+  for (unsigned i = 0; i < subview.getSizes().size(); ++i) {
+    std::string size =
+        sdfg::utils::attributeToString(subview.getSizes()[i], *subview);
+    std::string stride =
+        sdfg::utils::attributeToString(subview.getStrides()[i], *subview);
+
+    // Rank reducing subviews drop the dimensions of size one.
+    if (rankReduced && size == "1")
+      continue;
+
+    if (stride == "1")
+      strides.push_back(srcStrides[i]);
+    else
+      strides.push_back("(" + srcStrides[i] + ") * " + stride);
+  }
+
+  if (strides.size() != shape.getRank())
+    return contiguous.getContiguousStrides();
+
+  return strides;
+}
+
+/// Creates the data container of the provided view.
+static translation::Array createView(Value view) {
+  using namespace translation;
+
+  Array array(sdfg::utils::valueToString(view), /*transient=*/true,
+              /*stream=*/false, /*init=*/false,
+              sdfg::utils::getSizedType(view.getType()));
+  array.view = true;
+
+  if (view.getDefiningOp<SubviewOp>())
+    array.strides = getArrayStrides(view);
+
+  return array;
+}
+
 /// Inserts a transient array with an dependency edge to enforce ordering.
 static translation::Connector
 insertDependencyArray(Location location, Value value, Value dep,
@@ -97,12 +173,13 @@ insertDependencyArray(Location location, Value value, Value dep,
 }
 
 /// Collects a operation by performing a case distinction on the operation type.
-LogicalResult collectOperations(Operation &op, translation::ScopeNode &scope) {
+LogicalResult collectOperations(Operation &op, translation::ScopeNode &scope,
+                                translation::TranslationContext &ctx) {
   using namespace translation;
 
   for (Operation &operation : op.getRegion(0).getOps()) {
     if (TaskletNode oper = dyn_cast<TaskletNode>(operation)) {
-      if (collect(oper, scope).failed())
+      if (collect(oper, scope, ctx).failed())
         return failure();
       continue;
     }
@@ -114,19 +191,19 @@ LogicalResult collectOperations(Operation &op, translation::ScopeNode &scope) {
     }
 
     if (NestedSDFGNode oper = dyn_cast<NestedSDFGNode>(operation)) {
-      if (collect(oper, scope).failed())
+      if (collect(oper, scope, ctx).failed())
         return failure();
       continue;
     }
 
     if (MapNode oper = dyn_cast<MapNode>(operation)) {
-      if (collect(oper, scope).failed())
+      if (collect(oper, scope, ctx).failed())
         return failure();
       continue;
     }
 
     if (ConsumeNode oper = dyn_cast<ConsumeNode>(operation)) {
-      if (collect(oper, scope).failed())
+      if (collect(oper, scope, ctx).failed())
         return failure();
       continue;
     }
@@ -155,6 +232,18 @@ LogicalResult collectOperations(Operation &op, translation::ScopeNode &scope) {
       continue;
     }
 
+    if (ViewCastOp oper = dyn_cast<ViewCastOp>(operation)) {
+      if (collect(oper, scope).failed())
+        return failure();
+      continue;
+    }
+
+    if (SubviewOp oper = dyn_cast<SubviewOp>(operation)) {
+      if (collect(oper, scope).failed())
+        return failure();
+      continue;
+    }
+
     if (AllocSymbolOp oper = dyn_cast<AllocSymbolOp>(operation)) {
       if (collect(oper, scope).failed()) {
         return failure();
@@ -190,12 +279,23 @@ LogicalResult collectOperations(Operation &op, translation::ScopeNode &scope) {
   return success();
 }
 
-/// Collects all operations in a SDFG.
-LogicalResult collectSDFG(Operation &op, translation::SDFG &sdfg) {
+static LogicalResult
+precollectNestedSDFGs(Operation *root, translation::TranslationContext &ctx,
+                      unsigned &numNested);
+
+/// Collects all operations in a SDFG. If an emitter is provided, every state is
+/// emitted to it as soon as it is collected and released afterwards, along
+/// with the nested SDFGs it contains.
+LogicalResult collectSDFG(Operation &op, translation::SDFG &sdfg,
+                          translation::TranslationContext &ctx,
+                          Emitter *stream = nullptr) {
   using namespace translation;
 
   sdfg.setName(sdfg::utils::generateName("sdfg"));
 
+  if (StringAttr instrument = op.getAttrOfType<StringAttr>("instrument"))
+    sdfg.setInstrument(instrument.getValue());
+
   for (BlockArgument ba : op.getRegion(0).getArguments()) {
     if (sdfg::utils::isSizedType(ba.getType())) {
       SizedType sizedType = sdfg::utils::getSizedType(ba.getType());
@@ -219,9 +319,52 @@ LogicalResult collectSDFG(Operation &op, translation::SDFG &sdfg) {
       return failure();
   }
 
+  for (ViewCastOp viewCastOp : op.getRegion(0).getOps<ViewCastOp>()) {
+    if (collect(viewCastOp, sdfg).failed())
+      return failure();
+  }
+
+  for (SubviewOp subviewOp : op.getRegion(0).getOps<SubviewOp>()) {
+    if (collect(subviewOp, sdfg).failed())
+      return failure();
+  }
+
+  if (stream) {
+    // Nested SDFGs map all symbols of the SDFG, including the ones allocated
+    // in later states.
+    WalkResult result = op.walk([&](AllocSymbolOp allocSymbolOp) {
+      if (sdfg::utils::getParentSDFG(*allocSymbolOp) != &op)
+        return WalkResult::advance();
+
+      if (collect(allocSymbolOp, sdfg).failed())
+        return WalkResult::interrupt();
+      return WalkResult::advance();
+    });
+
+    if (result.wasInterrupted())
+      return failure();
+
+    sdfg.beginStream(*stream);
+  }
+
+  unsigned numNested = 0;
   for (StateNode stateNode : op.getRegion(0).getOps<StateNode>()) {
-    if (collect(stateNode, sdfg).failed())
+    NodeArena stateArena;
+    if (stream) {
+      // Only the nested SDFGs of the current state are kept in memory.
+      if (precollectNestedSDFGs(stateNode.getOperation(), ctx, numNested)
+              .failed())
+        return failure();
+      ctx.stateArena = &stateArena;
+    }
+
+    if (collect(stateNode, sdfg, ctx).failed())
       return failure();
+
+    if (stream) {
+      sdfg.streamState(sdfg.lookup(stateNode.getSymName()), *stream);
+      ctx.releasePrecollected();
+    }
   }
 
   for (EdgeOp edgeOp : op.getRegion(0).getOps<EdgeOp>()) {
@@ -245,6 +388,238 @@ LogicalResult collectSDFG(Operation &op, translation::SDFG &sdfg) {
     sdfg.setStartState(sdfg.lookup(entryName));
   }
 
+  if (stream)
+    sdfg.endStream(*stream);
+
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// Translation Cache
+//===----------------------------------------------------------------------===//
+
+#ifndef SDFG_TRANSLATION_REVISION
+#define SDFG_TRANSLATION_REVISION "unknown"
+#endif
+
+/// Version of the cache entries. Contains a hash of the translator sources set
+/// by the build, so that entries of another translator are never reused. The
+/// format version is bumped whenever the format of the entries changes.
+static constexpr StringLiteral cacheVersion =
+    "nested_sdfg-v2-" SDFG_TRANSLATION_REVISION;
+
+/// Prints the provided attribute, type or location to a string.
+template <typename T>
+static std::string printToString(T entity) {
+  std::string str;
+  llvm::raw_string_ostream strStream(str);
+  entity.print(strStream);
+  strStream.flush();
+  return str;
+}
+
+/// Adds a length-prefixed string to the hasher.
+static void hashString(llvm::SHA1 &hasher, StringRef str) {
+  hasher.update(std::to_string(str.size()) + ":");
+  hasher.update(str);
+}
+
+/// Adds the structure of the provided operation to the hasher. Values are
+/// identified by the order of their definition and the IDs generated while
+/// parsing are skipped, so the hash does not depend on the position of the
+/// operation in the module.
+static void hashOperation(Operation &op, llvm::SHA1 &hasher,
+                          llvm::DenseMap<Value, unsigned> &valueIDs) {
+  hashString(hasher, op.getName().getStringRef());
+  hashString(hasher, printToString(op.getLoc()));
+
+  for (NamedAttribute attr : op.getAttrs()) {
+    if (llvm::is_contained({"ID", "entryID", "exitID"},
+                           attr.getName().strref()))
+      continue;
+
+    hashString(hasher, attr.getName().strref());
+    hashString(hasher, printToString(attr.getValue()));
+  }
+
+  for (Value operand : op.getOperands()) {
+    auto it = valueIDs.find(operand);
+    hashString(hasher,
+               it == valueIDs.end() ? "?" : std::to_string(it->second));
+  }
+
+  for (Value result : op.getResults()) {
+    valueIDs.insert({result, valueIDs.size()});
+    hashString(hasher, printToString(result.getType()));
+  }
+
+  for (Region &region : op.getRegions()) {
+    hashString(hasher, "region");
+
+    for (Block &block : region) {
+      hashString(hasher, "block");
+
+      for (BlockArgument arg : block.getArguments()) {
+        valueIDs.insert({arg, valueIDs.size()});
+        hashString(hasher, printToString(arg.getType()));
+        hashString(hasher, printToString(arg.getLoc()));
+      }
+
+      for (Operation &nested : block)
+        hashOperation(nested, hasher, valueIDs);
+    }
+
+    hashString(hasher, "end");
+  }
+}
+
+/// Returns the cache key of a nested SDFG node, which is a hash of its
+/// structure and the translation options.
+static std::string getCacheKey(NestedSDFGNode &op,
+                               const translation::TranslationOptions &options) {
+  llvm::SHA1 hasher;
+  hashString(hasher, cacheVersion);
+  hashString(hasher,
+             std::to_string(static_cast<int>(options.taskletLanguage)));
+  hashString(hasher, options.mapInstrumentation);
+
+  llvm::DenseMap<Value, unsigned> valueIDs;
+  hashOperation(*op, hasher, valueIDs);
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+/// Stores a recording in the cache file at the provided path. The recording is
+/// written to a temporary file first, so that concurrent translations never
+/// read partially written entries.
+static LogicalResult storeRecording(StringRef path, StringRef recording) {
+  if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(path)))
+    return failure();
+
+  int fd;
+  SmallString<128> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(path + ".%%%%%%.tmp", fd, tmpPath))
+    return failure();
+
+  llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+  os << recording;
+  os.close();
+
+  if (os.has_error()) {
+    os.clear_error();
+    llvm::sys::fs::remove(tmpPath);
+    return failure();
+  }
+
+  if (llvm::sys::fs::rename(tmpPath, path)) {
+    llvm::sys::fs::remove(tmpPath);
+    return failure();
+  }
+
+  return success();
+}
+
+/// Translates a nested SDFG node to a recording of its emission. Reuses the
+/// recording of a previous translation if the cache directory contains one for
+/// the same structure. Otherwise translates the node and adds the recording to
+/// the cache.
+static LogicalResult collectCachedSDFG(NestedSDFGNode &op,
+                                       Recording &recording,
+                                       translation::TranslationContext &ctx) {
+  using namespace translation;
+
+  std::string key = getCacheKey(op, ctx.options);
+  SmallString<128> path(ctx.options.cacheDirectory);
+  llvm::sys::path::append(path, key + ".sdfg");
+
+  if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+          llvm::MemoryBuffer::getFile(path))
+    if (RecordingEmitter::parse((*buffer)->getBuffer(), recording).succeeded())
+      return success();
+
+  // The SDFG is only needed until it is recorded.
+  NodeArena arena;
+  NodeArena::Scope arenaScope(arena);
+
+  SDFG sdfg(op.getLoc());
+  {
+    // The generated names only depend on the key, so that cache hits emit the
+    // same SDFG as the translation.
+    sdfg::utils::NameGeneratorScope nameScope("c" + key.substr(0, 12));
+    sdfg::utils::ValueNameScope valueNameScope;
+    if (collectSDFG(*op, sdfg, ctx).failed())
+      return failure();
+  }
+  sdfg.setNestedTransient();
+
+  RecordingEmitter recorder;
+  sdfg.emitNested(recorder);
+  if (recorder.finish().failed()) {
+    emitError(op.getLoc(), "Invalid nested SDFG recording generated");
+    return failure();
+  }
+
+  recording = recorder.getEvents();
+  if (storeRecording(path, recorder.str()).failed())
+    emitWarning(op.getLoc(), "Could not store the nested SDFG in the "
+                             "translation cache");
+
+  return success();
+}
+
+/// Collects the independent nested SDFGs in the provided operation of the
+/// top-level SDFG in parallel. Each nested SDFG generates its names in its own
+/// scope, numbered from the provided count of already collected nested SDFGs,
+/// so the result depends neither on the scheduling nor on whether
+/// multithreading is enabled.
+static LogicalResult
+precollectNestedSDFGs(Operation *root, translation::TranslationContext &ctx,
+                      unsigned &numNested) {
+  using namespace translation;
+
+  // Only the outermost nested SDFGs are independent of each other.
+  SmallVector<NestedSDFGNode> nestedNodes;
+  root->walk<WalkOrder::PreOrder>([&](NestedSDFGNode nested) {
+    nestedNodes.push_back(nested);
+    return WalkResult::skip();
+  });
+
+  bool cached = !ctx.options.cacheDirectory.empty();
+  size_t firstArena = ctx.precollectedArenas.size();
+  SmallVector<SDFG> sdfgs;
+  for (NestedSDFGNode nested : nestedNodes) {
+    ctx.precollectedArenas.push_back(std::make_unique<NodeArena>());
+    NodeArena::Scope arenaScope(*ctx.precollectedArenas.back());
+    sdfgs.push_back(SDFG(nested.getLoc()));
+  }
+  SmallVector<Recording> nestedRecordings(nestedNodes.size());
+
+  LogicalResult res = failableParallelForEach(
+      root->getContext(), llvm::seq<size_t>(0, nestedNodes.size()),
+      [&](size_t idx) {
+        if (cached)
+          return collectCachedSDFG(nestedNodes[idx], nestedRecordings[idx],
+                                   ctx);
+
+        // Every worker allocates in the arena of its nested SDFG.
+        NodeArena::Scope arenaScope(*ctx.precollectedArenas[firstArena + idx]);
+        sdfg::utils::NameGeneratorScope nameScope(
+            "n" + std::to_string(numNested + idx));
+        sdfg::utils::ValueNameScope valueNameScope;
+        return collectSDFG(*nestedNodes[idx], sdfgs[idx], ctx);
+      });
+
+  if (res.failed())
+    return failure();
+
+  numNested += nestedNodes.size();
+  for (unsigned i = 0; i < nestedNodes.size(); ++i) {
+    if (cached)
+      ctx.precollectedRecordings.insert(
+          {nestedNodes[i].getOperation(), nestedRecordings[i]});
+    else
+      ctx.precollectedSDFGs.insert({nestedNodes[i].getOperation(), sdfgs[i]});
+  }
+
   return success();
 }
 
@@ -252,22 +627,100 @@ LogicalResult collectSDFG(Operation &op, translation::SDFG &sdfg) {
 // Module
 //===----------------------------------------------------------------------===//
 
+/// Verifies the translation options that are not checked by their type.
+static LogicalResult
+verifyOptions(ModuleOp &op, const translation::TranslationOptions &options) {
+  if (!options.mapInstrumentation.empty() &&
+      !isInstrumentationType(options.mapInstrumentation)) {
+    emitError(op.getLoc(), "Invalid map instrumentation type '" +
+                               options.mapInstrumentation + "'");
+    return failure();
+  }
+
+  return success();
+}
+
+/// Collects the provided top-level SDFG and emits it to the provided emitter.
+/// The nested SDFGs are collected ahead of time, per state if the states are
+/// streamed as requested by the translation options.
+static LogicalResult
+translateSDFGNode(SDFGNode &sdfgNode, Emitter &jemit,
+                  const translation::TranslationOptions &options) {
+  // The translation IR of the SDFG lives until it is emitted.
+  translation::NodeArena arena;
+  translation::NodeArena::Scope arenaScope(arena);
+
+  translation::TranslationContext ctx(options);
+  Emitter *stream = options.streamStates ? &jemit : nullptr;
+  unsigned numNested = 0;
+  if (!stream &&
+      precollectNestedSDFGs(sdfgNode.getOperation(), ctx, numNested).failed())
+    return failure();
+
+  translation::SDFG sdfg(sdfgNode.getLoc());
+
+  if (collectSDFG(*sdfgNode, sdfg, ctx, stream).failed())
+    return failure();
+
+  if (!stream)
+    sdfg.emit(jemit);
+  return success();
+}
+
 /// Translates a module containing SDFG dialect to SDFG IR, outputs the result
 /// to the provided output stream.
-LogicalResult translation::translateToSDFG(ModuleOp &op, JsonEmitter &jemit) {
+LogicalResult
+translation::translateToSDFG(ModuleOp &op, Emitter &jemit,
+                             const TranslationOptions &options) {
+  // The IR is not modified during translation, so the value names can be
+  // computed once per SDFG.
+  sdfg::utils::ValueNameScope valueNameScope;
+  // Generated names restart for every translated module.
+  sdfg::utils::NameGeneratorScope nameScope;
+
+  if (verifyOptions(op, options).failed())
+    return failure();
+
   if (++op.getOps<SDFGNode>().begin() != op.getOps<SDFGNode>().end()) {
     emitError(op.getLoc(), "Must have exactly one top-level SDFGNode");
     return failure();
   }
 
   SDFGNode sdfgNode = *op.getOps<SDFGNode>().begin();
-  SDFG sdfg(sdfgNode.getLoc());
+  return translateSDFGNode(sdfgNode, jemit, options);
+}
 
-  if (collectSDFG(*sdfgNode, sdfg).failed())
+/// Translates every top-level SDFG of a module containing SDFG dialect to SDFG
+/// IR and outputs the i-th SDFG to the i-th emitter. The SDFGs are independent
+/// of each other and translated in parallel if multithreading is enabled.
+LogicalResult translation::translateToSDFGs(
+    ModuleOp &op, ArrayRef<Emitter *> emitters,
+    const TranslationOptions &options,
+    llvm::function_ref<void(size_t)> onTranslated) {
+  if (verifyOptions(op, options).failed())
     return failure();
 
-  sdfg.emit(jemit);
-  return success();
+  SmallVector<SDFGNode> sdfgNodes(op.getOps<SDFGNode>());
+
+  if (sdfgNodes.size() != emitters.size()) {
+    emitError(op.getLoc(), "Expected an emitter per top-level SDFGNode");
+    return failure();
+  }
+
+  return failableParallelForEach(
+      op.getContext(), llvm::seq<size_t>(0, sdfgNodes.size()),
+      [&](size_t idx) {
+        // Names only depend on the position of the SDFG in the module.
+        sdfg::utils::NameGeneratorScope nameScope("s" + std::to_string(idx));
+        sdfg::utils::ValueNameScope valueNameScope;
+        if (translateSDFGNode(sdfgNodes[idx], *emitters[idx], options)
+                .failed())
+          return failure();
+
+        if (onTranslated)
+          onTranslated(idx);
+        return success();
+      });
 }
 
 //===----------------------------------------------------------------------===//
@@ -275,14 +728,28 @@ LogicalResult translation::translateToSDFG(ModuleOp &op, JsonEmitter &jemit) {
 //===----------------------------------------------------------------------===//
 
 /// Collects state node information in a top-level SDFG.
-LogicalResult translation::collect(StateNode &op, SDFG &sdfg) {
+LogicalResult translation::collect(StateNode &op, SDFG &sdfg,
+                                   TranslationContext &ctx) {
   State state(op.getLoc());
   state.setName(op.getName());
   sdfg.addState(state);
 
-  if (collectOperations(*op, state).failed())
+  if (StringAttr instrument = op.getInstrumentAttr())
+    state.setInstrument(instrument.getValue());
+
+  // The contents of a streamed state are allocated in an arena of their own,
+  // which is freed after the state is emitted. The states of nested SDFGs are
+  // not streamed.
+  Optional<NodeArena::Scope> arenaScope;
+  if (NodeArena *stateArena = ctx.stateArena) {
+    ctx.stateArena = nullptr;
+    arenaScope.emplace(*stateArena);
+  }
+
+  if (collectOperations(*op, state, ctx).failed())
     return failure();
 
+  state.propagateMemlets();
   return success();
 }
 
@@ -314,8 +781,7 @@ LogicalResult translation::collect(EdgeOp &op, SDFG &sdfg) {
   if (op.getRef() != Value()) {
     refname = sdfg::utils::valueToString(op.getRef());
 
-    if (op.getRef().getDefiningOp() != nullptr) {
-      AllocOp allocOp = cast<AllocOp>(op.getRef().getDefiningOp());
+    if (AllocOp allocOp = op.getRef().getDefiningOp<AllocOp>()) {
       refname = allocOp.getName().value_or(refname);
     }
   }
@@ -346,6 +812,11 @@ LogicalResult translation::collect(EdgeOp &op, SDFG &sdfg) {
 LogicalResult translation::collect(AllocOp &op, SDFG &sdfg) {
   Array array(op.getContainerName(), op.getTransient(), op.isStream(),
               op->hasAttr("init"), sdfg::utils::getSizedType(op.getType()));
+  array.storage = op.getStorage().value_or("").str();
+  array.lifetime = op.getLifetime().value_or("").str();
+  if (op.getBufferSize().has_value())
+    array.bufferSize =
+        std::to_string(op.getBufferSize().value().getSExtValue());
   sdfg.addArray(array);
 
   return success();
@@ -355,11 +826,48 @@ LogicalResult translation::collect(AllocOp &op, SDFG &sdfg) {
 LogicalResult translation::collect(AllocOp &op, ScopeNode &scope) {
   Array array(op.getContainerName(), op.getTransient(), op.isStream(),
               op->hasAttr("init"), sdfg::utils::getSizedType(op.getType()));
+  array.storage = op.getStorage().value_or("").str();
+  array.lifetime = op.getLifetime().value_or("").str();
+  if (op.getBufferSize().has_value())
+    array.bufferSize =
+        std::to_string(op.getBufferSize().value().getSExtValue());
   scope.getSDFG().addArray(array);
 
   return success();
 }
 
+//===----------------------------------------------------------------------===//
+// ViewCastOp
+//===----------------------------------------------------------------------===//
+
+/// Collects view cast information in a top-level SDFG.
+LogicalResult translation::collect(ViewCastOp &op, SDFG &sdfg) {
+  sdfg.addArray(createView(op.getRes()));
+  return success();
+}
+
+/// Collects view cast information in a scope.
+LogicalResult translation::collect(ViewCastOp &op, ScopeNode &scope) {
+  scope.getSDFG().addArray(createView(op.getRes()));
+  return success();
+}
+
+//===----------------------------------------------------------------------===//
+// SubviewOp
+//===----------------------------------------------------------------------===//
+
+/// Collects subview information in a top-level SDFG.
+LogicalResult translation::collect(SubviewOp &op, SDFG &sdfg) {
+  sdfg.addArray(createView(op.getRes()));
+  return success();
+}
+
+/// Collects subview information in a scope.
+LogicalResult translation::collect(SubviewOp &op, ScopeNode &scope) {
+  scope.getSDFG().addArray(createView(op.getRes()));
+  return success();
+}
+
 //===----------------------------------------------------------------------===//
 // AllocSymbolOp
 //===----------------------------------------------------------------------===//
@@ -376,12 +884,31 @@ LogicalResult translation::collect(AllocSymbolOp &op, SDFG &sdfg) {
 // TaskletNode
 //===----------------------------------------------------------------------===//
 
+/// Returns true if the provided tasklet computes on vectors, which only the C++
+/// lifter supports.
+static bool usesVectors(TaskletNode tasklet) {
+  auto isVector = [](Type t) { return t.isa<VectorType>(); };
+
+  WalkResult result = tasklet->walk([&](Operation *op) {
+    if (llvm::any_of(op->getOperandTypes(), isVector) ||
+        llvm::any_of(op->getResultTypes(), isVector))
+      return WalkResult::interrupt();
+    return WalkResult::advance();
+  });
+
+  return result.wasInterrupted();
+}
+
 /// Collects tasklet information in a scope.
-LogicalResult translation::collect(TaskletNode &op, ScopeNode &scope) {
+LogicalResult translation::collect(TaskletNode &op, ScopeNode &scope,
+                                   TranslationContext &ctx) {
   Tasklet tasklet(op.getLoc());
   tasklet.setName(getTaskletName(*op));
   scope.addNode(tasklet);
 
+  if (StringAttr instrument = op.getInstrumentAttr())
+    tasklet.setInstrument(instrument.getValue());
+
   for (unsigned i = 0; i < op.getNumOperands(); ++i) {
     Connector connector(tasklet, op.getInputName(i));
     tasklet.addInConnector(connector);
@@ -455,6 +982,22 @@ LogicalResult translation::collect(TaskletNode &op, ScopeNode &scope) {
     }
 
   } else {
+    bool vectors = usesVectors(op);
+
+    if (ctx.options.taskletLanguage == CodeLanguage::CPP || vectors) {
+      Optional<std::string> cppCode = liftToCpp(*op);
+      if (cppCode.has_value()) {
+        tasklet.setCode(Code(cppCode.value(), CodeLanguage::CPP));
+        return success();
+      }
+    }
+
+    if (vectors) {
+      emitError(op.getLoc(), "unsupported vector operation in tasklet");
+      return failure();
+    }
+
+    // Falls back to Python for operations without a C++ equivalent.
     Optional<std::string> code_data = liftToPython(*op);
     if (code_data.has_value()) {
       Code code(code_data.value(), CodeLanguage::Python);
@@ -477,6 +1020,36 @@ LogicalResult translation::collect(LibCallOp &op, ScopeNode &scope) {
   Library lib(op.getLoc());
   lib.setName(sdfg::utils::generateName(op.getCallee().str()));
   lib.setClasspath(op.getCallee());
+
+  // Library node properties, such as the axes of a reduction. Strings are
+  // emitted as strings, arrays as lists and all other properties as raw
+  // values.
+  if (DictionaryAttr properties =
+          op->getAttrOfType<DictionaryAttr>("properties")) {
+    Operation &libOp = *op.getOperation();
+    for (NamedAttribute property : properties) {
+      Attribute value = property.getValue();
+      if (StringAttr str = value.dyn_cast<StringAttr>()) {
+        lib.addProperty(property.getName(), str.getValue());
+        continue;
+      }
+
+      if (ArrayAttr array = value.dyn_cast<ArrayAttr>()) {
+        std::vector<std::string> list;
+        for (Attribute elem : array)
+          list.push_back(sdfg::utils::attributeToString(elem, libOp));
+        bool stringify = llvm::all_of(
+            array, [](Attribute elem) { return elem.isa<StringAttr>(); });
+        lib.addProperty(property.getName(), list, stringify && !array.empty());
+        continue;
+      }
+
+      lib.addProperty(property.getName(),
+                      sdfg::utils::attributeToString(value, libOp),
+                      /*stringify=*/false);
+    }
+  }
+
   scope.addNode(lib);
 
   for (unsigned i = 0; i < op.getNumOperands(); ++i) {
@@ -502,17 +1075,28 @@ LogicalResult translation::collect(LibCallOp &op, ScopeNode &scope) {
 //===----------------------------------------------------------------------===//
 
 /// Collects nested SDFG node information in a scope.
-LogicalResult translation::collect(NestedSDFGNode &op, ScopeNode &scope) {
+LogicalResult translation::collect(NestedSDFGNode &op, ScopeNode &scope,
+                                   TranslationContext &ctx) {
   SDFG sdfg(op.getLoc());
 
   llvm::SmallVector<Connector> args;
   for (unsigned i = 0; i < op.getNumOperands(); ++i)
     args.push_back(scope.lookup(op.getOperand(i)));
 
-  if (collectSDFG(*op, sdfg).failed())
+  Recording recording;
+  if (ctx.precollectedRecordings.count(op.getOperation()))
+    recording = ctx.precollectedRecordings.find(op.getOperation())->second;
+  else if (ctx.precollectedSDFGs.count(op.getOperation()))
+    sdfg = ctx.precollectedSDFGs.find(op.getOperation())->second;
+  else if (!ctx.options.cacheDirectory.empty()) {
+    if (collectCachedSDFG(op, recording, ctx).failed())
+      return failure();
+  } else if (collectSDFG(*op, sdfg, ctx).failed())
     return failure();
 
-  NestedSDFG nestedSDFG(op.getLoc(), sdfg);
+  NestedSDFG nestedSDFG = recording.empty()
+                              ? NestedSDFG(op.getLoc(), sdfg)
+                              : NestedSDFG(op.getLoc(), recording);
   nestedSDFG.setName(sdfg::utils::generateName("nested_sdfg"));
   scope.addNode(nestedSDFG);
 
@@ -543,8 +1127,7 @@ LogicalResult translation::collect(NestedSDFGNode &op, ScopeNode &scope) {
     std::string name = sdfg::utils::valueToString(op.getOperand(i));
     bool init = false;
 
-    if (op.getOperand(i).getDefiningOp() != nullptr) {
-      AllocOp allocOp = cast<AllocOp>(op.getOperand(i).getDefiningOp());
+    if (AllocOp allocOp = op.getOperand(i).getDefiningOp<AllocOp>()) {
       name = allocOp.getName().value_or(name);
       init = allocOp->hasAttr("init");
     }
@@ -568,7 +1151,8 @@ LogicalResult translation::collect(NestedSDFGNode &op, ScopeNode &scope) {
 //===----------------------------------------------------------------------===//
 
 /// Collects map node information in a scope.
-LogicalResult translation::collect(MapNode &op, ScopeNode &scope) {
+LogicalResult translation::collect(MapNode &op, ScopeNode &scope,
+                                   TranslationContext &ctx) {
   MapEntry mapEntry(op.getLoc());
   mapEntry.setName(sdfg::utils::generateName("mapEntry"));
 
@@ -648,6 +1232,28 @@ LogicalResult translation::collect(MapNode &op, ScopeNode &scope) {
     mapEntry.addRange(r);
   }
 
+  if (StringAttr schedule = op.getScheduleAttr())
+    mapEntry.setSchedule(schedule.getValue());
+
+  if (IntegerAttr collapse = op.getCollapseAttr())
+    mapEntry.setCollapse(collapse.getInt());
+
+  if (IntegerAttr chunkSize = op.getOmpChunkSizeAttr())
+    mapEntry.setOmpChunkSize(chunkSize.getInt());
+
+  if (ArrayAttr tileSizes = op.getTileSizesAttr()) {
+    SmallVector<int> sizes;
+    for (Attribute tileSize : tileSizes)
+      sizes.push_back(tileSize.cast<IntegerAttr>().getInt());
+    mapEntry.setTileSizes(sizes);
+  }
+
+  if (StringAttr instrument = op.getInstrumentAttr())
+    mapEntry.setInstrument(instrument.getValue());
+  else if (isa<StateNode>(op->getParentOp()) &&
+           !ctx.options.mapInstrumentation.empty())
+    mapEntry.setInstrument(ctx.options.mapInstrumentation);
+
   // FIXME: It would be cleaner if users would directly incorporate it as a
   // symbol.
   for (BlockArgument bArg : op.getBody().getArguments()) {
@@ -666,7 +1272,7 @@ LogicalResult translation::collect(MapNode &op, ScopeNode &scope) {
     insertTransientArray(op.getLoc(), taskOut, bArg, mapEntry);
   }
 
-  if (collectOperations(*op, mapEntry).failed())
+  if (collectOperations(*op, mapEntry, ctx).failed())
     return failure();
 
   mapEntry.connectDanglingNodes();
@@ -678,7 +1284,8 @@ LogicalResult translation::collect(MapNode &op, ScopeNode &scope) {
 //===----------------------------------------------------------------------===//
 
 /// Collects consume node information in a scope.
-LogicalResult translation::collect(ConsumeNode &op, ScopeNode &scope) {
+LogicalResult translation::collect(ConsumeNode &op, ScopeNode &scope,
+                                   TranslationContext &ctx) {
   ConsumeEntry consumeEntry(op.getLoc());
   consumeEntry.setName(sdfg::utils::generateName("consumeEntry"));
 
@@ -699,6 +1306,9 @@ LogicalResult translation::collect(ConsumeNode &op, ScopeNode &scope) {
     consumeEntry.setNumPes("1");
   }
 
+  // The chunk size is not emitted, as a DaCe chunk turns the element into an
+  // array of that many elements, while the body takes a single element.
+
   consumeEntry.setPeIndex(sdfg::utils::valueToString(op.pe()));
 
   if (op.getCondition().has_value()) {
@@ -740,7 +1350,7 @@ LogicalResult translation::collect(ConsumeNode &op, ScopeNode &scope) {
     insertTransientArray(op.getLoc(), taskOut, op.getPe(), consumeEntry); */
   }
 
-  if (collectOperations(*op, consumeEntry).failed())
+  if (collectOperations(*op, consumeEntry, ctx).failed())
     return failure();
 
   return success();
@@ -755,8 +1365,7 @@ LogicalResult translation::collect(CopyOp &op, ScopeNode &scope) {
   std::string name = sdfg::utils::valueToString(op.getDest());
   bool init = false;
 
-  if (op.getDest().getDefiningOp() != nullptr) {
-    AllocOp allocOp = cast<AllocOp>(op.getDest().getDefiningOp());
+  if (AllocOp allocOp = op.getDest().getDefiningOp<AllocOp>()) {
     name = allocOp.getName().value_or(name);
     init = allocOp->hasAttr("init");
   }
@@ -781,8 +1390,7 @@ LogicalResult translation::collect(StoreOp &op, ScopeNode &scope) {
   std::string name = sdfg::utils::valueToString(op.getArr());
   bool init = false;
 
-  if (op.getArr().getDefiningOp() != nullptr) {
-    AllocOp allocOp = cast<AllocOp>(op.getArr().getDefiningOp());
+  if (AllocOp allocOp = op.getArr().getDefiningOp<AllocOp>()) {
     name = allocOp.getName().value_or(name);
     init = allocOp->hasAttr("init");
   }
@@ -792,6 +1400,7 @@ LogicalResult translation::collect(StoreOp &op, ScopeNode &scope) {
 
   Connector accIn(access);
   accIn.setData(name);
+  accIn.setWCR(op.getWcr().value_or(""));
   access.addInConnector(accIn);
 
   ArrayAttr numList = op->getAttr("indices_numList").cast<ArrayAttr>();
@@ -858,6 +1467,13 @@ LogicalResult translation::collect(StoreOp &op, ScopeNode &scope) {
     return success();
   }
 
+  // The indirection tasklet writes the whole array.
+  if (op.getWcr()) {
+    emitError(op.getLoc(), "write-conflict resolution not supported for "
+                           "indirect stores");
+    return failure();
+  }
+
   Tasklet task(op.getLoc());
   task.setName("indirect_store" + name);
   scope.addNode(task);
@@ -925,8 +1541,7 @@ LogicalResult translation::collect(LoadOp &op, ScopeNode &scope) {
 
   std::string name = sdfg::utils::valueToString(op.getArr());
 
-  if (op.getArr().getDefiningOp() != nullptr) {
-    AllocOp allocOp = cast<AllocOp>(op.getArr().getDefiningOp());
+  if (AllocOp allocOp = op.getArr().getDefiningOp<AllocOp>()) {
     name = allocOp.getName().value_or(name);
   }
 
@@ -1085,8 +1700,7 @@ LogicalResult translation::collect(StreamPushOp &op, ScopeNode &scope) {
   Access access(op.getLoc(), false);
   std::string name = sdfg::utils::valueToString(op.getStr());
 
-  if (op.getStr().getDefiningOp() != nullptr) {
-    AllocOp allocOp = cast<AllocOp>(op.getStr().getDefiningOp());
+  if (AllocOp allocOp = op.getStr().getDefiningOp<AllocOp>()) {
     name = allocOp.getName().value_or(name);
   }
 
@@ -0,0 +1,92 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains the access collection utility functions.
+
+#include "SDFG/Utils/CollectAccesses.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+namespace mlir::sdfg::utils {
+
+/// Returns true if the provided array is a view of another array.
+bool isView(Value array) {
+  return array.getDefiningOp<ViewCastOp>() || array.getDefiningOp<SubviewOp>();
+}
+
+/// Collects the data containers the provided operation and the operations
+/// nested in it access. Nested SDFGs read their arguments and write their
+/// results, except for the provided one, whose arguments are replaced by the
+/// corresponding operands. Fails if the operations contain accesses through
+/// views or side effects that cannot be attributed to data containers.
+LogicalResult collectAccesses(Operation *root, Accesses &accesses,
+                              NestedSDFGNode inlined) {
+  auto resolve = [&](Value value) {
+    BlockArgument arg = value.dyn_cast<BlockArgument>();
+    if (inlined && arg && arg.getOwner() == &inlined.getBody().front())
+      return inlined.getOperand(arg.getArgNumber());
+    return value;
+  };
+
+  auto record = [&](Operation *op, Value array, bool isWrite) {
+    if (isWrite)
+      accesses.writes.insert(array);
+    else
+      accesses.reads.insert(array);
+
+    SmallVector<Operation *> &ops = accesses.ops[array];
+    if (ops.empty() || ops.back() != op)
+      ops.push_back(op);
+  };
+
+  WalkResult result = root->walk<WalkOrder::PreOrder>([&](Operation *op) {
+    NestedSDFGNode nested = dyn_cast<NestedSDFGNode>(op);
+    if (nested && nested != inlined) {
+      for (unsigned i = 0; i < nested.getNumOperands(); ++i) {
+        Value operand = resolve(nested.getOperand(i));
+        if (isView(operand))
+          return WalkResult::interrupt();
+
+        record(op, operand, /*isWrite=*/false);
+        if (i >= nested.getNumArgs())
+          record(op, operand, /*isWrite=*/true);
+      }
+
+      return WalkResult::skip();
+    }
+
+    if (isa<ConsumeNode, LibCallOp, StreamPopOp, StreamPushOp, StreamLengthOp>(
+            op))
+      return WalkResult::interrupt();
+
+    if (op->getParentOfType<TaskletNode>() &&
+        !op->hasTrait<OpTrait::IsTerminator>() && !isMemoryEffectFree(op))
+      return WalkResult::interrupt();
+
+    SmallVector<Value, 2> reads;
+    SmallVector<Value, 2> writes;
+
+    if (LoadOp loadOp = dyn_cast<LoadOp>(op))
+      reads.push_back(resolve(loadOp.getArr()));
+
+    if (StoreOp storeOp = dyn_cast<StoreOp>(op))
+      writes.push_back(resolve(storeOp.getArr()));
+
+    if (CopyOp copyOp = dyn_cast<CopyOp>(op)) {
+      reads.push_back(resolve(copyOp.getSrc()));
+      writes.push_back(resolve(copyOp.getDest()));
+    }
+
+    // Accesses through views may alias accesses of the viewed array.
+    if (llvm::any_of(reads, isView) || llvm::any_of(writes, isView))
+      return WalkResult::interrupt();
+
+    for (Value read : reads)
+      record(op, read, /*isWrite=*/false);
+    for (Value write : writes)
+      record(op, write, /*isWrite=*/true);
+    return WalkResult::advance();
+  });
+
+  return failure(result.wasInterrupted());
+}
+
+} // namespace mlir::sdfg::utils
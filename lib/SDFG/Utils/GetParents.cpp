@@ -24,6 +24,14 @@ Operation *getParentSDFG(Operation &op) {
   return nullptr;
 }
 
+/// Returns the name of the entry state of the provided (nested) SDFG node.
+StringRef getEntryStateName(Operation *sdfg) {
+  if (SDFGNode sdfgNode = dyn_cast<SDFGNode>(sdfg))
+    return sdfgNode.getEntryState().getSymName();
+
+  return cast<NestedSDFGNode>(sdfg).getEntryState().getSymName();
+}
+
 /// Returns the parent State node or nullptr if a parent does not exist.
 StateNode getParentState(Operation &op, bool ignoreSDFGs) {
   Operation *parent = op.getParentOp();
@@ -3,16 +3,28 @@
 /// This file contains the ID generator utility functions.
 
 #include "SDFG/Utils/IDGenerator.h"
+#include "SDFG/Dialect/Dialect.h"
 
 namespace mlir::sdfg::utils {
-namespace {
-unsigned idGeneratorID = 0;
+
+/// Returns an ID unique within the provided context. The counter is attached
+/// to the SDFG dialect and may be used concurrently by multiple threads.
+unsigned generateID(MLIRContext *ctx) {
+  return ctx->getOrLoadDialect<SDFGDialect>()->generateID();
 }
 
-/// Returns a globally unique ID.
-unsigned generateID() { return idGeneratorID++; }
+/// Renumbers the IDs of all nodes nested in the provided operation in the order
+/// of the operations, so that they do not depend on the order the nodes were
+/// created in.
+void renumberIDs(Operation *root) {
+  Builder builder(root->getContext());
+  unsigned id = 0;
 
-/// Resets the ID generator.
-void resetIDGenerator() { idGeneratorID = 0; }
+  root->walk<WalkOrder::PreOrder>([&](Operation *op) {
+    for (StringRef name : {"ID", "entryID", "exitID"})
+      if (op->hasAttr(name))
+        op->setAttr(name, builder.getI32IntegerAttr(id++));
+  });
+}
 
 } // namespace mlir::sdfg::utils
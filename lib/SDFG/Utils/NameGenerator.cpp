@@ -3,15 +3,43 @@
 /// This file contains the name generator utility functions.
 
 #include "SDFG/Utils/NameGenerator.h"
+#include <atomic>
 
 namespace mlir::sdfg::utils {
 namespace {
-int nameGeneratorID = 0;
-}
+std::atomic<unsigned> nameGeneratorID(0);
+/// The innermost active NameGeneratorScope of the current thread.
+thread_local NameGeneratorScope *activeScope = nullptr;
+} // namespace
 
-/// Converts the provided string to a globally unique one.
+/// Converts the provided string to a unique one. Uses the innermost active
+/// NameGeneratorScope of the current thread or a global counter otherwise.
 std::string generateName(std::string base) {
+  if (activeScope != nullptr)
+    return activeScope->generateName(base);
+
   return base + "_" + std::to_string(nameGeneratorID++);
 }
 
+/// Redirects generateName on the current thread to a local counter for its
+/// lifetime. Passes open an unprefixed scope per module, so names restart for
+/// every module and do not depend on other threads. Prefixed scopes keep the
+/// names unique and deterministic when independent tasks of the same module
+/// generate names concurrently. Scopes may be nested.
+NameGeneratorScope::NameGeneratorScope(std::string prefix)
+    : prevScope(activeScope), prefix(prefix), counter(0) {
+  activeScope = this;
+}
+
+/// Restores the previously active scope.
+NameGeneratorScope::~NameGeneratorScope() { activeScope = prevScope; }
+
+/// Converts the provided string to a name unique in this scope.
+std::string NameGeneratorScope::generateName(std::string base) {
+  if (prefix.empty())
+    return base + "_" + std::to_string(counter++);
+
+  return base + "_" + prefix + "_" + std::to_string(counter++);
+}
+
 } // namespace mlir::sdfg::utils
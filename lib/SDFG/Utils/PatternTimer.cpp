@@ -0,0 +1,124 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains the conversion pattern timing utility.
+
+#include "SDFG/Utils/PatternTimer.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Timer.h"
+
+namespace mlir::sdfg::utils {
+namespace {
+/// Wraps a conversion pattern and records its applications in a timer.
+class TimedPattern : public ConversionPattern {
+public:
+  TimedPattern(std::unique_ptr<ConversionPattern> pattern, PatternTimer &timer,
+               StringRef rootName)
+      : ConversionPattern(*pattern->getTypeConverter(), rootName,
+                          pattern->getBenefit(), pattern->getContext()),
+        inner(std::move(pattern)), timer(timer) {
+    init();
+  }
+
+  TimedPattern(std::unique_ptr<ConversionPattern> pattern, PatternTimer &timer,
+               MatchAnyOpTypeTag tag)
+      : ConversionPattern(*pattern->getTypeConverter(), tag,
+                          pattern->getBenefit(), pattern->getContext()),
+        inner(std::move(pattern)), timer(timer) {
+    init();
+  }
+
+  LogicalResult
+  matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+                  ConversionPatternRewriter &rewriter) const override {
+    llvm::TimeRecord start = llvm::TimeRecord::getCurrentTime(/*Start=*/true);
+    LogicalResult res = inner->matchAndRewrite(op, operands, rewriter);
+    llvm::TimeRecord end = llvm::TimeRecord::getCurrentTime(/*Start=*/false);
+
+    timer.record(name, end.getWallTime() - start.getWallTime(),
+                 succeeded(res));
+    return res;
+  }
+
+private:
+  /// Copies the properties of the wrapped pattern.
+  void init() {
+    setHasBoundedRewriteRecursion(inner->hasBoundedRewriteRecursion());
+    setDebugName(inner->getDebugName());
+
+    name = inner->getDebugName().str();
+    if (name.empty() && inner->getRootKind().has_value())
+      name = inner->getRootKind()->getStringRef().str();
+    if (name.empty())
+      name = "<unnamed>";
+  }
+
+  std::unique_ptr<ConversionPattern> inner;
+  PatternTimer &timer;
+  std::string name;
+};
+} // namespace
+
+/// Wraps every pattern of the set, which must only contain conversion
+/// patterns, such that its applications are recorded by this timer. The timer
+/// must outlive the patterns.
+void PatternTimer::instrument(RewritePatternSet &patterns) {
+  for (std::unique_ptr<RewritePattern> &pattern :
+       patterns.getNativePatterns()) {
+    std::unique_ptr<ConversionPattern> inner(
+        static_cast<ConversionPattern *>(pattern.release()));
+    Optional<OperationName> rootKind = inner->getRootKind();
+
+    if (rootKind.has_value())
+      pattern = std::make_unique<TimedPattern>(std::move(inner), *this,
+                                               rootKind->getStringRef());
+    else
+      pattern = std::make_unique<TimedPattern>(std::move(inner), *this,
+                                               MatchAnyOpTypeTag());
+  }
+}
+
+/// Records a single application of the pattern with the provided name.
+void PatternTimer::record(StringRef name, double seconds, bool rewritten) {
+  Record &rec = records[name];
+  rec.seconds += seconds;
+  rec.attempts++;
+  if (rewritten)
+    rec.rewrites++;
+}
+
+/// Prints the recorded applications, the slowest pattern first.
+void PatternTimer::print(raw_ostream &os, StringRef title) const {
+  SmallVector<const llvm::StringMapEntry<Record> *> sorted;
+  double total = 0;
+
+  for (const llvm::StringMapEntry<Record> &entry : records) {
+    sorted.push_back(&entry);
+    total += entry.getValue().seconds;
+  }
+
+  llvm::sort(sorted, [](const llvm::StringMapEntry<Record> *a,
+                        const llvm::StringMapEntry<Record> *b) {
+    return a->getValue().seconds > b->getValue().seconds;
+  });
+
+  std::string separator = "===" + std::string(73, '-') + "===\n";
+  os << separator;
+  os.indent(title.size() < 80 ? (80 - title.size()) / 2 : 0) << title << "\n";
+  os << separator;
+  os << llvm::format("  Total Execution Time: %.4f seconds\n\n", total);
+  os << "  ----Wall Time----  ----Attempts----  ----Rewrites----"
+     << "  ----Name----\n";
+
+  for (const llvm::StringMapEntry<Record> *entry : sorted) {
+    const Record &rec = entry->getValue();
+    double percent = total > 0 ? rec.seconds / total * 100 : 0;
+    os << llvm::format("  %8.4f (%5.1f%%)  %16u  %16u  ", rec.seconds, percent,
+                       rec.attempts, rec.rewrites)
+       << entry->getKey() << "\n";
+  }
+
+  os << "\n";
+  os.flush();
+}
+
+} // namespace mlir::sdfg::utils
@@ -5,9 +5,39 @@
 #include "SDFG/Utils/ValueToString.h"
 #include "SDFG/Utils/Utils.h"
 #include "mlir/IR/AsmState.h"
+#include "llvm/ADT/DenseMap.h"
+#include <memory>
 
 namespace mlir::sdfg::utils {
 
+/// Cached naming information of a single SDFG.
+struct SDFGNames {
+  explicit SDFGNames(Operation *sdfg) : state(sdfg) {}
+
+  AsmState state;
+  llvm::DenseMap<Value, std::string> names;
+};
+
+/// Maps SDFGs to their cached naming information.
+struct ValueNameCache {
+  llvm::DenseMap<Operation *, std::unique_ptr<SDFGNames>> sdfgs;
+};
+
+namespace {
+/// The cache of the innermost active ValueNameScope.
+thread_local ValueNameCache *activeCache = nullptr;
+
+/// Prints a value as operand using the provided naming state.
+std::string printValue(Value value, AsmState &state) {
+  std::string name;
+  llvm::raw_string_ostream nameStream(name);
+  value.printAsOperand(nameStream, state);
+  nameStream.flush();
+  utils::sanitizeName(name);
+  return name;
+}
+} // namespace
+
 /// Prints a value to a string. Optionally takes a context operation.
 std::string valueToString(Value value) {
   if (value.getDefiningOp() != nullptr)
@@ -25,12 +55,46 @@ std::string valueToString(Value value, Operation &op) {
   else
     sdfg = utils::getParentSDFG(op);
 
-  AsmState state(sdfg);
-  std::string name;
-  llvm::raw_string_ostream nameStream(name);
-  value.printAsOperand(nameStream, state);
-  utils::sanitizeName(name);
+  if (activeCache == nullptr) {
+    AsmState state(sdfg);
+    return printValue(value, state);
+  }
+
+  std::unique_ptr<SDFGNames> &entry = activeCache->sdfgs[sdfg];
+  if (!entry)
+    entry = std::make_unique<SDFGNames>(sdfg);
+
+  auto it = entry->names.find(value);
+  if (it != entry->names.end())
+    return it->second;
+
+  std::string name = printValue(value, entry->state);
+  entry->names.insert({value, name});
   return name;
 }
 
+/// Enables caching of value names for its lifetime. While a scope is active,
+/// the SSA numbering of each SDFG is computed once and reused by
+/// valueToString. The IR must not be modified while a scope is active, unless
+/// the cache is invalidated afterwards. Scopes may be nested.
+ValueNameScope::ValueNameScope()
+    : prevCache(activeCache), cache(std::make_unique<ValueNameCache>()) {
+  activeCache = cache.get();
+}
+
+/// Restores the previously active scope.
+ValueNameScope::~ValueNameScope() { activeCache = prevCache; }
+
+/// Drops all cached value names of the active scope.
+void invalidateValueNames() {
+  if (activeCache != nullptr)
+    activeCache->sdfgs.clear();
+}
+
+/// Drops the cached value names of the provided SDFG in the active scope.
+void invalidateValueNames(Operation &sdfg) {
+  if (activeCache != nullptr)
+    activeCache->sdfgs.erase(&sdfg);
+}
+
 } // namespace mlir::sdfg::utils
@@ -0,0 +1,241 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains a Python object emitter, which builds the same document
+/// structure as the JSON emitter out of Python dicts and lists.
+
+#include "PyObjectEmitter.h"
+#include "llvm/Support/ConvertUTF.h"
+#include <string>
+
+using namespace mlir;
+using namespace sdfg;
+using namespace emitter;
+
+namespace py = pybind11;
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+/// Resolves the JSON escape sequences in a string, as the translator generates
+/// strings ready to be printed into JSON (e.g. tasklet code).
+static std::string unescape(StringRef str) {
+  std::string res;
+  res.reserve(str.size());
+
+  for (size_t i = 0; i < str.size(); ++i) {
+    if (str[i] != '\\' || i + 1 == str.size()) {
+      res += str[i];
+      continue;
+    }
+
+    char c = str[++i];
+    switch (c) {
+    case 'n':
+      res += '\n';
+      break;
+    case 't':
+      res += '\t';
+      break;
+    case 'r':
+      res += '\r';
+      break;
+    case 'b':
+      res += '\b';
+      break;
+    case 'f':
+      res += '\f';
+      break;
+    case 'u': {
+      unsigned code;
+      if (i + 4 >= str.size() ||
+          str.substr(i + 1, 4).getAsInteger(16, code)) {
+        res += "\\u";
+        break;
+      }
+
+      char utf8[UNI_MAX_UTF8_BYTES_PER_CODE_POINT];
+      char *end = utf8;
+      if (llvm::ConvertCodePointToUTF8(code, end))
+        res.append(utf8, end);
+      i += 4;
+      break;
+    }
+    default:
+      // Covers the escaped quotation mark, backslash and slash
+      res += c;
+      break;
+    }
+  }
+
+  return res;
+}
+
+/// Converts a value given as a JSON literal (null, true, false or numbers) to
+/// the equivalent Python object. Other literals are converted to strings.
+static py::object convertLiteral(StringRef str) {
+  str = str.trim();
+
+  if (str == "null")
+    return py::none();
+
+  if (str == "false")
+    return py::bool_(false);
+
+  if (str == "true")
+    return py::bool_(true);
+
+  int64_t intVal;
+  if (!str.getAsInteger(10, intVal))
+    return py::int_(intVal);
+
+  double floatVal;
+  if (!str.getAsDouble(floatVal))
+    return py::float_(floatVal);
+
+  return py::str(unescape(str));
+}
+
+//===----------------------------------------------------------------------===//
+// PyObjectEmitter
+//===----------------------------------------------------------------------===//
+
+/// Creates a new Python object emitter.
+PyObjectEmitter::PyObjectEmitter() { error = false; }
+
+/// Checks for errors (open objects/lists). Returns a LogicalResult indicating
+/// success or failure.
+LogicalResult PyObjectEmitter::finish() {
+  if (!containerStack.empty()) {
+    containerStack.clear();
+    error = true;
+  }
+
+  return failure(error || !root);
+}
+
+/// Appends a string to the current list.
+void PyObjectEmitter::printString(StringRef str) {
+  insert(std::nullopt, py::str(unescape(str)));
+}
+
+/// Appends a literal value (null, true, false or a number) to the current
+/// list.
+void PyObjectEmitter::printLiteral(StringRef str) {
+  insert(std::nullopt, convertLiteral(str));
+}
+
+/// Starts a new dict.
+void PyObjectEmitter::startObject() {
+  startContainer(std::nullopt, /*isDict=*/true);
+}
+
+/// Starts a new named (keyed) dict.
+void PyObjectEmitter::startNamedObject(StringRef name) {
+  startContainer(name, /*isDict=*/true);
+}
+
+/// Ends the current dict.
+void PyObjectEmitter::endObject() { endContainer(/*isDict=*/true); }
+
+/// Starts a new named list.
+void PyObjectEmitter::startNamedList(StringRef name) {
+  startContainer(name, /*isDict=*/false);
+}
+
+/// Ends the current list.
+void PyObjectEmitter::endList() { endContainer(/*isDict=*/false); }
+
+/// Starts a new entry in the current dict or list. Entries are inserted when
+/// they are printed, so this is a no-op.
+void PyObjectEmitter::startEntry() {}
+
+/// Inserts a key-value pair into the current dict. If desired, turns the value
+/// into string.
+void PyObjectEmitter::printKVPair(StringRef key, StringRef val,
+                                  bool stringify) {
+  if (stringify)
+    insert(key, py::str(unescape(val)));
+  else
+    insert(key, convertLiteral(val));
+}
+
+/// Inserts a key-value pair into the current dict. If desired, turns the value
+/// into string.
+void PyObjectEmitter::printKVPair(StringRef key, int val, bool stringify) {
+  if (stringify)
+    insert(key, py::str(std::to_string(val)));
+  else
+    insert(key, py::int_(val));
+}
+
+/// Inserts a key-value pair into the current dict. If desired, turns the value
+/// into string.
+void PyObjectEmitter::printKVPair(StringRef key, Attribute val,
+                                  bool stringify) {
+  if (StringAttr strAttr = val.dyn_cast<StringAttr>()) {
+    insert(key, py::str(strAttr.getValue().str()));
+    return;
+  }
+
+  std::string str;
+  llvm::raw_string_ostream strStream(str);
+  val.print(strStream);
+  strStream.flush();
+
+  if (stringify)
+    insert(key, py::str(unescape(str)));
+  else
+    insert(key, convertLiteral(str));
+}
+
+/// Inserts a value into the current container, checking that it is of the
+/// expected kind. Keyed values are inserted into dicts, others into lists.
+void PyObjectEmitter::insert(Optional<StringRef> key, py::object val) {
+  if (containerStack.empty()) {
+    // Only a single unkeyed root value is allowed
+    if (key || root)
+      error = true;
+    else
+      root = val;
+    return;
+  }
+
+  py::object &container = containerStack.back();
+  bool isDict = py::isinstance<py::dict>(container);
+
+  // Keyed entries only in dicts, unkeyed entries only in lists
+  if (isDict != key.has_value()) {
+    error = true;
+    return;
+  }
+
+  if (isDict)
+    container.cast<py::dict>()[py::str(key->str())] = val;
+  else
+    container.cast<py::list>().append(val);
+}
+
+/// Starts a new container inserted with the provided key.
+void PyObjectEmitter::startContainer(Optional<StringRef> key, bool isDict) {
+  py::object container;
+  if (isDict)
+    container = py::dict();
+  else
+    container = py::list();
+
+  insert(key, container);
+  containerStack.push_back(container);
+}
+
+/// Ends the current container, checking for matching kinds.
+void PyObjectEmitter::endContainer(bool isDict) {
+  if (containerStack.empty()) {
+    error = true;
+    return;
+  }
+
+  py::object container = containerStack.pop_back_val();
+  if (py::isinstance<py::dict>(container) != isDict)
+    error = true;
+}
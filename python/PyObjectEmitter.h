@@ -0,0 +1,80 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// Header for the Python object emitter in SDFG translation.
+
+#ifndef SDFG_PyObjectEmitter_H
+#define SDFG_PyObjectEmitter_H
+
+#include "SDFG/Translate/Emitter.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
+#include <pybind11/pybind11.h>
+
+namespace mlir::sdfg::emitter {
+
+/// Builds the SDFG directly as Python dicts and lists. The produced object is
+/// equal to the result of json.loads on the output of the JsonEmitter, so that
+/// it can be passed to SDFG.from_json without any text encoding.
+struct PyObjectEmitter : public Emitter {
+  PyObjectEmitter();
+
+  /// Checks for errors (open objects/lists). Returns a LogicalResult
+  /// indicating success or failure.
+  LogicalResult finish() override;
+
+  /// Appends a string to the current list.
+  void printString(StringRef str) override;
+  /// Appends a literal value (null, true, false or a number) to the current
+  /// list.
+  void printLiteral(StringRef str) override;
+
+  /// Starts a new dict.
+  void startObject() override;
+  /// Starts a new named (keyed) dict.
+  void startNamedObject(StringRef name) override;
+  /// Ends the current dict.
+  void endObject() override;
+
+  /// Starts a new named list.
+  void startNamedList(StringRef name) override;
+  /// Ends the current list.
+  void endList() override;
+
+  /// Starts a new entry in the current dict or list. Entries are inserted when
+  /// they are printed, so this is a no-op.
+  void startEntry() override;
+  /// Inserts a key-value pair into the current dict. If desired, turns the
+  /// value into string.
+  void printKVPair(StringRef key, StringRef val,
+                   bool stringify = true) override;
+  /// Inserts a key-value pair into the current dict. If desired, turns the
+  /// value into string.
+  void printKVPair(StringRef key, int val, bool stringify = true) override;
+  /// Inserts a key-value pair into the current dict. If desired, turns the
+  /// value into string.
+  void printKVPair(StringRef key, Attribute val,
+                   bool stringify = true) override;
+
+  /// Returns the built root object.
+  pybind11::object getResult() { return root; }
+
+private:
+  /// The root object.
+  pybind11::object root;
+  /// Stack to keep track of the opened dicts and lists.
+  SmallVector<pybind11::object> containerStack;
+  /// Flag indicating whether there was an error during emission.
+  bool error;
+
+  /// Inserts a value into the current container, checking that it is of the
+  /// expected kind. Keyed values are inserted into dicts, others into lists.
+  void insert(Optional<StringRef> key, pybind11::object val);
+  /// Starts a new container inserted with the provided key.
+  void startContainer(Optional<StringRef> key, bool isDict);
+  /// Ends the current container, checking for matching kinds.
+  void endContainer(bool isDict);
+};
+
+} // namespace mlir::sdfg::emitter
+
+#endif // SDFG_PyObjectEmitter_H
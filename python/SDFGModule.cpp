@@ -0,0 +1,71 @@
+// Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+/// This file contains the Python extension module translating SDFG dialect to
+/// SDFGs in-process. The SDFG is handed to Python as dicts and lists, which
+/// SDFG.from_json accepts without any JSON text in between.
+
+#include "PyObjectEmitter.h"
+#include "SDFG/Translate/Translation.h"
+#include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/Parser/Parser.h"
+#include "llvm/Support/raw_ostream.h"
+#include <stdexcept>
+
+namespace py = pybind11;
+
+/// Translates the provided SDFG dialect source to a SDFG. Throws a
+/// RuntimeError containing the diagnostics on failure, including invalid
+/// options.
+static py::object translateToSDFG(const std::string &source, bool cppTasklets,
+                                  const std::string &instrumentMaps,
+                                  const std::string &cacheDir,
+                                  bool streamStates) {
+  mlir::DialectRegistry registry;
+  mlir::sdfg::translation::registerTranslationDialects(registry);
+  mlir::MLIRContext ctx(registry);
+
+  std::string diagnostics;
+  llvm::raw_string_ostream diagStream(diagnostics);
+  mlir::ScopedDiagnosticHandler handler(&ctx, [&](mlir::Diagnostic &diag) {
+    diagStream << diag.getLocation() << ": " << diag << "\n";
+    return mlir::success();
+  });
+
+  mlir::OwningOpRef<mlir::ModuleOp> module =
+      mlir::parseSourceString<mlir::ModuleOp>(source, &ctx);
+  if (!module)
+    throw std::runtime_error("Failed to parse the module:\n" +
+                             diagStream.str());
+
+  mlir::sdfg::translation::TranslationOptions options;
+  if (cppTasklets)
+    options.taskletLanguage = mlir::sdfg::translation::CodeLanguage::CPP;
+  options.mapInstrumentation = instrumentMaps;
+  options.cacheDirectory = cacheDir;
+  options.streamStates = streamStates;
+
+  mlir::sdfg::emitter::PyObjectEmitter emitter;
+  mlir::ModuleOp moduleOp = module.get();
+  mlir::LogicalResult res =
+      mlir::sdfg::translation::translateToSDFG(moduleOp, emitter, options);
+
+  if (res.failed())
+    throw std::runtime_error("Failed to translate the module:\n" +
+                             diagStream.str());
+
+  if (emitter.finish().failed())
+    throw std::runtime_error("Invalid SDFG generated");
+
+  return emitter.getResult();
+}
+
+PYBIND11_MODULE(mlir_sdfg, m) {
+  m.doc() = "In-process translation of the SDFG dialect to SDFGs";
+
+  m.def("translateToSDFG", &translateToSDFG, py::arg("source"),
+        py::arg("cpp_tasklets") = false, py::arg("instrument_maps") = "",
+        py::arg("cache_dir") = "", py::arg("stream_states") = false,
+        "Translates SDFG dialect source to a SDFG, given as the dict "
+        "SDFG.from_json expects");
+}
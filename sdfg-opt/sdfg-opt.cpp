@@ -1,6 +1,7 @@
 // Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
 
-/// This file contains the SDFG optimizer with the conversion passes.
+/// This file contains the SDFG optimizer with the conversion and
+/// transformation passes.
 
 #include "mlir/InitAllDialects.h"
 #include "mlir/InitAllPasses.h"
@@ -13,12 +14,14 @@
 #include "SDFG/Conversion/LinalgToSDFG/Passes.h"
 #include "SDFG/Conversion/SDFGToGeneric/Passes.h"
 #include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Transforms/Passes.h"
 
 int main(int argc, char **argv) {
   // Register SDFG passes
   mlir::sdfg::conversion::registerGenericToSDFGPasses();
   mlir::sdfg::conversion::registerLinalgToSDFGPasses();
   mlir::sdfg::conversion::registerSDFGToGenericPasses();
+  mlir::sdfg::transforms::registerSDFGTransformsPasses();
 
   mlir::DialectRegistry registry;
   registry.insert<mlir::sdfg::SDFGDialect>();
@@ -1,12 +1,266 @@
 // Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
 
-/// This file contains the SDFG program generator.
+/// This file contains the SDFG program generator. Besides generating a single
+/// program per invocation, it provides a batch mode that generates programs
+/// for a range of seeds in a pool of long-lived worker processes:
+///
+///   sdfg-smith --batch=<count> [--batch-seed=<first seed>]
+///              [--batch-jobs=<workers>] [--batch-dir=<output directory>]
+///              [--batch-config=<generator configuration>] [--batch-stats]
+///
+/// With an output directory every program is written to `<seed>.mlir`.
+/// Otherwise the programs are streamed to stdout, separated by `// -----`.
+/// With `--batch-stats` the generator throughput is reported on stderr, which
+/// serves as the benchmark for generator changes. Every worker owns a single
+/// context and calls the generator directly, so the batch mode does not accept
+/// the options of mlirSmithMain.
+///
+/// The size of the generated SDFGs can be fixed through the generator
+/// configuration, e.g. to produce translator stress inputs of a given scale:
+/// `sdfg.num_states` chains that many states, each holding a map nest of depth
+/// `sdfg.map_depth` that loads from a global array, passes the value through a
+/// chain of `sdfg.tasklets_per_state` tasklets and stores it back, and
+/// `sdfg.num_arrays` sets the number of global arrays. Combined with the batch
+/// mode and a fixed seed this yields a reproducible scaling corpus.
 
 #include "SDFG/Dialect/Dialect.h"
+#include "SDFG/Utils/NameGenerator.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/Dialect.h"
+#include "mlir/IR/GeneratorOpBuilder.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/Verifier.h"
+#include "mlir/Support/FileUtilities.h"
 #include "mlir/Tools/mlir-smith/MlirSmithMain.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace mlir;
+
+namespace {
+/// The options of the batch mode.
+struct BatchOptions {
+  /// The number of programs to generate. Zero disables the batch mode.
+  unsigned count = 0;
+  /// The seed of the first program.
+  unsigned seed = 0;
+  /// The number of worker processes.
+  unsigned jobs = 1;
+  /// The output directory. If empty, the programs are streamed to stdout.
+  std::string outputDir;
+  /// The generator configuration file. If empty, the defaults are used.
+  std::string configFile;
+  /// Whether to report the generator throughput.
+  bool stats = false;
+};
+} // namespace
+
+/// Extracts the batch options from the command line arguments.
+static LogicalResult parseBatchOptions(SmallVectorImpl<char *> &args,
+                                       BatchOptions &options) {
+  SmallVector<char *> remaining;
+
+  for (char *arg : args) {
+    StringRef argRef(arg);
+    bool invalid = false;
+
+    if (argRef.consume_front("--batch="))
+      invalid = argRef.getAsInteger(10, options.count);
+    else if (argRef.consume_front("--batch-seed="))
+      invalid = argRef.getAsInteger(10, options.seed);
+    else if (argRef.consume_front("--batch-jobs="))
+      invalid = argRef.getAsInteger(10, options.jobs) || options.jobs == 0;
+    else if (argRef.consume_front("--batch-dir="))
+      options.outputDir = argRef.str();
+    else if (argRef.consume_front("--batch-config="))
+      options.configFile = argRef.str();
+    else if (argRef == "--batch-stats")
+      options.stats = true;
+    else
+      remaining.push_back(arg);
+
+    if (invalid) {
+      llvm::errs() << "invalid batch option: " << arg << "\n";
+      return failure();
+    }
+  }
+
+  if (options.count > 0 && options.jobs > 1 && options.outputDir.empty()) {
+    llvm::errs() << "--batch-jobs > 1 requires --batch-dir\n";
+    return failure();
+  }
+
+  // The batch mode generates the programs itself, the remaining options are
+  // only understood by mlirSmithMain.
+  if (options.count > 0 && remaining.size() > 1) {
+    llvm::errs() << "unsupported option in batch mode: " << remaining[1]
+                 << "\n";
+    return failure();
+  }
+
+  args.assign(remaining.begin(), remaining.end());
+  return success();
+}
+
+namespace {
+/// The generator state owned by a worker. The context, its dialects and the
+/// generator configuration are set up once and reused for every program.
+struct Worker {
+  Worker(DialectRegistry &registry) : context(registry), config(&context) {
+    context.loadAllAvailableDialects();
+  }
+
+  MLIRContext context;
+  GeneratorOpBuilder::Config config;
+};
+} // namespace
+
+/// Loads the generator configuration of the batch into the worker.
+static LogicalResult loadConfig(Worker &worker, const BatchOptions &options) {
+  if (options.configFile.empty())
+    return success();
+
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+      llvm::MemoryBuffer::getFile(options.configFile);
+  if (!buffer) {
+    llvm::errs() << "failed to read " << options.configFile << ": "
+                 << buffer.getError().message() << "\n";
+    return failure();
+  }
+
+  return worker.config.loadFromFileContent((*buffer)->getBuffer());
+}
+
+/// Generates a single program with the provided seed in the context of the
+/// worker and writes it to the provided output file.
+static LogicalResult generateProgram(Worker &worker, unsigned seed,
+                                     StringRef outputFile) {
+  // Generated names and IDs only depend on the seed, as if the program was
+  // generated in a fresh context.
+  sdfg::utils::NameGeneratorScope nameScope;
+  worker.context.getOrLoadDialect<sdfg::SDFGDialect>()->resetIDs();
+
+  OwningOpRef<ModuleOp> module(
+      ModuleOp::create(UnknownLoc::get(&worker.context)));
+  GeneratorOpBuilder builder(&worker.context, worker.config, seed);
+  builder.setInsertionPointToEnd(module->getBody());
+
+  if (!sdfg::SDFGNode::generate(builder) || failed(verify(*module)))
+    return failure();
+
+  std::string errorMessage;
+  std::unique_ptr<llvm::ToolOutputFile> output =
+      openOutputFile(outputFile, &errorMessage);
+  if (!output) {
+    llvm::errs() << errorMessage << "\n";
+    return failure();
+  }
+
+  module->print(output->os());
+  output->os().flush();
+  output->keep();
+  return success();
+}
+
+/// Generates every program assigned to the provided worker. Returns the
+/// number of programs that failed to generate.
+static unsigned runWorker(DialectRegistry &registry,
+                          const BatchOptions &options, unsigned worker) {
+  Worker state(registry);
+  if (loadConfig(state, options).failed())
+    return options.count;
+
+  unsigned failures = 0;
+
+  for (unsigned i = worker; i < options.count; i += options.jobs) {
+    unsigned seed = options.seed + i;
+    SmallString<128> outputFile("-");
+
+    if (!options.outputDir.empty()) {
+      outputFile = options.outputDir;
+      llvm::sys::path::append(outputFile, std::to_string(seed) + ".mlir");
+    } else if (i > 0) {
+      llvm::outs() << "// -----\n";
+      llvm::outs().flush();
+    }
+
+    if (generateProgram(state, seed, outputFile).failed()) {
+      llvm::errs() << "failed to generate program with seed " << seed << "\n";
+      ++failures;
+    }
+  }
+
+  return failures;
+}
+
+/// Distributes the programs of the batch across the worker processes.
+static int runWorkers(DialectRegistry &registry,
+                      const BatchOptions &options) {
+  if (!options.outputDir.empty())
+    if (std::error_code ec =
+            llvm::sys::fs::create_directories(options.outputDir)) {
+      llvm::errs() << "failed to create " << options.outputDir << ": "
+                   << ec.message() << "\n";
+      return 1;
+    }
+
+  if (options.jobs == 1)
+    return runWorker(registry, options, 0) > 0;
+
+  llvm::outs().flush();
+  llvm::errs().flush();
+
+  SmallVector<pid_t> workers;
+  for (unsigned worker = 0; worker < options.jobs; ++worker) {
+    pid_t pid = fork();
+
+    if (pid == 0)
+      _exit(runWorker(registry, options, worker) > 0);
+
+    if (pid < 0) {
+      llvm::errs() << "failed to start worker " << worker << "\n";
+      break;
+    }
+
+    workers.push_back(pid);
+  }
+
+  bool failed = workers.size() != options.jobs;
+  for (pid_t pid : workers) {
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0)
+      failed = true;
+  }
+
+  return failed;
+}
+
+/// Runs the batch and reports the generator throughput if requested.
+static int runBatch(DialectRegistry &registry, const BatchOptions &options) {
+  auto start = std::chrono::steady_clock::now();
+  int result = runWorkers(registry, options);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  if (options.stats)
+    llvm::errs() << "generated " << options.count << " programs in "
+                 << llvm::format("%.3f", elapsed.count()) << " s ("
+                 << llvm::format("%.1f", options.count / elapsed.count())
+                 << " programs/s)\n";
+
+  return result;
+}
 
 int main(int argc, char **argv) {
   mlir::DialectRegistry registry;
@@ -14,6 +268,14 @@ int main(int argc, char **argv) {
   registry.insert<mlir::arith::ArithDialect>();
   registry.insert<mlir::math::MathDialect>();
 
-  return mlir::failed(mlir::mlirSmithMain(argc, argv, registry,
+  SmallVector<char *> args(argv, argv + argc);
+  BatchOptions options;
+  if (parseBatchOptions(args, options).failed())
+    return 1;
+
+  if (options.count > 0)
+    return runBatch(registry, options);
+
+  return mlir::failed(mlir::mlirSmithMain(args.size(), args.data(), registry,
                                           mlir::sdfg::SDFGNode::generate));
 }
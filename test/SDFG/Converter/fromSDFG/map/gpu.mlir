@@ -0,0 +1,46 @@
+// RUN: sdfg-opt --lower-sdfg="gpu-maps=true" %s | FileCheck %s
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s --check-prefix=HOST
+
+// CHECK: func.func @sdfg(%[[R:[a-zA-Z0-9_]+]]: memref<2x6xi32>)
+// CHECK: memref.alloc() : memref<2x6xi32>
+// CHECK: [[DEV:%[a-zA-Z0-9_]+]] = gpu.alloc () : memref<2x6xi32, 1>
+// CHECK: gpu.memcpy [[DEV]], %{{.*}} : memref<2x6xi32, 1>, memref<2x6xi32>
+
+// The argument is staged in GPU memory around the map
+// CHECK: [[RDEV:%[a-zA-Z0-9_]+]] = gpu.alloc () : memref<2x6xi32, 1>
+// CHECK-NEXT: gpu.memcpy [[RDEV]], %[[R]] : memref<2x6xi32, 1>, memref<2x6xi32>
+// CHECK: scf.parallel
+// CHECK: memref.load [[DEV]]
+// CHECK: memref.store %{{.*}}, [[RDEV]]
+// CHECK: mapping = [#gpu.loop_dim_map<processor = block_y, {{.*}}>, #gpu.loop_dim_map<processor = block_x, {{.*}}>]
+// CHECK-NEXT: gpu.memcpy %[[R]], [[RDEV]] : memref<2x6xi32>, memref<2x6xi32, 1>
+// CHECK-NEXT: gpu.dealloc [[RDEV]]
+// CHECK-NOT: memref.store %{{.*}}, %[[R]]
+
+// HOST-NOT: gpu.
+// HOST: scf.parallel
+// HOST-NOT: mapping
+
+sdfg.sdfg () -> (%r: !sdfg.array<2x6xi32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x6xi32>
+  %B = sdfg.alloc() : !sdfg.array<2x6xi32>
+
+  sdfg.state @state_0 {
+    sdfg.copy %A -> %B : !sdfg.array<2x6xi32>
+  }
+
+  sdfg.state @state_1 {
+    sdfg.map {schedule = "GPU_Device"} (%i, %j) = (0, 0) to (1, 5) step (1, 1) {
+      %b_ij = sdfg.load %B[%i, %j] : !sdfg.array<2x6xi32> -> i32
+
+      %res = sdfg.tasklet(%b_ij: i32) -> (i32) {
+        %z = arith.addi %b_ij, %b_ij : i32
+        sdfg.return %z : i32
+      }
+
+      sdfg.store %res, %r[%i, %j] : i32 -> !sdfg.array<2x6xi32>
+    }
+  }
+
+  sdfg.edge @state_0 -> @state_1
+}
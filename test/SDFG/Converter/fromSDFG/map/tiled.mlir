@@ -0,0 +1,18 @@
+// RUN: sdfg-opt --sdfg-tile-maps="tile-sizes=32,4" --lower-sdfg %s | FileCheck %s
+
+// CHECK: scf.parallel ([[TI:%[a-zA-Z0-9_]+]], [[TJ:%[a-zA-Z0-9_]+]])
+// CHECK: [[UBI:%[a-zA-Z0-9_]+]] = arith.minsi
+// CHECK: [[UBJ:%[a-zA-Z0-9_]+]] = arith.minsi
+// CHECK: scf.parallel
+// CHECK-SAME: = ([[TI]], [[TJ]]) to
+// CHECK: memref.load
+// CHECK: memref.store
+
+sdfg.sdfg {entry = @state_0} (%arg0: !sdfg.array<100x6xf64>) -> (%arg1: !sdfg.array<100x6xf64>) {
+  sdfg.state @state_0 {
+    sdfg.map {schedule = "CPU_Multicore"} (%i, %j) = (0, 0) to (99, 5) step (1, 1) {
+      %a = sdfg.load %arg0[%i, %j] : !sdfg.array<100x6xf64> -> f64
+      sdfg.store %a, %arg1[%i, %j] : f64 -> !sdfg.array<100x6xf64>
+    }
+  }
+}
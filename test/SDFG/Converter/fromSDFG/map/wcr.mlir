@@ -0,0 +1,16 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x6xf32>
+  %B = sdfg.alloc() : !sdfg.array<f32>
+
+  sdfg.state @state_0 {
+    // CHECK: scf.parallel
+    sdfg.map (%i, %j) = (0, 0) to (2, 6) step (1, 1) {
+      // CHECK: memref.load
+      %a_ij = sdfg.load %A[%i, %j] : !sdfg.array<2x6xf32> -> f32
+      // CHECK: memref.atomic_rmw maxf
+      sdfg.store {wcr = "max"} %a_ij, %B[] : f32 -> !sdfg.array<f32>
+    }
+  }
+}
@@ -0,0 +1,32 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+
+// CHECK: func.func @sdfg
+// CHECK-DAG: [[SCALAR:%[a-zA-Z0-9_]+]] = memref.alloca() : memref<i32>
+// CHECK-DAG: [[ARRAY:%[a-zA-Z0-9_]+]] = memref.alloc() : memref<2x6xi32>
+// CHECK: cf.br
+// CHECK-NOT: memref.alloc
+// CHECK: memref.dealloc [[ARRAY]] : memref<2x6xi32>
+// CHECK: return
+// CHECK-NOT: memref.dealloc [[SCALAR]]
+
+sdfg.sdfg{entry=@init} () -> (%r: !sdfg.array<i32>) {
+  %s = sdfg.alloc{transient}() : !sdfg.array<i32>
+
+  sdfg.state @init {}
+
+  sdfg.state @loop {
+    %A = sdfg.alloc{transient}() : !sdfg.array<2x6xi32>
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+    sdfg.store %1, %A[0, 0] : i32 -> !sdfg.array<2x6xi32>
+    sdfg.store %1, %s[] : i32 -> !sdfg.array<i32>
+  }
+
+  sdfg.state @exit {}
+
+  sdfg.edge{assign=["i: 0"]} @init -> @loop
+  sdfg.edge{assign=["i: i + 1"], condition="i < 10"} @loop -> @loop
+  sdfg.edge{condition="not(i < 10)"} @loop -> @exit
+}
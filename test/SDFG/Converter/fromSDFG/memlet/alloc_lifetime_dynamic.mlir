@@ -0,0 +1,32 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+
+// Symbol-sized transients of a state are allocated every time the state is
+// executed, so they are freed at the end of the state.
+// CHECK: func.func @sdfg
+// CHECK: cf.br
+// CHECK: [[ARRAY:%[a-zA-Z0-9_]+]] = memref.alloc({{.*}}) : memref<?xi32>
+// CHECK: memref.dealloc [[ARRAY]] : memref<?xi32>
+// CHECK-NEXT: cf.
+// CHECK-NOT: memref.dealloc [[ARRAY]]
+// CHECK: return
+
+sdfg.sdfg{entry=@init} () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @init {
+    sdfg.alloc_symbol("N")
+  }
+
+  sdfg.state @loop {
+    %A = sdfg.alloc{transient}() : !sdfg.array<sym("N")xi32>
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+    sdfg.store %1, %A[0] : i32 -> !sdfg.array<sym("N")xi32>
+  }
+
+  sdfg.state @exit {}
+
+  sdfg.edge{assign=["i: 0"]} @init -> @loop
+  sdfg.edge{assign=["i: i + 1"], condition="i < 10"} @loop -> @loop
+  sdfg.edge{condition="not(i < 10)"} @loop -> @exit
+}
@@ -0,0 +1,15 @@
+// RUN: sdfg-opt --lower-sdfg="pattern-timing=true" %s 2>&1 >/dev/null | FileCheck %s
+// CHECK: SDFG to Generic Pattern Timing
+// CHECK: Total Execution Time
+// CHECK: Wall Time{{.*}}Attempts{{.*}}Rewrites{{.*}}Name
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0{
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+
+    sdfg.store %1, %r[] : i32 -> !sdfg.array<i32>
+  }
+}
@@ -0,0 +1,23 @@
+// RUN: sdfg-opt --split-input-file --lower-sdfg %s | FileCheck %s
+
+// The symbols of a module are not passed to the nested SDFGs of the next one.
+// CHECK: func.func @sdfg(%{{.*}}: memref<?xi32>, %{{.*}}: index)
+// CHECK: // -----
+// CHECK: func.func @sdfg(%{{.*}}: memref<i32>)
+// CHECK: call @{{.*}}() : () -> ()
+
+sdfg.sdfg () -> (%r: !sdfg.array<sym("N")xi32>) {
+  sdfg.state @state_0{
+  }
+}
+
+// -----
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0{
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+      sdfg.state @state_1{
+      }
+    }
+  }
+}
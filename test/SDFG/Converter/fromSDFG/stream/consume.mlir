@@ -0,0 +1,28 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK: memref.atomic_rmw addi
+// CHECK: scf.while
+// CHECK: scf.condition
+// CHECK: scf.parallel
+// CHECK: scf.for
+// CHECK: memref.load
+// CHECK: memref.store
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.stream<i32>
+
+  sdfg.state @state_0 {
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+
+    sdfg.stream_push %1, %A : i32 -> !sdfg.stream<i32>
+
+    sdfg.consume{num_pes=4} (%A : !sdfg.stream<i32>) -> (pe: %p, elem: %e) {
+      %res = sdfg.tasklet(%e: i32) -> (i32) {
+        sdfg.return %e : i32
+      }
+      sdfg.store %res, %r[] : i32 -> !sdfg.array<i32>
+    }
+  }
+}
@@ -0,0 +1,26 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK: arith.constant 64 : index
+// CHECK: memref.alloc(%{{.*}}) : memref<?xi32>
+// CHECK: scf.while
+// CHECK: scf.parallel
+// CHECK: scf.for
+// CHECK: arith.minsi
+// CHECK: scf.for
+// CHECK: memref.load
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc {buffer_size = 64} () : !sdfg.stream<i32>
+
+  sdfg.state @state_0 {
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+
+    sdfg.stream_push %1, %A : i32 -> !sdfg.stream<i32>
+
+    sdfg.consume{num_pes=4, chunksize=16} (%A : !sdfg.stream<i32>) -> (pe: %p, elem: %e) {
+      sdfg.store %e, %r[] : i32 -> !sdfg.array<i32>
+    }
+  }
+}
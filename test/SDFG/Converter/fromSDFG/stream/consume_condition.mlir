@@ -0,0 +1,28 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK-NOT: func.func @empty
+// CHECK: scf.while
+// CHECK: [[QUIESCENT:%[a-zA-Z0-9_]+]] = arith.cmpi eq
+// CHECK: [[RUNNING:%[a-zA-Z0-9_]+]] = arith.xori [[QUIESCENT]]
+// CHECK: [[PROCEED:%[a-zA-Z0-9_]+]] = arith.andi %{{.*}}, [[RUNNING]]
+// CHECK: scf.condition([[PROCEED]])
+// CHECK: scf.parallel
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.stream<i32>
+
+  sdfg.state @state_0 {
+    func.func @empty(%x: !sdfg.stream<i32>) -> i1 {
+      %0 = arith.constant 0 : i32
+      %length = sdfg.stream_length %x : !sdfg.stream<i32> -> i32
+      %isZero = arith.cmpi "eq", %length, %0 : i32
+      return %isZero : i1
+    }
+
+    sdfg.consume{num_pes=4, condition=@empty} (%A : !sdfg.stream<i32>) -> (pe: %p, elem: %e) {
+      %res = sdfg.tasklet(%e: i32) -> (i32) {
+        sdfg.return %e : i32
+      }
+      sdfg.store %res, %r[] : i32 -> !sdfg.array<i32>
+    }
+  }
+}
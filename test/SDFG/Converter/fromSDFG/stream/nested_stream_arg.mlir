@@ -0,0 +1,39 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK: func.func private @[[NESTED:[a-zA-Z0-9_]+]](%{{.*}}: memref<?xi32>, %{{.*}}: memref<i32>, %{{.*}}: memref<2xi64>)
+// CHECK: memref.atomic_rmw addi
+// CHECK: scf.while
+// CHECK: func.func @sdfg(%{{.*}}: memref<?xi32>, %{{.*}}: memref<i32>, %{{.*}}: memref<2xi64>)
+// CHECK: [[BUFFER:%[a-zA-Z0-9_]+]] = memref.alloc({{.*}}) : memref<?xi32>
+// CHECK: [[COUNTERS:%[a-zA-Z0-9_]+]] = memref.alloc() : memref<2xi64>
+// CHECK: call @[[NESTED]]([[BUFFER]], %{{.*}}, [[COUNTERS]])
+
+sdfg.sdfg (%S: !sdfg.stream<i32>) -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc {buffer_size = 16} () : !sdfg.stream<i32>
+
+  sdfg.state @state_0 {
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+
+    sdfg.stream_push %1, %S : i32 -> !sdfg.stream<i32>
+
+    sdfg.nested_sdfg (%A: !sdfg.stream<i32>) -> (%r: !sdfg.array<i32>) {
+      sdfg.state @state_1 {
+        %2 = sdfg.tasklet() -> (i32) {
+          %2 = arith.constant 2 : i32
+          sdfg.return %2 : i32
+        }
+
+        sdfg.stream_push %2, %A : i32 -> !sdfg.stream<i32>
+
+        sdfg.consume{num_pes=2} (%A : !sdfg.stream<i32>) -> (pe: %p, elem: %e) {
+          %res = sdfg.tasklet(%e: i32) -> (i32) {
+            sdfg.return %e : i32
+          }
+          sdfg.store %res, %r[] : i32 -> !sdfg.array<i32>
+        }
+      }
+    }
+  }
+}
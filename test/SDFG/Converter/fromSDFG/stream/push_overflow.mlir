@@ -0,0 +1,19 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK: memref.atomic_rmw addi
+// CHECK: [[LENGTH:%[a-zA-Z0-9_]+]] = arith.subi
+// CHECK: [[FITS:%[a-zA-Z0-9_]+]] = arith.cmpi slt, [[LENGTH]]
+// CHECK: cf.assert [[FITS]], "stream buffer overflow"
+// CHECK: memref.store
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc {buffer_size = 4} () : !sdfg.stream<i32>
+
+  sdfg.state @state_0 {
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+
+    sdfg.stream_push %1, %A : i32 -> !sdfg.stream<i32>
+  }
+}
@@ -0,0 +1,22 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK: memref.load
+// CHECK: scf.parallel
+// CHECK-NOT: memref.load
+// CHECK: scf.parallel
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.alloc_symbol("N")
+
+    sdfg.map (%i) = (0) to (sym("N")) step (1) {
+      sdfg.map (%j) = (0) to (sym("N")) step (1) {
+        %res = sdfg.tasklet() -> (i32) {
+          %c = arith.constant 1 : i32
+          sdfg.return %c : i32
+        }
+
+        sdfg.store %res, %r[] : i32 -> !sdfg.array<i32>
+      }
+    }
+  }
+}
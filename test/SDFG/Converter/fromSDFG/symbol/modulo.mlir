@@ -0,0 +1,21 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK-NOT: arith.remsi
+// CHECK: [[Q:%[a-zA-Z0-9_]+]] = arith.floordivsi [[L:%[a-zA-Z0-9_]+]], [[R:%[a-zA-Z0-9_]+]]
+// CHECK-NEXT: [[P:%[a-zA-Z0-9_]+]] = arith.muli [[Q]], [[R]]
+// CHECK-NEXT: arith.subi [[L]], [[P]]
+// CHECK-NOT: arith.remsi
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.alloc_symbol("N")
+
+    sdfg.map (%i) = (0) to (sym("N%3")) step (1) {
+      %res = sdfg.tasklet() -> (i32) {
+        %c = arith.constant 1 : i32
+        sdfg.return %c : i32
+      }
+
+      sdfg.store %res, %r[] : i32 -> !sdfg.array<i32>
+    }
+  }
+}
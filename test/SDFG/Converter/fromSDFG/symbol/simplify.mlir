@@ -0,0 +1,21 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK-NOT: arith.muli
+// CHECK-NOT: arith.addi
+// CHECK: arith.constant 8 : i64
+// CHECK-NOT: arith.muli
+// CHECK-NOT: arith.addi
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.alloc_symbol("N")
+
+    sdfg.map (%i) = (0) to (sym("N*1+0")) step (sym("2**3")) {
+      %res = sdfg.tasklet() -> (i32) {
+        %c = arith.constant 1 : i32
+        sdfg.return %c : i32
+      }
+
+      sdfg.store %res, %r[] : i32 -> !sdfg.array<i32>
+    }
+  }
+}
@@ -0,0 +1,25 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK-NOT: func.func private
+// CHECK: func.func @sdfg
+// CHECK-NOT: func.call
+// CHECK: scf.parallel
+// CHECK: arith.index_cast
+// CHECK: arith.addi
+// CHECK: memref.store
+
+sdfg.sdfg () -> (%r: !sdfg.array<8xi64>) {
+  sdfg.alloc_symbol("N")
+
+  sdfg.state @state_0{
+    sdfg.map (%i) = (0) to (7) step (1) {
+      %c = sdfg.tasklet(%i: index) -> (i64) {
+        %n = sdfg.sym("N") : i64
+        %x = arith.index_cast %i : index to i64
+        %c = arith.addi %x, %n : i64
+        sdfg.return %c : i64
+      }
+
+      sdfg.store %c, %r[%i] : i64 -> !sdfg.array<8xi64>
+    }
+  }
+}
@@ -0,0 +1,19 @@
+// RUN: sdfg-opt --lower-sdfg="outline-tasklets" %s | FileCheck %s
+// CHECK: func.func private @[[TASKLET:[a-zA-Z0-9_]*]]
+// CHECK-SAME: (%{{[a-zA-Z0-9_]*}}: memref<i64>) -> i64
+// CHECK: func.func @sdfg
+// CHECK: func.call @[[TASKLET]](%{{[a-zA-Z0-9_]*}}) : (memref<i64>) -> i64
+
+sdfg.sdfg () -> (%r: !sdfg.array<i64>) {
+  sdfg.alloc_symbol("N")
+  sdfg.alloc_symbol("M")
+
+  sdfg.state @state_0{
+    %c = sdfg.tasklet() -> (i64) {
+      %n = sdfg.sym("2 * N") : i64
+      sdfg.return %n : i64
+    }
+
+    sdfg.store %c, %r[] : i64 -> !sdfg.array<i64>
+  }
+}
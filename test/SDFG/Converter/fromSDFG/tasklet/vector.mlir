@@ -0,0 +1,24 @@
+// RUN: sdfg-opt --lower-sdfg %s | FileCheck %s
+// CHECK: memref<vector<4xf32>>
+// CHECK: vector.reduction <add>
+
+sdfg.sdfg () -> (%r: !sdfg.array<f32>) {
+  %A = sdfg.alloc() : !sdfg.array<vector<4xf32>>
+
+  sdfg.state @state_0{
+    %v = sdfg.tasklet() -> (vector<4xf32>) {
+      %c = arith.constant dense<2.0> : vector<4xf32>
+      sdfg.return %c : vector<4xf32>
+    }
+
+    sdfg.store %v, %A[] : vector<4xf32> -> !sdfg.array<vector<4xf32>>
+    %l = sdfg.load %A[] : !sdfg.array<vector<4xf32>> -> vector<4xf32>
+
+    %s = sdfg.tasklet(%l: vector<4xf32>) -> (f32) {
+      %s = vector.reduction <add>, %l : vector<4xf32> into f32
+      sdfg.return %s : f32
+    }
+
+    sdfg.store %s, %r[] : f32 -> !sdfg.array<f32>
+  }
+}
@@ -0,0 +1,14 @@
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --convert-to-sdfg %s | sdfg-opt
+// CHECK: sdfg.tasklet
+// CHECK-NEXT: arith.addi
+// CHECK-NEXT: arith.muli
+// CHECK-NEXT: arith.subi
+// CHECK-NEXT: sdfg.return
+// CHECK-NOT: sdfg.tasklet
+func.func private @main(%arg1: i32, %arg2: i32) -> i32 {
+  %c0 = arith.addi %arg1, %arg2 : i32
+  %c1 = arith.muli %c0, %arg1 : i32
+  %c2 = arith.subi %c1, %c0 : i32
+  return %c2 : i32
+}
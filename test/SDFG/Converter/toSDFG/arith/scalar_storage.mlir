@@ -0,0 +1,10 @@
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// CHECK: sdfg.alloc
+// CHECK-SAME: lifetime = "Scope"
+// CHECK-SAME: storage = "Register"
+// CHECK-SAME: transient
+// CHECK-SAME: !sdfg.array<i32>
+func.func private @main(%arg1: i32, %arg2: i32) -> i32 {
+  %c0 = arith.addi %arg1, %arg2 : i32
+  return %c0 : i32
+}
@@ -0,0 +1,15 @@
+// RUN: sdfg-opt --convert-to-sdfg %s | sdfg-opt
+
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// CHECK: !sdfg.array<8xvector<4xf32>>
+// CHECK: sdfg.tasklet
+// CHECK: vector.broadcast
+// CHECK: arith.mulf {{.*}} : vector<4xf32>
+func.func private @main(%arg0: memref<8xvector<4xf32>>, %arg1: f32) {
+  %c0 = arith.constant 0 : index
+  %0 = memref.load %arg0[%c0] : memref<8xvector<4xf32>>
+  %1 = vector.broadcast %arg1 : f32 to vector<4xf32>
+  %2 = arith.mulf %0, %1 : vector<4xf32>
+  memref.store %2, %arg0[%c0] : memref<8xvector<4xf32>>
+  return
+}
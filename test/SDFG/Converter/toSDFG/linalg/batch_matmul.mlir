@@ -0,0 +1,17 @@
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | sdfg-opt
+// CHECK: sdfg.libcall
+// CHECK-SAME: inputs = ["_a", "_b"]
+// CHECK-SAME: outputs = ["_c"]
+// CHECK-SAME: "dace.libraries.blas.nodes.BatchedMatMul"
+// CHECK: sdfg.map
+// CHECK-SAME: (%{{.*}}, %{{.*}}, %{{.*}}) = (0, 0, 0) to (3, 63, 63)
+// CHECK: sdfg.tasklet
+// CHECK: arith.addf
+// CHECK: sdfg.store
+func.func private @main(%A: memref<4x64x16xf32>, %B: memref<4x16x64xf32>,
+                        %C: memref<4x64x64xf32>) {
+  linalg.batch_matmul ins(%A, %B : memref<4x64x16xf32>, memref<4x16x64xf32>)
+                      outs(%C : memref<4x64x64xf32>)
+  return
+}
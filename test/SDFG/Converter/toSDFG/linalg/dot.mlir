@@ -0,0 +1,16 @@
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | sdfg-opt
+// CHECK: sdfg.libcall
+// CHECK-SAME: inputs = ["_x", "_y"]
+// CHECK-SAME: outputs = ["_result"]
+// CHECK-SAME: "dace.libraries.blas.nodes.Dot"
+// CHECK-NOT: sdfg.map
+// CHECK: sdfg.tasklet
+// CHECK: arith.addf
+// CHECK: sdfg.store
+func.func private @main(%x: memref<128xf32>, %y: memref<128xf32>,
+                        %r: memref<f32>) {
+  linalg.dot ins(%x, %y : memref<128xf32>, memref<128xf32>)
+             outs(%r : memref<f32>)
+  return
+}
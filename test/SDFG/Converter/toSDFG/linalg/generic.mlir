@@ -0,0 +1,19 @@
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | sdfg-opt
+// CHECK: sdfg.map
+// CHECK: sdfg.load
+// CHECK: sdfg.tasklet
+// CHECK: arith.mulf
+// CHECK: sdfg.store
+// CHECK-NOT: sdfg.libcall
+#id = affine_map<(i, j) -> (i, j)>
+func.func private @main(%A: memref<16x32xf32>, %B: memref<16x32xf32>) {
+  linalg.generic {indexing_maps = [#id, #id],
+                  iterator_types = ["parallel", "parallel"]}
+      ins(%A : memref<16x32xf32>) outs(%B : memref<16x32xf32>) {
+  ^bb0(%a: f32, %b: f32):
+    %0 = arith.mulf %a, %a : f32
+    linalg.yield %0 : f32
+  }
+  return
+}
@@ -1,9 +1,14 @@
-// XFAIL: *
-// RUN: mlir-opt --linalg-bufferize --func-bufferize --cse --finalizing-bufferize %s | sdfg-opt --linalg-to-sdfg | sdfg-opt
-func.func @main() -> tensor<256x256xf32> {
-  %0 = linalg.init_tensor [256, 16] : tensor<256x16xf32>
-  %1 = linalg.init_tensor [16, 256] : tensor<16x256xf32>
-  %2 = linalg.init_tensor [256, 256] : tensor<256x256xf32>
-  %3 = linalg.matmul ins(%0, %1 : tensor<256x16xf32>, tensor<16x256xf32>) outs(%2 : tensor<256x256xf32>) -> tensor<256x256xf32>
-  return %2 : tensor<256x256xf32>
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | sdfg-opt
+// CHECK: sdfg.libcall
+// CHECK-SAME: "dace.libraries.blas.nodes.MatMul"
+// CHECK: sdfg.map
+// CHECK: sdfg.tasklet
+// CHECK: arith.addf
+// CHECK: sdfg.store
+func.func private @main(%A: memref<256x16xf32>, %B: memref<16x256xf32>,
+                        %C: memref<256x256xf32>) {
+  linalg.matmul ins(%A, %B : memref<256x16xf32>, memref<16x256xf32>)
+                outs(%C : memref<256x256xf32>)
+  return
 }
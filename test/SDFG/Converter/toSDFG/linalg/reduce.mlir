@@ -0,0 +1,22 @@
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | sdfg-opt
+// CHECK: sdfg.libcall
+// CHECK-SAME: inputs = ["_in"]
+// CHECK-SAME: outputs = ["_out"]
+// CHECK-SAME: properties = {axes = [1], identity = 0 : i64,
+// CHECK-SAME: wcr = "lambda a, b: a + b"}
+// CHECK-SAME: "dace.libraries.standard.nodes.Reduce"
+// CHECK: sdfg.map
+// CHECK: sdfg.tasklet
+// CHECK: arith.addf
+// CHECK: sdfg.store
+func.func private @main(%A: memref<16x32xf32>, %B: memref<16xf32>) {
+  linalg.reduce ins(%A : memref<16x32xf32>) outs(%B : memref<16xf32>)
+                dimensions = [1]
+    (%in: f32, %init: f32) {
+      %0 = arith.addf %in, %init : f32
+      linalg.yield %0 : f32
+    }
+  return
+}
+
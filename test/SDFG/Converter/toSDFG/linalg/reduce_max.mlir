@@ -0,0 +1,15 @@
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --linalg-to-sdfg --convert-to-sdfg %s | sdfg-opt
+// Reductions without a DaCe library node are lowered to loops.
+// CHECK-NOT: sdfg.libcall
+// CHECK: arith.maxf
+// CHECK-NOT: sdfg.libcall
+func.func private @main(%A: memref<16x32xf32>, %B: memref<16xf32>) {
+  linalg.reduce ins(%A : memref<16x32xf32>) outs(%B : memref<16xf32>)
+                dimensions = [1]
+    (%in: f32, %init: f32) {
+      %0 = arith.maxf %in, %init : f32
+      linalg.yield %0 : f32
+    }
+  return
+}
@@ -0,0 +1,22 @@
+// XFAIL: *
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// CHECK: sdfg.view_cast
+// CHECK-SAME: !sdfg.array<sym("{{.*}}")x16xf64>
+// CHECK: sdfg.load {{.*}}[{{.*}}, {{.*}}]
+func.func @main(%arg0: !llvm.ptr<f64>, %i: i64) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c16 = arith.constant 16 : index
+  %c16_i64 = arith.constant 16 : i64
+
+  scf.for %j = %c0 to %c16 step %c1 {
+    %jj = arith.index_cast %j : index to i64
+    %0 = arith.muli %i, %c16_i64 : i64
+    %1 = arith.addi %0, %jj : i64
+    %2 = llvm.getelementptr %arg0[%1] : (!llvm.ptr<f64>, i64) -> !llvm.ptr<f64>
+    %3 = llvm.load %2 : !llvm.ptr<f64>
+    llvm.store %3, %arg0 : !llvm.ptr<f64>
+  }
+
+  return
+}
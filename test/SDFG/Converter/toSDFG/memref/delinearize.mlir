@@ -0,0 +1,30 @@
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// CHECK: !sdfg.array<sym("[[SYM:[^"]*]]")xf64>
+// CHECK: [[VIEW:%[a-zA-Z0-9_]+]] = sdfg.view_cast
+// CHECK-SAME: !sdfg.array<sym("[[SYM]]")x16xf64>
+// CHECK-NOT: sdfg.view_cast
+// CHECK: sdfg.load [[VIEW]][{{[^,]*}}, {{[^,]*}}]
+// CHECK: sdfg.store {{.*}}, [[VIEW]][{{[^,]*}}, {{[^,]*}}]
+// CHECK: sdfg.store {{.*}}[{{[^,]*}}] : f64 -> !sdfg.array<sym("[[SYM]]")xf64>
+func.func private @main(%arg0: memref<?xf64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c16 = arith.constant 16 : index
+
+  scf.for %i = %c0 to %c4 step %c1 {
+    scf.for %j = %c0 to %c16 step %c1 {
+      %0 = arith.muli %i, %c16 : index
+      %1 = arith.addi %0, %j : index
+      %v = memref.load %arg0[%1] : memref<?xf64>
+      %w = arith.addf %v, %v : f64
+      memref.store %w, %arg0[%1] : memref<?xf64>
+
+      // The shifted index may leave the row and stays linear
+      %2 = arith.addi %1, %c1 : index
+      memref.store %w, %arg0[%2] : memref<?xf64>
+    }
+  }
+
+  return
+}
@@ -0,0 +1,21 @@
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// CHECK: sdfg.view_cast
+// CHECK-SAME: !sdfg.array<64xf64> -> !sdfg.array<4x16xf64>
+// CHECK: sdfg.load {{.*}}[{{[^,]*}}, {{[^,]*}}]
+func.func private @main(%arg0: memref<64xf64>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c16 = arith.constant 16 : index
+
+  scf.for %i = %c0 to %c4 step %c1 {
+    scf.for %j = %c0 to %c16 step %c1 {
+      %0 = arith.muli %i, %c16 : index
+      %1 = arith.addi %0, %j : index
+      %v = memref.load %arg0[%1] : memref<64xf64>
+      memref.store %v, %arg0[%1] : memref<64xf64>
+    }
+  }
+
+  return
+}
@@ -0,0 +1,16 @@
+// RUN: sdfg-opt --split-input-file --convert-to-sdfg %s | FileCheck %s
+// CHECK: sdfg.state @init_0
+// CHECK: // -----
+// CHECK: sdfg.state @init_0
+
+func.func private @main(%arg1: i32, %arg2: i32) -> i32 {
+  %c0 = arith.addi %arg1, %arg2 : i32
+  return %c0 : i32
+}
+
+// -----
+
+func.func private @main(%arg1: i32, %arg2: i32) -> i32 {
+  %c0 = arith.addi %arg1, %arg2 : i32
+  return %c0 : i32
+}
@@ -0,0 +1,8 @@
+// RUN: sdfg-opt --convert-to-sdfg="pattern-timing=true" %s 2>&1 >/dev/null | FileCheck %s
+// CHECK: Generic to SDFG Pattern Timing
+// CHECK: Total Execution Time
+// CHECK: Wall Time{{.*}}Attempts{{.*}}Rewrites{{.*}}Name
+func.func private @main(%arg1: i32, %arg2: i32) -> i32 {
+  %c0 = arith.addi %arg1, %arg2 : i32
+  return %c0 : i32
+}
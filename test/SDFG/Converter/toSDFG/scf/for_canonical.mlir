@@ -0,0 +1,23 @@
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// CHECK: sdfg.edge {assign = ["[[IDX:[a-zA-Z0-9_]+]]: 0"]
+// CHECK-SAME: @for_init{{[a-zA-Z0-9_]*}} -> @for_guard
+// CHECK: sdfg.edge {{.*}}condition = "[[IDX]] < 16"
+// CHECK-SAME: @for_guard{{[a-zA-Z0-9_]*}} -> @for_body
+// CHECK: sdfg.edge {assign = ["[[IDX]]: [[IDX]] + 2"]
+// CHECK-SAME: @for_return{{[a-zA-Z0-9_]*}} -> @for_guard
+// CHECK: sdfg.edge {{.*}}condition = "not([[IDX]] < 16)"
+// CHECK-SAME: @for_guard{{[a-zA-Z0-9_]*}} -> @for_exit
+func.func private @main(%arg0: memref<16xf64>) -> f64 {
+  %c0 = arith.constant 0 : index
+  %c2 = arith.constant 2 : index
+  %c16 = arith.constant 16 : index
+  %zero = arith.constant 0.0 : f64
+
+  %sum = scf.for %iv = %c0 to %c16 step %c2 iter_args(%acc = %zero) -> (f64) {
+    %v = memref.load %arg0[%iv] : memref<16xf64>
+    %next = arith.addf %acc, %v : f64
+    scf.yield %next : f64
+  }
+
+  return %sum : f64
+}
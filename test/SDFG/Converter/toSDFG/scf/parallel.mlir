@@ -0,0 +1,24 @@
+// RUN: sdfg-opt --convert-to-sdfg %s | FileCheck %s
+// RUN: sdfg-opt --convert-to-sdfg %s | sdfg-opt
+// CHECK: sdfg.map
+// CHECK: sdfg.map
+// CHECK: sdfg.load
+// CHECK: sdfg.tasklet
+// CHECK: arith.addf
+// CHECK: sdfg.store
+func.func private @main(%A: memref<16x32xf32>, %B: memref<16x32xf32>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c16 = arith.constant 16 : index
+  scf.parallel (%i) = (%c0) to (%c16) step (%c1) {
+    %c32 = arith.constant 32 : index
+    scf.parallel (%j) = (%c0) to (%c32) step (%c1) {
+      %v = memref.load %A[%i, %j] : memref<16x32xf32>
+      %w = arith.addf %v, %v : f32
+      memref.store %w, %B[%i, %j] : memref<16x32xf32>
+      scf.yield
+    }
+    scf.yield
+  }
+  return
+}
@@ -0,0 +1,21 @@
+// RUN: sdfg-opt %s | sdfg-opt | FileCheck %s
+
+// CHECK: module
+// CHECK: sdfg.sdfg
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  // CHECK-NEXT: [[NAMEA:%[a-zA-Z0-9_]*]] = sdfg.alloc
+  // CHECK-SAME: buffer_size = 64
+  // CHECK-SAME: !sdfg.stream<i32>
+  %A = sdfg.alloc {buffer_size = 64} () : !sdfg.stream<i32>
+  // CHECK: sdfg.state
+  sdfg.state @state_0 {
+    // CHECK: sdfg.consume
+    // CHECK-DAG: chunksize = 16
+    // CHECK-DAG: num_pes = 4
+    // CHECK-SAME: [[NAMEA]] : !sdfg.stream<i32>
+    sdfg.consume{num_pes=4, chunksize=16} (%A : !sdfg.stream<i32>) -> (pe: %p, elem: %e) {
+      // CHECK: sdfg.store
+      sdfg.store %e, %r[] : i32 -> !sdfg.array<i32>
+    }
+  }
+}
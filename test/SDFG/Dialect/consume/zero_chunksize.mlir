@@ -0,0 +1,11 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: chunk size is at least one
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.stream<i32>
+
+  sdfg.state @state_0 {
+    sdfg.consume{chunksize=0} (%A : !sdfg.stream<i32>) -> (pe: %p, elem: %e) {
+    }
+  }
+}
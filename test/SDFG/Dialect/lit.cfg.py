@@ -56,6 +56,6 @@ config.sdfg_tools_dir = os.path.join(config.sdfg_obj_root, 'bin')
 llvm_config.with_environment('PATH', config.llvm_tools_dir, append_path=True)
 
 tool_dirs = [config.sdfg_tools_dir, config.llvm_tools_dir]
-tools = ['sdfg-opt']
+tools = ['sdfg-opt', 'sdfg-smith']
 
 llvm_config.add_tool_substitutions(tools, tool_dirs)
@@ -0,0 +1,19 @@
+// RUN: sdfg-opt %s | sdfg-opt | FileCheck %s
+
+// CHECK: module
+// CHECK: sdfg.sdfg
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  // CHECK: sdfg.state
+  // CHECK-SAME: @state_0
+  sdfg.state @state_0 {
+    // CHECK: sdfg.map
+    // CHECK-SAME: collapse = 2
+    // CHECK-SAME: omp_chunk_size = 16
+    // CHECK-SAME: schedule = "CPU_Multicore"
+    // CHECK-SAME: tile_sizes = [32, 8]
+    sdfg.map {schedule = "CPU_Multicore", collapse = 2, omp_chunk_size = 16,
+              tile_sizes = [32, 8]}
+             (%i, %j) = (0, 0) to (63, 63) step (1, 1) {
+    }
+  }
+}
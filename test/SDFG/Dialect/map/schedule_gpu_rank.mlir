@@ -0,0 +1,9 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: maps with a GPU schedule have at most three dimensions
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.map {schedule = "GPU_Device"} (%i, %j, %k, %l) = (0, 0, 0, 0) to (2, 2, 2, 2) step (1, 1, 1, 1) {
+    }
+  }
+}
@@ -0,0 +1,9 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: schedule is a valid map schedule
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.map {schedule = "CPU_Multithreaded"} (%i, %j) = (0, 0) to (2, 2) step (1, 1) {
+    }
+  }
+}
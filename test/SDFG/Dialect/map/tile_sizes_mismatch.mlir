@@ -0,0 +1,9 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: tile sizes matches size of arguments
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.map {tile_sizes = [32]} (%i, %j) = (0, 0) to (2, 2) step (1, 1) {
+    }
+  }
+}
@@ -0,0 +1,9 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: buffer size is only specified for streams
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %a = sdfg.alloc {buffer_size = 8} () : !sdfg.array<i32>
+
+  sdfg.state @state_0{
+  }
+}
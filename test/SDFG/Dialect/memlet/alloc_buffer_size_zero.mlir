@@ -0,0 +1,9 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: buffer size is at least one
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %a = sdfg.alloc {buffer_size = 0} () : !sdfg.stream<i32>
+
+  sdfg.state @state_0{
+  }
+}
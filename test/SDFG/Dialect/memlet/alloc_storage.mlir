@@ -0,0 +1,22 @@
+// RUN: sdfg-opt %s | sdfg-opt | FileCheck %s
+
+// CHECK: module
+// CHECK: sdfg.sdfg
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  // CHECK-NEXT: {{%[a-zA-Z0-9_]*}} = sdfg.alloc
+  // CHECK-SAME: lifetime = "Scope"
+  // CHECK-SAME: storage = "Register"
+  // CHECK-SAME: !sdfg.array<i32>
+  %a = sdfg.alloc {storage = "Register", lifetime = "Scope", transient} ()
+         : !sdfg.array<i32>
+
+  // CHECK-NEXT: {{%[a-zA-Z0-9_]*}} = sdfg.alloc
+  // CHECK-SAME: lifetime = "Persistent"
+  // CHECK-SAME: storage = "CPU_Heap"
+  // CHECK-SAME: !sdfg.array<12xi32>
+  %b = sdfg.alloc {storage = "CPU_Heap", lifetime = "Persistent"} ()
+         : !sdfg.array<12xi32>
+
+  sdfg.state @state_0{
+  }
+}
@@ -0,0 +1,9 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: storage is a valid storage type
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %a = sdfg.alloc {storage = "CPU_Stack"} () : !sdfg.array<i32>
+
+  sdfg.state @state_0{
+  }
+}
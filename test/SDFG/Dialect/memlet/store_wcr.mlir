@@ -0,0 +1,28 @@
+// RUN: sdfg-opt %s | sdfg-opt | FileCheck %s
+
+// CHECK: module
+// CHECK: sdfg.sdfg
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  // CHECK-NEXT: [[NAMEA:%[a-zA-Z0-9_]*]] = sdfg.alloc
+  // CHECK-SAME: !sdfg.array<i32>
+  %A = sdfg.alloc() : !sdfg.array<i32>
+  // CHECK-NEXT: [[NAMEB:%[a-zA-Z0-9_]*]] = sdfg.alloc
+  // CHECK-SAME: !sdfg.array<6xi32>
+  %B = sdfg.alloc() : !sdfg.array<6xi32>
+  // CHECK: sdfg.state
+  // CHECK-SAME: @state_0
+  sdfg.state @state_0 {
+    // CHECK: sdfg.map
+    sdfg.map (%i) = (0) to (6) step (1) {
+      // CHECK: [[NAMEC:%[a-zA-Z0-9_]*]] = sdfg.load [[NAMEB]]
+      %b_i = sdfg.load %B[%i] : !sdfg.array<6xi32> -> i32
+      // CHECK: sdfg.store {wcr = "add"} [[NAMEC]], [[NAMEA]][]
+      // CHECK-SAME: i32 -> !sdfg.array<i32>
+      sdfg.store {wcr = "add"} %b_i, %A[] : i32 -> !sdfg.array<i32>
+      // CHECK: sdfg.store {wcr = "lambda a, b: a + 2 * b"} [[NAMEC]]
+      // CHECK-SAME: i32 -> !sdfg.array<i32>
+      sdfg.store {wcr = "lambda a, b: a + 2 * b"} %b_i, %A[]
+        : i32 -> !sdfg.array<i32>
+    }
+  }
+}
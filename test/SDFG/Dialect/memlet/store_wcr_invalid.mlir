@@ -0,0 +1,15 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: wcr is a valid write-conflict resolution
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.array<i32>
+
+  sdfg.state @state_0 {
+    %1 = sdfg.tasklet() -> (i32) {
+      %1 = arith.constant 1 : i32
+      sdfg.return %1 : i32
+    }
+
+    sdfg.store {wcr = "sub"} %1, %A[] : i32 -> !sdfg.array<i32>
+  }
+}
@@ -0,0 +1,18 @@
+// RUN: printf '{"sdfg.scientific": 1, "sdfg.num_arrays": 4, ' > %t.json
+// RUN: printf '"sdfg.num_states": 3, "sdfg.map_depth": 2, ' >> %t.json
+// RUN: printf '"sdfg.tasklets_per_state": 4}' >> %t.json
+// RUN: sdfg-smith --batch=1 --batch-config=%t.json > %t.mlir
+// RUN: sdfg-opt %t.mlir > /dev/null
+// RUN: grep -c "sdfg.state @" %t.mlir | FileCheck --check-prefix=STATES %s
+// RUN: grep -c "sdfg.edge" %t.mlir | FileCheck --check-prefix=EDGES %s
+// RUN: grep -c "sdfg.map " %t.mlir | FileCheck --check-prefix=MAPS %s
+// RUN: grep -c "sdfg.tasklet" %t.mlir | FileCheck --check-prefix=TASKLETS %s
+// RUN: grep -c "sdfg.load" %t.mlir | FileCheck --check-prefix=LOADS %s
+// RUN: grep -c "sdfg.store" %t.mlir | FileCheck --check-prefix=STORES %s
+
+// STATES: {{^}}3{{$}}
+// EDGES: {{^}}2{{$}}
+// MAPS: {{^}}6{{$}}
+// TASKLETS: {{^}}12{{$}}
+// LOADS: {{^}}3{{$}}
+// STORES: {{^}}3{{$}}
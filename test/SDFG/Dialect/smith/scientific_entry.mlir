@@ -0,0 +1,13 @@
+// RUN: printf '{"sdfg.scientific": 1, "sdfg.num_arrays": 2}' > %t.json
+// RUN: sdfg-smith --batch=1 --batch-config=%t.json > %t.mlir
+// RUN: sdfg-opt %t.mlir > %t.opt.mlir
+// RUN: FileCheck --strict-whitespace --check-prefixes=ENTRY,MAP %s < %t.opt.mlir
+// RUN: FileCheck --strict-whitespace --check-prefixes=ENTRY,STORE %s < %t.opt.mlir
+
+// The entry state ends at the next top-level state. Nested states are indented
+// deeper.
+// ENTRY: sdfg.sdfg {{.*}}entry = @[[ENTRY:[a-zA-Z0-9_]+]]
+// ENTRY: {{^    }}sdfg.state @[[ENTRY]]
+// ENTRY-NOT: {{^    }}sdfg.state
+// MAP: sdfg.map
+// STORE: sdfg.store
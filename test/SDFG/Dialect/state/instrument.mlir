@@ -0,0 +1,22 @@
+// RUN: sdfg-opt %s | sdfg-opt | FileCheck %s
+
+// CHECK: module
+// CHECK: sdfg.sdfg
+// CHECK-SAME: instrument = "Timer"
+sdfg.sdfg {instrument = "Timer"} () -> (%r: !sdfg.array<i32>) {
+  // CHECK: sdfg.state
+  // CHECK-SAME: instrument = "PAPI_Counters"
+  // CHECK-SAME: @state_0
+  sdfg.state {instrument = "PAPI_Counters"} @state_0 {
+    // CHECK: sdfg.map
+    // CHECK-SAME: instrument = "LIKWID_CPU"
+    sdfg.map {instrument = "LIKWID_CPU"} (%i) = (0) to (2) step (1) {
+      // CHECK: sdfg.tasklet
+      // CHECK-SAME: instrument = "Timer"
+      %c = sdfg.tasklet {instrument = "Timer"} () -> (i32) {
+        %0 = arith.constant 0 : i32
+        sdfg.return %0 : i32
+      }
+    }
+  }
+}
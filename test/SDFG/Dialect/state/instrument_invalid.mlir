@@ -0,0 +1,7 @@
+// RUN: not sdfg-opt %s 2>&1 | FileCheck %s
+// CHECK: instrument is a valid instrumentation type
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state {instrument = "Stopwatch"} @state_0 {
+  }
+}
@@ -0,0 +1,35 @@
+// RUN: sdfg-opt --collapse-states %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+sdfg.sdfg {entry = @init_0} (%arg0: !sdfg.array<i32>) -> (%arg1: !sdfg.array<i32>) {
+  %0 = sdfg.alloc {name = "_addi_tmp", transient} () : !sdfg.array<i32>
+
+  // CHECK: sdfg.state @init_0
+  sdfg.state @init_0{
+  }
+
+  // CHECK-NEXT: sdfg.load
+  // CHECK: sdfg.tasklet
+  // CHECK: sdfg.store
+  sdfg.state @addi_1{
+    %1 = sdfg.load %arg0[] : !sdfg.array<i32> -> i32
+    %2 = sdfg.tasklet(%1: i32) -> (i32) {
+      %3 = arith.addi %1, %1 : i32
+      sdfg.return %3 : i32
+    }
+    sdfg.store %2, %0[] : i32 -> !sdfg.array<i32>
+  }
+
+  // CHECK-NEXT: sdfg.load
+  // CHECK-NEXT: sdfg.store
+  // CHECK-NEXT: }
+  sdfg.state @return_2{
+    %4 = sdfg.load %0[] : !sdfg.array<i32> -> i32
+    sdfg.store %4, %arg1[] : i32 -> !sdfg.array<i32>
+  }
+
+  // CHECK-NOT: sdfg.state
+  // CHECK-NOT: sdfg.edge
+  sdfg.edge {assign = [], condition = "1"} @init_0 -> @addi_1
+  sdfg.edge {assign = [], condition = "1"} @addi_1 -> @return_2
+}
@@ -0,0 +1,35 @@
+// RUN: sdfg-opt --collapse-states %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+sdfg.sdfg {entry = @read_0} (%arg0: !sdfg.array<i32>) -> (%arg1: !sdfg.array<i32>) {
+  // The second state overwrites the array read by the first state.
+  // CHECK: sdfg.state @read_0
+  sdfg.state @read_0{
+    %0 = sdfg.load %arg0[] : !sdfg.array<i32> -> i32
+    sdfg.store %0, %arg1[] : i32 -> !sdfg.array<i32>
+  }
+
+  // CHECK: sdfg.state @write_1
+  sdfg.state @write_1{
+    %1 = sdfg.tasklet() -> (i32) {
+      %2 = arith.constant 0 : i32
+      sdfg.return %2 : i32
+    }
+    sdfg.store %1, %arg0[] : i32 -> !sdfg.array<i32>
+  }
+
+  // The loop header is entered twice and stays a separate state.
+  // CHECK: sdfg.state @header_2
+  sdfg.state @header_2{
+  }
+
+  // CHECK: sdfg.edge
+  // CHECK-SAME: @read_0 -> @write_1
+  // CHECK: sdfg.edge
+  // CHECK-SAME: @write_1 -> @header_2
+  // CHECK: sdfg.edge
+  // CHECK-SAME: @header_2 -> @header_2
+  sdfg.edge {assign = [], condition = "1"} @read_0 -> @write_1
+  sdfg.edge {assign = [], condition = "1"} @write_1 -> @header_2
+  sdfg.edge {assign = ["i: i + 1"], condition = "i < 10"} @header_2 -> @header_2
+}
@@ -0,0 +1,49 @@
+// RUN: sdfg-opt --eliminate-transients %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+// CHECK-SAME: entry = @load_6
+sdfg.sdfg {entry = @init_0} (%arg0: !sdfg.array<2xi32>) -> (%arg1: !sdfg.array<i32>) {
+  // CHECK: [[TMP:%[a-zA-Z0-9_]*]] = sdfg.alloc {name = "_load_tmp"
+  // CHECK-NOT: _unused_tmp
+  %0 = sdfg.alloc {name = "_load_tmp", transient} () : !sdfg.array<i32>
+  %1 = sdfg.alloc {name = "_unused_tmp", transient} () : !sdfg.array<i32>
+
+  // CHECK-NOT: @init_0
+  sdfg.state @init_0{
+  }
+
+  // CHECK: sdfg.state @load_6
+  sdfg.state @load_6{
+    // CHECK-NEXT: [[A:%[a-zA-Z0-9_]*]] = sdfg.load {{%[a-zA-Z0-9_]*}}[0]
+    %2 = sdfg.load %arg0[0] : !sdfg.array<2xi32> -> i32
+    // CHECK-NEXT: sdfg.store [[A]], [[TMP]][]
+    sdfg.store %2, %0[] : i32 -> !sdfg.array<i32>
+    sdfg.store %2, %1[] : i32 -> !sdfg.array<i32>
+    // CHECK-NEXT: sdfg.tasklet ([[A]] as
+    %3 = sdfg.load %0[] : !sdfg.array<i32> -> i32
+    %4 = sdfg.tasklet(%3: i32) -> (i32) {
+      %5 = arith.addi %3, %3 : i32
+      sdfg.return %5 : i32
+    }
+    %6 = sdfg.load %0[] : !sdfg.array<i32> -> i32
+    sdfg.store %4, %0[] : i32 -> !sdfg.array<i32>
+  }
+
+  // CHECK-NOT: @alloc_init_7
+  sdfg.state @alloc_init_7{
+  }
+
+  // CHECK: sdfg.state @return_8
+  sdfg.state @return_8{
+    // CHECK-NEXT: sdfg.load [[TMP]][]
+    %7 = sdfg.load %0[] : !sdfg.array<i32> -> i32
+    sdfg.store %7, %arg1[] : i32 -> !sdfg.array<i32>
+  }
+
+  // CHECK: sdfg.edge
+  // CHECK-SAME: @load_6 -> @return_8
+  // CHECK-NOT: sdfg.edge
+  sdfg.edge {assign = [], condition = "1"} @init_0 -> @load_6
+  sdfg.edge {assign = [], condition = "1"} @load_6 -> @alloc_init_7
+  sdfg.edge {assign = [], condition = "1"} @alloc_init_7 -> @return_8
+}
@@ -0,0 +1,23 @@
+// RUN: sdfg-opt --eliminate-transients %s | FileCheck %s
+
+sdfg.sdfg {entry = @state_0} (%arg0: !sdfg.array<2xi32>) -> (%arg1: !sdfg.array<i32>) {
+  // CHECK: [[TMP:%[a-zA-Z0-9_]*]] = sdfg.alloc {name = "_acc_tmp"
+  %0 = sdfg.alloc {name = "_acc_tmp", transient} () : !sdfg.array<i32>
+
+  // CHECK: sdfg.state @state_0
+  sdfg.state @state_0{
+    // CHECK-NEXT: [[A:%[a-zA-Z0-9_]*]] = sdfg.load {{%[a-zA-Z0-9_]*}}[0]
+    // CHECK-NEXT: [[B:%[a-zA-Z0-9_]*]] = sdfg.load {{%[a-zA-Z0-9_]*}}[1]
+    %1 = sdfg.load %arg0[0] : !sdfg.array<2xi32> -> i32
+    %2 = sdfg.load %arg0[1] : !sdfg.array<2xi32> -> i32
+    // CHECK-NEXT: sdfg.store [[A]], [[TMP]][]
+    sdfg.store %1, %0[] : i32 -> !sdfg.array<i32>
+    // CHECK-NEXT: sdfg.store {wcr = "add"} [[B]], [[TMP]][]
+    sdfg.store {wcr = "add"} %2, %0[] : i32 -> !sdfg.array<i32>
+    // The accumulated element is not the stored value
+    // CHECK-NEXT: [[C:%[a-zA-Z0-9_]*]] = sdfg.load [[TMP]][]
+    %3 = sdfg.load %0[] : !sdfg.array<i32> -> i32
+    // CHECK-NEXT: sdfg.store [[C]], {{%[a-zA-Z0-9_]*}}[]
+    sdfg.store %3, %arg1[] : i32 -> !sdfg.array<i32>
+  }
+}
@@ -0,0 +1,67 @@
+// RUN: sdfg-opt --inline-nested-sdfgs %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+sdfg.sdfg {entry = @state_0} (%arg0: !sdfg.array<8xi32>) -> (%arg1: !sdfg.array<8xi32>, %arg2: !sdfg.array<i32>) {
+  // The nested SDFG consists of a single state and is inlined.
+  // CHECK: sdfg.state @state_0
+  // CHECK-NEXT: sdfg.alloc {transient}
+  // CHECK-NEXT: sdfg.map
+  // CHECK-NEXT: sdfg.load %arg0
+  // CHECK-NEXT: sdfg.store
+  // CHECK-NEXT: sdfg.load
+  // CHECK-NEXT: sdfg.store {{.*}} %arg1
+  // CHECK-NEXT: }
+  // CHECK-NEXT: }
+  sdfg.state @state_0 {
+    sdfg.nested_sdfg (%arg0 as %a: !sdfg.array<8xi32>) -> (%arg1 as %b: !sdfg.array<8xi32>) {
+      %t = sdfg.alloc () : !sdfg.array<8xi32>
+
+      sdfg.state @inner_0 {
+        sdfg.map (%i) = (0) to (7) step (1) {
+          %0 = sdfg.load %a[%i] : !sdfg.array<8xi32> -> i32
+          sdfg.store %0, %t[%i] : i32 -> !sdfg.array<8xi32>
+          %1 = sdfg.load %t[%i] : !sdfg.array<8xi32> -> i32
+          sdfg.store %1, %b[%i] : i32 -> !sdfg.array<8xi32>
+        }
+      }
+    }
+  }
+
+  // Nested SDFGs with multiple states stay nested.
+  // CHECK: sdfg.state @state_1
+  // CHECK-NEXT: sdfg.nested_sdfg
+  sdfg.state @state_1 {
+    sdfg.nested_sdfg {entry = @inner_1} () -> (%arg2 as %r: !sdfg.array<i32>) {
+      sdfg.state @inner_1 {
+      }
+
+      sdfg.state @inner_2 {
+      }
+
+      sdfg.edge {assign = [], condition = "1"} @inner_1 -> @inner_2
+    }
+  }
+
+  // The nested SDFG overwrites the array read before it.
+  // CHECK: sdfg.state @state_2
+  // CHECK-NEXT: sdfg.load %arg2
+  // CHECK-NEXT: sdfg.nested_sdfg
+  sdfg.state @state_2 {
+    %0 = sdfg.load %arg2[] : !sdfg.array<i32> -> i32
+
+    sdfg.nested_sdfg () -> (%arg2 as %r: !sdfg.array<i32>) {
+      sdfg.state @inner_3 {
+        %1 = sdfg.tasklet() -> (i32) {
+          %2 = arith.constant 0 : i32
+          sdfg.return %2 : i32
+        }
+        sdfg.store %1, %r[] : i32 -> !sdfg.array<i32>
+      }
+    }
+
+    sdfg.store %0, %arg1[0] : i32 -> !sdfg.array<8xi32>
+  }
+
+  sdfg.edge {assign = [], condition = "1"} @state_0 -> @state_1
+  sdfg.edge {assign = [], condition = "1"} @state_1 -> @state_2
+}
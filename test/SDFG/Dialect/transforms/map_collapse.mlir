@@ -0,0 +1,21 @@
+// RUN: sdfg-opt --map-collapse %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+sdfg.sdfg {entry = @state_0} (%arg0: !sdfg.array<8x16xi32>) -> (%arg1: !sdfg.array<8x16xi32>) {
+  // CHECK: sdfg.state @state_0
+  sdfg.state @state_0 {
+    // CHECK-NEXT: sdfg.map {schedule = "CPU_Multicore"}
+    // CHECK-SAME: ([[I:%[a-zA-Z0-9_]*]], [[J:%[a-zA-Z0-9_]*]])
+    // CHECK-SAME: = (0, 0) to (7, 15) step (1, 2)
+    sdfg.map {schedule = "CPU_Multicore"} (%i) = (0) to (7) step (1) {
+      sdfg.map (%j) = (0) to (15) step (2) {
+        // CHECK-NEXT: sdfg.load %arg0{{\[}}[[I]], [[J]]{{\]}}
+        %a = sdfg.load %arg0[%i, %j] : !sdfg.array<8x16xi32> -> i32
+        // CHECK-NEXT: sdfg.store
+        sdfg.store %a, %arg1[%i, %j] : i32 -> !sdfg.array<8x16xi32>
+      }
+    }
+    // CHECK-NEXT: }
+    // CHECK-NEXT: }
+  }
+}
@@ -0,0 +1,32 @@
+// RUN: sdfg-opt --map-fusion %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+sdfg.sdfg {entry = @state_0} (%arg0: !sdfg.array<8xi32>) -> (%arg1: !sdfg.array<8xi32>) {
+  %0 = sdfg.alloc {name = "_tmp", transient} () : !sdfg.array<8xi32>
+
+  // CHECK: sdfg.state @state_0
+  sdfg.state @state_0 {
+    // CHECK-NEXT: sdfg.map ([[I:%[a-zA-Z0-9_]*]])
+    sdfg.map (%i) = (0) to (7) step (1) {
+      // CHECK-NEXT: sdfg.load %arg0{{\[}}[[I]]{{\]}}
+      %a = sdfg.load %arg0[%i] : !sdfg.array<8xi32> -> i32
+      // CHECK-NEXT: sdfg.store {{.*}}{{\[}}[[I]]{{\]}}
+      sdfg.store %a, %0[%i] : i32 -> !sdfg.array<8xi32>
+    }
+
+    // CHECK-NEXT: sdfg.load {{.*}}{{\[}}[[I]]{{\]}}
+    // CHECK-NEXT: sdfg.store {{.*}} %arg1{{\[}}[[I]]{{\]}}
+    // CHECK-NEXT: }
+    sdfg.map (%j) = (0) to (7) step (1) {
+      %b = sdfg.load %0[%j] : !sdfg.array<8xi32> -> i32
+      sdfg.store %b, %arg1[%j] : i32 -> !sdfg.array<8xi32>
+    }
+
+    // CHECK-NEXT: sdfg.map
+    // CHECK-NEXT: sdfg.load {{.*}}[0]
+    sdfg.map (%k) = (0) to (7) step (1) {
+      %c = sdfg.load %arg1[0] : !sdfg.array<8xi32> -> i32
+      sdfg.store %c, %0[%k] : i32 -> !sdfg.array<8xi32>
+    }
+  }
+}
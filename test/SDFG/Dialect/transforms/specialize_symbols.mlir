@@ -0,0 +1,40 @@
+// RUN: sdfg-opt --sdfg-specialize="symbols=N=16,M=8" %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+// CHECK-SAME: !sdfg.array<16x8xf64>
+// CHECK-SAME: !sdfg.array<128xf64>
+sdfg.sdfg {entry = @init_0} (%arg0: !sdfg.array<sym("N")xsym("M")xf64>)
+    -> (%arg1: !sdfg.array<sym("N*M")xf64>) {
+  // CHECK-NOT: sdfg.alloc_symbol
+  // CHECK: sdfg.alloc_symbol ("K")
+  // CHECK-NEXT: sdfg.alloc
+  // CHECK-SAME: !sdfg.array<sym("K+8")xf64>
+  sdfg.state @init_0 {
+    sdfg.alloc_symbol("N")
+    sdfg.alloc_symbol("M")
+    sdfg.alloc_symbol("K")
+    %0 = sdfg.alloc {name = "_tmp", transient} () : !sdfg.array<sym("K+M")xf64>
+  }
+
+  // CHECK: sdfg.state @map_1
+  // CHECK-NEXT: sdfg.map
+  // CHECK-SAME: = (0, 0) to (15, 7) step (1, 1)
+  sdfg.state @map_1 {
+    sdfg.map (%i, %j) = (0, 0) to (sym("N-1"), sym("M-1")) step (1, 1) {
+      // CHECK: sdfg.load
+      // CHECK-SAME: !sdfg.array<16x8xf64>
+      %1 = sdfg.load %arg0[%i, %j] : !sdfg.array<sym("N")xsym("M")xf64> -> f64
+      // CHECK: sdfg.sym ("128") : i64
+      %2 = sdfg.sym("N*M") : i64
+      // CHECK: sdfg.sym ("K*16") : i64
+      %3 = sdfg.sym("K*N") : i64
+      // CHECK: sdfg.sym ("4096") : i64
+      %4 = sdfg.sym("N**3") : i64
+      // CHECK: sdfg.sym ("16**16") : i64
+      %5 = sdfg.sym("N**N") : i64
+    }
+  }
+
+  // CHECK: sdfg.edge {assign = ["i: 15"], condition = "1"}
+  sdfg.edge {assign = ["i: N - 1"], condition = "N > 0"} @init_0 -> @map_1
+}
@@ -0,0 +1,22 @@
+// RUN: sdfg-opt --sdfg-tile-maps="tile-sizes=32,4" %s | FileCheck %s
+
+// CHECK: sdfg.sdfg
+sdfg.sdfg {entry = @state_0} (%arg0: !sdfg.array<100x6xf64>) -> (%arg1: !sdfg.array<100x6xf64>) {
+  // CHECK: sdfg.state @state_0
+  sdfg.state @state_0 {
+    // CHECK-NEXT: sdfg.map {schedule = "CPU_Multicore"}
+    // CHECK-SAME: ([[TI:%[a-zA-Z0-9_]*]], [[TJ:%[a-zA-Z0-9_]*]])
+    // CHECK-SAME: = (0, 0) to (99, 5) step (32, 4)
+    // CHECK-NEXT: [[UB:%[a-zA-Z0-9_]*]]:2 = sdfg.tasklet
+    // CHECK: arith.minsi
+    // CHECK: arith.minsi
+    // CHECK: sdfg.map
+    // CHECK-SAME: = ([[TI]], [[TJ]]) to ([[UB]]#0, [[UB]]#1) step (1, 1)
+    // CHECK-NEXT: sdfg.load
+    // CHECK-NEXT: sdfg.store
+    sdfg.map {schedule = "CPU_Multicore"} (%i, %j) = (0, 0) to (99, 5) step (1, 1) {
+      %a = sdfg.load %arg0[%i, %j] : !sdfg.array<100x6xf64> -> f64
+      sdfg.store %a, %arg1[%i, %j] : f64 -> !sdfg.array<100x6xf64>
+    }
+  }
+}
@@ -0,0 +1,24 @@
+// RUN: python3 %S/../../../../bench/fuzz_perf.py --compare %s --sdfg-opt sdfg-opt --sdfg-translate sdfg-translate --repetitions 1 | FileCheck %s
+// CHECK: outputs match
+
+// The native lowering hands out chunks of eight elements to every processing
+// element, while DaCe consumes the stream element by element. Both have to
+// sum up the same elements.
+sdfg.sdfg {entry = @push} (%A: !sdfg.array<32xi32>) -> (%r: !sdfg.array<i32>) {
+  %S = sdfg.alloc {buffer_size = 32, transient} () : !sdfg.stream<i32>
+
+  sdfg.state @push {
+    sdfg.map (%i) = (0) to (31) step (1) {
+      %a = sdfg.load %A[%i] : !sdfg.array<32xi32> -> i32
+      sdfg.stream_push %a, %S : i32 -> !sdfg.stream<i32>
+    }
+  }
+
+  sdfg.state @consume {
+    sdfg.consume{num_pes=4, chunksize=8} (%S : !sdfg.stream<i32>) -> (pe: %p, elem: %e) {
+      sdfg.store{wcr="add"} %e, %r[] : i32 -> !sdfg.array<i32>
+    }
+  }
+
+  sdfg.edge {assign = [], condition = "1"} @push -> @consume
+}
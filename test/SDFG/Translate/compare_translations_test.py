@@ -0,0 +1,19 @@
+# Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+# Compares two translations of the same program. The streamed translation
+# emits the keys of the top-level SDFG in a different order, so the parsed
+# JSON is compared rather than the text.
+
+import json
+import sys
+
+with open(sys.argv[1]) as f:
+    regular = json.load(f)
+with open(sys.argv[2]) as f:
+    streamed = json.load(f)
+
+if regular != streamed:
+    print("translations differ")
+    exit(1)
+
+print("translations match")
@@ -0,0 +1,68 @@
+# Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+import json
+import struct
+import sys
+from dace import SDFG
+
+
+def decode(data, pos):
+    tag = data[pos]
+    pos += 1
+
+    if tag <= 0x7f:
+        return tag, pos
+    if tag >= 0xe0:
+        return tag - 0x100, pos
+    if 0xa0 <= tag <= 0xbf:
+        size = tag & 0x1f
+        return data[pos:pos + size].decode(), pos + size
+    if tag == 0xc0:
+        return None, pos
+    if tag == 0xc2:
+        return False, pos
+    if tag == 0xc3:
+        return True, pos
+    if tag == 0xcb:
+        return struct.unpack('>d', data[pos:pos + 8])[0], pos + 8
+    if tag == 0xd3:
+        return struct.unpack('>q', data[pos:pos + 8])[0], pos + 8
+    if tag in (0xd9, 0xda, 0xdb):
+        width = {0xd9: 1, 0xda: 2, 0xdb: 4}[tag]
+        size = int.from_bytes(data[pos:pos + width], 'big')
+        pos += width
+        return data[pos:pos + size].decode(), pos + size
+    if tag == 0xdd:
+        size = int.from_bytes(data[pos:pos + 4], 'big')
+        pos += 4
+        arr = []
+        for _ in range(size):
+            val, pos = decode(data, pos)
+            arr.append(val)
+        return arr, pos
+    if tag == 0xdf:
+        size = int.from_bytes(data[pos:pos + 4], 'big')
+        pos += 4
+        obj = {}
+        for _ in range(size):
+            key, pos = decode(data, pos)
+            val, pos = decode(data, pos)
+            obj[key] = val
+        return obj, pos
+
+    raise ValueError('Unsupported MessagePack tag: ' + hex(tag))
+
+
+try:
+    data = sys.stdin.buffer.read()
+    obj, pos = decode(data, 0)
+    if pos != len(data):
+        raise ValueError('Trailing data after MessagePack document')
+    # Dumps the decoded document as JSON, so that it can be checked
+    dump = json.dumps(obj)
+    SDFG.from_json(obj).validate()
+    if '--dump' in sys.argv:
+        print(dump)
+except Exception as e:
+    print(e)
+    exit(1)
@@ -0,0 +1,19 @@
+# Copyright (c) 2021-2023, Scalable Parallel Computing Lab, ETH Zurich
+
+# Translates the given file with the Python bindings and checks that the result
+# matches the JSON translation on stdin.
+
+import json
+import sys
+import mlir_sdfg
+from dace import SDFG
+
+try:
+    with open(sys.argv[1]) as f:
+        obj = mlir_sdfg.translateToSDFG(f.read())
+    if obj != json.load(sys.stdin):
+        raise ValueError('Python translation differs from the JSON one')
+    SDFG.from_json(obj).validate()
+except Exception as e:
+    print(e)
+    exit(1)
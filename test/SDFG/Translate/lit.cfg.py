@@ -59,3 +59,9 @@ tool_dirs = [config.sdfg_tools_dir, config.llvm_tools_dir]
 tools = ['sdfg-translate']
 
 llvm_config.add_tool_substitutions(tools, tool_dirs)
+
+if config.sdfg_python_bindings:
+    config.available_features.add('python-bindings')
+    llvm_config.with_environment('PYTHONPATH',
+                                 os.path.join(config.sdfg_obj_root, 'python'),
+                                 append_path=True)
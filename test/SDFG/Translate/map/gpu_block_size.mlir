@@ -0,0 +1,22 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+
+// The block size is [x, y, z] with x being the innermost dimension.
+// CHECK: "schedule": "GPU_Device"
+// CHECK: "gpu_block_size": [
+// CHECK-NEXT: 32,
+// CHECK-NEXT: 8
+// CHECK-NEXT: ]
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc {storage = "GPU_Global"} () : !sdfg.array<64x64xi32>
+  %B = sdfg.alloc {storage = "GPU_Global"} () : !sdfg.array<64x64xi32>
+
+  sdfg.state @state_0 {
+    sdfg.map {schedule = "GPU_Device", tile_sizes = [8, 32]}
+             (%i, %j) = (0, 0) to (63, 63) step (1, 1) {
+      %a_ij = sdfg.load %A[%i, %j] : !sdfg.array<64x64xi32> -> i32
+      sdfg.store %a_ij, %B[%i, %j] : i32 -> !sdfg.array<64x64xi32>
+    }
+  }
+}
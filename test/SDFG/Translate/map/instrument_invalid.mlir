@@ -0,0 +1,10 @@
+// RUN: not sdfg-translate --mlir-to-sdfg --sdfg-instrument-maps=Timers %s 2>&1 | FileCheck %s
+// RUN: not sdfg-translate --mlir-to-sdfgs --sdfg-instrument-maps=Timers %s 2>&1 | FileCheck %s
+// CHECK: Invalid map instrumentation type 'Timers'
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.map (%i) = (0) to (1) step (1) {
+    }
+  }
+}
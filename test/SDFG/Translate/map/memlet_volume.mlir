@@ -0,0 +1,32 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+
+// CHECK: "dst_connector":{{ ?}}"IN_{{.*}}"
+// CHECK: "subset":{{ ?}}{
+// CHECK: "start":{{ ?}}"0"
+// CHECK-NEXT: "end":{{ ?}}"1"
+// CHECK: "start":{{ ?}}"0"
+// CHECK-NEXT: "end":{{ ?}}"5"
+// CHECK: "volume":{{ ?}}"12"
+// CHECK-NEXT: "dynamic":{{ ?}}false
+// CHECK: "volume":{{ ?}}"1"
+// CHECK: "src_connector":{{ ?}}"OUT_{{.*}}"
+// CHECK: "volume":{{ ?}}"12"
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x6xi32>
+  %B = sdfg.alloc() : !sdfg.array<2x6xi32>
+
+  sdfg.state @state_0 {
+    sdfg.map (%i, %j) = (0, 0) to (1, 5) step (1, 1) {
+      %a_ij = sdfg.load %A[%i, %j] : !sdfg.array<2x6xi32> -> i32
+
+      %res = sdfg.tasklet(%a_ij: i32) -> (i32) {
+        %z = arith.addi %a_ij, %a_ij : i32
+        sdfg.return %z : i32
+      }
+
+      sdfg.store %res, %B[%i, %j] : i32 -> !sdfg.array<2x6xi32>
+    }
+  }
+}
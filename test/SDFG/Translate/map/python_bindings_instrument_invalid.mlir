@@ -0,0 +1,11 @@
+// REQUIRES: python-bindings
+// RUN: not python3 -c "import mlir_sdfg; mlir_sdfg.translateToSDFG(open('%s').read(), instrument_maps='Timers')" 2>&1 | FileCheck %s
+// CHECK: RuntimeError
+// CHECK: Invalid map instrumentation type 'Timers'
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.map (%i) = (0) to (1) step (1) {
+    }
+  }
+}
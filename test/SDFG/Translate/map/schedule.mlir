@@ -0,0 +1,21 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x6xi32>
+  %B = sdfg.alloc() : !sdfg.array<2x6xi32>
+
+  sdfg.state @state_0 {
+    sdfg.map {schedule = "CPU_Multicore", collapse = 2, omp_chunk_size = 4,
+              tile_sizes = [2, 2]}
+             (%i, %j) = (0, 0) to (1, 5) step (1, 1) {
+      %a_ij = sdfg.load %A[%i, %j] : !sdfg.array<2x6xi32> -> i32
+
+      %res = sdfg.tasklet(%a_ij: i32) -> (i32) {
+        %z = arith.addi %a_ij, %a_ij : i32
+        sdfg.return %z : i32
+      }
+
+      sdfg.store %res, %B[%i, %j] : i32 -> !sdfg.array<2x6xi32>
+    }
+  }
+}
@@ -0,0 +1,17 @@
+// RUN: sdfg-opt --sdfg-tile-maps="tile-sizes=32,4" %s | sdfg-translate --mlir-to-sdfg | python3 %S/../import_translation_test.py
+// RUN: sdfg-opt --sdfg-tile-maps="tile-sizes=32,4" %s | sdfg-translate --mlir-to-sdfg | FileCheck %s
+
+// The inner map reads its upper bounds from the tasklet clamping the tiles.
+// CHECK: "type":{{ ?}}"Tasklet"
+// CHECK: "type":{{ ?}}"MapEntry"
+// CHECK: "in_connectors":{{ ?}}{
+// CHECK-SAME: "UB_
+
+sdfg.sdfg {entry = @state_0} (%arg0: !sdfg.array<100x6xf64>) -> (%arg1: !sdfg.array<100x6xf64>) {
+  sdfg.state @state_0 {
+    sdfg.map {schedule = "CPU_Multicore"} (%i, %j) = (0, 0) to (99, 5) step (1, 1) {
+      %a = sdfg.load %arg0[%i, %j] : !sdfg.array<100x6xf64> -> f64
+      sdfg.store %a, %arg1[%i, %j] : f64 -> !sdfg.array<100x6xf64>
+    }
+  }
+}
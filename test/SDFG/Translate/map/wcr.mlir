@@ -0,0 +1,13 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x6xi32>
+  %B = sdfg.alloc() : !sdfg.array<i32>
+
+  sdfg.state @state_0 {
+    sdfg.map (%i, %j) = (0, 0) to (1, 5) step (1, 1) {
+      %a_ij = sdfg.load %A[%i, %j] : !sdfg.array<2x6xi32> -> i32
+      sdfg.store {wcr = "add"} %a_ij, %B[] : i32 -> !sdfg.array<i32>
+    }
+  }
+}
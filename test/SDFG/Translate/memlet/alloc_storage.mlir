@@ -0,0 +1,11 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc {storage = "Register", lifetime = "Scope", transient} ()
+         : !sdfg.array<i32>
+  %B = sdfg.alloc {storage = "CPU_Heap", lifetime = "SDFG", transient} ()
+         : !sdfg.array<2x6xi32>
+
+  sdfg.state @state_0{
+  }
+}
@@ -0,0 +1,15 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+// CHECK: "type":{{ ?}}"View"
+// CHECK: "views"
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.array<8x16x4xi32>
+
+  sdfg.state @state_0 {
+    %a_s = sdfg.subview %A[3, 4, 2][1, 6, 2][1, 1, 1] : !sdfg.array<8x16x4xi32> -> !sdfg.array<6x2xi32>
+    %a_1 = sdfg.load %a_s[1, 0] : !sdfg.array<6x2xi32> -> i32
+    sdfg.store %a_1, %a_s[2, 1] : i32 -> !sdfg.array<6x2xi32>
+  }
+}
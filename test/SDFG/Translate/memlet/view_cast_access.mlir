@@ -0,0 +1,15 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+// CHECK: "type":{{ ?}}"View"
+// CHECK: "views"
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x12xi32>
+  %b = sdfg.view_cast %A : !sdfg.array<2x12xi32> -> !sdfg.array<4x6xi32>
+
+  sdfg.state @state_0 {
+    %b_1 = sdfg.load %b[3, 5] : !sdfg.array<4x6xi32> -> i32
+    sdfg.store %b_1, %A[0, 0] : i32 -> !sdfg.array<2x12xi32>
+  }
+}
@@ -0,0 +1,9 @@
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-compact-json %s | python3 %S/../import_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-compact-json %s | count 1
+
+sdfg.sdfg{entry=@state_0} () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_1 {}
+  sdfg.state @state_0 {}
+
+  sdfg.edge{assign=["i: 1"]} @state_0 -> @state_1
+}
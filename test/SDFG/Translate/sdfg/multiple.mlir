@@ -0,0 +1,25 @@
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: sdfg-translate --mlir-to-sdfgs --sdfg-output-dir=%t/out %s
+// RUN: python3 %S/../import_translation_test.py < %t/out/0.json
+// RUN: python3 %S/../import_translation_test.py < %t/out/1.json
+// RUN: sdfg-translate --mlir-to-sdfgs %s | FileCheck %s
+// RUN: sdfg-translate --mlir-to-sdfgs --sdfg-stream-states %s | FileCheck %s
+// RUN: sdfg-translate --mlir-to-sdfgs %s > %t/parallel.json
+// RUN: sdfg-translate --mlir-to-sdfgs --mlir-disable-threading %s | diff %t/parallel.json -
+
+// CHECK: [
+// CHECK: "type": "SDFG"
+// CHECK: "type": "SDFG"
+// CHECK: ]
+sdfg.sdfg{entry=@state_0} () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {}
+}
+
+sdfg.sdfg{entry=@state_0} () -> (%r: !sdfg.array<i64>) {
+  sdfg.state @state_0 {
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i64>) {
+      sdfg.state @state_1 {
+      }
+    }
+  }
+}
@@ -0,0 +1,24 @@
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-cache-dir=%t/cache %s > %t/miss.json
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-cache-dir=%t/cache %s > %t/hit.json
+// RUN: diff %t/miss.json %t/hit.json
+// RUN: python3 %S/../import_translation_test.py < %t/hit.json
+// RUN: sdfg-translate --mlir-to-sdfg --mlir-disable-threading --sdfg-cache-dir=%t/cache %s | diff %t/hit.json -
+
+sdfg.sdfg () -> (%r: !sdfg.array<sym("N")xi32>) {
+  sdfg.state @state_0{
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<sym("N")xi32>) {
+      sdfg.state @state_1{
+      }
+    }
+
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<sym("N")xi32>) {
+      sdfg.state @state_2{
+        sdfg.nested_sdfg () -> (%r: !sdfg.array<sym("N")xi32>) {
+          sdfg.state @state_3{
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,22 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg --mlir-disable-threading %s | python3 %S/../import_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg %s > %t
+// RUN: sdfg-translate --mlir-to-sdfg --mlir-disable-threading %s | diff %t -
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0{
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+      sdfg.state @state_1{
+      }
+    }
+
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+      sdfg.state @state_2{
+        sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+          sdfg.state @state_3{
+          }
+        }
+      }
+    }
+  }
+}
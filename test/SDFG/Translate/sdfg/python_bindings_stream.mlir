@@ -0,0 +1,23 @@
+// REQUIRES: python-bindings
+// RUN: sdfg-translate --mlir-to-sdfg %s > %t.json
+// RUN: python3 -c "import json, mlir_sdfg; assert mlir_sdfg.translateToSDFG(open('%s').read(), stream_states=True) == json.load(open('%t.json'))"
+
+sdfg.sdfg{entry=@state_0} () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+      sdfg.state @inner_0 {
+        %t = sdfg.tasklet() -> (i32) {
+          %c = arith.constant 0 : i32
+          sdfg.return %c : i32
+        }
+        sdfg.store %t, %r[] : i32 -> !sdfg.array<i32>
+      }
+    }
+  }
+
+  sdfg.state @state_1 {
+    %a = sdfg.alloc {transient} () : !sdfg.array<i32>
+  }
+
+  sdfg.edge{assign=["i: 1"]} @state_0 -> @state_1
+}
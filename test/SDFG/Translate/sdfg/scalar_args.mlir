@@ -0,0 +1,26 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+// CHECK: "_arrays"
+// CHECK: "{{_?}}arg0":{{ ?}}{
+// CHECK-NEXT: "type":{{ ?}}"Array"
+// CHECK: "for_iterarg":{{ ?}}{
+// CHECK-NEXT: "type":{{ ?}}"Scalar"
+// CHECK: "sum_arg":{{ ?}}{
+// CHECK-NEXT: "type":{{ ?}}"Scalar"
+
+sdfg.sdfg () -> (%arg0: !sdfg.array<i32>) {
+  %0 = sdfg.alloc {name = "for_iterarg", transient} () : !sdfg.array<i32>
+  %1 = sdfg.alloc {name = "sum_arg"} () : !sdfg.array<i32>
+
+  sdfg.state @state_0 {
+    %2 = sdfg.tasklet() -> (i32) {
+      %c42_i32 = arith.constant 42 : i32
+      sdfg.return %c42_i32 : i32
+    }
+
+    sdfg.store %2, %0[] : i32 -> !sdfg.array<i32>
+    sdfg.store %2, %1[] : i32 -> !sdfg.array<i32>
+    sdfg.store %2, %arg0[] : i32 -> !sdfg.array<i32>
+  }
+}
@@ -0,0 +1,21 @@
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-stream-states %s | python3 %S/../import_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-stream-states %s | FileCheck %s
+
+// CHECK: "nodes"
+// CHECK: "start_state"
+// CHECK: "_arrays"
+sdfg.sdfg{entry=@state_0} () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+      sdfg.state @state_2 {
+      }
+    }
+  }
+
+  sdfg.state @state_1 {
+    sdfg.alloc_symbol("N")
+    %t = sdfg.alloc {transient} () : !sdfg.array<i32>
+  }
+
+  sdfg.edge{assign=["i: 1"]} @state_0 -> @state_1
+}
@@ -0,0 +1,38 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s > %t.regular.json
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-stream-states %s > %t.streamed.json
+// RUN: python3 %S/../compare_translations_test.py %t.regular.json %t.streamed.json | FileCheck %s
+
+// CHECK: translations match
+sdfg.sdfg{entry=@state_0} () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0 {
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+      sdfg.state @inner_0 {
+        %t = sdfg.tasklet() -> (i32) {
+          %c = arith.constant 0 : i32
+          sdfg.return %c : i32
+        }
+        sdfg.store %t, %r[] : i32 -> !sdfg.array<i32>
+      }
+    }
+  }
+
+  sdfg.state @state_1 {
+    sdfg.nested_sdfg () -> (%r: !sdfg.array<i32>) {
+      sdfg.state @inner_1 {
+        %t = sdfg.tasklet() -> (i32) {
+          %c = arith.constant 1 : i32
+          sdfg.return %c : i32
+        }
+        sdfg.store %t, %r[] : i32 -> !sdfg.array<i32>
+      }
+    }
+  }
+
+  sdfg.state @state_2 {
+    sdfg.alloc_symbol("N")
+    %a = sdfg.alloc {transient} () : !sdfg.array<i32>
+  }
+
+  sdfg.edge{assign=["i: 1"]} @state_0 -> @state_1
+  sdfg.edge{assign=[], condition="1"} @state_1 -> @state_2
+}
@@ -0,0 +1,23 @@
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-cpp-tasklets %s | python3 %S/../import_translation_test.py
+
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-cpp-tasklets %s | FileCheck %s --check-prefix=CODE
+// CODE: "language":{{ ?}}"CPP"
+// CODE: int32_t
+
+// RUN: sdfg-translate --mlir-to-sdfg --sdfg-cpp-tasklets %s | python3 %S/../execute_sdfg.py | FileCheck %s
+// CHECK: begin_dump: [[ARRAY:[a-zA-Z0-9_]*]]
+// CHECK-NEXT: -2147483648
+// CHECK-NEXT: end_dump: [[ARRAY]]
+
+sdfg.sdfg () -> (%r: !sdfg.array<i32>) {
+  sdfg.state @state_0{
+    %res = sdfg.tasklet() -> (i32) {
+      %max = arith.constant 2147483647 : i32
+      %1 = arith.constant 1 : i32
+      %sum = arith.addi %max, %1 : i32
+      sdfg.return %sum : i32
+    }
+
+    sdfg.store %res, %r[] : i32 -> !sdfg.array<i32>
+  }
+}
@@ -0,0 +1,17 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+// CHECK: "classpath": "dace.libraries.standard.nodes.Reduce"
+// CHECK: "identity": 0
+// CHECK: "wcr": "lambda a, b: a + b"
+// CHECK: "axes": [
+// CHECK-NEXT: 1
+// CHECK-NEXT: ]
+
+sdfg.sdfg () -> (%r: !sdfg.array<2xf32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x3xf32>
+
+  sdfg.state @state_0{
+    %b = sdfg.libcall{inputs=["_in"], outputs=["_out"], properties={axes=[1], identity=0, wcr="lambda a, b: a + b"}} "dace.libraries.standard.nodes.Reduce" (%A) : (!sdfg.array<2x3xf32>) -> !sdfg.array<2xf32>
+    sdfg.copy %b -> %r : !sdfg.array<2xf32>
+  }
+}
@@ -0,0 +1,13 @@
+// RUN: sdfg-translate --mlir-to-sdfg-msgpack %s | python3 %S/../import_msgpack_translation_test.py
+// RUN: sdfg-translate --mlir-to-sdfg-msgpack %s | python3 %S/../import_msgpack_translation_test.py --dump | FileCheck %s
+// CHECK: "classpath": "dace.libraries.standard.nodes.Reduce"
+// CHECK-SAME: "axes": [1, 2]
+
+sdfg.sdfg () -> (%r: !sdfg.array<2xf32>) {
+  %A = sdfg.alloc() : !sdfg.array<2x3x4xf32>
+
+  sdfg.state @state_0{
+    %b = sdfg.libcall{inputs=["_in"], outputs=["_out"], properties={axes=[1, 2], identity=0, wcr="lambda a, b: a + b"}} "dace.libraries.standard.nodes.Reduce" (%A) : (!sdfg.array<2x3x4xf32>) -> !sdfg.array<2xf32>
+    sdfg.copy %b -> %r : !sdfg.array<2xf32>
+  }
+}
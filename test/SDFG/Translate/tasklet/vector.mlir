@@ -0,0 +1,29 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+// CHECK: "type":{{ ?}}"vector"
+// CHECK: "elements":{{ ?}}"4"
+// CHECK: "language":{{ ?}}"CPP"
+// CHECK: dace::vec<float, 4>
+
+sdfg.sdfg () -> (%r: !sdfg.array<f32>) {
+  %A = sdfg.alloc() : !sdfg.array<vector<4xf32>>
+
+  sdfg.state @state_0{
+    %v = sdfg.tasklet() -> (vector<4xf32>) {
+      %c = arith.constant dense<2.0> : vector<4xf32>
+      %m = arith.mulf %c, %c : vector<4xf32>
+      sdfg.return %m : vector<4xf32>
+    }
+
+    sdfg.store %v, %A[] : vector<4xf32> -> !sdfg.array<vector<4xf32>>
+    %l = sdfg.load %A[] : !sdfg.array<vector<4xf32>> -> vector<4xf32>
+
+    %s = sdfg.tasklet(%l: vector<4xf32>) -> (f32) {
+      %s = vector.reduction <add>, %l : vector<4xf32> into f32
+      sdfg.return %s : f32
+    }
+
+    sdfg.store %s, %r[] : f32 -> !sdfg.array<f32>
+  }
+}
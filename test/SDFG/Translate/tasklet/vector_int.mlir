@@ -0,0 +1,20 @@
+// RUN: sdfg-translate --mlir-to-sdfg %s | python3 %S/../import_translation_test.py
+
+// RUN: sdfg-translate --mlir-to-sdfg %s | FileCheck %s
+// CHECK: "language":{{ ?}}"CPP"
+// CHECK: dace::vec<int32_t, 2>{static_cast<int32_t>(static_cast<uint32_t>([[A:[a-z_0-9]+]][0]) * static_cast<uint32_t>([[B:[a-z_0-9]+]][0])), static_cast<int32_t>(static_cast<uint32_t>([[A]][1]) * static_cast<uint32_t>([[B]][1]))}
+
+sdfg.sdfg () -> (%r: !sdfg.array<vector<2xi32>>) {
+  %A = sdfg.alloc() : !sdfg.array<vector<2xi32>>
+
+  sdfg.state @state_0{
+    %l = sdfg.load %A[] : !sdfg.array<vector<2xi32>> -> vector<2xi32>
+
+    %v = sdfg.tasklet(%l: vector<2xi32>) -> (vector<2xi32>) {
+      %m = arith.muli %l, %l : vector<2xi32>
+      sdfg.return %m : vector<2xi32>
+    }
+
+    sdfg.store %v, %r[] : vector<2xi32> -> !sdfg.array<vector<2xi32>>
+  }
+}